@@ -274,11 +274,57 @@
  * If your application is very active with random allocation, be sure
  * tolerates restarts due to fragmentation.
  *
+ * Redefine it to `os::memory::tlsf` if the application threads
+ * have real-time constraints; both allocation and deallocation are
+ * deterministic, constant time, regardless of the fragmentation.
+ *
  * @par Default
  *   The default memory manager is `os::memory::first_fit_top`.
  */
 #define OS_TYPE_APPLICATION_MEMORY_RESOURCE
 
+/**
+ * @brief Add per thread caches in front of the application free store.
+ *
+ * @details
+ * By default, `malloc()`, `free()`, `operator new` and `operator delete`
+ * lock the scheduler while using the application memory resource.
+ *
+ * With this option, each thread keeps a cache of small free blocks,
+ * grouped in size classes, and most small allocations and
+ * deallocations complete without locking; the caches are refilled
+ * and drained in batches.
+ *
+ * The cost is a header of `alignof(std::max_align_t)` bytes for
+ * each block and some memory kept in the thread caches.
+ *
+ * @par Default
+ *   Undefined (the allocations always lock the scheduler).
+ */
+#define OS_USE_RTOS_THREAD_ALLOCATION_CACHE
+
+/**
+ * @brief Define the number of size classes in the thread caches.
+ *
+ * @details
+ * The smallest class is `alignof(std::max_align_t)` bytes, and each
+ * class doubles the size of the previous one; larger blocks are
+ * not cached.
+ *
+ * @par Default
+ *   5 (i.e. up to 128 bytes on Cortex-M).
+ */
+#define OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES
+
+/**
+ * @brief Define the maximum number of free blocks kept in each class
+ *  of the thread caches.
+ *
+ * @par Default
+ *   8.
+ */
+#define OS_INTEGER_RTOS_ALLOCATION_CACHE_DEPTH
+
 /**
  * @}
  */
@@ -397,6 +443,57 @@
  */
 #define OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES
 
+/**
+ * @brief Include statistics for thread latencies and load.
+ *
+ * @details
+ * Add support to measure, for each thread:
+ * - the wakeup latency, from the moment the thread is resumed,
+ *   to the moment it is selected to run, as a maximum and as
+ *   a logarithmic histogram;
+ * - the length of the run bursts, as a logarithmic histogram;
+ * - the CPU load in the last complete window of
+ *   @ref OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS ticks.
+ *
+ * The high resolution clock is sampled when the thread is resumed,
+ * and the durations are accounted at context switches.
+ *
+ * The RAM overhead is two histograms of
+ * @ref OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS 32-bit counters
+ * plus six 64-bit variables for each thread.
+ *
+ * It requires @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES, and is
+ * effective only with the µOS++ scheduler.
+ *
+ * @see os::rtos::thread::statistics::cpu_load()
+ * @see os::rtos::thread::statistics::latency_percentile()
+ * @see os::rtos::scheduler::statistics::top()
+ *
+ * @par Default
+ * Disable. Do not include latency statistics.
+ */
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+
+/**
+ * @brief Define the number of buckets in the thread statistics histograms.
+ *
+ * @details
+ * Bucket `n` counts the durations from 2^(n-1) to 2^n-1 CPU cycles;
+ * the last bucket counts all longer durations.
+ *
+ * @par Default
+ *  24 (i.e. up to about 50 ms at 168 MHz).
+ */
+#define OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS (24)
+
+/**
+ * @brief Define the duration of the thread CPU load window, in ticks.
+ *
+ * @par Default
+ *  1000 (i.e. 1 second at 1000 Hz).
+ */
+#define OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS (1000)
+
 /**
  * @brief Add a user defined storage to each thread.
  */
@@ -463,6 +560,169 @@
  */
 #define OS_BOOL_RTOS_SCHEDULER_PREEMPTIVE (true)
 
+/**
+ * @brief Default definition for the thread stack fill flag.
+ *
+ * @details
+ * This option sets the default value of the
+ * `thread::attributes::th_stack_fill` attribute.
+ *
+ * Filling the stack with the magic word is required to measure
+ * the stack usage, but for large stacks it delays the creation
+ * of the threads. When not filled, only the guard words at both
+ * ends of the stack are set.
+ *
+ * @par Default
+ *  True (the entire stack is filled).
+ */
+#define OS_BOOL_RTOS_THREAD_STACK_FILL (true)
+
+/**
+ * @brief Use a bitmap indexed ready list.
+ *
+ * @details
+ * By default the ready threads are kept in a single list, ordered
+ * by priorities, and inserting a thread requires a partial list
+ * traversal, which grows with the number of ready threads.
+ *
+ * With this option, the scheduler keeps a separate FIFO list for
+ * each priority level and a bitmap of the non empty levels,
+ * scanned with the count leading zeros instruction; both inserting
+ * a thread and selecting the next thread to run are constant time.
+ *
+ * The RAM overhead is a list head (two pointers) for each of the
+ * 256 priority levels, plus the bitmap (36 bytes).
+ *
+ * @par Default
+ *  Undefined (use the priority ordered list).
+ */
+#define OS_USE_RTOS_READY_THREADS_BITMAP
+
+/**
+ * @brief Use a hierarchical timing wheel for the clock lists.
+ *
+ * @details
+ * By default the clock timeouts (sleeps, timed waits, timers) are
+ * kept in lists ordered by time stamps, and inserting a node requires
+ * a partial list traversal, which grows with the number of
+ * pending timeouts.
+ *
+ * With this option, each clock list is a 4 levels wheel of
+ * 32 slots each, covering 2^20 clock ticks, plus an overflow list
+ * for farther time stamps; inserting and removing a node are
+ * constant time, and expiring is amortised constant time.
+ *
+ * Timeouts expiring in the same clock check are processed in
+ * slot order, not strictly in time stamp order.
+ *
+ * The RAM overhead is about 1 KB for each clock list (on 32-bit
+ * devices, 129 list heads plus the bitmaps); there are four
+ * lists (the system clock, the high resolution clock and the
+ * two real time clock lists).
+ *
+ * @par Default
+ *  Undefined (use the ordered lists).
+ */
+#define OS_USE_RTOS_CLOCK_TIMING_WHEEL
+
+/**
+ * @brief Suppress the system ticks while idle.
+ *
+ * @details
+ * By default the SysTick interrupt fires at each tick, to increment
+ * the clocks and check the timeouts, even when no thread or timer
+ * is due.
+ *
+ * With this option, the idle thread computes the number of ticks
+ * until the earliest deadline of the tick driven clocks and
+ * calls `os_rtos_idle_tickless_sleep_hook()`, which must suppress
+ * the tick interrupts, sleep, and return the number of ticks slept;
+ * the clock counts are then advanced, and the timeouts expired
+ * meanwhile are processed by the tick that ended the sleep, so the
+ * timer callbacks still run in the SysTick interrupt.
+ *
+ * The thread CPU load windows assume at least one context switch
+ * per tick; while sleeping without ticks there is none, so the
+ * load of the windows spanned by a long sleep is under-reported.
+ *
+ * The hook is device specific and should be provided by the
+ * application; the weak default does not sleep and returns 0,
+ * so the ticks are counted as usual.
+ *
+ * @par Default
+ *  Undefined (the ticks are always counted).
+ */
+#define OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS
+
+/**
+ * @brief Define the maximum length of the priority inheritance chains.
+ *
+ * @details
+ * When a thread blocks on a mutex with the `mutex::protocol::inherit`
+ * protocol, the owner inherits its priority; if the owner is itself
+ * blocked on another such mutex, the priority is propagated further,
+ * to the next owner, and so on.
+ *
+ * This value limits the number of mutexes visited along the
+ * chain, and so the time spent with the scheduler locked.
+ *
+ * @par Default
+ *  8.
+ */
+#define OS_INTEGER_RTOS_MUTEX_INHERITANCE_MAX_DEPTH (8)
+
+/**
+ * @brief Defer the semaphore posts from interrupt handlers.
+ *
+ * @details
+ * When an interrupt handler posts a semaphore, only a pending count
+ * is incremented; the pending counts of all semaphores are folded
+ * once, during the next context switch, when the waiting threads
+ * are also resumed.
+ *
+ * Handlers posting many times in a row (like DMA completion
+ * interrupts, posting once per descriptor) request a single
+ * context switch, instead of one for each post.
+ *
+ * The RAM overhead is a pointer and a counter for each semaphore.
+ *
+ * Ignored if the scheduler is implemented by the port.
+ *
+ * @see os::rtos::semaphore::post()
+ *
+ * @par Default
+ * Disable. The posts from interrupt handlers resume the waiting
+ * threads immediately.
+ */
+#define OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS
+
+/**
+ * @brief Use lock-free free lists in the memory pools.
+ *
+ * @details
+ * The free blocks are kept in a lock-free stack, updated with
+ * atomic compare-and-exchange operations (LDREX/STREX on Cortex-M),
+ * instead of inside interrupts critical sections. The stack head
+ * packs the block index with a generation tag, to be immune
+ * to the ABA problem.
+ *
+ * The allocations and the deallocations do not disable the
+ * interrupts; the critical sections are used only by the blocking
+ * allocations, when the pool is empty, to link the thread to
+ * the waiting list.
+ *
+ * Requires lock-free 32-bit atomics, thus it is not available on
+ * Cortex-M0/M0+ (ARMv6-M) devices.
+ *
+ * @see os::rtos::memory_pool::alloc()
+ * @see os::rtos::memory_pool::free()
+ *
+ * @par Default
+ * Disable. The free lists are updated inside interrupts critical
+ * sections.
+ */
+#define OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE
+
 /**
  * @brief Do not enter sleep in the idle thread.
  *
@@ -793,6 +1053,73 @@
  */
 #define OS_USE_TRACE_SEGGER_RTT
 
+/**
+ * @brief Record trace messages as binary events.
+ *
+ * @details
+ * Instead of formatting the `OS_TRACE_RTOS_*` messages with
+ * `vsnprintf()` and sending them to the trace channel, store
+ * the format string address and the arguments in a RAM ring
+ * buffer, which is much faster and perturbs the timings less.
+ *
+ * The ring (`os_trace_events`) can be dumped by the debugger
+ * and decoded on the host with `scripts/trace-events-decode.py`.
+ *
+ * The `trace::puts()` and `trace::putchar()` output is not affected.
+ *
+ * @see OS_INTEGER_TRACE_EVENTS_RECORDS
+ */
+#define OS_USE_TRACE_EVENTS
+
+/**
+ * @brief Record the context switches as trace events.
+ *
+ * @details
+ * Requires @ref OS_USE_TRACE_EVENTS.
+ */
+#define OS_TRACE_EVENTS_SWITCH
+
+/**
+ * @brief Record the threads resumes as trace events.
+ *
+ * @details
+ * The object which resumed the thread and its kind
+ * (semaphore, mutex, timeout, etc) are recorded as the reason.
+ *
+ * Requires @ref OS_USE_TRACE_EVENTS.
+ */
+#define OS_TRACE_EVENTS_RESUME
+
+/**
+ * @brief Record the threads suspends as trace events.
+ *
+ * @details
+ * The object waited for, its kind and the timeout time stamp
+ * are recorded.
+ *
+ * Requires @ref OS_USE_TRACE_EVENTS.
+ */
+#define OS_TRACE_EVENTS_BLOCK
+
+/**
+ * @brief Record the expired timeouts as trace events.
+ *
+ * @details
+ * Requires @ref OS_USE_TRACE_EVENTS.
+ */
+#define OS_TRACE_EVENTS_TIMEOUT
+
+/**
+ * @brief Record the interrupt handlers entry and exit as trace events.
+ *
+ * @details
+ * The system clock handler is recorded; the application
+ * handlers can use `os::trace::events::isr_scope`.
+ *
+ * Requires @ref OS_USE_TRACE_EVENTS.
+ */
+#define OS_TRACE_EVENTS_ISR
+
 /**
  * @brief Enable trace messages for RTOS clocks functions.
  */
@@ -808,6 +1135,11 @@
  */
 #define OS_TRACE_RTOS_CONDVAR
 
+/**
+ * @brief Enable trace messages for RTOS channels functions.
+ */
+#define OS_TRACE_RTOS_CHANNEL
+
 /**
  * @brief Enable trace messages for RTOS event flags functions.
  */
@@ -833,6 +1165,11 @@
  */
 #define OS_TRACE_RTOS_RTC_TICK
 
+/**
+ * @brief Enable trace messages for RTOS read-write locks functions.
+ */
+#define OS_TRACE_RTOS_RWLOCK
+
 /**
  * @brief Enable trace messages for RTOS scheduler functions.
  */
@@ -871,11 +1208,21 @@
  */
 #define OS_TRACE_RTOS_THREAD_FLAGS
 
+/**
+ * @brief Enable trace messages for RTOS thread pools functions.
+ */
+#define OS_TRACE_RTOS_THREAD_POOL
+
 /**
  * @brief Enable trace messages for RTOS timer functions.
  */
 #define OS_TRACE_RTOS_TIMER
 
+/**
+ * @brief Enable trace messages for RTOS work queues functions.
+ */
+#define OS_TRACE_RTOS_WORK_QUEUE
+
 /**
  * @brief Enable trace messages for RTOS list functions.
  *
@@ -937,6 +1284,19 @@
  */
 #define OS_INTEGER_TRACE_SEMIHOSTING_BUFF_ARRAY_SIZE (16)
 
+/**
+ * @brief Define the number of records in the trace events ring.
+ *
+ * @details
+ * Each record takes 32 bytes on 32-bit platforms.
+ *
+ * @par Default
+ *  256.
+ *
+ * @see OS_USE_TRACE_EVENTS
+ */
+#define OS_INTEGER_TRACE_EVENTS_RECORDS (256)
+
 /**
  * @}
  */
@@ -0,0 +1,383 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_DIAG_TRACE_EVENTS_H_
+#define CMSIS_PLUS_DIAG_TRACE_EVENTS_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/diag/trace.h>
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(OS_INTEGER_TRACE_EVENTS_RECORDS)
+#define OS_INTEGER_TRACE_EVENTS_RECORDS (256)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace trace
+  {
+    /**
+     * @brief Binary trace events namespace.
+     * @ingroup cmsis-plus-diag
+     * @details
+     * Instead of formatting the messages on the target, the trace
+     * events are stored as fixed size binary records in a RAM ring
+     * buffer, and are formatted later, on the host, by
+     * `scripts/trace-events-decode.py`.
+     *
+     * A record holds the event identifier, a time stamp from the
+     * high resolution clock, the current thread and up to
+     * four arguments. The identifier is either a small number
+     * (less than `events::user_id_max`), or the address of a
+     * `printf()` format string, which the decoder reads from
+     * the ELF file.
+     *
+     * Writing a record takes a single atomic increment to reserve
+     * the slot; no locks are used, so records can be written from
+     * any thread and from interrupt handlers. When the ring is
+     * full, the oldest records are overwritten.
+     *
+     * When `OS_USE_TRACE_EVENTS` is defined, the `OS_TRACE_RTOS_*`
+     * messages are recorded as binary events, with the format
+     * string address as identifier; the other `trace::printf()`
+     * output, like the assert and the stack check messages,
+     * is still formatted and written to the trace channel.
+     */
+    namespace events
+    {
+      // ----------------------------------------------------------------------
+
+      /**
+       * @brief Type of event identifiers.
+       */
+      using id_t = uintptr_t;
+
+      /**
+       * @brief Type of event arguments.
+       */
+      using arg_t = uintptr_t;
+
+      /**
+       * @brief Maximum number of arguments in a record.
+       */
+      constexpr std::size_t max_args = 4;
+
+      /**
+       * @brief Identifiers below this value are not addresses.
+       */
+      constexpr id_t user_id_max = 0x10000;
+
+      /**
+       * @brief Ring signature, `"TREV"` in memory.
+       */
+      constexpr uint32_t magic = 0x56455254;
+
+      /**
+       * @brief Version of the ring layout.
+       */
+      constexpr uint16_t version = 2;
+
+      /**
+       * @brief Identifiers of the scheduler events.
+       * @details
+       * The reasons are the `rtos::internal::wait_reason` values,
+       * telling the kind of the object recorded next to them;
+       * the decoder translates the addresses of static objects
+       * to names.
+       */
+      enum : id_t
+      {
+        /**
+         * @brief Context switch; a0 = previous thread, a1 = next
+         *  thread, a2 = state of the previous thread.
+         */
+        thread_switch = 1,
+
+        /**
+         * @brief Thread made ready; a0 = thread, a1 = object posted,
+         *  or 0, a2 = reason.
+         */
+        thread_resume = 2,
+
+        /**
+         * @brief Thread suspended; a0 = thread, a1 = object waited
+         *  for, or 0, a2 = reason, a3 = timeout time stamp, or 0.
+         */
+        thread_block = 3,
+
+        /**
+         * @brief Timeout expired; a0 = thread.
+         */
+        timeout_expired = 4,
+
+        /**
+         * @brief Interrupt handler entered; a0 = handler address.
+         */
+        isr_enter = 5,
+
+        /**
+         * @brief Interrupt handler left; a0 = handler address.
+         */
+        isr_exit = 6,
+
+        /**
+         * @brief First identifier available to the application.
+         */
+        user_first = 0x100
+      };
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Binary trace record.
+       */
+      typedef struct record_s
+      {
+        /**
+         * @brief Record index plus 1, or 0 while being written.
+         */
+        std::atomic<uint32_t> sequence;
+
+        /**
+         * @brief The low 32-bits of the high resolution clock.
+         */
+        uint32_t timestamp;
+
+        /**
+         * @brief Event identifier or address of the format string.
+         */
+        id_t id;
+
+        /**
+         * @brief Address of the current thread, or 0 in handlers.
+         */
+        uintptr_t thread;
+
+        /**
+         * @brief Event arguments; 64-bit values keep only the low
+         *  word, floating point values are stored as `float`.
+         */
+        arg_t args[max_args];
+      } record_t;
+
+      /**
+       * @brief Ring buffer of binary records.
+       * @details
+       * The header describes the layout, so the decoder
+       * can process raw memory dumps from any architecture.
+       */
+      typedef struct ring_s
+      {
+        uint32_t magic;
+        uint16_t version;
+        uint8_t record_bytes;
+        uint8_t arg_bytes;
+        uint32_t records;
+        // Frequency of the time stamps clock, in Hz.
+        uint32_t frequency_hz;
+        // Index of the next record to write; it only increases.
+        std::atomic<uint32_t> next;
+        record_t buffer[OS_INTEGER_TRACE_EVENTS_RECORDS];
+      } ring_t;
+
+#pragma GCC diagnostic pop
+
+      // ----------------------------------------------------------------------
+
+      /**
+       * @brief Write a record with a numeric identifier.
+       * @param [in] id Event identifier, less than `user_id_max`.
+       * @param [in] a0 First argument.
+       * @param [in] a1 Second argument.
+       * @param [in] a2 Third argument.
+       * @param [in] a3 Fourth argument.
+       * @par Returns
+       *  Nothing.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      record (id_t id, arg_t a0 = 0, arg_t a1 = 0, arg_t a2 = 0, arg_t a3 = 0);
+
+      /**
+       * @brief Write a record for a `printf()` format, without
+       *  formatting it.
+       * @param [in] format Address of the format string; it must
+       *  be in read only memory, to be found by the decoder.
+       * @param [in] args A variable arguments list.
+       * @par Returns
+       *  Nothing.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      vrecord (const char* format, std::va_list args);
+
+      /**
+       * @brief Discard all records.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      clear (void);
+
+      /**
+       * @brief Get the ring buffer.
+       * @par Parameters
+       *  None.
+       * @return Reference to the ring.
+       */
+      ring_t&
+      ring (void);
+
+      /**
+       * @brief Write the ring to the trace channel, as hex text.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       *
+       * @details
+       * The ring is written with `trace::write()`, between
+       * `TREV-BEGIN` and `TREV-END` lines, so it can be captured
+       * over semihosting, SWO or the standard output of the
+       * native platform, and passed to the decoder.
+       */
+      void
+      dump (void);
+
+      // ----------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Record the entry and the exit of an interrupt handler.
+       * @details
+       * Create an object of this class at the beginning of
+       * the handler.
+       */
+      class isr_scope
+      {
+      public:
+
+        /**
+         * @brief Record the handler entry.
+         * @param [in] handler Address identifying the handler.
+         */
+        isr_scope (const void* handler);
+
+        /**
+         * @cond ignore
+         */
+
+        isr_scope (const isr_scope&) = delete;
+        isr_scope (isr_scope&&) = delete;
+        isr_scope&
+        operator= (const isr_scope&) = delete;
+        isr_scope&
+        operator= (isr_scope&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Record the handler exit.
+         */
+        ~isr_scope ();
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        arg_t handler_;
+
+        /**
+         * @endcond
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+      // ----------------------------------------------------------------------
+
+      inline
+      isr_scope::isr_scope (const void* handler) :
+          handler_ (reinterpret_cast<arg_t> (handler))
+      {
+        record (isr_enter, handler_);
+      }
+
+      inline
+      isr_scope::~isr_scope ()
+      {
+        record (isr_exit, handler_);
+      }
+
+    // ------------------------------------------------------------------------
+    } /* namespace events */
+  } /* namespace trace */
+} /* namespace os */
+
+/**
+ * @brief The ring buffer, with a C name, to be easily found
+ *  in the ELF and dumped by the debugger.
+ */
+extern "C" os::trace::events::ring_t os_trace_events;
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_DIAG_TRACE_EVENTS_H_ */
@@ -119,6 +119,44 @@ namespace os
        * @}
        */
 
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Get the size of a block.
+       * @par Parameters
+       *  None.
+       * @return The block size, in bytes.
+       */
+      std::size_t
+      block_size (void) const noexcept;
+
+      /**
+       * @brief Get the number of blocks in the pool.
+       * @par Parameters
+       *  None.
+       * @return The number of blocks.
+       */
+      std::size_t
+      capacity (void) const noexcept;
+
+      /**
+       * @brief Get the pool storage address.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the first block.
+       */
+      void*
+      pool (void) const noexcept;
+
+      /**
+       * @}
+       */
+
     protected:
 
       /**
@@ -487,6 +525,24 @@ namespace os
       internal_construct_ (blocks, block_size_bytes, addr, bytes);
     }
 
+    inline std::size_t
+    block_pool::block_size (void) const noexcept
+    {
+      return block_size_bytes_;
+    }
+
+    inline std::size_t
+    block_pool::capacity (void) const noexcept
+    {
+      return blocks_;
+    }
+
+    inline void*
+    block_pool::pool (void) const noexcept
+    {
+      return pool_addr_;
+    }
+
     // ========================================================================
 
     template<typename T, std::size_t N>
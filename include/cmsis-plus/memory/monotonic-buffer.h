@@ -0,0 +1,586 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_MEMORY_MONOTONIC_BUFFER_H_
+#define CMSIS_PLUS_MEMORY_MONOTONIC_BUFFER_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief Memory resource allocating by incrementing a pointer
+     *  in an existing buffer, and releasing all blocks at once.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile monotonic-buffer.h <cmsis-plus/memory/monotonic-buffer.h>
+     *
+     * @details
+     * The blocks are allocated consecutively from the buffer, and
+     * the deallocations do nothing; the memory is released only
+     * by `reset()`, or when a `scope` object is destroyed.
+     *
+     * When the buffer is exhausted, if an upstream memory resource is
+     * set, additional buffers, of increasing sizes, are allocated from
+     * it; they are returned to the upstream memory resource
+     * when released.
+     *
+     * Both operations are deterministic and very fast, at the
+     * cost of not reusing the deallocated blocks. This memory
+     * manager is ideal for the objects with the same life span,
+     * like those used to process a request, which are all
+     * released together at the end.
+     *
+     * Similar to the C++17 `std::pmr::monotonic_buffer_resource`.
+     */
+    class monotonic_buffer : public rtos::memory::memory_resource
+    {
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      // Header of the buffers allocated from upstream.
+      typedef struct buffer_s
+      {
+        /* struct */ buffer_s* next;
+        // Total size, including the header.
+        std::size_t bytes;
+      } buffer_t;
+
+      /**
+       * @endcond
+       */
+
+    public:
+
+      /**
+       * @brief RAII helper to release the blocks allocated
+       *  during its life span.
+       * @headerfile monotonic-buffer.h <cmsis-plus/memory/monotonic-buffer.h>
+       *
+       * @details
+       * The constructor remembers the current position in the buffer,
+       * and the destructor releases all blocks allocated since then.
+       *
+       * Scopes can be nested, but must be destroyed in the reverse
+       * order of their construction, and all objects allocated inside
+       * a scope must be destroyed before it.
+       */
+      class scope
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a scope object instance.
+         * @param [in] mb Reference to the memory resource.
+         */
+        scope (monotonic_buffer& mb) noexcept;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        scope (const scope&) = delete;
+        scope (scope&&) = delete;
+        scope&
+        operator= (const scope&) = delete;
+        scope&
+        operator= (scope&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the scope object instance, releasing the
+         *  blocks allocated since its construction.
+         */
+        ~scope () noexcept;
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        monotonic_buffer& mb_;
+
+        buffer_t* buffer_;
+        char* current_;
+
+        std::size_t total_bytes_;
+        std::size_t allocated_bytes_;
+        std::size_t allocated_chunks_;
+
+        /**
+         * @endcond
+         */
+
+      };
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a memory resource object instance.
+       * @param [in] addr Begin of the buffer.
+       * @param [in] bytes Size of the buffer, in bytes.
+       * @param [in] upstream Pointer to the memory resource used
+       *  when the buffer is exhausted, or `nullptr`.
+       */
+      monotonic_buffer (void* addr, std::size_t bytes,
+                        rtos::memory::memory_resource* upstream = nullptr);
+
+      /**
+       * @brief Construct a named memory resource object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] addr Begin of the buffer.
+       * @param [in] bytes Size of the buffer, in bytes.
+       * @param [in] upstream Pointer to the memory resource used
+       *  when the buffer is exhausted, or `nullptr`.
+       */
+      monotonic_buffer (const char* name, void* addr, std::size_t bytes,
+                        rtos::memory::memory_resource* upstream = nullptr);
+
+    protected:
+
+      /**
+       * @brief Construct a named memory resource object instance.
+       * @param [in] name Pointer to name.
+       */
+      monotonic_buffer (const char* name);
+
+    public:
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      monotonic_buffer (const monotonic_buffer&) = delete;
+      monotonic_buffer (monotonic_buffer&&) = delete;
+      monotonic_buffer&
+      operator= (const monotonic_buffer&) = delete;
+      monotonic_buffer&
+      operator= (monotonic_buffer&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the memory resource object instance.
+       */
+      virtual
+      ~monotonic_buffer () override;
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Release all allocated blocks.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       * @par Standard compliance
+       *   Same as `reset()`; for compatibility with C++17.
+       */
+      void
+      release (void) noexcept;
+
+      /**
+       * @brief Get the upstream memory resource.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the memory resource, or `nullptr`.
+       */
+      rtos::memory::memory_resource*
+      upstream_resource (void) const noexcept;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Internal function to construct the memory resource.
+       * @param [in] addr Begin of the buffer.
+       * @param [in] bytes Size of the buffer, in bytes.
+       * @param [in] upstream Pointer to the memory resource used
+       *  when the buffer is exhausted, or `nullptr`.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (void* addr, std::size_t bytes,
+                           rtos::memory::memory_resource* upstream) noexcept;
+
+      /**
+       * @brief Internal function to release the blocks
+       *  allocated after a given position.
+       * @param [in] buffer Pointer to the buffer allocated from
+       *  upstream, or `nullptr` for the initial buffer.
+       * @param [in] current The first free byte in that buffer.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_release_ (buffer_t* buffer, char* current) noexcept;
+
+      /**
+       * @brief Internal function to allocate a new buffer from upstream.
+       * @param [in] bytes Number of bytes required.
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @retval true The new buffer can serve the request.
+       * @retval false The upstream memory resource is exhausted.
+       */
+      bool
+      internal_grow_ (std::size_t bytes, std::size_t alignment);
+
+      /**
+       * @brief Implementation of the memory allocator.
+       * @param [in] bytes Number of bytes to allocate.
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @return Pointer to newly allocated block, or `nullptr`.
+       */
+      virtual void*
+      do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+      /**
+       * @brief Implementation of the memory deallocator.
+       * @param [in] addr Address of a previously allocated block to free.
+       * @param [in] bytes Number of bytes to deallocate (may be 0 if unknown).
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @par Returns
+       *  Nothing.
+       */
+      virtual void
+      do_deallocate (void* addr, std::size_t bytes, std::size_t alignment)
+          noexcept override;
+
+      /**
+       * @brief Implementation of the function to get max size.
+       * @par Parameters
+       *  None.
+       * @return Integer with size in bytes, or 0 if unknown.
+       */
+      virtual std::size_t
+      do_max_size (void) const noexcept override;
+
+      /**
+       * @brief Implementation of the function to reset the memory manager.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      virtual void
+      do_reset (void) noexcept override;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      // The size of the first buffer allocated from upstream,
+      // if the initial buffer is smaller.
+      static constexpr std::size_t upstream_min_bytes = 256;
+
+      char* initial_addr_ = nullptr;
+      std::size_t initial_bytes_ = 0;
+
+      rtos::memory::memory_resource* upstream_ = nullptr;
+
+      // The buffers allocated from upstream, the most recent first.
+      buffer_t* buffers_ = nullptr;
+      std::size_t next_buffer_bytes_ = 0;
+
+      // The free space in the most recent buffer.
+      char* current_ = nullptr;
+      char* limit_ = nullptr;
+
+      /**
+       * @endcond
+       */
+
+    };
+
+#pragma GCC diagnostic pop
+
+    // ========================================================================
+
+    /**
+     * @brief Memory resource allocating by incrementing a pointer
+     *  in an internal buffer, and releasing all blocks at once.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile monotonic-buffer.h <cmsis-plus/memory/monotonic-buffer.h>
+     *
+     * @details
+     * This class template is a convenience class that includes
+     * an array of chars to be used as the buffer.
+     */
+    template<std::size_t N>
+      class monotonic_buffer_inclusive : public monotonic_buffer
+      {
+      public:
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t bytes = N;
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a memory resource object instance.
+         * @param [in] upstream Pointer to the memory resource used
+         *  when the buffer is exhausted, or `nullptr`.
+         */
+        monotonic_buffer_inclusive (rtos::memory::memory_resource* upstream =
+                                        nullptr);
+
+        /**
+         * @brief Construct a named memory resource object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] upstream Pointer to the memory resource used
+         *  when the buffer is exhausted, or `nullptr`.
+         */
+        monotonic_buffer_inclusive (const char* name,
+                                    rtos::memory::memory_resource* upstream =
+                                        nullptr);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        monotonic_buffer_inclusive (const monotonic_buffer_inclusive&) = delete;
+        monotonic_buffer_inclusive (monotonic_buffer_inclusive&&) = delete;
+        monotonic_buffer_inclusive&
+        operator= (const monotonic_buffer_inclusive&) = delete;
+        monotonic_buffer_inclusive&
+        operator= (monotonic_buffer_inclusive&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual
+        ~monotonic_buffer_inclusive () override;
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief The buffer is an array of bytes.
+         */
+        typename std::aligned_storage<bytes, max_align>::type buffer_;
+
+        /**
+         * @endcond
+         */
+
+      };
+
+  // -------------------------------------------------------------------------
+  } /* namespace memory */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+    inline
+    monotonic_buffer::scope::scope (monotonic_buffer& mb) noexcept :
+        mb_ (mb), //
+        buffer_ (mb.buffers_), //
+        current_ (mb.current_), //
+        total_bytes_ (mb.total_bytes_), //
+        allocated_bytes_ (mb.allocated_bytes_), //
+        allocated_chunks_ (mb.allocated_chunks_)
+    {
+    }
+
+    inline
+    monotonic_buffer::scope::~scope () noexcept
+    {
+      mb_.internal_release_ (buffer_, current_);
+
+      mb_.total_bytes_ = total_bytes_;
+      mb_.allocated_bytes_ = allocated_bytes_;
+      mb_.allocated_chunks_ = allocated_chunks_;
+      mb_.free_bytes_ = static_cast<std::size_t> (mb_.limit_ - mb_.current_);
+    }
+
+    // ========================================================================
+
+    inline
+    monotonic_buffer::monotonic_buffer (const char* name) :
+        rtos::memory::memory_resource
+          { name }
+    {
+    }
+
+    inline
+    monotonic_buffer::monotonic_buffer (void* addr, std::size_t bytes,
+                                        rtos::memory::memory_resource* upstream) :
+        monotonic_buffer
+          { nullptr, addr, bytes, upstream }
+    {
+    }
+
+    inline
+    monotonic_buffer::monotonic_buffer (const char* name, void* addr,
+                                        std::size_t bytes,
+                                        rtos::memory::memory_resource* upstream) :
+        rtos::memory::memory_resource
+          { name }
+    {
+      trace::printf ("%s(%p,%u,%p) @%p %s\n", __func__, addr, bytes, upstream,
+                     this, this->name ());
+
+      internal_construct_ (addr, bytes, upstream);
+    }
+
+    inline void
+    monotonic_buffer::release (void) noexcept
+    {
+      reset ();
+    }
+
+    inline rtos::memory::memory_resource*
+    monotonic_buffer::upstream_resource (void) const noexcept
+    {
+      return upstream_;
+    }
+
+    // ========================================================================
+
+    template<std::size_t N>
+      inline
+      monotonic_buffer_inclusive<N>::monotonic_buffer_inclusive (
+          rtos::memory::memory_resource* upstream) :
+          monotonic_buffer_inclusive (nullptr, upstream)
+      {
+      }
+
+    template<std::size_t N>
+      inline
+      monotonic_buffer_inclusive<N>::monotonic_buffer_inclusive (
+          const char* name, rtos::memory::memory_resource* upstream) :
+          monotonic_buffer
+            { name }
+      {
+        trace::printf ("%s(%p) @%p %s\n", __func__, upstream, this,
+                       this->name ());
+
+        internal_construct_ (&buffer_, bytes, upstream);
+      }
+
+    template<std::size_t N>
+      monotonic_buffer_inclusive<N>::~monotonic_buffer_inclusive ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      }
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace memory */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_MEMORY_MONOTONIC_BUFFER_H_ */
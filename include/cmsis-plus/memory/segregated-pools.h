@@ -0,0 +1,569 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_MEMORY_SEGREGATED_POOLS_H_
+#define CMSIS_PLUS_MEMORY_SEGREGATED_POOLS_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/memory/block-pool.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief Memory resource routing the requests to several
+     *  pools of same size blocks, by size class.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile segregated-pools.h <cmsis-plus/memory/segregated-pools.h>
+     *
+     * @details
+     * Each allocation is served by the pool with the smallest
+     * blocks that fit the requested size and alignment; if that
+     * pool is exhausted, the pools with larger blocks are tried.
+     * Requests larger than all size classes, or which find all pools
+     * exhausted, are forwarded to the upstream memory resource, if any.
+     *
+     * The deallocations are routed by address, so they do not
+     * need the size of the block.
+     *
+     * Both operations are deterministic, with a duration proportional
+     * to the number of size classes, and the pools do not fragment.
+     *
+     * The statistics of the object itself cover only the
+     * blocks in the pools; the occupancy of each size class is
+     * available from the individual pools, and the upstream memory
+     * resource keeps its own statistics.
+     *
+     * This class holds only the routing logic; the pools are
+     * defined by the `segregated_pools_inclusive` class template.
+     */
+    class segregated_pools : public rtos::memory::memory_resource
+    {
+    public:
+
+      /**
+       * @brief Pool of same size blocks, serving one size class.
+       * @headerfile segregated-pools.h <cmsis-plus/memory/segregated-pools.h>
+       */
+      class class_pool : public block_pool
+      {
+      public:
+
+        /**
+         * @brief Construct an empty pool.
+         * @par Parameters
+         *  None.
+         */
+        class_pool ();
+
+        /**
+         * @brief Destruct the pool.
+         */
+        virtual
+        ~class_pool () override = default;
+
+        using block_pool::internal_construct_;
+      };
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+    protected:
+
+      /**
+       * @brief Construct a named memory resource object instance.
+       * @param [in] name Pointer to name.
+       */
+      segregated_pools (const char* name);
+
+    public:
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      segregated_pools (const segregated_pools&) = delete;
+      segregated_pools (segregated_pools&&) = delete;
+      segregated_pools&
+      operator= (const segregated_pools&) = delete;
+      segregated_pools&
+      operator= (segregated_pools&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the memory resource object instance.
+       */
+      virtual
+      ~segregated_pools () override;
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Get the number of size classes.
+       * @par Parameters
+       *  None.
+       * @return The number of pools.
+       */
+      std::size_t
+      classes (void) const noexcept;
+
+      /**
+       * @brief Get the pool serving a size class.
+       * @param [in] index The size class index, in ascending
+       *  order of the block sizes.
+       * @return Reference to the pool.
+       */
+      block_pool&
+      pool (std::size_t index) noexcept;
+
+      /**
+       * @brief Get the upstream memory resource.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the memory resource, or `nullptr`.
+       */
+      rtos::memory::memory_resource*
+      upstream (void) const noexcept;
+
+      /**
+       * @brief Print the occupancy of each size class.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      trace_print_classes (void);
+
+      /**
+       * @brief Get the size of the blocks of a size class.
+       * @param [in] size The size class, in bytes.
+       * @return The block size, in bytes.
+       */
+      static constexpr std::size_t
+      block_bytes (std::size_t size) noexcept;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Internal function to compute the storage of the pools.
+       * @param [in] blocks Number of blocks in each pool.
+       * @param [in] sizes Pointer to array of size classes.
+       * @param [in] count Number of size classes.
+       * @return Number of bytes.
+       */
+      static constexpr std::size_t
+      arena_bytes_ (std::size_t blocks, const std::size_t* sizes,
+                    std::size_t count) noexcept;
+
+      /**
+       * @brief Internal function to validate the size classes.
+       * @param [in] sizes Pointer to array of size classes.
+       * @param [in] count Number of size classes.
+       * @retval true The size classes are in ascending order.
+       * @retval false The size classes are not in ascending order.
+       */
+      static constexpr bool
+      ascending_ (const std::size_t* sizes, std::size_t count) noexcept;
+
+      /**
+       * @brief Internal function to construct the memory resource.
+       * @param [in] pools Pointer to array of pools, in ascending
+       *  order of the block sizes.
+       * @param [in] classes Number of pools.
+       * @param [in] upstream Pointer to the memory resource used
+       *  when the pools cannot serve a request, or `nullptr`.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (class_pool* pools, std::size_t classes,
+                           rtos::memory::memory_resource* upstream) noexcept;
+
+      /**
+       * @brief Internal function to reset the statistics.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_reset_ (void) noexcept;
+
+      /**
+       * @brief Implementation of the memory allocator.
+       * @param [in] bytes Number of bytes to allocate.
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @return Pointer to newly allocated block, or `nullptr`.
+       */
+      virtual void*
+      do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+      /**
+       * @brief Implementation of the memory deallocator.
+       * @param [in] addr Address of a previously allocated block to free.
+       * @param [in] bytes Number of bytes to deallocate (may be 0 if unknown).
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @par Returns
+       *  Nothing.
+       */
+      virtual void
+      do_deallocate (void* addr, std::size_t bytes, std::size_t alignment)
+          noexcept override;
+
+      /**
+       * @brief Implementation of the function to get max size.
+       * @par Parameters
+       *  None.
+       * @return Integer with size in bytes, or 0 if unknown.
+       */
+      virtual std::size_t
+      do_max_size (void) const noexcept override;
+
+      /**
+       * @brief Implementation of the function to reset the memory manager.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      virtual void
+      do_reset (void) noexcept override;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      class_pool* pools_ = nullptr;
+      std::size_t classes_ = 0;
+
+      rtos::memory::memory_resource* upstream_ = nullptr;
+
+      /**
+       * @endcond
+       */
+
+    };
+
+#pragma GCC diagnostic pop
+
+    // ========================================================================
+
+    /**
+     * @brief Memory resource routing the requests to several
+     *  internal pools of same size blocks, by size class.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile segregated-pools.h <cmsis-plus/memory/segregated-pools.h>
+     *
+     * @tparam N The number of blocks in each size class.
+     * @tparam Sizes The size classes, in bytes, in ascending order.
+     *
+     * @details
+     * This class template is a convenience class that includes
+     * the pools and their storage.
+     *
+     * The common use case it to define a statically allocated
+     * memory manager in front of the application free store, to
+     * make the frequent small allocations deterministic:
+     *
+     * @code{.cpp}
+     * static os::memory::segregated_pools_inclusive<32, 16, 32, 64, 128> sp
+     *   { "sp", estd::pmr::get_default_resource () };
+     *
+     * estd::pmr::set_default_resource (&sp);
+     * @endcode
+     */
+    template<std::size_t N, std::size_t ... Sizes>
+      class segregated_pools_inclusive : public segregated_pools
+      {
+      public:
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t blocks = N;
+
+        static_assert(N > 0, "The pools must have at least one block.");
+        static_assert(sizeof...(Sizes) > 0,
+            "There must be at least one size class.");
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a memory resource object instance.
+         * @param [in] upstream Pointer to the memory resource used
+         *  when the pools cannot serve a request, or `nullptr`.
+         */
+        segregated_pools_inclusive (rtos::memory::memory_resource* upstream =
+                                        nullptr);
+
+        /**
+         * @brief Construct a named memory resource object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] upstream Pointer to the memory resource used
+         *  when the pools cannot serve a request, or `nullptr`.
+         */
+        segregated_pools_inclusive (const char* name,
+                                    rtos::memory::memory_resource* upstream =
+                                        nullptr);
+
+      public:
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        segregated_pools_inclusive (const segregated_pools_inclusive&) = delete;
+        segregated_pools_inclusive (segregated_pools_inclusive&&) = delete;
+        segregated_pools_inclusive&
+        operator= (const segregated_pools_inclusive&) = delete;
+        segregated_pools_inclusive&
+        operator= (segregated_pools_inclusive&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual
+        ~segregated_pools_inclusive () override;
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        static constexpr std::size_t sizes_[] =
+          { Sizes... };
+
+        static_assert(ascending_ (sizes_, sizeof...(Sizes)),
+            "The size classes must be in ascending order.");
+
+        class_pool pools_storage_[sizeof...(Sizes)];
+
+        /**
+         * @brief The storage of all pools.
+         */
+        typename std::aligned_storage<
+            arena_bytes_ (N, sizes_, sizeof...(Sizes)), max_align>::type arena_;
+
+        /**
+         * @endcond
+         */
+
+      };
+
+  // -------------------------------------------------------------------------
+  } /* namespace memory */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+    inline
+    segregated_pools::class_pool::class_pool () :
+        block_pool
+          { nullptr }
+    {
+    }
+
+    // ========================================================================
+
+    inline
+    segregated_pools::segregated_pools (const char* name) :
+        rtos::memory::memory_resource
+          { name }
+    {
+    }
+
+    inline std::size_t
+    segregated_pools::classes (void) const noexcept
+    {
+      return classes_;
+    }
+
+    inline block_pool&
+    segregated_pools::pool (std::size_t index) noexcept
+    {
+      assert(index < classes_);
+      return pools_[index];
+    }
+
+    inline rtos::memory::memory_resource*
+    segregated_pools::upstream (void) const noexcept
+    {
+      return upstream_;
+    }
+
+    /**
+     * @details
+     * The blocks must be able to store the free list link,
+     * and their size is a multiple of the maximum alignment,
+     * so that all blocks carved from the arena can serve the
+     * default aligned requests.
+     */
+    constexpr std::size_t
+    segregated_pools::block_bytes (std::size_t size) noexcept
+    {
+      return rtos::memory::align_size (
+          rtos::memory::max (size, sizeof(void*)), max_align);
+    }
+
+    constexpr std::size_t
+    segregated_pools::arena_bytes_ (std::size_t blocks,
+                                    const std::size_t* sizes,
+                                    std::size_t count) noexcept
+    {
+      return (count == 0) ?
+          0 :
+          blocks * block_bytes (sizes[0])
+              + arena_bytes_ (blocks, sizes + 1, count - 1);
+    }
+
+    constexpr bool
+    segregated_pools::ascending_ (const std::size_t* sizes,
+                                  std::size_t count) noexcept
+    {
+      return (count < 2) ?
+          true : (sizes[0] < sizes[1]) && ascending_ (sizes + 1, count - 1);
+    }
+
+    // ========================================================================
+
+    template<std::size_t N, std::size_t ... Sizes>
+      constexpr std::size_t segregated_pools_inclusive<N, Sizes...>::sizes_[];
+
+    template<std::size_t N, std::size_t ... Sizes>
+      inline
+      segregated_pools_inclusive<N, Sizes...>::segregated_pools_inclusive (
+          rtos::memory::memory_resource* upstream) :
+          segregated_pools_inclusive (nullptr, upstream)
+      {
+      }
+
+    template<std::size_t N, std::size_t ... Sizes>
+      segregated_pools_inclusive<N, Sizes...>::segregated_pools_inclusive (
+          const char* name, rtos::memory::memory_resource* upstream) :
+          segregated_pools
+            { name }
+      {
+        trace::printf ("%s(%p) @%p %s\n", __func__, upstream, this,
+                       this->name ());
+
+        // Carve the storage of each pool from the common arena;
+        // since the arena and all block sizes are aligned to
+        // max_align, so are the pools.
+        char* addr = reinterpret_cast<char*> (&arena_);
+        for (std::size_t i = 0; i < sizeof...(Sizes); ++i)
+          {
+            std::size_t block = block_bytes (sizes_[i]);
+            std::size_t bytes = N * block;
+            pools_storage_[i].internal_construct_ (N, block, addr, bytes);
+            addr += bytes;
+          }
+
+        internal_construct_ (pools_storage_, sizeof...(Sizes), upstream);
+      }
+
+    template<std::size_t N, std::size_t ... Sizes>
+      segregated_pools_inclusive<N, Sizes...>::~segregated_pools_inclusive ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      }
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace memory */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_MEMORY_SEGREGATED_POOLS_H_ */
@@ -0,0 +1,699 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_MEMORY_TLSF_H_
+#define CMSIS_PLUS_MEMORY_TLSF_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief Memory resource implementing the two level segregated fit
+     *  (TLSF) allocation policies, using an existing arena.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile tlsf.h <cmsis-plus/memory/tlsf.h>
+     *
+     * @details
+     * The free blocks are kept in segregated lists, indexed by
+     * a first level, the power of two of the block size, and a second
+     * level, which splits each power of two range into 16 linear
+     * sub-ranges; two levels of bitmaps identify the non empty lists.
+     *
+     * Allocation selects a list guaranteed to hold large enough blocks
+     * with two bit scans, and deallocation immediately coalesces the
+     * block with its free neighbours, using the physical links
+     * kept in the block headers. Both are deterministic, constant time,
+     * operations, regardless of the fragmentation.
+     *
+     * The overhead for each allocated block is the size word, rounded
+     * up to `max_align`; all block sizes are multiples of `max_align`
+     * and all payloads are aligned to it, such that the requests with
+     * the default alignment never need to split leading free blocks.
+     *
+     * The algorithm was described by M. Masmano, I. Ripoll, A. Crespo,
+     * and J. Real, in _TLSF: a New Dynamic Memory Allocator for
+     * Real-Time Systems_ (2004).
+     */
+    class tlsf : public rtos::memory::memory_resource
+    {
+    public:
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a memory resource object instance.
+       * @param [in] addr Begin of allocator arena.
+       * @param [in] bytes Size of allocator arena, in bytes.
+       */
+      tlsf (void* addr, std::size_t bytes);
+
+      /**
+       * @brief Construct a named memory resource object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] addr Begin of allocator arena.
+       * @param [in] bytes Size of allocator arena, in bytes.
+       */
+      tlsf (const char* name, void* addr, std::size_t bytes);
+
+    protected:
+
+      /**
+       * @brief Default constructor. Construct a memory resource
+       *  object instance.
+       */
+      tlsf () = default;
+
+      /**
+       * @brief Construct a named memory resource object instance.
+       * @param [in] name Pointer to name.
+       */
+      tlsf (const char* name);
+
+    public:
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      tlsf (const tlsf&) = delete;
+      tlsf (tlsf&&) = delete;
+      tlsf&
+      operator= (const tlsf&) = delete;
+      tlsf&
+      operator= (tlsf&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the memory resource object instance.
+       */
+      virtual
+      ~tlsf () override;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      // A 'block' is where the user payload resides; the physical
+      // neighbours are reachable from the header.
+      typedef struct block_s
+      {
+        // Valid only if the previous physical block is free; otherwise,
+        // when the overhead is smaller than the header, it is
+        // the last word of the previous block payload.
+        /* struct */ block_s* prev_phys;
+
+        // The payload size, in bytes; the next block payload
+        // starts `block_overhead` bytes after the payload end.
+        // The two least significant bits are status flags.
+        // This is the only overhead that applies to all allocated blocks.
+        std::size_t size;
+
+        // For allocated blocks, here, or at the next address that
+        // satisfies the required alignment, starts the payload.
+
+        // When the block is free, instead of the payload,
+        // here are the links in the segregated free list.
+        /* struct */ block_s* next_free;
+        /* struct */ block_s* prev_free;
+      } block_t;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Internal function to construct the memory resource.
+       * @param [in] addr Begin of allocator arena.
+       * @param [in] bytes Size of allocator arena, in bytes.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (void* addr, std::size_t bytes);
+
+      /**
+       * @brief Internal function to reset the memory resource.
+       * @par Parameters
+       *  None.
+       */
+      void
+      internal_reset_ (void) noexcept;
+
+      /**
+       * @brief Implementation of the memory allocator.
+       * @param [in] bytes Number of bytes to allocate.
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @return Pointer to newly allocated block, or `nullptr`.
+       */
+      virtual void*
+      do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+      /**
+       * @brief Implementation of the memory deallocator.
+       * @param [in] addr Address of a previously allocated block to free.
+       * @param [in] bytes Number of bytes to deallocate (may be 0 if unknown).
+       * @param [in] alignment Alignment constraint (power of 2).
+       * @par Returns
+       *  Nothing.
+       */
+      virtual void
+      do_deallocate (void* addr, std::size_t bytes, std::size_t alignment)
+          noexcept override;
+
+      /**
+       * @brief Implementation of the function to get max size.
+       * @par Parameters
+       *  None.
+       * @return Integer with size in bytes, or 0 if unknown.
+       */
+      virtual std::size_t
+      do_max_size (void) const noexcept override;
+
+      /**
+       * @brief Implementation of the function to reset the memory manager.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      virtual void
+      do_reset (void) noexcept override;
+
+      /**
+       * @cond ignore
+       */
+
+      static std::size_t
+      block_size_ (const block_t* block);
+
+      static block_t*
+      next_block_ (const block_t* block);
+
+      static void*
+      payload_ (const block_t* block);
+
+      static block_t*
+      from_payload_ (const void* ptr);
+
+      static void
+      mark_as_free_ (block_t* block);
+
+      static void
+      mark_as_used_ (block_t* block);
+
+      static void
+      mapping_insert_ (std::size_t size, std::size_t& fl, std::size_t& sl);
+
+      static void
+      mapping_search_ (std::size_t size, std::size_t& fl, std::size_t& sl);
+
+      block_t*
+      search_suitable_ (std::size_t& fl, std::size_t& sl);
+
+      void
+      insert_free_ (block_t* block);
+
+      void
+      remove_free_ (block_t* block);
+
+      block_t*
+      locate_free_ (std::size_t size);
+
+      block_t*
+      split_ (block_t* block, std::size_t size);
+
+      block_t*
+      absorb_ (block_t* prev, block_t* block);
+
+      block_t*
+      merge_prev_ (block_t* block);
+
+      void
+      merge_next_ (block_t* block);
+
+      block_t*
+      trim_leading_ (block_t* block, std::size_t size);
+
+      void
+      trim_trailing_ (block_t* block, std::size_t size);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      // All block sizes and payloads are multiples of the maximum
+      // alignment, which is the default allocation alignment.
+      static constexpr std::size_t block_align = max_align;
+      static constexpr std::size_t align_log2 =
+          static_cast<std::size_t> (__builtin_ctz (
+              static_cast<unsigned int> (block_align)));
+
+      static_assert((1u << align_log2) == block_align,
+          "max_align must be a power of 2");
+
+      // Number of second level lists for each first level.
+      static constexpr std::size_t sl_count_log2 = 4;
+      static constexpr std::size_t sl_count = 1u << sl_count_log2;
+
+      // Blocks below this size are all kept in the first level 0,
+      // with linear second level ranges.
+      static constexpr std::size_t fl_shift = sl_count_log2 + align_log2;
+      static constexpr std::size_t small_block_size = 1u << fl_shift;
+
+      // The largest block is 1 GB on 32-bit and 4 GB on 64-bit
+      // platforms, well beyond the usual arenas.
+      static constexpr std::size_t fl_max = (sizeof(void*) == 8) ? 32 : 30;
+      static constexpr std::size_t fl_count = fl_max - fl_shift + 1;
+
+      static constexpr std::size_t block_size_max = static_cast<std::size_t> (1)
+          << fl_max;
+
+      // Offset of payload inside the block.
+      static constexpr std::size_t block_offset = offsetof(block_t, next_free);
+      // Only the size is overhead for allocated blocks, but it is
+      // rounded up to keep the payloads aligned; when it is smaller
+      // than the header, the previous block payload overlaps it.
+      static constexpr std::size_t block_overhead = rtos::memory::align_size (
+          block_offset - sizeof(block_t*), block_align);
+      static constexpr std::size_t block_overlap =
+          (block_offset > block_overhead) ? block_offset - block_overhead : 0;
+      // A free block payload must hold the free list links and the
+      // part of the next block header that overlaps it.
+      static constexpr std::size_t block_size_min = rtos::memory::align_size (
+          sizeof(block_t) - block_offset + block_overlap, block_align);
+
+      // Flags stored in the size least significant bits.
+      static constexpr std::size_t block_free_bit = 1;
+      static constexpr std::size_t block_prev_free_bit = 2;
+      static constexpr std::size_t block_flags = block_free_bit
+          | block_prev_free_bit;
+
+      static_assert(fl_count <= 32, "adjust the bitmaps");
+      static_assert(sl_count <= 32, "adjust the bitmaps");
+
+      void* arena_addr_ = nullptr;
+      std::size_t arena_bytes_ = 0;
+
+      uint32_t fl_bitmap_ = 0;
+      uint32_t sl_bitmap_[fl_count];
+
+      block_t* free_lists_[fl_count][sl_count];
+
+      /**
+       * @endcond
+       */
+
+    };
+
+#pragma GCC diagnostic pop
+
+    // ========================================================================
+
+    /**
+     * @brief Memory resource implementing the two level segregated fit
+     *  (TLSF) allocation policies, using an internal arena.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile tlsf.h <cmsis-plus/memory/tlsf.h>
+     *
+     * @details
+     * This class template is a convenience class that includes
+     * an array of chars to be used as the allocation arena.
+     *
+     * The common use case it to define statically allocated memory managers.
+     */
+    template<std::size_t N>
+      class tlsf_inclusive : public tlsf
+      {
+      public:
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t bytes = N;
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a memory resource object instance.
+         * @par Parameters
+         *  None.
+         */
+        tlsf_inclusive (void);
+
+        /**
+         * @brief Construct a named memory resource object instance.
+         * @param [in] name Pointer to name.
+         */
+        tlsf_inclusive (const char* name);
+
+      public:
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        tlsf_inclusive (const tlsf_inclusive&) = delete;
+        tlsf_inclusive (tlsf_inclusive&&) = delete;
+        tlsf_inclusive&
+        operator= (const tlsf_inclusive&) = delete;
+        tlsf_inclusive&
+        operator= (tlsf_inclusive&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual
+        ~tlsf_inclusive ();
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief The allocation arena is an array of bytes.
+         */
+        char arena_[bytes];
+
+        /**
+         * @endcond
+         */
+
+      };
+
+    // ========================================================================
+
+    /**
+     * @brief Memory resource implementing the two level segregated fit
+     *  (TLSF) allocation policies, using a dynamically allocated arena.
+     * @ingroup cmsis-plus-rtos-memres
+     * @headerfile tlsf.h <cmsis-plus/memory/tlsf.h>
+     *
+     * @details
+     * This class template is a convenience class that allocates
+     * an array of chars to be used as the allocation arena.
+     *
+     * The common use case it to define dynamically allocated memory managers.
+     */
+    template<typename A = os::rtos::memory::allocator<char>>
+      class tlsf_allocated : public tlsf
+      {
+      public:
+
+        /**
+         * @brief Standard allocator type definition.
+         */
+        using value_type = char;
+
+        /**
+         * @brief Standard allocator type definition.
+         */
+        using allocator_type = A;
+
+        /**
+         * @brief Standard allocator traits definition.
+         */
+        using allocator_traits = std::allocator_traits<A>;
+
+        // It is recommended to have the same type, but at least the types
+        // should have the same size.
+        static_assert(sizeof(value_type) == sizeof(typename allocator_traits::value_type),
+            "The allocator must be parametrised with a type of same size.");
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a memory resource object instance.
+         * @param [in] bytes The size of the allocation arena.
+         * @param [in] allocator Reference to allocator. Default a
+         * local temporary instance.
+         */
+        tlsf_allocated (std::size_t bytes, const allocator_type& allocator =
+                            allocator_type ());
+
+        /**
+         * @brief Construct a named memory resource object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] bytes The size of the allocation arena.
+         * @param [in] allocator Reference to allocator. Default a
+         * local temporary instance.
+         */
+        tlsf_allocated (const char* name, std::size_t bytes,
+                        const allocator_type& allocator = allocator_type ());
+
+      public:
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        tlsf_allocated (const tlsf_allocated&) = delete;
+        tlsf_allocated (tlsf_allocated&&) = delete;
+        tlsf_allocated&
+        operator= (const tlsf_allocated&) = delete;
+        tlsf_allocated&
+        operator= (tlsf_allocated&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual
+        ~tlsf_allocated ();
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief Pointer to allocator.
+         * @details
+         * The allocator is remembered because deallocation
+         * must be performed during destruction.
+         */
+        allocator_type* allocator_ = nullptr;
+
+        /**
+         * @endcond
+         */
+
+      };
+
+  // --------------------------------------------------------------------------
+  } /* namespace memory */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+    inline
+    tlsf::tlsf (const char* name) :
+        rtos::memory::memory_resource
+          { name }
+    {
+    }
+
+    inline
+    tlsf::tlsf (void* addr, std::size_t bytes) :
+        tlsf
+          { nullptr, addr, bytes }
+    {
+    }
+
+    inline
+    tlsf::tlsf (const char* name, void* addr, std::size_t bytes) :
+        rtos::memory::memory_resource
+          { name }
+    {
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, addr, bytes, this,
+                     this->name ());
+
+      internal_construct_ (addr, bytes);
+    }
+
+    // ========================================================================
+
+    template<std::size_t N>
+      inline
+      tlsf_inclusive<N>::tlsf_inclusive () :
+          tlsf_inclusive (nullptr)
+      {
+      }
+
+    template<std::size_t N>
+      inline
+      tlsf_inclusive<N>::tlsf_inclusive (const char* name) :
+          tlsf
+            { name }
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+
+        internal_construct_ (&arena_[0], bytes);
+      }
+
+    template<std::size_t N>
+      tlsf_inclusive<N>::~tlsf_inclusive ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      }
+
+    // ========================================================================
+
+    template<typename A>
+      inline
+      tlsf_allocated<A>::tlsf_allocated (std::size_t bytes,
+                                         const allocator_type& allocator) :
+          tlsf_allocated (nullptr, bytes, allocator)
+      {
+      }
+
+    template<typename A>
+      tlsf_allocated<A>::tlsf_allocated (const char* name, std::size_t bytes,
+                                         const allocator_type& allocator) :
+          tlsf
+            { name }
+      {
+        trace::printf ("%s(%u) @%p %s\n", __func__, bytes, this, this->name ());
+
+        // Remember the allocator, it'll be used by the destructor.
+        allocator_ =
+            static_cast<allocator_type*> (&const_cast<allocator_type&> (allocator));
+
+        void* addr = allocator_->allocate (bytes);
+        if (addr == nullptr)
+          {
+            estd::__throw_bad_alloc ();
+          }
+
+        internal_construct_ (addr, bytes);
+      }
+
+    template<typename A>
+      tlsf_allocated<A>::~tlsf_allocated ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+
+        // Skip in case a derived class did the deallocation.
+        if (allocator_ != nullptr)
+          {
+            allocator_->deallocate (
+                static_cast<typename allocator_traits::pointer> (arena_addr_),
+                arena_bytes_);
+
+            // Prevent another deallocation.
+            allocator_ = nullptr;
+          }
+      }
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace memory */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_MEMORY_TLSF_H_ */
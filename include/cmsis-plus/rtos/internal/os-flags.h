@@ -117,6 +117,18 @@ namespace os
         check_raised (flags::mask_t mask, flags::mask_t* oflags,
                       flags::mode_t mode);
 
+        /**
+         * @brief Check if expected flags are raised, without clearing them.
+         * @param [in] mask The expected flags (OR-ed bit-mask);
+         *  if `flags::any`, any flag raised will do it.
+         * @param [in] mode Mode bits to select if either all or any flags
+         *  in the mask are expected (the clear bit is ignored).
+         * @retval true The expected flags are raised.
+         * @retval false The expected flags are not raised.
+         */
+        bool
+        is_raised (flags::mask_t mask, flags::mode_t mode) const;
+
         /**
          * @brief Get (and possibly clear) event flags.
          * @param [in] mask The OR-ed flags to get/clear; can be `flags::any`.
@@ -25,6 +25,7 @@
 #include <cstddef>
 #include <cassert>
 #include <iterator>
+#include <limits>
 
 // ----------------------------------------------------------------------------
 
@@ -41,6 +42,7 @@ namespace os
   namespace rtos
   {
     class thread;
+    class work_item;
 
     namespace internal
     {
@@ -116,6 +118,222 @@ namespace os
 
       // ======================================================================
 
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Double linked list node, with thread reference and
+       *  the expected flags.
+       */
+      class waiting_flags_node : public waiting_thread_node
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a node with references to the thread.
+         * @param th Reference to the thread.
+         * @param mask The expected flags (OR-ed bit-mask).
+         * @param mode Mode bits to select if either all or any flags
+         *  in the mask are expected.
+         */
+        waiting_flags_node (thread& th, flags::mask_t mask,
+                            flags::mode_t mode);
+
+        /**
+         * @cond ignore
+         */
+
+        waiting_flags_node (const waiting_flags_node&) = delete;
+        waiting_flags_node (waiting_flags_node&&) = delete;
+        waiting_flags_node&
+        operator= (const waiting_flags_node&) = delete;
+        waiting_flags_node&
+        operator= (waiting_flags_node&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the node.
+         */
+        ~waiting_flags_node ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        /**
+         * @brief The flags expected by the waiting thread.
+         */
+        flags::mask_t mask_;
+
+        /**
+         * @brief The wait mode (all/any).
+         */
+        flags::mode_t mode_;
+
+        /**
+         * @}
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+      // ======================================================================
+
+      /**
+       * @brief Double linked list node, with thread reference and
+       *  the mutex associated with the condition variable.
+       */
+      class waiting_condvar_node : public waiting_thread_node
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a node with references to the thread.
+         * @param th Reference to the thread.
+         * @param mx Reference to the mutex released by the thread.
+         */
+        waiting_condvar_node (thread& th, mutex& mx);
+
+        /**
+         * @cond ignore
+         */
+
+        waiting_condvar_node (const waiting_condvar_node&) = delete;
+        waiting_condvar_node (waiting_condvar_node&&) = delete;
+        waiting_condvar_node&
+        operator= (const waiting_condvar_node&) = delete;
+        waiting_condvar_node&
+        operator= (waiting_condvar_node&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the node.
+         */
+        ~waiting_condvar_node ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        /**
+         * @brief The mutex to be locked again after the wait.
+         */
+        mutex* mutex_;
+
+        /**
+         * @}
+         */
+      };
+
+      // ======================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Double linked list node, with thread reference and
+       *  the number of expected units.
+       */
+      class waiting_count_node : public waiting_thread_node
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a node with references to the thread.
+         * @param th Reference to the thread.
+         * @param count The number of units expected by the thread.
+         */
+        waiting_count_node (thread& th, uint32_t count);
+
+        /**
+         * @cond ignore
+         */
+
+        waiting_count_node (const waiting_count_node&) = delete;
+        waiting_count_node (waiting_count_node&&) = delete;
+        waiting_count_node&
+        operator= (const waiting_count_node&) = delete;
+        waiting_count_node&
+        operator= (waiting_count_node&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the node.
+         */
+        ~waiting_count_node ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        /**
+         * @brief The number of units still expected by the thread;
+         *  zero when the units were handed over.
+         */
+        uint32_t count_;
+
+        /**
+         * @}
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+      // ======================================================================
+
 #pragma GCC diagnostic push
 #if defined(__clang__)
 #pragma clang diagnostic ignored "-Wpadded"
@@ -389,6 +607,97 @@ namespace os
          */
       };
 
+#pragma GCC diagnostic pop
+
+      // ======================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Double linked list node, with time stamp and work item.
+       */
+      class work_node : public timestamp_node
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a clock work node.
+         * @param [in] ts Time stamp.
+         * @param [in] wi Reference to work item.
+         */
+        work_node (port::clock::timestamp_t ts, work_item& wi);
+
+        /**
+         * @cond ignore
+         */
+        work_node (const work_node&) = delete;
+        work_node (work_node&&) = delete;
+        work_node&
+        operator= (const work_node&) = delete;
+        work_node&
+        operator= (work_node&&) = delete;
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the node.
+         */
+        virtual
+        ~work_node () override;
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Action to perform when the time stamp is reached.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        action (void) override;
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        /**
+         * @brief Reference to delayed work item.
+         */
+        work_item& item;
+
+        /**
+         * @}
+         */
+      };
+
 #pragma GCC diagnostic pop
 
       // ======================================================================
@@ -459,6 +768,8 @@ namespace os
 
       // ======================================================================
 
+#if !defined(OS_USE_RTOS_READY_THREADS_BITMAP)
+
       /**
        * @brief Priority ordered list of threads waiting too run.
        */
@@ -522,25 +833,208 @@ namespace os
          *  None.
          * @return Casted pointer to head node.
          */
-        volatile waiting_thread_node*
-        head (void) const;
+        volatile waiting_thread_node*
+        head (void) const;
+
+        /**
+         * @brief Remove the top node from the list.
+         * @par Parameters
+         *  None.
+         * @return Pointer to thread.
+         */
+        thread*
+        unlink_head (void);
+
+        /**
+         * @brief Remove a node from the list.
+         * @param [in] node Reference to a list node.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        unlink (waiting_thread_node& node);
+
+        // TODO add iterator begin(), end()
+
+        /**
+         * @}
+         */
+      };
+
+#else
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Priority indexed lists of threads waiting to run.
+       */
+      class ready_threads_list
+      {
+      public:
+
+        /**
+         * @name Types and constants
+         * @{
+         */
+
+        /**
+         * @brief Number of priority levels, one FIFO for each.
+         * @details
+         * The full range of the 8-bits `thread::priority_t`.
+         */
+        static constexpr std::size_t levels = 256;
+
+        /**
+         * @}
+         */
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a list of waiting threads.
+         */
+        ready_threads_list ();
+
+        /**
+         * @cond ignore
+         */
+
+        ready_threads_list (const ready_threads_list&) = delete;
+        ready_threads_list (ready_threads_list&&) = delete;
+        ready_threads_list&
+        operator= (const ready_threads_list&) = delete;
+        ready_threads_list&
+        operator= (ready_threads_list&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the list.
+         */
+        ~ready_threads_list ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Check if the list is empty.
+         * @par Parameters
+         *  None.
+         * @retval true There are no ready threads.
+         * @retval false There is at least one ready thread.
+         */
+        bool
+        empty (void) const;
+
+        /**
+         * @brief Add a new thread node to the list.
+         * @param [in] node Reference to a list node.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        link (waiting_thread_node& node);
+
+        /**
+         * @brief Get list head.
+         * @par Parameters
+         *  None.
+         * @return Casted pointer to the oldest node with
+         *  the highest priority, or `nullptr` if the list is empty.
+         */
+        volatile waiting_thread_node*
+        head (void) const;
+
+        /**
+         * @brief Remove the top node from the list.
+         * @par Parameters
+         *  None.
+         * @return Pointer to thread.
+         */
+        thread*
+        unlink_head (void);
+
+        /**
+         * @brief Remove a node from the list.
+         * @param [in] node Reference to a list node.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        unlink (waiting_thread_node& node);
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        using map_t = uint32_t;
+
+        static constexpr std::size_t map_bits = 8 * sizeof(map_t);
+        static constexpr std::size_t map_words = levels / map_bits;
+
+        static_assert(map_words <= map_bits, "adjust map_t");
 
         /**
-         * @brief Remove the top node from the list.
-         * @par Parameters
-         *  None.
-         * @return Pointer to thread.
+         * @brief FIFO list of threads with the same priority.
          */
-        thread*
-        unlink_head (void);
+        class bucket : public utils::static_double_list
+        {
+        public:
 
-        // TODO add iterator begin(), end()
+          void
+          link (waiting_thread_node& node);
+        };
+
+        std::size_t
+        top_level_ (void) const;
+
+        void
+        mark_empty_ (std::size_t level);
+
+        // Bit `w` set if the word `w` in `map_[]` is not zero.
+        map_t summary_;
+
+        // Bit `l % map_bits` in word `l / map_bits` set if
+        // `buckets_[l]` is not empty.
+        map_t map_[map_words];
+
+        // Lazily initialised, only when the corresponding bit
+        // in the map is zero.
+        bucket buckets_[levels];
 
         /**
-         * @}
+         * @endcond
          */
       };
 
+#pragma GCC diagnostic pop
+
+#endif /* !defined(OS_USE_RTOS_READY_THREADS_BITMAP) */
+
       // ======================================================================
 
       /**
@@ -625,23 +1119,34 @@ namespace os
 
         /**
          * @brief Wake-up one thread (the oldest with the highest priority)
-         * @par Parameters
-         *  None.
+         * @param [in] object Pointer to the object owning the list.
+         * @param [in] reason Kind of the object.
          * @retval true The list may have further entries.
          * @retval false The list is empty.
          */
         bool
-        resume_one (void);
+        resume_one (const void* object, wait_reason_t reason);
 
         /**
          * @brief Wake-up all threads in the list.
-         * @par Parameters
-         *  None.
+         * @param [in] object Pointer to the object owning the list.
+         * @param [in] reason Kind of the object.
          * @par Returns
          *  Nothing.
          */
         void
-        resume_all (void);
+        resume_all (const void* object, wait_reason_t reason);
+
+        /**
+         * @brief Wake-up several threads, with a single reschedule.
+         * @param [in] object Pointer to the object owning the list.
+         * @param [in] reason Kind of the object.
+         * @param [in] count Maximum number of threads to wake-up.
+         * @return The number of threads removed from the list.
+         */
+        std::size_t
+        resume_n (const void* object, wait_reason_t reason,
+                  std::size_t count);
 
         /**
          * @brief Iterator begin.
@@ -664,6 +1169,8 @@ namespace os
 
       // ======================================================================
 
+#if !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL)
+
       /**
        * @brief Ordered list of time stamp nodes.
        */
@@ -730,6 +1237,138 @@ namespace os
         volatile timestamp_node*
         head (void) const;
 
+        /**
+         * @brief Get the earliest time stamp in the list.
+         * @par Parameters
+         *  None.
+         * @return The time stamp of the list head, or the
+         *  largest time stamp if the list is empty.
+         */
+        port::clock::timestamp_t
+        earliest_timestamp (void) const;
+
+        /**
+         * @brief Check list time stamps.
+         * @param [in] now The current clock time stamp.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        check_timestamp (port::clock::timestamp_t now);
+
+        /**
+         * @}
+         */
+      };
+
+#else
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+      /**
+       * @brief Hierarchical timing wheel of time stamp nodes.
+       */
+      class clock_timestamps_list
+      {
+      public:
+
+        /**
+         * @name Types and constants
+         * @{
+         */
+
+        /**
+         * @brief Number of bits used to index the slots of a level.
+         */
+        static constexpr std::size_t slot_bits = 5;
+
+        /**
+         * @brief Number of slots in each level.
+         */
+        static constexpr std::size_t slots = 1u << slot_bits;
+
+        /**
+         * @brief Number of levels.
+         */
+        static constexpr std::size_t levels = 4;
+
+        /**
+         * @brief Number of clock units covered by the wheel;
+         * farther time stamps are kept in an overflow list.
+         */
+        static constexpr port::clock::timestamp_t range = 1ull
+            << (slot_bits * levels);
+
+        /**
+         * @}
+         */
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a list of clock time stamps.
+         */
+        clock_timestamps_list ();
+
+        /**
+         * @cond ignore
+         */
+
+        clock_timestamps_list (const clock_timestamps_list&) = delete;
+        clock_timestamps_list (clock_timestamps_list&&) = delete;
+        clock_timestamps_list&
+        operator= (const clock_timestamps_list&) = delete;
+        clock_timestamps_list&
+        operator= (clock_timestamps_list&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the list.
+         */
+        ~clock_timestamps_list ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Add a new thread node to the list.
+         * @param [in] node Reference to a list node.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        link (timestamp_node& node);
+
+        /**
+         * @brief Get the earliest time stamp in the list.
+         * @par Parameters
+         *  None.
+         * @return A time stamp not later than the earliest
+         *  time stamp in the list, or the largest time stamp
+         *  if the list is empty.
+         */
+        port::clock::timestamp_t
+        earliest_timestamp (void);
+
         /**
          * @brief Check list time stamps.
          * @param [in] now The current clock time stamp.
@@ -742,8 +1381,86 @@ namespace os
         /**
          * @}
          */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        using map_t = uint32_t;
+
+        static_assert(slots <= 8 * sizeof(map_t), "adjust map_t");
+
+        /**
+         * @brief Unordered list of time stamp nodes.
+         */
+        class slot : public utils::double_list
+        {
+        public:
+
+          void
+          link (timestamp_node& node);
+
+          void
+          splice (slot& from);
+
+          void
+          take_due (port::clock::timestamp_t now, slot& to);
+        };
+
+        static std::size_t
+        index_ (port::clock::timestamp_t ts, std::size_t level);
+
+        void
+        insert_ (timestamp_node& node);
+
+        bool
+        wheel_empty_ (void);
+
+        void
+        take_ (std::size_t level, std::size_t ix, slot& to);
+
+        void
+        reinsert_ (slot& from);
+
+        void
+        move_now_ (port::clock::timestamp_t ts);
+
+        void
+        advance_ (port::clock::timestamp_t now, slot& expired);
+
+        void
+        take_overdue_ (port::clock::timestamp_t now, slot& expired);
+
+        void
+        rebuild_ (port::clock::timestamp_t ts);
+
+        slot slots_[levels][slots];
+
+        // Nodes beyond the current top level period.
+        slot overflow_;
+
+        // Bit `ix` set if `slots_[level][ix]` may be not empty;
+        // nodes can be unlinked directly, so a set bit is only a hint.
+        map_t maps_[levels];
+
+        // All time stamps before this one were processed.
+        port::clock::timestamp_t now_;
+
+        // A node with a past time stamp was added to the
+        // current level 0 slot.
+        bool overdue_;
+
+        /**
+         * @endcond
+         */
       };
 
+#pragma GCC diagnostic pop
+
+#endif /* !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL) */
+
       // ======================================================================
 
       /**
@@ -832,7 +1549,8 @@ namespace os
 
       void
       internal_link_node (internal::waiting_threads_list& list,
-                          internal::waiting_thread_node& node);
+                          internal::waiting_thread_node& node,
+                          const void* object, internal::wait_reason_t reason);
 
       void
       internal_unlink_node (internal::waiting_thread_node& node);
@@ -841,7 +1559,8 @@ namespace os
       internal_link_node (internal::waiting_threads_list& list,
                           internal::waiting_thread_node& node,
                           internal::clock_timestamps_list& timeout_list,
-                          internal::timeout_thread_node& timeout_node);
+                          internal::timeout_thread_node& timeout_node,
+                          const void* object, internal::wait_reason_t reason);
 
       void
       internal_unlink_node (internal::waiting_thread_node& node,
@@ -882,6 +1601,56 @@ namespace os
 
       // ======================================================================
 
+      inline
+      waiting_flags_node::waiting_flags_node (rtos::thread& th,
+                                              flags::mask_t mask,
+                                              flags::mode_t mode) :
+          waiting_thread_node
+            { th }, //
+          mask_ (mask), //
+          mode_ (mode)
+      {
+      }
+
+      inline
+      waiting_flags_node::~waiting_flags_node ()
+      {
+      }
+
+      // ======================================================================
+
+      inline
+      waiting_condvar_node::waiting_condvar_node (rtos::thread& th,
+                                                  rtos::mutex& mx) :
+          waiting_thread_node
+            { th }, //
+          mutex_ (&mx)
+      {
+      }
+
+      inline
+      waiting_condvar_node::~waiting_condvar_node ()
+      {
+      }
+
+      // ======================================================================
+
+      inline
+      waiting_count_node::waiting_count_node (rtos::thread& th,
+                                              uint32_t count) :
+          waiting_thread_node
+            { th }, //
+          count_ (count)
+      {
+      }
+
+      inline
+      waiting_count_node::~waiting_count_node ()
+      {
+      }
+
+      // ======================================================================
+
       /**
        * @details
        * The initial list status is empty.
@@ -905,6 +1674,8 @@ namespace os
       inline
       ready_threads_list::ready_threads_list ()
       {
+        // By all means, do not add any code here, the list
+        // must be usable before the static constructors run.
       }
 
       inline
@@ -912,12 +1683,59 @@ namespace os
       {
       }
 
+#if !defined(OS_USE_RTOS_READY_THREADS_BITMAP)
+
       inline volatile waiting_thread_node*
       ready_threads_list::head (void) const
       {
         return static_cast<volatile waiting_thread_node*> (static_double_list::head ());
       }
 
+      /**
+       * @details
+       * Must be called in a critical section.
+       */
+      inline void
+      ready_threads_list::unlink (waiting_thread_node& node)
+      {
+        node.unlink ();
+      }
+
+#else
+
+      inline bool
+      ready_threads_list::empty (void) const
+      {
+        return (summary_ == 0);
+      }
+
+      inline volatile waiting_thread_node*
+      ready_threads_list::head (void) const
+      {
+        if (empty ())
+          {
+            return nullptr;
+          }
+        return static_cast<volatile waiting_thread_node*> (buckets_[top_level_ ()].head ());
+      }
+
+      /**
+       * @details
+       * Use the count leading zeros instruction, where available,
+       * to identify the highest non empty bucket with two
+       * constant time lookups.
+       */
+      inline std::size_t
+      ready_threads_list::top_level_ (void) const
+      {
+        std::size_t word = map_bits - 1
+            - static_cast<std::size_t> (__builtin_clz (summary_));
+        return word * map_bits + map_bits - 1
+            - static_cast<std::size_t> (__builtin_clz (map_[word]));
+      }
+
+#endif /* !defined(OS_USE_RTOS_READY_THREADS_BITMAP) */
+
       // ======================================================================
 
       /**
@@ -964,6 +1782,8 @@ namespace os
 
       // ======================================================================
 
+#if !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL)
+
       inline
       clock_timestamps_list::clock_timestamps_list ()
       {
@@ -980,6 +1800,34 @@ namespace os
         return static_cast<volatile timestamp_node*> (double_list::head ());
       }
 
+      inline port::clock::timestamp_t
+      clock_timestamps_list::earliest_timestamp (void) const
+      {
+        if (empty ())
+          {
+            return std::numeric_limits<port::clock::timestamp_t>::max ();
+          }
+        return head ()->timestamp;
+      }
+
+#else
+
+      inline
+      clock_timestamps_list::clock_timestamps_list () :
+          maps_
+            { }, //
+          now_ (0), //
+          overdue_ (false)
+      {
+      }
+
+      inline
+      clock_timestamps_list::~clock_timestamps_list ()
+      {
+      }
+
+#endif /* !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL) */
+
       // ======================================================================
 
       /**
@@ -701,6 +701,14 @@ extern "C"
   size_t
   os_thread_stack_get_available (os_thread_stack_t* stack);
 
+  /**
+   * @brief Estimate the maximum stack usage.
+   * @param [in] stack Pointer to stack object instance.
+   * @return Number of bytes used at the deepest point.
+   */
+  size_t
+  os_thread_stack_get_high_water_mark (os_thread_stack_t* stack);
+
   /**
    * @brief Check if bottom magic word is still there.
    * @param [in] stack Pointer to stack object instance.
@@ -1652,6 +1660,229 @@ extern "C"
 #define os_condvar_create os_condvar_construct
 #define os_condvar_destroy os_condvar_destruct
 
+  /**
+   * @}
+   */
+
+  /**
+   * @}
+   */
+
+  // --------------------------------------------------------------------------
+  /**
+   * @addtogroup cmsis-plus-rtos-c-rwlock
+   * @{
+   */
+
+  /**
+   * @name Read-write Lock Attributes Functions
+   * @{
+   */
+
+  /**
+   * @brief Initialise the read-write lock attributes.
+   * @param [in] attr Pointer to read-write lock attributes object instance.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_rwlock_attr_init (os_rwlock_attr_t* attr);
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Read-write Lock Creation Functions
+   * @{
+   */
+
+  /**
+   * @brief Construct a statically allocated read-write lock
+   *  object instance.
+   * @param [in] rwlock Pointer to read-write lock object instance storage.
+   * @param [in] name Pointer to name (may be NULL).
+   * @param [in] attr Pointer to attributes (may be NULL).
+   * @par Errors
+   *  The constructor shall fail if:
+   *  - `EPERM` - Cannot be invoked from an Interrupt Service Routines.
+   * @par
+   *  The constructor shall not fail with an error code of `EINTR`.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_rwlock_construct (os_rwlock_t* rwlock, const char* name,
+                       const os_rwlock_attr_t* attr);
+
+  /**
+   * @brief Destruct the statically allocated read-write lock
+   *  object instance.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_rwlock_destruct (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Allocate a read-write lock object instance and construct it.
+   * @param [in] name Pointer to name (may be NULL).
+   * @param [in] attr Pointer to attributes (may be NULL).
+   * @par Errors
+   *  The constructor shall fail if:
+   *  - `EPERM` - Cannot be invoked from an Interrupt Service Routines.
+   * @par
+   *  The constructor shall not fail with an error code of `EINTR`.
+   * @return Pointer to new read-write lock object instance.
+   */
+  os_rwlock_t*
+  os_rwlock_new (const char* name, const os_rwlock_attr_t* attr);
+
+  /**
+   * @brief Destruct the read-write lock object instance and deallocate it.
+   * @param [in] rwlock Pointer to dynamically allocated read-write lock
+   *  object instance.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_rwlock_delete (os_rwlock_t* rwlock);
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Read-write Lock Functions
+   * @{
+   */
+
+  /**
+   * @brief Get the read-write lock name.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @return Null terminated string.
+   */
+  const char*
+  os_rwlock_get_name (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Lock the read-write lock for reading.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @retval os_ok The lock was acquired for reading.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EDEADLK The current thread holds the lock for writing.
+   * @retval EAGAIN The maximum number of readers was exceeded.
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_rwlock_read_lock (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Try to lock the read-write lock for reading.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @retval os_ok The lock was acquired for reading.
+   * @retval EWOULDBLOCK The lock is held by a writer, or
+   *  a writer with at least the same priority is waiting.
+   * @retval EDEADLK The current thread holds the lock for writing.
+   * @retval EAGAIN The maximum number of readers was exceeded.
+   */
+  os_result_t
+  os_rwlock_try_read_lock (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Timed attempt to lock the read-write lock for reading.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @param [in] timeout Timeout to wait.
+   * @retval os_ok The lock was acquired for reading.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ETIMEDOUT The lock could not be acquired before the
+   *  specified timeout expired.
+   * @retval EDEADLK The current thread holds the lock for writing.
+   * @retval EAGAIN The maximum number of readers was exceeded.
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_rwlock_timed_read_lock (os_rwlock_t* rwlock, os_clock_duration_t timeout);
+
+  /**
+   * @brief Lock the read-write lock for writing.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @retval os_ok The lock was acquired for writing.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EDEADLK The current thread already holds the lock
+   *  for writing.
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_rwlock_write_lock (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Try to lock the read-write lock for writing.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @retval os_ok The lock was acquired for writing.
+   * @retval EWOULDBLOCK The lock is held for reading or writing.
+   * @retval EDEADLK The current thread already holds the lock
+   *  for writing.
+   */
+  os_result_t
+  os_rwlock_try_write_lock (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Timed attempt to lock the read-write lock for writing.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @param [in] timeout Timeout to wait.
+   * @retval os_ok The lock was acquired for writing.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ETIMEDOUT The lock could not be acquired before the
+   *  specified timeout expired.
+   * @retval EDEADLK The current thread already holds the lock
+   *  for writing.
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_rwlock_timed_write_lock (os_rwlock_t* rwlock,
+                              os_clock_duration_t timeout);
+
+  /**
+   * @brief Unlock the read-write lock.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @retval os_ok The lock was released.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines,
+   *  or the lock is not held.
+   */
+  os_result_t
+  os_rwlock_unlock (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Get the number of readers holding the lock.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @return The number of readers.
+   */
+  os_rwlock_count_t
+  os_rwlock_get_readers (os_rwlock_t* rwlock);
+
+  /**
+   * @brief Get the thread holding the lock for writing.
+   * @param [in] rwlock Pointer to read-write lock object instance.
+   * @return Pointer to thread or `NULL` if not locked for writing.
+   */
+  os_thread_t*
+  os_rwlock_get_writer (os_rwlock_t* rwlock);
+
+  /**
+   * @}
+   */
+
+  // --------------------------------------------------------------------------
+  /**
+   * @name Compatibility Macros
+   * @{
+   */
+
+#define os_rwlock_create os_rwlock_construct
+#define os_rwlock_destroy os_rwlock_destruct
+
   /**
    * @}
    */
@@ -1880,6 +2111,72 @@ extern "C"
   os_semaphore_timed_wait (os_semaphore_t* semaphore,
                            os_clock_duration_t timeout);
 
+  /**
+   * @brief Post (unlock) the semaphore multiple times.
+   * @param [in] semaphore Pointer to semaphore object instance.
+   * @param [in] count The number of units to add.
+   * @retval os_ok The semaphore was posted.
+   * @retval EINVAL The count is not positive.
+   * @retval EAGAIN The maximum count value would be exceeded;
+   *  no units were added.
+   * @retval ENOTSUP Multiple units are not supported by the port.
+   */
+  os_result_t
+  os_semaphore_post_count (os_semaphore_t* semaphore,
+                           os_semaphore_count_t count);
+
+  /**
+   * @brief Lock the semaphore multiple times, possibly waiting.
+   * @param [in] semaphore Pointer to semaphore object instance.
+   * @param [in] count The number of units to acquire.
+   * @retval os_ok The calling process successfully
+   *  acquired all units.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The count is not positive or exceeds the
+   *  maximum value.
+   * @retval ENOTSUP Multiple units are not supported by the port.
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_semaphore_wait_count (os_semaphore_t* semaphore,
+                           os_semaphore_count_t count);
+
+  /**
+   * @brief Try to lock the semaphore multiple times.
+   * @param [in] semaphore Pointer to semaphore object instance.
+   * @param [in] count The number of units to acquire.
+   * @retval os_ok The calling process successfully
+   *  acquired all units.
+   * @retval EWOULDBLOCK Not enough units were available;
+   *  no units were acquired.
+   * @retval EINVAL The count is not positive or exceeds the
+   *  maximum value.
+   * @retval ENOTSUP Multiple units are not supported by the port.
+   */
+  os_result_t
+  os_semaphore_try_wait_count (os_semaphore_t* semaphore,
+                               os_semaphore_count_t count);
+
+  /**
+   * @brief Timed wait to lock the semaphore multiple times.
+   * @param [in] semaphore Pointer to semaphore object instance.
+   * @param [in] count The number of units to acquire.
+   * @param [in] timeout Timeout to wait.
+   * @retval os_ok The calling process successfully
+   *  acquired all units.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The count is not positive or exceeds the
+   *  maximum value.
+   * @retval ETIMEDOUT Not enough units were available before
+   *  the specified timeout expired.
+   * @retval ENOTSUP Multiple units are not supported by the port.
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_semaphore_timed_wait_count (os_semaphore_t* semaphore,
+                                 os_semaphore_count_t count,
+                                 os_clock_duration_t timeout);
+
   /**
    * @brief Get the semaphore count value.
    * @param [in] semaphore Pointer to semaphore object instance.
@@ -2365,6 +2662,280 @@ extern "C"
                            os_clock_duration_t timeout,
                            os_mqueue_prio_t* mprio);
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
+
+  /**
+   * @brief Reserve a free message slot.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] slot The address where to store the slot address.
+   * @retval os_ok A slot was reserved.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ENOTRECOVERABLE The slot could not be reserved
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_mqueue_reserve (os_mqueue_t* mqueue, void** slot);
+
+  /**
+   * @brief Try to reserve a free message slot.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] slot The address where to store the slot address.
+   * @retval os_ok A slot was reserved.
+   * @retval EWOULDBLOCK The specified message queue is full.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   */
+  os_result_t
+  os_mqueue_try_reserve (os_mqueue_t* mqueue, void** slot);
+
+  /**
+   * @brief Reserve a free message slot with timeout.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] slot The address where to store the slot address.
+   * @param [in] timeout The timeout duration.
+   * @retval os_ok A slot was reserved.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ETIMEDOUT The timeout expired before a slot
+   *  became available.
+   * @retval ENOTRECOVERABLE The slot could not be reserved
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_mqueue_timed_reserve (os_mqueue_t* mqueue, void** slot,
+                           os_clock_duration_t timeout);
+
+  /**
+   * @brief Enqueue a previously reserved message slot.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [in] slot The address of the reserved slot.
+   * @param [in] mprio The message priority. Enter 0 if priorities are not used.
+   * @retval os_ok The message was enqueued.
+   * @retval EINVAL The slot does not belong to this queue, or
+   *  is not reserved.
+   */
+  os_result_t
+  os_mqueue_commit (os_mqueue_t* mqueue, void* slot, os_mqueue_prio_t mprio);
+
+  /**
+   * @brief Borrow the message slot at the head of the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] slot The address where to store the slot address.
+   * @param [out] mprio The address where to store the message
+   *  priority. Enter `NULL` if priorities are not used.
+   * @retval os_ok The message was dequeued.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ENOTRECOVERABLE The message could not be dequeued
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_mqueue_borrow (os_mqueue_t* mqueue, void** slot, os_mqueue_prio_t* mprio);
+
+  /**
+   * @brief Try to borrow the message slot at the head of the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] slot The address where to store the slot address.
+   * @param [out] mprio The address where to store the message
+   *  priority. Enter `NULL` if priorities are not used.
+   * @retval os_ok The message was dequeued.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EWOULDBLOCK The specified message queue is empty.
+   */
+  os_result_t
+  os_mqueue_try_borrow (os_mqueue_t* mqueue, void** slot,
+                        os_mqueue_prio_t* mprio);
+
+  /**
+   * @brief Borrow the message slot at the head of the queue with timeout.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] slot The address where to store the slot address.
+   * @param [in] timeout The timeout duration.
+   * @param [out] mprio The address where to store the message
+   *  priority. Enter `NULL` if priorities are not used.
+   * @retval os_ok The message was dequeued.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ENOTRECOVERABLE The message could not be dequeued
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   * @retval ETIMEDOUT No message arrived on the queue before the
+   *  specified timeout expired.
+   */
+  os_result_t
+  os_mqueue_timed_borrow (os_mqueue_t* mqueue, void** slot,
+                          os_clock_duration_t timeout,
+                          os_mqueue_prio_t* mprio);
+
+  /**
+   * @brief Return a borrowed or reserved message slot to the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [in] slot The address of the slot.
+   * @retval os_ok The slot was released.
+   * @retval EINVAL The slot does not belong to this queue, or
+   *  is neither borrowed nor reserved.
+   */
+  os_result_t
+  os_mqueue_release (os_mqueue_t* mqueue, void* slot);
+
+  /**
+   * @brief Send a batch of messages to the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [in] msg_array The address of the array of messages to enqueue.
+   * @param [in] count The number of messages in the array.
+   * @param [in] nbytes The size of each message. Must be lower or
+   *  equal to the value used when creating the queue.
+   * @param [in] mprio The priority of the messages. Enter 0 if
+   *  priorities are not used.
+   * @param [out] sent The address where to store the number of
+   *  messages enqueued, or `NULL`.
+   * @retval os_ok At least one message was enqueued.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EMSGSIZE The specified message length, nbytes,
+   *  exceeds the message size attribute of the message queue.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ENOTRECOVERABLE The messages could not be enqueued
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_mqueue_send_n (os_mqueue_t* mqueue, const void* msg_array, size_t count,
+                    size_t nbytes, os_mqueue_prio_t mprio, size_t* sent);
+
+  /**
+   * @brief Try to send a batch of messages to the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [in] msg_array The address of the array of messages to enqueue.
+   * @param [in] count The number of messages in the array.
+   * @param [in] nbytes The size of each message. Must be lower or
+   *  equal to the value used when creating the queue.
+   * @param [in] mprio The priority of the messages. Enter 0 if
+   *  priorities are not used.
+   * @param [out] sent The address where to store the number of
+   *  messages enqueued, or `NULL`.
+   * @retval os_ok At least one message was enqueued.
+   * @retval EWOULDBLOCK The specified message queue is full.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EMSGSIZE The specified message length, nbytes,
+   *  exceeds the message size attribute of the message queue.
+   */
+  os_result_t
+  os_mqueue_try_send_n (os_mqueue_t* mqueue, const void* msg_array,
+                        size_t count, size_t nbytes, os_mqueue_prio_t mprio,
+                        size_t* sent);
+
+  /**
+   * @brief Send a batch of messages to the queue with timeout.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [in] msg_array The address of the array of messages to enqueue.
+   * @param [in] count The number of messages in the array.
+   * @param [in] nbytes The size of each message. Must be lower or
+   *  equal to the value used when creating the queue.
+   * @param [in] timeout The timeout duration.
+   * @param [in] mprio The priority of the messages. Enter 0 if
+   *  priorities are not used.
+   * @param [out] sent The address where to store the number of
+   *  messages enqueued, or `NULL`.
+   * @retval os_ok At least one message was enqueued.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EMSGSIZE The specified message length, nbytes,
+   *  exceeds the message size attribute of the message queue.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ETIMEDOUT The timeout expired before any message
+   *  could be added to the queue.
+   * @retval ENOTRECOVERABLE The messages could not be enqueued
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_mqueue_timed_send_n (os_mqueue_t* mqueue, const void* msg_array,
+                          size_t count, size_t nbytes,
+                          os_clock_duration_t timeout,
+                          os_mqueue_prio_t mprio, size_t* sent);
+
+  /**
+   * @brief Receive a batch of messages from the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] msg_array The address of the array where to store
+   *  the dequeued messages.
+   * @param [in] count The number of messages in the array.
+   * @param [in] nbytes The size of each array element. Must
+   *  be lower or equal to the value used when creating the queue.
+   * @param [out] received The address where to store the number of
+   *  messages dequeued, or `NULL`.
+   * @param [out] mprios The address of the array where to store
+   *  the message priorities. Enter `NULL` if priorities are not used.
+   * @retval os_ok At least one message was received.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EMSGSIZE The specified message length, nbytes, is
+   *  greater than the message size attribute of the message queue.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ENOTRECOVERABLE The messages could not be dequeued
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   */
+  os_result_t
+  os_mqueue_receive_n (os_mqueue_t* mqueue, void* msg_array, size_t count,
+                       size_t nbytes, size_t* received,
+                       os_mqueue_prio_t* mprios);
+
+  /**
+   * @brief Try to receive a batch of messages from the queue.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] msg_array The address of the array where to store
+   *  the dequeued messages.
+   * @param [in] count The number of messages in the array.
+   * @param [in] nbytes The size of each array element. Must
+   *  be lower or equal to the value used when creating the queue.
+   * @param [out] received The address where to store the number of
+   *  messages dequeued, or `NULL`.
+   * @param [out] mprios The address of the array where to store
+   *  the message priorities. Enter `NULL` if priorities are not used.
+   * @retval os_ok At least one message was received.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EMSGSIZE The specified message length, nbytes, is
+   *  greater than the message size attribute of the message queue.
+   * @retval EWOULDBLOCK The specified message queue is empty.
+   */
+  os_result_t
+  os_mqueue_try_receive_n (os_mqueue_t* mqueue, void* msg_array, size_t count,
+                           size_t nbytes, size_t* received,
+                           os_mqueue_prio_t* mprios);
+
+  /**
+   * @brief Receive a batch of messages from the queue with timeout.
+   * @param [in] mqueue Pointer to message queue object instance.
+   * @param [out] msg_array The address of the array where to store
+   *  the dequeued messages.
+   * @param [in] count The number of messages in the array.
+   * @param [in] nbytes The size of each array element. Must
+   *  be lower or equal to the value used when creating the queue.
+   * @param [in] timeout The timeout duration.
+   * @param [out] received The address where to store the number of
+   *  messages dequeued, or `NULL`.
+   * @param [out] mprios The address of the array where to store
+   *  the message priorities. Enter `NULL` if priorities are not used.
+   * @retval os_ok At least one message was received.
+   * @retval EINVAL A parameter is invalid or outside of a permitted range.
+   * @retval EMSGSIZE The specified message length, nbytes, is
+   *  greater than the message size attribute of the message queue.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval ENOTRECOVERABLE The messages could not be dequeued
+   *  (extension to POSIX).
+   * @retval EINTR The operation was interrupted.
+   * @retval ETIMEDOUT No message arrived on the queue before the
+   *  specified timeout expired.
+   */
+  os_result_t
+  os_mqueue_timed_receive_n (os_mqueue_t* mqueue, void* msg_array, size_t count,
+                             size_t nbytes, os_clock_duration_t timeout,
+                             size_t* received, os_mqueue_prio_t* mprios);
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
   /**
    * @brief Get queue capacity.
    * @param [in] mqueue Pointer to message queue object instance.
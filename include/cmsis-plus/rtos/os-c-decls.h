@@ -71,11 +71,44 @@ extern "C"
     void* thread;
   } os_internal_waiting_thread_node_t;
 
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
   typedef struct os_internal_clock_timestamps_list_s
   {
+#if !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL)
     os_internal_double_list_links_t links;
+#else
+    os_internal_double_list_links_t slots[4 * 32];
+    os_internal_double_list_links_t overflow;
+    uint32_t maps[4];
+    os_port_clock_timestamp_t now;
+    bool overdue;
+#endif
   } os_internal_clock_timestamps_list_t;
 
+#pragma GCC diagnostic pop
+
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+#if !defined(OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES)
+#define OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES            (5)
+#endif
+
+  typedef struct os_internal_allocation_cache_s
+  {
+    void* lists[OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES];
+    size_t counts[OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES];
+    size_t hits;
+    size_t misses;
+  } os_internal_allocation_cache_t;
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
   /**
    * @addtogroup cmsis-plus-rtos-c-core
    * @{
@@ -410,6 +443,7 @@ extern "C"
 
     void* stack_addr;
     size_t stack_size_bytes;
+    void* watermark;
 
     /**
      * @endcond
@@ -444,6 +478,11 @@ extern "C"
 
   } os_thread_context_t;
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) \
+  && !defined(OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS)
+#define OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS        (24)
+#endif
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
   || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
@@ -471,6 +510,17 @@ extern "C"
     os_statistics_duration_t cpu_cycles;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+    os_clock_timestamp_t resume_timestamp;
+    os_statistics_duration_t latency_max;
+    os_statistics_duration_t burst_cycles;
+    os_clock_timestamp_t window;
+    os_statistics_duration_t window_cycles;
+    os_statistics_duration_t load_cycles;
+    uint32_t latency_histogram[OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS];
+    uint32_t burst_histogram[OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS];
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
     /**
      * @endcond
      */
@@ -541,6 +591,15 @@ extern "C"
      */
     bool th_enable_assert_reuse;
 
+    /**
+     * @brief Fill the entire stack with the magic word.
+     *
+     * @details
+     * If false, only the guard words are set; the stack usage
+     * cannot be measured, but the thread starts faster.
+     */
+    bool th_stack_fill;
+
   } os_thread_attr_t;
 
   /**
@@ -578,6 +637,7 @@ extern "C"
     os_internal_double_list_links_t mutexes;
     void* joiner;
     void* waiting_node;
+    void* waiting_mutex;
     void* clock_node;
     void* clock;
     void* allocator;
@@ -598,6 +658,10 @@ extern "C"
     os_thread_statistics_t statistics;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+    os_internal_allocation_cache_t allocation_cache;
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
     os_thread_port_data_t port;
 #endif
@@ -952,6 +1016,11 @@ extern "C"
      */
     os_mutex_count_t mx_max_count;
 
+    /**
+     * @brief Mutex number of yields to a preempted owner.
+     */
+    uint8_t mx_adaptive_yields;
+
   } os_mutex_attr_t;
 
   /**
@@ -997,6 +1066,7 @@ extern "C"
     os_mutex_protocol_t protocol;
     os_mutex_robustness_t robustness;
     os_mutex_count_t max_count;
+    uint8_t adaptive_yields;
 
     /**
      * @endcond
@@ -1070,6 +1140,84 @@ extern "C"
 
   } os_condvar_t;
 
+  /**
+   * @}
+   */
+
+  // ==========================================================================
+  /**
+   * @addtogroup cmsis-plus-rtos-c-rwlock
+   * @{
+   */
+
+  /**
+   * @brief Type of variables holding read-write lock readers counts.
+   */
+  typedef uint16_t os_rwlock_count_t;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+  /**
+   * @brief Read-write lock attributes.
+   * @headerfile os-c-api.h <cmsis-plus/rtos/os-c-api.h>
+   *
+   * @details
+   * Initialise this structure with `os_rwlock_attr_init()` and then
+   * set any of the individual members directly.
+   *
+   * @see os::rtos::rwlock::attributes
+   */
+  typedef struct os_rwlock_attr_s
+  {
+    /**
+     * @brief Pointer to clock object instance.
+     */
+    void* clock;
+
+  } os_rwlock_attr_t;
+
+  /**
+   * @brief Read-write lock object storage.
+   * @headerfile os-c-api.h <cmsis-plus/rtos/os-c-api.h>
+   *
+   * @details
+   * This C structure has the same size as the C++ `os::rtos::rwlock`
+   * object and must be initialised with `os_rwlock_create()`.
+   *
+   * Later on a pointer to it can be used both in C and C++
+   * to refer to the read-write lock object instance.
+   *
+   * The members of this structure are hidden and should not
+   * be used directly, but only through specific functions.
+   *
+   * @see os::rtos::rwlock
+   */
+  typedef struct os_rwlock_s
+  {
+    /**
+     * @cond ignore
+     */
+
+    const char* name;
+    os_internal_threads_waiting_list_t readers_list;
+    os_internal_threads_waiting_list_t writers_list;
+    void* clock;
+    void* writer;
+    os_rwlock_count_t readers;
+
+    /**
+     * @endcond
+     */
+
+  } os_rwlock_t;
+
+#pragma GCC diagnostic pop
+
   /**
    * @}
    */
@@ -1150,12 +1298,18 @@ extern "C"
     os_internal_threads_waiting_list_t list;
     void* clock;
 #endif
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+    void* deferred_next;
+#endif
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
     os_semaphore_port_data_t port;
 #endif
     os_semaphore_count_t initial_count;
     os_semaphore_count_t count;
     os_semaphore_count_t max_count;
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+    os_semaphore_count_t pending_count;
+#endif
 
     /**
      * @endcond
@@ -1252,7 +1406,11 @@ extern "C"
     os_mempool_size_t blocks;
     os_mempool_size_t block_size_bytes;
     os_mempool_size_t count;
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+    uint32_t head;
+#else
     void* first;
+#endif
 
     /**
      * @endcond
@@ -1288,6 +1446,36 @@ extern "C"
    */
   typedef uint8_t os_mqueue_prio_t;
 
+  /**
+   * @brief Type of variables holding message queue ordering methods.
+   *
+   * @see os::rtos::message_queue::ordering_t
+   */
+  typedef uint8_t os_mqueue_ordering_t;
+
+  /**
+   * @brief An enumeration with message queue ordering methods.
+   *
+   * @see os::rtos::message_queue::ordering
+   */
+  enum
+  {
+    /**
+     * @brief Walk the list to find the place of the new message.
+     */
+    os_mqueue_ordering_linear = 0,
+
+    /**
+     * @brief Use a per-priority tail index and a priority bitmap.
+     */
+    os_mqueue_ordering_indexed = 1,
+
+    /**
+     * @brief Default message ordering method.
+     */
+    os_mqueue_ordering_default = os_mqueue_ordering_linear
+  };
+
 #pragma GCC diagnostic push
 #if defined(__clang__)
 #pragma clang diagnostic ignored "-Wpadded"
@@ -1322,6 +1510,11 @@ extern "C"
      */
     size_t mq_queue_size_bytes;
 
+    /**
+     * @brief Message ordering method.
+     */
+    os_mqueue_ordering_t mq_ordering;
+
   } os_mqueue_attr_t;
 
   /**
@@ -1355,6 +1548,8 @@ extern "C"
     os_mqueue_index_t* prev_array;
     os_mqueue_index_t* next_array;
     os_mqueue_prio_t* prio_array;
+    uint32_t* prio_map;
+    os_mqueue_index_t* prio_tails;
     void* first_free;
 #endif
 
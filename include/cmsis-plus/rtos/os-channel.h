@@ -0,0 +1,752 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_RTOS_OS_CHANNEL_H_
+#define CMSIS_PLUS_RTOS_OS_CHANNEL_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os-decls.h>
+#include <cmsis-plus/rtos/os-thread.h>
+#include <cmsis-plus/rtos/os-clocks.h>
+
+#include <cmsis-plus/diag/trace.h>
+
+#include <atomic>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief Template of a single producer/single consumer
+     * **channel** with message type and local storage.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-channel
+     *
+     * @details
+     * A lock-free ring of `N` messages, intended to be used as a
+     * point-to-point pipe between one producer (a thread or an
+     * interrupt handler) and one consumer thread.
+     *
+     * The fast path uses only atomic loads and stores of the ring
+     * indices, without interrupt masking. The threads block only
+     * when the ring is empty (consumer) or full (producer), and
+     * are resumed via their thread event flags, using the
+     * flags passed to the constructor.
+     */
+    template<typename T, std::size_t N>
+      class spsc_channel : public internal::object_named
+      {
+      public:
+
+        /**
+         * @brief Local type of message.
+         */
+        using value_type = T;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t msgs = N;
+
+        static_assert(N > 0, "The channel must have at least one message.");
+        static_assert(std::is_trivially_copyable<T>::value,
+            "The message type must be trivially copyable.");
+
+        /**
+         * @brief Default thread event flags used to wake up the threads.
+         */
+        static constexpr flags::mask_t default_flags = 0x80000000;
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a channel object instance.
+         * @param [in] wakeup_flags The thread event flags used to
+         *  wake up the blocked threads.
+         */
+        spsc_channel (flags::mask_t wakeup_flags = default_flags);
+
+        /**
+         * @brief Construct a named channel object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] wakeup_flags The thread event flags used to
+         *  wake up the blocked threads.
+         */
+        spsc_channel (const char* name, flags::mask_t wakeup_flags =
+                          default_flags);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        spsc_channel (const spsc_channel&) = delete;
+        spsc_channel (spsc_channel&&) = delete;
+        spsc_channel&
+        operator= (const spsc_channel&) = delete;
+        spsc_channel&
+        operator= (spsc_channel&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the channel object instance.
+         */
+        ~spsc_channel ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Push a message to the channel.
+         * @param [in] msg The message to enqueue.
+         * @retval result::ok The message was enqueued.
+         * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+         * @retval EINTR The operation was interrupted.
+         */
+        result_t
+        push (const value_type& msg);
+
+        /**
+         * @brief Try to push a message to the channel.
+         * @param [in] msg The message to enqueue.
+         * @retval result::ok The message was enqueued.
+         * @retval EWOULDBLOCK The channel is full.
+         */
+        result_t
+        try_push (const value_type& msg);
+
+        /**
+         * @brief Push a message to the channel with timeout.
+         * @param [in] msg The message to enqueue.
+         * @param [in] timeout The timeout duration.
+         * @retval result::ok The message was enqueued.
+         * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+         * @retval ETIMEDOUT The channel was full for the entire
+         *  timeout duration.
+         * @retval EINTR The operation was interrupted.
+         */
+        result_t
+        timed_push (const value_type& msg, clock::duration_t timeout);
+
+        /**
+         * @brief Pop a message from the channel.
+         * @param [out] msg The address where to store the message.
+         * @retval result::ok The message was dequeued.
+         * @retval EINVAL A parameter is invalid or outside of a permitted range.
+         * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+         * @retval EINTR The operation was interrupted.
+         */
+        result_t
+        pop (value_type* msg);
+
+        /**
+         * @brief Try to pop a message from the channel.
+         * @param [out] msg The address where to store the message.
+         * @retval result::ok The message was dequeued.
+         * @retval EINVAL A parameter is invalid or outside of a permitted range.
+         * @retval EWOULDBLOCK The channel is empty.
+         */
+        result_t
+        try_pop (value_type* msg);
+
+        /**
+         * @brief Pop a message from the channel with timeout.
+         * @param [out] msg The address where to store the message.
+         * @param [in] timeout The timeout duration.
+         * @retval result::ok The message was dequeued.
+         * @retval EINVAL A parameter is invalid or outside of a permitted range.
+         * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+         * @retval ETIMEDOUT The channel was empty for the entire
+         *  timeout duration.
+         * @retval EINTR The operation was interrupted.
+         */
+        result_t
+        timed_pop (value_type* msg, clock::duration_t timeout);
+
+        /**
+         * @brief Get channel capacity.
+         * @par Parameters
+         *  None.
+         * @return The max number of messages that can be queued.
+         */
+        std::size_t
+        capacity (void) const;
+
+        /**
+         * @brief Get channel length.
+         * @par Parameters
+         *  None.
+         * @return The number of messages in the channel.
+         */
+        std::size_t
+        length (void) const;
+
+        /**
+         * @brief Check if the channel is empty.
+         * @par Parameters
+         *  None.
+         * @retval true The channel has no messages.
+         * @retval false The channel has some messages.
+         */
+        bool
+        empty (void) const;
+
+        /**
+         * @brief Check if the channel is full.
+         * @par Parameters
+         *  None.
+         * @retval true The channel is full.
+         * @retval false The channel is not full.
+         */
+        bool
+        full (void) const;
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @name Private Member Functions
+         * @{
+         */
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief Compute the index following the given one.
+         * @param [in] ix The ring index.
+         * @return The next ring index.
+         */
+        static constexpr std::size_t
+        next_ (std::size_t ix);
+
+        /**
+         * @brief Wait until the condition is true or the timeout expires.
+         * @param [in] waiter The waiting thread pointer to set.
+         * @param [in] timeout_timestamp Pointer to the time point when
+         *  the wait expires, or `nullptr` to wait forever.
+         * @param [in] ready Function returning true when the wait is over.
+         * @retval result::ok The thread was resumed.
+         * @retval ETIMEDOUT The timeout expired.
+         * @retval EINTR The operation was interrupted.
+         */
+        template<typename F>
+          result_t
+          internal_wait_ (std::atomic<thread*>& waiter,
+                          const clock::timestamp_t* timeout_timestamp,
+                          F ready);
+
+        /**
+         * @brief Wake up the waiting thread, if any.
+         * @param [in] waiter The waiting thread pointer.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        internal_wakeup_ (std::atomic<thread*>& waiter);
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @name Private Member Variables
+         * @{
+         */
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief Local storage for the ring.
+         * @details
+         * One slot is always kept empty, to distinguish a full
+         * ring from an empty one.
+         */
+        value_type buffer_[N + 1];
+
+        /**
+         * @brief Index of the next message to pop; written by the consumer.
+         */
+        std::atomic<std::size_t> head_
+          { 0 };
+
+        /**
+         * @brief Index of the next message to push; written by the producer.
+         */
+        std::atomic<std::size_t> tail_
+          { 0 };
+
+        /**
+         * @brief The consumer thread, while blocked on an empty ring.
+         */
+        std::atomic<thread*> consumer_
+          { nullptr };
+
+        /**
+         * @brief The producer thread, while blocked on a full ring.
+         */
+        std::atomic<thread*> producer_
+          { nullptr };
+
+        /**
+         * @brief The thread event flags used to wake up the threads.
+         */
+        flags::mask_t flags_;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @}
+         */
+
+      };
+
+#pragma GCC diagnostic pop
+
+  } /* namespace rtos */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace rtos
+  {
+
+    /**
+     * @details
+     * The blocked threads are resumed by raising _wakeup_flags_
+     * in their thread event flags; these flags should not be used
+     * for other purposes by the producer and consumer threads.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      inline
+      spsc_channel<T, N>::spsc_channel (flags::mask_t wakeup_flags) :
+          spsc_channel
+            { nullptr, wakeup_flags }
+      {
+      }
+
+    /**
+     * @details
+     * The blocked threads are resumed by raising _wakeup_flags_
+     * in their thread event flags; these flags should not be used
+     * for other purposes by the producer and consumer threads.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      spsc_channel<T, N>::spsc_channel (const char* name,
+                                        flags::mask_t wakeup_flags) :
+          object_named
+            { name }, //
+          flags_ (wakeup_flags)
+      {
+#if defined(OS_TRACE_RTOS_CHANNEL)
+        internal::trace_printf ("%s() @%p %s %u\n", __func__, this,
+                                this->name (), N);
+#endif
+        assert(wakeup_flags != 0);
+      }
+
+    /**
+     * @details
+     * It shall be safe to destroy a channel object upon which
+     * no threads are currently blocked.
+     */
+    template<typename T, std::size_t N>
+      spsc_channel<T, N>::~spsc_channel ()
+      {
+#if defined(OS_TRACE_RTOS_CHANNEL)
+        internal::trace_printf ("%s() @%p %s\n", __func__, this,
+                                this->name ());
+#endif
+
+        // There must be no threads waiting for this channel.
+        assert(consumer_.load (std::memory_order_relaxed) == nullptr);
+        assert(producer_.load (std::memory_order_relaxed) == nullptr);
+      }
+
+    template<typename T, std::size_t N>
+      constexpr std::size_t
+      spsc_channel<T, N>::next_ (std::size_t ix)
+      {
+        return (ix == N) ? 0 : ix + 1;
+      }
+
+    /**
+     * @details
+     * Must be called only by the producer. If the channel is full,
+     * the producer thread blocks until the consumer makes room
+     * for the message.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      result_t
+      spsc_channel<T, N>::push (const value_type& msg)
+      {
+        // Don't call this from interrupt handlers.
+        os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+        for (;;)
+          {
+            if (try_push (msg) == result::ok)
+              {
+                return result::ok;
+              }
+
+            result_t res = internal_wait_ (producer_, nullptr, [this]
+              { return !full ();});
+            if (res != result::ok)
+              {
+                return res;
+              }
+          }
+      }
+
+    /**
+     * @details
+     * Must be called only by the producer. The operation is wait-free;
+     * if the channel is full it fails immediately.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      result_t
+      spsc_channel<T, N>::try_push (const value_type& msg)
+      {
+        std::size_t tail = tail_.load (std::memory_order_relaxed);
+        std::size_t next = next_ (tail);
+        if (next == head_.load (std::memory_order_acquire))
+          {
+            return EWOULDBLOCK;
+          }
+
+        buffer_[tail] = msg;
+        tail_.store (next, std::memory_order_release);
+
+        internal_wakeup_ (consumer_);
+        return result::ok;
+      }
+
+    /**
+     * @details
+     * Must be called only by the producer. If the channel is full,
+     * the producer thread blocks until the consumer makes room
+     * for the message, or the timeout expires.
+     *
+     * The timeout is measured with the `sysclock`, like the thread
+     * event flags timeouts.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      result_t
+      spsc_channel<T, N>::timed_push (const value_type& msg,
+                                      clock::duration_t timeout)
+      {
+        // Don't call this from interrupt handlers.
+        os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+        clock::timestamp_t timeout_timestamp = sysclock.steady_now ()
+            + timeout;
+
+        for (;;)
+          {
+            if (try_push (msg) == result::ok)
+              {
+                return result::ok;
+              }
+
+            result_t res = internal_wait_ (producer_, &timeout_timestamp,
+                                           [this]
+                                             { return !full ();});
+            if (res != result::ok)
+              {
+                return res;
+              }
+          }
+      }
+
+    /**
+     * @details
+     * Must be called only by the consumer. If the channel is empty,
+     * the consumer thread blocks until a message is pushed.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      result_t
+      spsc_channel<T, N>::pop (value_type* msg)
+      {
+        // Don't call this from interrupt handlers.
+        os_assert_err(!interrupts::in_handler_mode (), EPERM);
+        os_assert_err(msg != nullptr, EINVAL);
+
+        for (;;)
+          {
+            if (try_pop (msg) == result::ok)
+              {
+                return result::ok;
+              }
+
+            result_t res = internal_wait_ (consumer_, nullptr, [this]
+              { return !empty ();});
+            if (res != result::ok)
+              {
+                return res;
+              }
+          }
+      }
+
+    /**
+     * @details
+     * Must be called only by the consumer. The operation is wait-free;
+     * if the channel is empty it fails immediately.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      result_t
+      spsc_channel<T, N>::try_pop (value_type* msg)
+      {
+        os_assert_err(msg != nullptr, EINVAL);
+
+        std::size_t head = head_.load (std::memory_order_relaxed);
+        if (head == tail_.load (std::memory_order_acquire))
+          {
+            return EWOULDBLOCK;
+          }
+
+        *msg = buffer_[head];
+        head_.store (next_ (head), std::memory_order_release);
+
+        internal_wakeup_ (producer_);
+        return result::ok;
+      }
+
+    /**
+     * @details
+     * Must be called only by the consumer. If the channel is empty,
+     * the consumer thread blocks until a message is pushed, or
+     * the timeout expires.
+     *
+     * The timeout is measured with the `sysclock`, like the thread
+     * event flags timeouts.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      result_t
+      spsc_channel<T, N>::timed_pop (value_type* msg,
+                                     clock::duration_t timeout)
+      {
+        // Don't call this from interrupt handlers.
+        os_assert_err(!interrupts::in_handler_mode (), EPERM);
+        os_assert_err(msg != nullptr, EINVAL);
+
+        clock::timestamp_t timeout_timestamp = sysclock.steady_now ()
+            + timeout;
+
+        for (;;)
+          {
+            if (try_pop (msg) == result::ok)
+              {
+                return result::ok;
+              }
+
+            result_t res = internal_wait_ (consumer_, &timeout_timestamp,
+                                           [this]
+                                             { return !empty ();});
+            if (res != result::ok)
+              {
+                return res;
+              }
+          }
+      }
+
+    template<typename T, std::size_t N>
+      inline std::size_t
+      spsc_channel<T, N>::capacity (void) const
+      {
+        return N;
+      }
+
+    /**
+     * @details
+     * When called concurrently with `push()` or `pop()`,
+     * the result is only a snapshot.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    template<typename T, std::size_t N>
+      std::size_t
+      spsc_channel<T, N>::length (void) const
+      {
+        std::size_t head = head_.load (std::memory_order_acquire);
+        std::size_t tail = tail_.load (std::memory_order_acquire);
+        return (tail >= head) ? (tail - head) : (tail + N + 1 - head);
+      }
+
+    template<typename T, std::size_t N>
+      inline bool
+      spsc_channel<T, N>::empty (void) const
+      {
+        return head_.load (std::memory_order_acquire)
+            == tail_.load (std::memory_order_acquire);
+      }
+
+    template<typename T, std::size_t N>
+      inline bool
+      spsc_channel<T, N>::full (void) const
+      {
+        return next_ (tail_.load (std::memory_order_acquire))
+            == head_.load (std::memory_order_acquire);
+      }
+
+    /**
+     * @details
+     * The thread first publishes itself as waiting, then checks the
+     * ring again, so a concurrent push/pop either sees the waiting
+     * thread and raises its flags, or is seen by the check.
+     * Spurious wake-ups are possible and are handled by the callers.
+     */
+    template<typename T, std::size_t N>
+      template<typename F>
+        result_t
+        spsc_channel<T, N>::internal_wait_ (
+            std::atomic<thread*>& waiter,
+            const clock::timestamp_t* timeout_timestamp, F ready)
+        {
+          waiter.store (&this_thread::thread (), std::memory_order_relaxed);
+          std::atomic_thread_fence (std::memory_order_seq_cst);
+
+          result_t res = result::ok;
+          if (!ready ())
+            {
+              if (timeout_timestamp == nullptr)
+                {
+                  res = this_thread::flags_wait (
+                      flags_, nullptr, flags::mode::any | flags::mode::clear);
+                }
+              else
+                {
+                  clock::timestamp_t now = sysclock.steady_now ();
+                  if (now >= *timeout_timestamp)
+                    {
+                      res = ETIMEDOUT;
+                    }
+                  else
+                    {
+                      res = this_thread::flags_timed_wait (
+                          flags_,
+                          static_cast<clock::duration_t> (*timeout_timestamp
+                              - now),
+                          nullptr, flags::mode::any | flags::mode::clear);
+                    }
+                }
+            }
+
+          waiter.store (nullptr, std::memory_order_relaxed);
+          return res;
+        }
+
+    /**
+     * @details
+     * The fence pairs with the one in `internal_wait_()`.
+     */
+    template<typename T, std::size_t N>
+      void
+      spsc_channel<T, N>::internal_wakeup_ (std::atomic<thread*>& waiter)
+      {
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+
+        thread* th = waiter.load (std::memory_order_relaxed);
+        if (th != nullptr)
+          {
+            th->flags_raise (flags_);
+          }
+      }
+
+  } /* namespace rtos */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_RTOS_OS_CHANNEL_H_ */
@@ -252,6 +252,9 @@ namespace os
       void
       internal_increment_count (void);
 
+      void
+      internal_add_count (duration_t duration);
+
       void
       internal_check_timestamps (void);
 
@@ -531,6 +534,21 @@ namespace os
         static constexpr clock::duration_t
         ticks_cast (Rep_T microsec);
 
+#if defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS)
+
+      /**
+       * @cond ignore
+       */
+
+      bool
+      internal_tickless_sleep (void);
+
+      /**
+       * @endcond
+       */
+
+#endif /* defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS) */
+
       /**
        * @}
        */
@@ -837,6 +855,22 @@ namespace os
 #pragma GCC diagnostic pop
     }
 
+    inline void
+    __attribute__((always_inline))
+    clock::internal_add_count (duration_t duration)
+    {
+      // Several tick counts passed; the timestamps are not checked.
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wdeprecated-volatile"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wvolatile"
+#endif
+      steady_count_ += duration;
+#pragma GCC diagnostic pop
+    }
+
     inline void
     __attribute__((always_inline))
     clock::internal_check_timestamps (void)
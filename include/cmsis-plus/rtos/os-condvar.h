@@ -270,6 +270,34 @@ namespace os
 
     protected:
 
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+#if !defined(OS_USE_RTOS_PORT_MUTEX)
+
+      /**
+       * @brief Internal function used to notify the waiting threads.
+       * @param all Notify all threads, not only the first one.
+       */
+      void
+      internal_notify_ (bool all);
+
+#endif
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
       /**
        * @name Private Member Variables
        * @{
@@ -341,6 +341,66 @@ namespace os
     namespace internal
     {
 
+      /**
+       * @brief Type of variables holding the reasons threads wait.
+       */
+      using wait_reason_t = uint8_t;
+
+      /**
+       * @brief Reasons threads wait.
+       * @details
+       * Passed along with the address of the object when threads
+       * are suspended or resumed, and recorded in the scheduler
+       * trace events.
+       */
+      struct wait_reason
+      {
+        /**
+         * @brief Kinds of objects threads wait for.
+         */
+        enum
+          : wait_reason_t
+            {
+              /**
+               * @brief Explicit `suspend()` or `resume()`.
+               */
+              none = 0,
+              semaphore = 1,
+              mutex = 2,
+              condition_variable = 3,
+              event_flags = 4,
+              memory_pool = 5,
+              message_queue = 6,
+              rwlock = 7,
+              thread_join = 8,
+              thread_flags = 9,
+              /**
+               * @brief Clock `sleep_for()` and `sleep_until()`.
+               */
+              sleep = 10,
+              /**
+               * @brief Timeout expired, no object.
+               */
+              timeout = 11,
+              /**
+               * @brief Thread interrupted, no object.
+               */
+              interrupt = 12
+        };
+      };
+
+      /**
+       * @brief Write a message from the `OS_TRACE_RTOS_*` call sites.
+       * @param [in] format A null terminated string with the format.
+       * @return The number of characters written, or 0 when recorded.
+       * @details
+       * If `OS_USE_TRACE_EVENTS` is defined, the message is recorded
+       * unformatted as a binary trace event; otherwise it is passed
+       * to `trace::printf()`.
+       */
+      int
+      trace_printf (const char* format, ...);
+
       // ======================================================================
 
       /**
@@ -1155,10 +1215,45 @@ extern "C"
 #define OS_BOOL_RTOS_SCHEDULER_PREEMPTIVE                   (true)
 #endif
 
+#if !defined(OS_BOOL_RTOS_THREAD_STACK_FILL)
+#define OS_BOOL_RTOS_THREAD_STACK_FILL                      (true)
+#endif
+
+#if !defined(OS_INTEGER_RTOS_MUTEX_INHERITANCE_MAX_DEPTH)
+#define OS_INTEGER_RTOS_MUTEX_INHERITANCE_MAX_DEPTH         (8)
+#endif
+
 #if !defined(OS_INTEGER_RTOS_REUSE_MAGIC)
 #define OS_INTEGER_RTOS_REUSE_MAGIC                         (0xA55AAA55)
 #endif
 
+#if !defined(OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES)
+#define OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES            (5)
+#endif
+
+#if !defined(OS_INTEGER_RTOS_ALLOCATION_CACHE_DEPTH)
+#define OS_INTEGER_RTOS_ALLOCATION_CACHE_DEPTH              (8)
+#endif
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) \
+  && !defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+#error "OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY requires OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES."
+#endif
+
+#if (defined(OS_TRACE_EVENTS_SWITCH) || defined(OS_TRACE_EVENTS_RESUME) \
+    || defined(OS_TRACE_EVENTS_BLOCK) || defined(OS_TRACE_EVENTS_TIMEOUT) \
+    || defined(OS_TRACE_EVENTS_ISR)) && !defined(OS_USE_TRACE_EVENTS)
+#error "The scheduler trace events require OS_USE_TRACE_EVENTS."
+#endif
+
+#if !defined(OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS)
+#define OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS        (24)
+#endif
+
+#if !defined(OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS)
+#define OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS        (1000)
+#endif
+
 // ----------------------------------------------------------------------------
 
 #endif /* CMSIS_PLUS_RTOS_OS_DECLS_H_ */
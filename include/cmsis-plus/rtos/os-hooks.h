@@ -13,6 +13,7 @@
 #ifndef CMSIS_PLUS_RTOS_OS_HOOKS_H_
 #define CMSIS_PLUS_RTOS_OS_HOOKS_H_
 
+#include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
 
@@ -146,6 +147,15 @@ extern "C"
   bool
   os_rtos_idle_enter_power_saving_mode_hook (void);
 
+  /**
+   * @brief Hook to sleep without system ticks.
+   * @param [in] ticks Number of ticks until the next clock deadline.
+   * @return The number of ticks slept, not counting the tick
+   *  that ended the sleep.
+   */
+  uint32_t
+  os_rtos_idle_tickless_sleep_hook (uint32_t ticks);
+
   /**
    * @brief Hook to handle out of memory in the application free store.
    * @par Parameters
@@ -90,6 +90,10 @@ namespace os
 
       class memory_resource;
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+      class allocation_cache;
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
       // ----------------------------------------------------------------------
 
       /**
@@ -363,6 +367,28 @@ namespace os
         std::size_t
         deallocations (void);
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+        /**
+         * @brief Get the number of allocations served by the thread caches.
+         * @par Parameters
+         *  None.
+         * @return Number of allocations.
+         */
+        std::size_t
+        cache_hits (void);
+
+        /**
+         * @brief Get the number of thread cache refills.
+         * @par Parameters
+         *  None.
+         * @return Number of allocations.
+         */
+        std::size_t
+        cache_misses (void);
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
         /**
          * @brief Print a long message with usage statistics.
          * @par Parameters
@@ -482,6 +508,13 @@ namespace os
         std::size_t allocations_ = 0;
         std::size_t deallocations_ = 0;
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+        friend class allocation_cache;
+
+        std::size_t cache_hits_ = 0;
+        std::size_t cache_misses_ = 0;
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
         /**
          * @endcond
          */
@@ -489,6 +522,199 @@ namespace os
       };
 #pragma GCC diagnostic pop
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+      /**
+       * @brief Per thread cache of small blocks.
+       * @headerfile os.h <cmsis-plus/rtos/os.h>
+       *
+       * @details
+       * Each thread has a separate cache with
+       * `OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES` size classes;
+       * each class keeps a singly linked list of at most
+       * `OS_INTEGER_RTOS_ALLOCATION_CACHE_DEPTH` free blocks.
+       *
+       * Since the cache is accessed only by the thread owning it,
+       * most small allocations and deallocations complete without
+       * locking the scheduler. When a list is empty it is refilled,
+       * and when it is full half of it is drained, in batches,
+       * from/to the application memory resource
+       * (`estd::pmr::get_default_resource()`), inside a scheduler
+       * critical section.
+       *
+       * Each block is preceded by a header, which stores the class,
+       * required to identify the block size when it is freed.
+       * Larger blocks are allocated directly from the memory resource,
+       * but also have a header, which stores their size.
+       *
+       * Blocks kept in the caches are accounted as allocated by the
+       * memory resource; they are returned when the thread is destroyed.
+       */
+      class allocation_cache
+      {
+      public:
+
+        /**
+         * @brief Number of size classes.
+         */
+        static constexpr std::size_t classes =
+        OS_INTEGER_RTOS_ALLOCATION_CACHE_CLASSES;
+
+        /**
+         * @brief Maximum number of free blocks kept in a class.
+         */
+        static constexpr std::size_t depth =
+        OS_INTEGER_RTOS_ALLOCATION_CACHE_DEPTH;
+
+        /**
+         * @brief Number of blocks moved to/from the memory resource
+         *  in a single critical section.
+         */
+        static constexpr std::size_t batch = (depth + 1) / 2;
+
+        /**
+         * @brief Size of the header preceding each block.
+         */
+        static constexpr std::size_t header_bytes =
+            memory_resource::max_align;
+
+        /**
+         * @brief Size of the smallest class. Each class
+         *  doubles the size of the previous one.
+         */
+        static constexpr std::size_t min_class_bytes =
+            memory_resource::max_align;
+
+        static_assert(classes > 0, "At least one class is required");
+        static_assert(depth > 0, "The cache depth must be positive");
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct an empty cache.
+         * @par Parameters
+         *  None.
+         */
+        allocation_cache () = default;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        allocation_cache (const allocation_cache&) = delete;
+        allocation_cache (allocation_cache&&) = delete;
+        allocation_cache&
+        operator= (const allocation_cache&) = delete;
+        allocation_cache&
+        operator= (allocation_cache&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the cache.
+         */
+        ~allocation_cache () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Allocate a block, via the current thread cache.
+         * @param bytes Number of bytes to allocate.
+         * @return Pointer to newly allocated block, or `nullptr`.
+         */
+        static void*
+        allocate (std::size_t bytes);
+
+        /**
+         * @brief Deallocate a block, via the current thread cache.
+         * @param addr Address of a block returned by `allocate()`.
+         * @par Returns
+         *  Nothing.
+         */
+        static void
+        deallocate (void* addr) noexcept;
+
+        /**
+         * @brief Get the usable size of a block.
+         * @param addr Address of a block returned by `allocate()`.
+         * @return Number of bytes, or 0 for `nullptr`.
+         */
+        static std::size_t
+        usable_size (void* addr) noexcept;
+
+        /**
+         * @brief Return all cached blocks to the memory resource.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        flush (void) noexcept;
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        struct free_block
+        {
+          free_block* next;
+        };
+
+        static std::size_t
+        class_index_ (std::size_t bytes) noexcept;
+
+        static allocation_cache*
+        current_ (void) noexcept;
+
+        void*
+        refill_ (memory_resource* mr, std::size_t index);
+
+        void
+        drain_ (memory_resource* mr, std::size_t index,
+                std::size_t count) noexcept;
+
+        void
+        report_ (memory_resource* mr) noexcept;
+
+        free_block* lists_[classes] =
+          { };
+        std::size_t counts_[classes] =
+          { };
+
+        // Counters not yet reported to the memory resource.
+        std::size_t hits_ = 0;
+        std::size_t misses_ = 0;
+
+        /**
+         * @endcond
+         */
+
+      };
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
       /**
        * @name Operators
        * @{
@@ -1439,6 +1665,22 @@ namespace os
         return deallocations_;
       }
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+      inline std::size_t
+      memory_resource::cache_hits (void)
+      {
+        return cache_hits_;
+      }
+
+      inline std::size_t
+      memory_resource::cache_misses (void)
+      {
+        return cache_misses_;
+      }
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
       inline void
       memory_resource::trace_print_statistics (void)
       {
@@ -1453,6 +1695,10 @@ namespace os
                        allocated_chunks (), free_bytes (), free_chunks (),
                        max_allocated_bytes (), allocations (),
                        deallocations ());
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+        trace::printf ("\tthread caches: %u hits, %u misses\n", cache_hits (),
+                       cache_misses ());
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
 #endif /* defined(TRACE) */
       }
 
@@ -28,6 +28,10 @@
 
 #include <cmsis-plus/diag/trace.h>
 
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+#include <atomic>
+#endif
+
 // ----------------------------------------------------------------------------
 
 #pragma GCC diagnostic push
@@ -446,6 +450,26 @@ namespace os
       void*
       internal_try_first_ (void);
 
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+
+      /**
+       * @brief Internal function used to link a block back to
+       *  the free list.
+       * @param [in] block Pointer to block.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_push_ (void* block);
+
+      // The free list head packs a 1-based block index (0 for
+      // an empty list) in the low half and a generation tag, incremented
+      // by each update, in the high half, to detect the ABA cases.
+      static constexpr uint32_t link_mask = 0xFFFF;
+      static constexpr uint32_t tag_increment = 0x10000;
+
+#endif
+
       /**
        * @endcond
        */
@@ -516,6 +540,22 @@ namespace os
        */
       memory_pool::size_t block_size_bytes_ = 0;
 
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+
+      /**
+       * @brief The current number of blocks allocated from the pool.
+       */
+      std::atomic<memory_pool::size_t> count_
+        { 0 };
+
+      /**
+       * @brief The tagged index of the first free block.
+       */
+      std::atomic<uint32_t> head_
+        { 0 };
+
+#else
+
       /**
        * @brief The current number of blocks allocated from the pool.
        */
@@ -526,6 +566,8 @@ namespace os
        */
       void* volatile first_ = nullptr;
 
+#endif
+
       /**
        * @endcond
        */
@@ -939,7 +981,11 @@ namespace os
     inline std::size_t
     memory_pool::count (void) const
     {
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+      return count_.load (std::memory_order_relaxed);
+#else
       return count_;
+#endif
     }
 
     /**
@@ -1039,8 +1085,8 @@ namespace os
             { name }
       {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-        trace::printf ("%s() @%p %s %d %d\n", __func__, this, this->name (),
-                       blocks, block_size_bytes);
+        internal::trace_printf ("%s() @%p %s %d %d\n", __func__, this,
+                                this->name (), blocks, block_size_bytes);
 #endif
         if (attr.mp_pool_address != nullptr)
           {
@@ -1092,7 +1138,7 @@ namespace os
       memory_pool_allocated<Allocator>::~memory_pool_allocated ()
       {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-        trace::printf ("%s() @%p %s\n", __func__, this, name ());
+        internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
         typedef typename std::allocator_traits<allocator_type>::pointer pointer;
 
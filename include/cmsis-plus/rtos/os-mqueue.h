@@ -141,6 +141,65 @@ namespace os
        */
       static constexpr priority_t max_priority = 0xFF;
 
+      /**
+       * @brief Type of variables holding message ordering methods.
+       * @ingroup cmsis-plus-rtos-mqueue
+       */
+      using ordering_t = uint8_t;
+
+      /**
+       * @brief Message ordering methods.
+       * @headerfile os.h <cmsis-plus/rtos/os.h>
+       * @details
+       * Both methods deliver the messages in decreasing priority
+       * order and, for messages with the same priority, in the order
+       * they were sent (FIFO).
+       * @ingroup cmsis-plus-rtos-mqueue
+       */
+      struct ordering
+      {
+        /**
+         * @brief Enumeration of message ordering methods.
+         */
+        enum
+          : ordering_t
+            {
+              /**
+               * @brief Walk the list from the tail to find the place
+               * of the new message; no additional storage.
+               */
+              linear = 0,
+
+              /**
+               * @brief Use a per-priority tail index and a priority
+               * bitmap; constant time insertion and removal.
+               */
+              indexed = 1,
+
+              /**
+               * @brief Default value.
+               */
+              default_ = linear,
+
+              /**
+               * @brief Maximum value, for validation purposes.
+               */
+              max_ = indexed
+        };
+      };
+
+      /**
+       * @brief Size of the priority index used by `ordering::indexed`.
+       * @details
+       * A two levels bitmap of the priorities present in the queue
+       * (one 32-bits summary word plus one bit per priority),
+       * followed by the index of the last message of each priority.
+       * @ingroup cmsis-plus-rtos-mqueue
+       */
+      static constexpr std::size_t ordering_index_size_bytes = (1
+          + (max_priority + 1) / 32) * sizeof(uint32_t)
+          + (max_priority + 1) * sizeof(index_t);
+
       // ======================================================================
 
       /**
@@ -201,6 +260,16 @@ namespace os
          */
         std::size_t mq_queue_size_bytes = 0;
 
+        /**
+         * @brief Method used to keep the messages ordered by priority.
+         * @details
+         * With `ordering::indexed` the queue storage must also include
+         * `ordering_index_size_bytes`, as computed by
+         * `compute_allocated_size_bytes()`; the storage of
+         * `message_queue_inclusive` is sized for `ordering::linear` only.
+         */
+        ordering_t mq_ordering = ordering::default_;
+
         // Add more attributes here.
 
         /**
@@ -228,27 +297,35 @@ namespace os
        * Each message is stored in an element
        * extended to a multiple of pointers. The lists are kept in two arrays
        * of indices and the priorities are kept in a separate array.
+       * With `ordering::indexed`, the priority index follows the
+       * priorities.
        */
-      template<typename T, std::size_t msgs, std::size_t msg_size_bytes>
+      template<typename T, std::size_t msgs, std::size_t msg_size_bytes,
+          ordering_t order = ordering::default_>
         class arena
         {
         public:
           T queue[(msgs * msg_size_bytes + sizeof(T) - 1) / sizeof(T)];
           T links[((2 * msgs) * sizeof(index_t) + sizeof(T) - 1) / sizeof(T)];
-          T prios[(msgs * sizeof(priority_t) + sizeof(T) - 1) / sizeof(T)];
+          T prios[(msgs * sizeof(priority_t) + sizeof(T) - 1) / sizeof(T)
+              + ((order == ordering::indexed) ?
+                  ((ordering_index_size_bytes + sizeof(T) - 1) / sizeof(T)) :
+                  0)];
         };
 
       /**
        * @brief Calculator for queue storage requirements.
        * @param msgs Number of messages.
        * @param msg_size_bytes Size of message.
+       * @param order Message ordering method.
        * @return Total required storage in bytes, including
        * internal alignment.
        */
       template<typename T>
         constexpr std::size_t
         compute_allocated_size_bytes (std::size_t msgs,
-                                      std::size_t msg_size_bytes)
+                                      std::size_t msg_size_bytes,
+                                      ordering_t order = ordering::default_)
         {
           // Align each message
           return (msgs * ((msg_size_bytes + (sizeof(T) - 1)) & ~(sizeof(T) - 1)))
@@ -257,7 +334,12 @@ namespace os
                   & ~(sizeof(T) - 1))
               // Align the priority array
               + ((msgs * sizeof(priority_t) + (sizeof(T) - 1))
-                  & ~(sizeof(T) - 1));
+                  & ~(sizeof(T) - 1))
+              // Align the priority index, if any
+              + ((order == ordering::indexed) ?
+                  ((ordering_index_size_bytes + (sizeof(T) - 1))
+                      & ~(sizeof(T) - 1)) :
+                  0);
         }
 
       // ======================================================================
@@ -485,6 +567,267 @@ namespace os
       timed_receive (void* msg, std::size_t nbytes, clock::duration_t timeout,
                      priority_t* mprio = nullptr);
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) || defined(__DOXYGEN__)
+
+      /**
+       * @brief Reserve a free message slot.
+       * @param [out] slot The address where to store the slot address.
+       * @retval result::ok A slot was reserved.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The slot could not be reserved
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      reserve (void** slot);
+
+      /**
+       * @brief Try to reserve a free message slot.
+       * @param [out] slot The address where to store the slot address.
+       * @retval result::ok A slot was reserved.
+       * @retval EWOULDBLOCK The specified message queue is full.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       */
+      result_t
+      try_reserve (void** slot);
+
+      /**
+       * @brief Reserve a free message slot with timeout.
+       * @param [out] slot The address where to store the slot address.
+       * @param [in] timeout The timeout duration.
+       * @retval result::ok A slot was reserved.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The timeout expired before a slot
+       *  became available.
+       * @retval ENOTRECOVERABLE The slot could not be reserved
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_reserve (void** slot, clock::duration_t timeout);
+
+      /**
+       * @brief Enqueue a previously reserved message slot.
+       * @param [in] slot The address of the reserved slot.
+       * @param [in] mprio The message priority. The default is 0.
+       * @retval result::ok The message was enqueued.
+       * @retval EINVAL The slot does not belong to this queue, or
+       *  is not reserved.
+       */
+      result_t
+      commit (void* slot, priority_t mprio = default_priority);
+
+      /**
+       * @brief Borrow the message slot at the head of the queue.
+       * @param [out] slot The address where to store the slot address.
+       * @param [out] mprio The address where to store the message
+       *  priority. The default is `nullptr`.
+       * @retval result::ok The message was dequeued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The message could not be dequeued
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      borrow (void** slot, priority_t* mprio = nullptr);
+
+      /**
+       * @brief Try to borrow the message slot at the head of the queue.
+       * @param [out] slot The address where to store the slot address.
+       * @param [out] mprio The address where to store the message
+       *  priority. The default is `nullptr`.
+       * @retval result::ok The message was dequeued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EWOULDBLOCK The specified message queue is empty.
+       */
+      result_t
+      try_borrow (void** slot, priority_t* mprio = nullptr);
+
+      /**
+       * @brief Borrow the message slot at the head of the queue
+       *  with timeout.
+       * @param [out] slot The address where to store the slot address.
+       * @param [in] timeout The timeout duration.
+       * @param [out] mprio The address where to store the message
+       *  priority. The default is `nullptr`.
+       * @retval result::ok The message was dequeued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The message could not be dequeued
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       * @retval ETIMEDOUT No message arrived on the queue before the
+       *  specified timeout expired.
+       */
+      result_t
+      timed_borrow (void** slot, clock::duration_t timeout,
+                    priority_t* mprio = nullptr);
+
+      /**
+       * @brief Return a borrowed or reserved message slot to the queue.
+       * @param [in] slot The address of the slot.
+       * @retval result::ok The slot was released.
+       * @retval EINVAL The slot does not belong to this queue, or
+       *  is neither borrowed nor reserved.
+       */
+      result_t
+      release (void* slot);
+
+      /**
+       * @brief Send a batch of messages to the queue.
+       * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each message. Must be lower or
+       *  equal to the value used when creating the queue.
+       * @param [in] mprio The priority of the messages. The default is 0.
+       * @param [out] sent The address where to store the number of
+       *  messages enqueued. The default is `nullptr`.
+       * @retval result::ok At least one message was enqueued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The specified message length, nbytes,
+       *  exceeds the message size attribute of the message queue.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The messages could not be enqueued
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      send_n (const void* msg_array, std::size_t count, std::size_t nbytes,
+              priority_t mprio =
+                  default_priority,
+              std::size_t* sent = nullptr);
+
+      /**
+       * @brief Try to send a batch of messages to the queue.
+       * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each message. Must be lower or
+       *  equal to the value used when creating the queue.
+       * @param [in] mprio The priority of the messages. The default is 0.
+       * @param [out] sent The address where to store the number of
+       *  messages enqueued. The default is `nullptr`.
+       * @retval result::ok At least one message was enqueued.
+       * @retval EWOULDBLOCK The specified message queue is full.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The specified message length, nbytes,
+       *  exceeds the message size attribute of the message queue.
+       */
+      result_t
+      try_send_n (const void* msg_array, std::size_t count, std::size_t nbytes,
+                  priority_t mprio = default_priority, std::size_t* sent =
+                      nullptr);
+
+      /**
+       * @brief Send a batch of messages to the queue with timeout.
+       * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each message. Must be lower or
+       *  equal to the value used when creating the queue.
+       * @param [in] timeout The timeout duration.
+       * @param [in] mprio The priority of the messages. The default is 0.
+       * @param [out] sent The address where to store the number of
+       *  messages enqueued. The default is `nullptr`.
+       * @retval result::ok At least one message was enqueued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The specified message length, nbytes,
+       *  exceeds the message size attribute of the message queue.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The timeout expired before any message
+       *  could be added to the queue.
+       * @retval ENOTRECOVERABLE The messages could not be enqueued
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_send_n (const void* msg_array, std::size_t count,
+                    std::size_t nbytes,
+                    clock::duration_t timeout, priority_t mprio =
+                        default_priority,
+                    std::size_t* sent = nullptr);
+
+      /**
+       * @brief Receive a batch of messages from the queue.
+       * @param [out] msg_array The address of the array where to store
+       *  the dequeued messages.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each array element. Must
+       *  be lower or equal to the value used when creating the queue.
+       * @param [out] received The address where to store the number of
+       *  messages dequeued. The default is `nullptr`.
+       * @param [out] mprios The address of the array where to store
+       *  the message priorities. The default is `nullptr`.
+       * @retval result::ok At least one message was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The specified message length, nbytes, is
+       *  greater than the message size attribute of the message queue.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The messages could not be dequeued
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      receive_n (void* msg_array, std::size_t count, std::size_t nbytes,
+                 std::size_t* received = nullptr, priority_t* mprios = nullptr);
+
+      /**
+       * @brief Try to receive a batch of messages from the queue.
+       * @param [out] msg_array The address of the array where to store
+       *  the dequeued messages.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each array element. Must
+       *  be lower or equal to the value used when creating the queue.
+       * @param [out] received The address where to store the number of
+       *  messages dequeued. The default is `nullptr`.
+       * @param [out] mprios The address of the array where to store
+       *  the message priorities. The default is `nullptr`.
+       * @retval result::ok At least one message was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The specified message length, nbytes, is
+       *  greater than the message size attribute of the message queue.
+       * @retval EWOULDBLOCK The specified message queue is empty.
+       */
+      result_t
+      try_receive_n (void* msg_array, std::size_t count, std::size_t nbytes,
+                     std::size_t* received = nullptr, priority_t* mprios =
+                         nullptr);
+
+      /**
+       * @brief Receive a batch of messages from the queue with timeout.
+       * @param [out] msg_array The address of the array where to store
+       *  the dequeued messages.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each array element. Must
+       *  be lower or equal to the value used when creating the queue.
+       * @param [in] timeout The timeout duration.
+       * @param [out] received The address where to store the number of
+       *  messages dequeued. The default is `nullptr`.
+       * @param [out] mprios The address of the array where to store
+       *  the message priorities. The default is `nullptr`.
+       * @retval result::ok At least one message was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The specified message length, nbytes, is
+       *  greater than the message size attribute of the message queue.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The messages could not be dequeued
+       *  (extension to POSIX).
+       * @retval EINTR The operation was interrupted.
+       * @retval ETIMEDOUT No message arrived on the queue before the
+       *  specified timeout expired.
+       */
+      result_t
+      timed_receive_n (void* msg_array, std::size_t count, std::size_t nbytes,
+                       clock::duration_t timeout, std::size_t* received =
+                           nullptr,
+                       priority_t* mprios = nullptr);
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
       // TODO: check if some kind of peek() is useful.
 
       /**
@@ -612,6 +955,122 @@ namespace os
       bool
       internal_try_receive_ (void* msg, std::size_t nbytes, priority_t* mprio);
 
+      /**
+       * @brief Internal function used to get a free slot, if available.
+       * @par Parameters
+       *  None.
+       * @return The address of the slot, or `nullptr` if the
+       *  queue is full.
+       */
+      void*
+      internal_try_reserve_ (void);
+
+      /**
+       * @brief Internal function used to link a slot to the queue.
+       * @param [in] slot The address of the slot.
+       * @param [in] mprio The message priority.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_commit_ (void* slot, priority_t mprio);
+
+      /**
+       * @brief Internal function used to link a slot to the queue,
+       *  without waking up the receivers.
+       * @param [in] slot The address of the slot.
+       * @param [in] mprio The message priority.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_enlist_ (void* slot, priority_t mprio);
+
+      /**
+       * @brief Internal function used to unlink the head slot, if any.
+       * @param [out] mprio The address where to store the message
+       *  priority.
+       * @return The address of the slot, or `nullptr` if the
+       *  queue is empty.
+       */
+      void*
+      internal_try_borrow_ (priority_t* mprio);
+
+      /**
+       * @brief Internal function used to return a slot to the free list.
+       * @param [in] slot The address of the slot.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_release_ (void* slot);
+
+      /**
+       * @brief Internal function used to return a slot to the free list,
+       *  without waking up the senders.
+       * @param [in] slot The address of the slot.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_free_ (void* slot);
+
+      /**
+       * @brief Internal function used to send a batch of messages.
+       * @param [in] msg_array The address of the array of messages.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each message.
+       * @param [in] mprio The priority of the messages.
+       * @return The number of messages enqueued.
+       */
+      std::size_t
+      internal_try_send_n_ (const void* msg_array, std::size_t count,
+                            std::size_t nbytes, priority_t mprio);
+
+      /**
+       * @brief Internal function used to receive a batch of messages.
+       * @param [out] msg_array The address of the array of messages.
+       * @param [in] count The number of messages in the array.
+       * @param [in] nbytes The size of each message.
+       * @param [out] mprios The address of the array of priorities,
+       *  or `nullptr`.
+       * @return The number of messages dequeued.
+       */
+      std::size_t
+      internal_try_receive_n_ (void* msg_array, std::size_t count,
+                               std::size_t nbytes, priority_t* mprios);
+
+      /**
+       * @brief Internal function used to compute the index of a slot.
+       * @param [in] slot The address of the slot.
+       * @return The index of the slot in the queue storage.
+       */
+      std::size_t
+      internal_index_ (const void* slot) const;
+
+      /**
+       * @brief Internal function used to validate a slot address
+       *  and its state.
+       * @param [in] slot The address of the slot.
+       * @param [in] state The expected state, one of `slot_reserved`
+       *  or `slot_borrowed`.
+       * @retval true The slot belongs to the queue storage and
+       *  is in the given state.
+       * @retval false The address is not a slot of this queue, or
+       *  the slot is in another state.
+       */
+      bool
+      internal_is_slot_ (const void* slot, index_t state) const;
+
+      /**
+       * @brief Internal function used to find the lowest priority
+       *  present in the queue that is higher than the given one.
+       * @param [in] mprio The message priority.
+       * @return The priority, or `max_priority + 1` if there is none.
+       */
+      std::size_t
+      internal_higher_priority_ (priority_t mprio) const;
+
 #endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
 
       /**
@@ -648,6 +1107,12 @@ namespace os
        */
       clock* clock_ = nullptr;
 
+      // The slots not linked in the queue have `no_index` in
+      // `prev_array_` and their state in `next_array_`.
+      static constexpr index_t slot_free = 0;
+      static constexpr index_t slot_reserved = 1;
+      static constexpr index_t slot_borrowed = 2;
+
       // To save space, the double linked list is built
       // using short indexes, not pointers.
       /**
@@ -662,6 +1127,19 @@ namespace os
        * @brief Pointer to array of priorities.
        */
       volatile priority_t* prio_array_ = nullptr;
+      /**
+       * @brief Pointer to the bitmap of priorities present in the
+       * queue, or `nullptr` for `ordering::linear`.
+       * @details
+       * The first word has one bit for each non-zero word that follows,
+       * the next words have one bit for each priority.
+       */
+      volatile uint32_t* prio_map_ = nullptr;
+      /**
+       * @brief Pointer to array with the indices of the last message
+       * of each priority (valid only if the priority bit is set).
+       */
+      volatile index_t* prio_tails_ = nullptr;
 
       /**
        * @brief Pointer to the first free message, or `nullptr`.
@@ -1027,54 +1505,218 @@ namespace os
         timed_receive (value_type* msg, clock::duration_t timeout,
                        message_queue::priority_t* mprio = nullptr);
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) || defined(__DOXYGEN__)
+
         /**
-         * @}
+         * @brief Reserve a free typed message slot.
+         * @param [out] slot The address where to store the slot address.
+         * @return The same results as `message_queue::reserve()`.
          */
-
-      };
-#pragma GCC diagnostic pop
-
-    // ========================================================================
-
-    /**
-     * @brief Template of a POSIX compliant **message queue** with
-     * message type and local storage.
-     * @headerfile os.h <cmsis-plus/rtos/os.h>
-     * @ingroup cmsis-plus-rtos-mqueue
-     */
-    template<typename T, std::size_t N>
-      class message_queue_inclusive : public message_queue
-      {
-      public:
+        result_t
+        reserve (value_type** slot);
 
         /**
-         * @brief Local type of message.
+         * @brief Try to reserve a free typed message slot.
+         * @param [out] slot The address where to store the slot address.
+         * @return The same results as `message_queue::try_reserve()`.
          */
-        using value_type = T;
+        result_t
+        try_reserve (value_type** slot);
 
         /**
-         * @brief Local constant based on template definition.
+         * @brief Reserve a free typed message slot with timeout.
+         * @param [out] slot The address where to store the slot address.
+         * @param [in] timeout The timeout duration.
+         * @return The same results as `message_queue::timed_reserve()`.
          */
-        static const std::size_t msgs = N;
+        result_t
+        timed_reserve (value_type** slot, clock::duration_t timeout);
 
         /**
-         * @name Constructors & Destructor
-         * @{
+         * @brief Borrow the typed message slot at the head of the queue.
+         * @param [out] slot The address where to store the slot address.
+         * @param [out] mprio The address where to store the message
+         *  priority. The default is `nullptr`.
+         * @return The same results as `message_queue::borrow()`.
          */
+        result_t
+        borrow (value_type** slot, message_queue::priority_t* mprio = nullptr);
 
         /**
-         * @brief Construct a typed message queue object instance.
-         * @param [in] attr Reference to attributes.
+         * @brief Try to borrow the typed message slot at the head
+         *  of the queue.
+         * @param [out] slot The address where to store the slot address.
+         * @param [out] mprio The address where to store the message
+         *  priority. The default is `nullptr`.
+         * @return The same results as `message_queue::try_borrow()`.
          */
-        message_queue_inclusive (const attributes& attr = initializer);
+        result_t
+        try_borrow (value_type** slot, message_queue::priority_t* mprio = nullptr);
 
         /**
-         * @brief Construct a named typed message queue object instance.
-         * @param [in] name Pointer to name.
-         * @param [in] attr Reference to attributes.
+         * @brief Borrow the typed message slot at the head of the queue
+         *  with timeout.
+         * @param [out] slot The address where to store the slot address.
+         * @param [in] timeout The timeout duration.
+         * @param [out] mprio The address where to store the message
+         *  priority. The default is `nullptr`.
+         * @return The same results as `message_queue::timed_borrow()`.
          */
-        message_queue_inclusive (const char* name, const attributes& attr =
-                                     initializer);
+        result_t
+        timed_borrow (value_type** slot, clock::duration_t timeout,
+                      message_queue::priority_t* mprio = nullptr);
+
+        /**
+         * @brief Send a batch of typed messages to the queue.
+         * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+         * @param [in] count The number of messages in the array.
+         * @param [in] mprio The priority of the messages. The default is 0.
+         * @param [out] sent The address where to store the number of
+         *  messages enqueued. The default is `nullptr`.
+         * @return The same results as `message_queue::send_n()`.
+         */
+        result_t
+        send_n (const value_type* msg_array, std::size_t count,
+                message_queue::priority_t mprio =
+                    message_queue::default_priority,
+                std::size_t* sent = nullptr);
+
+        /**
+         * @brief Try to send a batch of typed messages to the queue.
+         * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+         * @param [in] count The number of messages in the array.
+         * @param [in] mprio The priority of the messages. The default is 0.
+         * @param [out] sent The address where to store the number of
+         *  messages enqueued. The default is `nullptr`.
+         * @return The same results as `message_queue::try_send_n()`.
+         */
+        result_t
+        try_send_n (const value_type* msg_array, std::size_t count,
+                    message_queue::priority_t mprio =
+                        message_queue::default_priority,
+                    std::size_t* sent = nullptr);
+
+        /**
+         * @brief Send a batch of typed messages to the queue with timeout.
+         * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+         * @param [in] count The number of messages in the array.
+         * @param [in] timeout The timeout duration.
+         * @param [in] mprio The priority of the messages. The default is 0.
+         * @param [out] sent The address where to store the number of
+         *  messages enqueued. The default is `nullptr`.
+         * @return The same results as `message_queue::timed_send_n()`.
+         */
+        result_t
+        timed_send_n (const value_type* msg_array, std::size_t count,
+                      clock::duration_t timeout,
+                      message_queue::priority_t mprio =
+                          message_queue::default_priority,
+                      std::size_t* sent = nullptr);
+
+        /**
+         * @brief Receive a batch of typed messages from the queue.
+         * @param [out] msg_array The address of the array where to store
+         *  the dequeued messages.
+         * @param [in] count The number of messages in the array.
+         * @param [out] received The address where to store the number of
+         *  messages dequeued. The default is `nullptr`.
+         * @param [out] mprios The address of the array where to store
+         *  the message priorities. The default is `nullptr`.
+         * @return The same results as `message_queue::receive_n()`.
+         */
+        result_t
+        receive_n (value_type* msg_array, std::size_t count,
+                   std::size_t* received = nullptr,
+                   message_queue::priority_t* mprios = nullptr);
+
+        /**
+         * @brief Try to receive a batch of typed messages from the queue.
+         * @param [out] msg_array The address of the array where to store
+         *  the dequeued messages.
+         * @param [in] count The number of messages in the array.
+         * @param [out] received The address where to store the number of
+         *  messages dequeued. The default is `nullptr`.
+         * @param [out] mprios The address of the array where to store
+         *  the message priorities. The default is `nullptr`.
+         * @return The same results as `message_queue::try_receive_n()`.
+         */
+        result_t
+        try_receive_n (value_type* msg_array, std::size_t count,
+                       std::size_t* received = nullptr,
+                       message_queue::priority_t* mprios = nullptr);
+
+        /**
+         * @brief Receive a batch of typed messages from the queue
+         *  with timeout.
+         * @param [out] msg_array The address of the array where to store
+         *  the dequeued messages.
+         * @param [in] count The number of messages in the array.
+         * @param [in] timeout The timeout duration.
+         * @param [out] received The address where to store the number of
+         *  messages dequeued. The default is `nullptr`.
+         * @param [out] mprios The address of the array where to store
+         *  the message priorities. The default is `nullptr`.
+         * @return The same results as `message_queue::timed_receive_n()`.
+         */
+        result_t
+        timed_receive_n (value_type* msg_array, std::size_t count,
+                         clock::duration_t timeout,
+                         std::size_t* received = nullptr,
+                         message_queue::priority_t* mprios = nullptr);
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
+        /**
+         * @}
+         */
+
+      };
+#pragma GCC diagnostic pop
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a POSIX compliant **message queue** with
+     * message type and local storage.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-mqueue
+     */
+    template<typename T, std::size_t N>
+      class message_queue_inclusive : public message_queue
+      {
+      public:
+
+        /**
+         * @brief Local type of message.
+         */
+        using value_type = T;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t msgs = N;
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a typed message queue object instance.
+         * @param [in] attr Reference to attributes.
+         */
+        message_queue_inclusive (const attributes& attr = initializer);
+
+        /**
+         * @brief Construct a named typed message queue object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] attr Reference to attributes.
+         */
+        message_queue_inclusive (const char* name, const attributes& attr =
+                                     initializer);
 
         /**
          * @cond ignore
@@ -1222,6 +1864,170 @@ namespace os
         timed_receive (value_type* msg, clock::duration_t timeout,
                        priority_t* mprio = nullptr);
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) || defined(__DOXYGEN__)
+
+        /**
+         * @brief Reserve a free typed message slot.
+         * @param [out] slot The address where to store the slot address.
+         * @return The same results as `message_queue::reserve()`.
+         */
+        result_t
+        reserve (value_type** slot);
+
+        /**
+         * @brief Try to reserve a free typed message slot.
+         * @param [out] slot The address where to store the slot address.
+         * @return The same results as `message_queue::try_reserve()`.
+         */
+        result_t
+        try_reserve (value_type** slot);
+
+        /**
+         * @brief Reserve a free typed message slot with timeout.
+         * @param [out] slot The address where to store the slot address.
+         * @param [in] timeout The timeout duration.
+         * @return The same results as `message_queue::timed_reserve()`.
+         */
+        result_t
+        timed_reserve (value_type** slot, clock::duration_t timeout);
+
+        /**
+         * @brief Borrow the typed message slot at the head of the queue.
+         * @param [out] slot The address where to store the slot address.
+         * @param [out] mprio The address where to store the message
+         *  priority. The default is `nullptr`.
+         * @return The same results as `message_queue::borrow()`.
+         */
+        result_t
+        borrow (value_type** slot, priority_t* mprio = nullptr);
+
+        /**
+         * @brief Try to borrow the typed message slot at the head
+         *  of the queue.
+         * @param [out] slot The address where to store the slot address.
+         * @param [out] mprio The address where to store the message
+         *  priority. The default is `nullptr`.
+         * @return The same results as `message_queue::try_borrow()`.
+         */
+        result_t
+        try_borrow (value_type** slot, priority_t* mprio = nullptr);
+
+        /**
+         * @brief Borrow the typed message slot at the head of the queue
+         *  with timeout.
+         * @param [out] slot The address where to store the slot address.
+         * @param [in] timeout The timeout duration.
+         * @param [out] mprio The address where to store the message
+         *  priority. The default is `nullptr`.
+         * @return The same results as `message_queue::timed_borrow()`.
+         */
+        result_t
+        timed_borrow (value_type** slot, clock::duration_t timeout,
+                      priority_t* mprio = nullptr);
+
+        /**
+         * @brief Send a batch of typed messages to the queue.
+         * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+         * @param [in] count The number of messages in the array.
+         * @param [in] mprio The priority of the messages. The default is 0.
+         * @param [out] sent The address where to store the number of
+         *  messages enqueued. The default is `nullptr`.
+         * @return The same results as `message_queue::send_n()`.
+         */
+        result_t
+        send_n (const value_type* msg_array, std::size_t count,
+                priority_t mprio =
+                    default_priority,
+                std::size_t* sent = nullptr);
+
+        /**
+         * @brief Try to send a batch of typed messages to the queue.
+         * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+         * @param [in] count The number of messages in the array.
+         * @param [in] mprio The priority of the messages. The default is 0.
+         * @param [out] sent The address where to store the number of
+         *  messages enqueued. The default is `nullptr`.
+         * @return The same results as `message_queue::try_send_n()`.
+         */
+        result_t
+        try_send_n (const value_type* msg_array, std::size_t count,
+                    priority_t mprio =
+                        default_priority,
+                    std::size_t* sent = nullptr);
+
+        /**
+         * @brief Send a batch of typed messages to the queue with timeout.
+         * @param [in] msg_array The address of the array of messages
+         *  to enqueue.
+         * @param [in] count The number of messages in the array.
+         * @param [in] timeout The timeout duration.
+         * @param [in] mprio The priority of the messages. The default is 0.
+         * @param [out] sent The address where to store the number of
+         *  messages enqueued. The default is `nullptr`.
+         * @return The same results as `message_queue::timed_send_n()`.
+         */
+        result_t
+        timed_send_n (const value_type* msg_array, std::size_t count,
+                      clock::duration_t timeout,
+                      priority_t mprio =
+                          default_priority,
+                      std::size_t* sent = nullptr);
+
+        /**
+         * @brief Receive a batch of typed messages from the queue.
+         * @param [out] msg_array The address of the array where to store
+         *  the dequeued messages.
+         * @param [in] count The number of messages in the array.
+         * @param [out] received The address where to store the number of
+         *  messages dequeued. The default is `nullptr`.
+         * @param [out] mprios The address of the array where to store
+         *  the message priorities. The default is `nullptr`.
+         * @return The same results as `message_queue::receive_n()`.
+         */
+        result_t
+        receive_n (value_type* msg_array, std::size_t count,
+                   std::size_t* received = nullptr,
+                   priority_t* mprios = nullptr);
+
+        /**
+         * @brief Try to receive a batch of typed messages from the queue.
+         * @param [out] msg_array The address of the array where to store
+         *  the dequeued messages.
+         * @param [in] count The number of messages in the array.
+         * @param [out] received The address where to store the number of
+         *  messages dequeued. The default is `nullptr`.
+         * @param [out] mprios The address of the array where to store
+         *  the message priorities. The default is `nullptr`.
+         * @return The same results as `message_queue::try_receive_n()`.
+         */
+        result_t
+        try_receive_n (value_type* msg_array, std::size_t count,
+                       std::size_t* received = nullptr,
+                       priority_t* mprios = nullptr);
+
+        /**
+         * @brief Receive a batch of typed messages from the queue
+         *  with timeout.
+         * @param [out] msg_array The address of the array where to store
+         *  the dequeued messages.
+         * @param [in] count The number of messages in the array.
+         * @param [in] timeout The timeout duration.
+         * @param [out] received The address where to store the number of
+         *  messages dequeued. The default is `nullptr`.
+         * @param [out] mprios The address of the array where to store
+         *  the message priorities. The default is `nullptr`.
+         * @return The same results as `message_queue::timed_receive_n()`.
+         */
+        result_t
+        timed_receive_n (value_type* msg_array, std::size_t count,
+                         clock::duration_t timeout,
+                         std::size_t* received = nullptr,
+                         priority_t* mprios = nullptr);
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
         /**
          * @}
          */
@@ -1422,8 +2228,8 @@ namespace os
             { name }
       {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-        trace::printf ("%s() @%p %s %d %d\n", __func__, this, this->name (),
-                       msgs, msg_size_bytes);
+        internal::trace_printf ("%s() @%p %s %d %d\n", __func__, this,
+                                this->name (), msgs, msg_size_bytes);
 #endif
 
         if (attr.mq_queue_address != nullptr)
@@ -1438,7 +2244,8 @@ namespace os
             // If no user storage was provided via attributes,
             // allocate it dynamically via the allocator.
             allocated_queue_size_elements_ = (compute_allocated_size_bytes<
-                typename allocator_type::value_type> (msgs, msg_size_bytes)
+                typename allocator_type::value_type> (msgs, msg_size_bytes,
+                                                      attr.mq_ordering)
                 + sizeof(typename allocator_type::value_type) - 1)
                 / sizeof(typename allocator_type::value_type);
 
@@ -1474,7 +2281,7 @@ namespace os
       message_queue_allocated<Allocator>::~message_queue_allocated ()
       {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-        trace::printf ("%s() @%p %s\n", __func__, this, name ());
+        internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
         typedef typename std::allocator_traits<allocator_type>::pointer pointer;
 
@@ -1695,6 +2502,230 @@ namespace os
             reinterpret_cast<char*> (msg), sizeof(value_type), timeout, mprio);
       }
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::reserve().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::reserve (
+          value_type** slot)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue_allocated<allocator_type>::reserve (&p);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::try_reserve().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::try_reserve (
+          value_type** slot)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue_allocated<allocator_type>::try_reserve (&p);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::timed_reserve().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::timed_reserve (
+          value_type** slot, clock::duration_t timeout)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue_allocated<allocator_type>::timed_reserve (&p, timeout);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::borrow().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::borrow (
+          value_type** slot, message_queue::priority_t* mprio)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue_allocated<allocator_type>::borrow (&p, mprio);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::try_borrow().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::try_borrow (
+          value_type** slot, message_queue::priority_t* mprio)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue_allocated<allocator_type>::try_borrow (&p, mprio);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::timed_borrow().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::timed_borrow (
+          value_type** slot, clock::duration_t timeout,
+          message_queue::priority_t* mprio)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue_allocated<allocator_type>::timed_borrow (&p, timeout, mprio);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::send_n().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::send_n (
+          const value_type* msg_array, std::size_t count,
+          message_queue::priority_t mprio, std::size_t* sent)
+      {
+        return message_queue_allocated<allocator_type>::send_n (
+            msg_array, count, sizeof(value_type), mprio, sent);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::try_send_n().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::try_send_n (
+          const value_type* msg_array, std::size_t count,
+          message_queue::priority_t mprio, std::size_t* sent)
+      {
+        return message_queue_allocated<allocator_type>::try_send_n (
+            msg_array, count, sizeof(value_type), mprio, sent);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::timed_send_n().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::timed_send_n (
+          const value_type* msg_array, std::size_t count,
+          clock::duration_t timeout, message_queue::priority_t mprio,
+          std::size_t* sent)
+      {
+        return message_queue_allocated<allocator_type>::timed_send_n (
+            msg_array, count, sizeof(value_type), timeout, mprio, sent);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::receive_n().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::receive_n (
+          value_type* msg_array, std::size_t count, std::size_t* received,
+          message_queue::priority_t* mprios)
+      {
+        return message_queue_allocated<allocator_type>::receive_n (
+            msg_array, count, sizeof(value_type), received, mprios);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::try_receive_n().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::try_receive_n (
+          value_type* msg_array, std::size_t count, std::size_t* received,
+          message_queue::priority_t* mprios)
+      {
+        return message_queue_allocated<allocator_type>::try_receive_n (
+            msg_array, count, sizeof(value_type), received, mprios);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::timed_receive_n().
+     */
+    template<typename T, typename Allocator>
+      inline result_t
+      message_queue_typed<T, Allocator>::timed_receive_n (
+          value_type* msg_array, std::size_t count,
+          clock::duration_t timeout, std::size_t* received,
+          message_queue::priority_t* mprios)
+      {
+        return message_queue_allocated<allocator_type>::timed_receive_n (
+            msg_array, count, sizeof(value_type), timeout, received,
+            mprios);
+      }
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
     // ========================================================================
 
     /**
@@ -1901,6 +2932,230 @@ namespace os
                                              sizeof(value_type), timeout, mprio);
       }
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::reserve().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::reserve (
+          value_type** slot)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue::reserve (&p);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::try_reserve().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::try_reserve (
+          value_type** slot)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue::try_reserve (&p);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::timed_reserve().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::timed_reserve (
+          value_type** slot, clock::duration_t timeout)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue::timed_reserve (&p, timeout);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::borrow().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::borrow (
+          value_type** slot, priority_t* mprio)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue::borrow (&p, mprio);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::try_borrow().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::try_borrow (
+          value_type** slot, priority_t* mprio)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue::try_borrow (&p, mprio);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, returning a typed slot.
+     *
+     * @see message_queue::timed_borrow().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::timed_borrow (
+          value_type** slot, clock::duration_t timeout,
+          priority_t* mprio)
+      {
+        os_assert_err(slot != nullptr, EINVAL);
+
+        void* p = nullptr;
+        result_t res = message_queue::timed_borrow (&p, timeout, mprio);
+        *slot = static_cast<value_type*> (p);
+        return res;
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::send_n().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::send_n (
+          const value_type* msg_array, std::size_t count,
+          priority_t mprio, std::size_t* sent)
+      {
+        return message_queue::send_n (
+            msg_array, count, sizeof(value_type), mprio, sent);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::try_send_n().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::try_send_n (
+          const value_type* msg_array, std::size_t count,
+          priority_t mprio, std::size_t* sent)
+      {
+        return message_queue::try_send_n (
+            msg_array, count, sizeof(value_type), mprio, sent);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::timed_send_n().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::timed_send_n (
+          const value_type* msg_array, std::size_t count,
+          clock::duration_t timeout, priority_t mprio,
+          std::size_t* sent)
+      {
+        return message_queue::timed_send_n (
+            msg_array, count, sizeof(value_type), timeout, mprio, sent);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::receive_n().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::receive_n (
+          value_type* msg_array, std::size_t count, std::size_t* received,
+          priority_t* mprios)
+      {
+        return message_queue::receive_n (
+            msg_array, count, sizeof(value_type), received, mprios);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::try_receive_n().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::try_receive_n (
+          value_type* msg_array, std::size_t count, std::size_t* received,
+          priority_t* mprios)
+      {
+        return message_queue::try_receive_n (
+            msg_array, count, sizeof(value_type), received, mprios);
+      }
+
+    /**
+     * @details
+     * Wrapper over the parent method, automatically
+     * passing the message size.
+     *
+     * @see message_queue::timed_receive_n().
+     */
+    template<typename T, std::size_t N>
+      inline result_t
+      message_queue_inclusive<T, N>::timed_receive_n (
+          value_type* msg_array, std::size_t count,
+          clock::duration_t timeout, std::size_t* received,
+          priority_t* mprios)
+      {
+        return message_queue::timed_receive_n (
+            msg_array, count, sizeof(value_type), timeout, received,
+            mprios);
+      }
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
   } /* namespace rtos */
 } /* namespace os */
 
@@ -286,6 +286,12 @@ namespace os
          */
         count_t mx_max_count = max_count;
 
+        /**
+         * @brief Attribute with the number of yields to a preempted
+         *  owner before blocking.
+         */
+        uint8_t mx_adaptive_yields = 0;
+
         // Add more attributes here.
 
         /**
@@ -598,6 +604,7 @@ namespace os
     protected:
 
       friend class thread;
+      friend class condition_variable;
 
       /**
        * @name Private Member Functions
@@ -624,6 +631,16 @@ namespace os
       result_t
       internal_try_lock_ (thread* th);
 
+      /**
+       * @brief Internal function used to lock the mutex, yielding
+       *  to a preempted owner before giving up.
+       * @par th Pointer to thread.
+       * @retval result::ok The mutex was locked.
+       * @retval EWOULDBLOCK The caller must block.
+       */
+      result_t
+      internal_try_lock_adaptive_ (thread* th);
+
       /**
        * @brief Internal function used to unlock the mutex.
        * @param th Pointer to thread.
@@ -632,6 +649,31 @@ namespace os
       result_t
       internal_unlock_ (thread* th);
 
+      /**
+       * @brief Internal function used to propagate the inherited
+       *  priority along the chain of owners.
+       * @param prio The priority of the blocking thread.
+       */
+      void
+      internal_inherit_ (thread::priority_t prio);
+
+      /**
+       * @brief Internal function used to compute the priority
+       *  inherited from the owned mutexes.
+       * @param th Pointer to thread.
+       * @return The highest boosted priority, or `thread::priority::none`.
+       */
+      static thread::priority_t
+      internal_inherited_priority_ (thread* th);
+
+      /**
+       * @brief Internal function used to move a thread waiting
+       *  for a condition variable to the mutex waiting list.
+       * @param node Reference to the waiting node.
+       */
+      void
+      internal_enqueue_ (internal::waiting_thread_node& node);
+
       void
       internal_mark_owner_dead_ (void);
 
@@ -693,6 +735,7 @@ namespace os
       const protocol_t protocol_; // none, inherit, protect
       const robustness_t robustness_; // stalled, robust
       const count_t max_count_;
+      const uint8_t adaptive_yields_;
 
       // Add more internal data.
 
@@ -0,0 +1,451 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_RTOS_OS_RWLOCK_H_
+#define CMSIS_PLUS_RTOS_OS_RWLOCK_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os-decls.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief POSIX compliant **read-write lock**.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-rwlock
+     */
+    class rwlock : public internal::object_named_system
+    {
+    public:
+
+      /**
+       * @brief Type of variables holding the number of readers.
+       * @ingroup cmsis-plus-rtos-rwlock
+       */
+      using count_t = uint16_t;
+
+      /**
+       * @brief Constant with the maximum number of readers.
+       * @ingroup cmsis-plus-rtos-rwlock
+       */
+      static constexpr count_t max_readers = 0xFFFF;
+
+      // ======================================================================
+
+      /**
+       * @brief Read-write lock attributes.
+       * @headerfile os.h <cmsis-plus/rtos/os.h>
+       * @ingroup cmsis-plus-rtos-rwlock
+       */
+      class attributes : public internal::attributes_clocked
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a read-write lock attributes object instance.
+         * @par Parameters
+         *  None.
+         */
+        constexpr
+        attributes ();
+
+        // The rule of five.
+        attributes (const attributes&) = default;
+        attributes (attributes&&) = default;
+        attributes&
+        operator= (const attributes&) = default;
+        attributes&
+        operator= (attributes&&) = default;
+
+        /**
+         * @brief Destruct the read-write lock attributes object instance.
+         */
+        ~attributes () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        // Public members; no accessors and mutators required.
+        // Warning: must match the type & order of the C file header.
+        // Add more attributes here.
+        /**
+         * @}
+         */
+
+      }; /* class attributes */
+
+      /**
+       * @brief Default read-write lock initialiser.
+       * @ingroup cmsis-plus-rtos-rwlock
+       */
+      static const attributes initializer;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a read-write lock object instance.
+       * @param [in] attr Reference to attributes.
+       * @par Errors
+       *  The constructor shall fail if:
+       *  - `EPERM` - Cannot be invoked from an Interrupt Service Routines.
+       * @par
+       *  The constructor shall not fail with an error code of `EINTR`.
+       */
+      rwlock (const attributes& attr = initializer);
+
+      /**
+       * @brief Construct a named read-write lock object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] attr Reference to attributes.
+       * @par Errors
+       *  The constructor shall fail if:
+       *  - `EPERM` - Cannot be invoked from an Interrupt Service Routines.
+       * @par
+       *  The constructor shall not fail with an error code of `EINTR`.
+       */
+      rwlock (const char* name, const attributes& attr = initializer);
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      rwlock (const rwlock&) = delete;
+      rwlock (rwlock&&) = delete;
+      rwlock&
+      operator= (const rwlock&) = delete;
+      rwlock&
+      operator= (rwlock&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the read-write lock object instance.
+       */
+      ~rwlock ();
+
+      /**
+       * @}
+       */
+
+      /**
+       * @name Operators
+       * @{
+       */
+
+      /**
+       * @brief Compare read-write locks.
+       * @retval true The given read-write lock is the same as this
+       *  read-write lock.
+       * @retval false The read-write locks are different.
+       */
+      bool
+      operator== (const rwlock& rhs) const;
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Lock the read-write lock for reading.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The lock was acquired for reading.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EDEADLK The current thread holds the lock for writing.
+       * @retval EAGAIN The maximum number of readers was exceeded.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      read_lock (void);
+
+      /**
+       * @brief Try to lock the read-write lock for reading.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The lock was acquired for reading.
+       * @retval EWOULDBLOCK The lock is held by a writer, or
+       *  a writer with at least the same priority is waiting.
+       * @retval EDEADLK The current thread holds the lock for writing.
+       * @retval EAGAIN The maximum number of readers was exceeded.
+       */
+      result_t
+      try_read_lock (void);
+
+      /**
+       * @brief Timed attempt to lock the read-write lock for reading.
+       * @param [in] timeout Timeout to wait.
+       * @retval result::ok The lock was acquired for reading.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The lock could not be acquired before the
+       *  specified timeout expired.
+       * @retval EDEADLK The current thread holds the lock for writing.
+       * @retval EAGAIN The maximum number of readers was exceeded.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_read_lock (clock::duration_t timeout);
+
+      /**
+       * @brief Lock the read-write lock for writing.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The lock was acquired for writing.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EDEADLK The current thread already holds the lock
+       *  for writing.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      write_lock (void);
+
+      /**
+       * @brief Try to lock the read-write lock for writing.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The lock was acquired for writing.
+       * @retval EWOULDBLOCK The lock is held for reading or writing.
+       * @retval EDEADLK The current thread already holds the lock
+       *  for writing.
+       */
+      result_t
+      try_write_lock (void);
+
+      /**
+       * @brief Timed attempt to lock the read-write lock for writing.
+       * @param [in] timeout Timeout to wait.
+       * @retval result::ok The lock was acquired for writing.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The lock could not be acquired before the
+       *  specified timeout expired.
+       * @retval EDEADLK The current thread already holds the lock
+       *  for writing.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_write_lock (clock::duration_t timeout);
+
+      /**
+       * @brief Unlock the read-write lock.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The lock was released.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines,
+       *  or the lock is not held.
+       */
+      result_t
+      unlock (void);
+
+      /**
+       * @brief Get the number of readers holding the lock.
+       * @par Parameters
+       *  None.
+       * @return The number of readers.
+       */
+      count_t
+      readers (void) const;
+
+      /**
+       * @brief Get the thread holding the lock for writing.
+       * @par Parameters
+       *  None.
+       * @return Pointer to thread or `nullptr` if not locked for writing.
+       */
+      thread*
+      writer (void) const;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Internal function used to lock for reading.
+       * @param th Pointer to thread.
+       * @retval result::ok The lock was acquired for reading.
+       */
+      result_t
+      internal_try_read_lock_ (thread* th);
+
+      /**
+       * @brief Internal function used to lock for writing.
+       * @param th Pointer to thread.
+       * @retval result::ok The lock was acquired for writing.
+       */
+      result_t
+      internal_try_write_lock_ (thread* th);
+
+      /**
+       * @brief Internal function used to resume the threads that
+       *  may acquire the lock.
+       * @par Parameters
+       *  None.
+       */
+      void
+      internal_resume_waiters_ (void);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      internal::waiting_threads_list readers_list_;
+      internal::waiting_threads_list writers_list_;
+      clock* clock_;
+
+      // Can be updated in different thread contexts.
+      thread* volatile writer_ = nullptr;
+      volatile count_t readers_ = 0;
+
+      // Add more internal data.
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    };
+
+#pragma GCC diagnostic pop
+
+  } /* namespace rtos */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace rtos
+  {
+    constexpr
+    rwlock::attributes::attributes ()
+    {
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * Identical read-write locks should have the same memory address.
+     */
+    inline bool
+    rwlock::operator== (const rwlock& rhs) const
+    {
+      return this == &rhs;
+    }
+
+    inline rwlock::count_t
+    rwlock::readers (void) const
+    {
+      return readers_;
+    }
+
+    inline thread*
+    rwlock::writer (void) const
+    {
+      return writer_;
+    }
+
+  } /* namespace rtos */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_RTOS_OS_RWLOCK_H_ */
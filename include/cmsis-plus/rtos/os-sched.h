@@ -468,6 +468,21 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+        /**
+         * @brief Write a table with the statistics of all threads
+         *  to the trace channel.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        top (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
       } /* namespace statistics */
     } /* namespace scheduler */
 
@@ -912,7 +927,7 @@ namespace os
           state_ (lock ())
       {
 #if defined(OS_TRACE_RTOS_SCHEDULER)
-        trace::printf ("{C ");
+        internal::trace_printf ("{C ");
 #endif
       }
 
@@ -927,7 +942,7 @@ namespace os
       critical_section::~critical_section ()
       {
 #if defined(OS_TRACE_RTOS_SCHEDULER)
-        trace::printf (" C}");
+        internal::trace_printf (" C}");
 #endif
         locked (state_);
       }
@@ -943,7 +958,7 @@ namespace os
           state_ (unlock ())
       {
 #if defined(OS_TRACE_RTOS_SCHEDULER)
-        trace::printf ("{U ");
+        internal::trace_printf ("{U ");
 #endif
       }
 
@@ -958,7 +973,7 @@ namespace os
       uncritical_section::~uncritical_section ()
       {
 #if defined(OS_TRACE_RTOS_SCHEDULER)
-        trace::printf (" U}");
+        internal::trace_printf (" U}");
 #endif
         locked (state_);
       }
@@ -343,6 +343,18 @@ namespace os
       result_t
       post (void);
 
+      /**
+       * @brief Post (unlock) the semaphore multiple times.
+       * @param [in] count The number of units to add.
+       * @retval result::ok The semaphore was posted.
+       * @retval EINVAL The count is not positive.
+       * @retval EAGAIN The maximum count value would be exceeded;
+       *  no units were added.
+       * @retval ENOTSUP Multiple units are not supported by the port.
+       */
+      result_t
+      post (count_t count);
+
       /**
        * @brief Lock the semaphore, possibly waiting.
        * @par Parameters
@@ -357,6 +369,20 @@ namespace os
       result_t
       wait (void);
 
+      /**
+       * @brief Lock the semaphore multiple times, possibly waiting.
+       * @param [in] count The number of units to acquire.
+       * @retval result::ok The calling process successfully
+       *  acquired all units.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The count is not positive or exceeds the
+       *  maximum value.
+       * @retval ENOTSUP Multiple units are not supported by the port.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      wait (count_t count);
+
       /**
        * @brief Try to lock the semaphore.
        * @par Parameters
@@ -372,6 +398,20 @@ namespace os
       result_t
       try_wait (void);
 
+      /**
+       * @brief Try to lock the semaphore multiple times.
+       * @param [in] count The number of units to acquire.
+       * @retval result::ok The calling process successfully
+       *  acquired all units.
+       * @retval EWOULDBLOCK Not enough units were available;
+       *  no units were acquired.
+       * @retval EINVAL The count is not positive or exceeds the
+       *  maximum value.
+       * @retval ENOTSUP Multiple units are not supported by the port.
+       */
+      result_t
+      try_wait (count_t count);
+
       /**
        * @brief Timed wait to lock the semaphore.
        * @param [in] timeout Timeout to wait.
@@ -389,6 +429,23 @@ namespace os
       result_t
       timed_wait (clock::duration_t timeout);
 
+      /**
+       * @brief Timed wait to lock the semaphore multiple times.
+       * @param [in] count The number of units to acquire.
+       * @param [in] timeout Timeout to wait.
+       * @retval result::ok The calling process successfully
+       *  acquired all units.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The count is not positive or exceeds the
+       *  maximum value.
+       * @retval ETIMEDOUT Not enough units were available before
+       *  the specified timeout expired.
+       * @retval ENOTSUP Multiple units are not supported by the port.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_wait (count_t count, clock::duration_t timeout);
+
       /**
        * @brief Get the semaphore count value.
        * @par Parameters
@@ -450,7 +507,65 @@ namespace os
       internal_init_ (void);
 
       bool
-      internal_try_wait_ (void);
+      internal_try_wait_ (count_t count);
+
+      /**
+       * @brief Internal function used to hand over the available
+       *  units to the first waiting thread.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the thread to be resumed, or `nullptr`.
+       */
+      thread*
+      internal_hand_over_ (void);
+
+      /**
+       * @brief Internal function used to hand over the available
+       *  units to all satisfied waiting threads and make them ready,
+       *  without rescheduling.
+       * @par Parameters
+       *  None.
+       * @return The number of threads made ready.
+       */
+      std::size_t
+      internal_ready_satisfied_ (void);
+
+      /**
+       * @brief Internal function used to resume all satisfied
+       *  waiting threads, with a single reschedule.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_resume_satisfied_ (void);
+
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+
+      /**
+       * @brief Internal function used to accumulate the posts
+       *  from interrupt handlers.
+       * @param count The number of units to add.
+       * @retval result::ok The units were added to the pending count.
+       * @retval EAGAIN The maximum count value would be exceeded.
+       */
+      result_t
+      internal_post_deferred_ (count_t count);
+
+      /**
+       * @brief Internal function used to fold the pending counts
+       *  of all semaphores posted from interrupt handlers.
+       * @par Parameters
+       *  None.
+       */
+      static void
+      internal_fold_deferred_posts_ (void);
+
+      friend void
+      scheduler::internal_switch_threads (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS) */
 
       /**
        * @endcond
@@ -476,6 +591,14 @@ namespace os
       clock* clock_ = nullptr;
 #endif
 
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+      // Link in the list of semaphores with pending posts; the last
+      // semaphore points to itself, null means not linked.
+      semaphore* volatile deferred_next_ = nullptr;
+
+      static semaphore* volatile deferred_list_;
+#endif
+
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
       friend class port::semaphore;
       os_semaphore_port_data_t port_;
@@ -489,6 +612,11 @@ namespace os
       // Can be updated in different contexts (interrupts or threads)
       volatile count_t count_ = 0;
 
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+      // Posted from interrupt handlers, not yet added to the count.
+      volatile count_t pending_ = 0;
+#endif
+
       // Add more internal data.
 
       /**
@@ -0,0 +1,532 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_RTOS_OS_THREAD_POOL_H_
+#define CMSIS_PLUS_RTOS_OS_THREAD_POOL_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os-decls.h>
+#include <cmsis-plus/rtos/os-thread.h>
+#include <cmsis-plus/rtos/os-mqueue.h>
+
+#include <cmsis-plus/diag/trace.h>
+
+#include <new>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief **Thread pool** executing jobs on pre-created threads.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-thread-pool
+     *
+     * @details
+     * The worker threads and their stacks are created once, when
+     * the pool is constructed, and wait for jobs on a message queue.
+     * Dispatching a job only queues a function and its argument,
+     * without allocating memory or initialising a stack; after the
+     * function returns, the worker waits for the next job.
+     *
+     * The jobs must return normally; they must not call
+     * `this_thread::exit()`, which would terminate the worker.
+     *
+     * This class holds only the logic; the threads and the
+     * queue are defined by the `thread_pool_inclusive` class template.
+     */
+    class thread_pool : public internal::object_named
+    {
+    public:
+
+      /**
+       * @brief Type of job function.
+       * @details
+       * Same as the thread function; the returned value is ignored.
+       */
+      using func_t = thread::func_t;
+
+      /**
+       * @brief Type of job function arguments.
+       */
+      using func_args_t = thread::func_args_t;
+
+      /**
+       * @brief Job queued to the workers.
+       */
+      typedef struct job_s
+      {
+        /**
+         * @brief Pointer to the job function, or `nullptr` to
+         *  stop the worker.
+         */
+        func_t function;
+
+        /**
+         * @brief Job function arguments.
+         */
+        func_args_t args;
+      } job_t;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+    protected:
+
+      /**
+       * @brief Construct a named thread pool object instance.
+       * @param [in] name Pointer to name.
+       */
+      thread_pool (const char* name);
+
+    public:
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      thread_pool (const thread_pool&) = delete;
+      thread_pool (thread_pool&&) = delete;
+      thread_pool&
+      operator= (const thread_pool&) = delete;
+      thread_pool&
+      operator= (thread_pool&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the thread pool object instance.
+       */
+      ~thread_pool ();
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Queue a job, waiting while the queue is full.
+       * @param [in] function Pointer to job function.
+       * @param [in] args Job function arguments.
+       * @retval result::ok The job was queued.
+       * @retval EINVAL The function pointer is `nullptr`.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      dispatch (func_t function, func_args_t args = nullptr);
+
+      /**
+       * @brief Try to queue a job.
+       * @param [in] function Pointer to job function.
+       * @param [in] args Job function arguments.
+       * @retval result::ok The job was queued.
+       * @retval EINVAL The function pointer is `nullptr`.
+       * @retval EWOULDBLOCK The queue is full.
+       */
+      result_t
+      try_dispatch (func_t function, func_args_t args = nullptr);
+
+      /**
+       * @brief Queue a job, waiting while the queue is full,
+       *  with timeout.
+       * @param [in] function Pointer to job function.
+       * @param [in] args Job function arguments.
+       * @param [in] timeout Timeout to wait.
+       * @retval result::ok The job was queued.
+       * @retval EINVAL The function pointer is `nullptr`.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The queue was full for the given time.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_dispatch (func_t function, func_args_t args,
+                      clock::duration_t timeout);
+
+      /**
+       * @brief Get the number of worker threads.
+       * @par Parameters
+       *  None.
+       * @return The number of threads.
+       */
+      std::size_t
+      workers (void) const;
+
+      /**
+       * @brief Get the number of workers executing jobs.
+       * @par Parameters
+       *  None.
+       * @return The number of threads.
+       */
+      std::size_t
+      busy (void) const;
+
+      /**
+       * @brief Get the number of jobs waiting for a worker.
+       * @par Parameters
+       *  None.
+       * @return The number of jobs.
+       */
+      std::size_t
+      pending (void) const;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Internal function used to initialise the pool.
+       * @param [in] queue Reference to the job queue.
+       * @param [in] threads Pointer to array of pointers to the workers.
+       * @param [in] workers Number of workers.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (message_queue& queue, thread** threads,
+                           std::size_t workers);
+
+      /**
+       * @brief Internal function used to stop and join the workers.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_stop_ (void);
+
+      /**
+       * @brief The worker thread function.
+       * @param [in] args Pointer to the thread pool.
+       * @return Always `nullptr`.
+       */
+      static void*
+      internal_worker_ (func_args_t args);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      message_queue* queue_ = nullptr;
+      thread** threads_ = nullptr;
+      std::size_t workers_ = 0;
+
+      // Updated by the workers.
+      volatile std::size_t busy_ = 0;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    };
+
+#pragma GCC diagnostic pop
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a **thread pool** with local storage.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-thread-pool
+     *
+     * @tparam N The number of worker threads.
+     * @tparam S The size of each worker stack, in bytes.
+     * @tparam Q The number of jobs that can be queued.
+     *
+     * @details
+     * The threads, their stacks and the job queue are allocated
+     * inside the object, so no allocator is involved.
+     */
+    template<std::size_t N, std::size_t S, std::size_t Q = N>
+      class thread_pool_inclusive : public thread_pool
+      {
+      public:
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t threads = N;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t stack_size_bytes = S;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t jobs = Q;
+
+        static_assert(N > 0, "The pool must have at least one thread.");
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a thread pool object instance.
+         * @param [in] attr Reference to the workers attributes;
+         *  the stack is always inside the pool.
+         */
+        thread_pool_inclusive (const thread::attributes& attr =
+                                   thread::initializer);
+
+        /**
+         * @brief Construct a named thread pool object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] attr Reference to the workers attributes;
+         *  the stack is always inside the pool.
+         */
+        thread_pool_inclusive (const char* name,
+                               const thread::attributes& attr =
+                                   thread::initializer);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        thread_pool_inclusive (const thread_pool_inclusive&) = delete;
+        thread_pool_inclusive (thread_pool_inclusive&&) = delete;
+        thread_pool_inclusive&
+        operator= (const thread_pool_inclusive&) = delete;
+        thread_pool_inclusive&
+        operator= (thread_pool_inclusive&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the thread pool object instance.
+         * @details
+         * The jobs already queued are executed, then the workers
+         * are stopped.
+         */
+        ~thread_pool_inclusive ();
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        using worker_type = thread_inclusive<S>;
+
+        message_queue_inclusive<job_t, Q> queue_storage_;
+
+        thread* threads_pointers_[N];
+
+        typename std::aligned_storage<sizeof(worker_type),
+            alignof(worker_type)>::type threads_storage_[N];
+
+        /**
+         * @endcond
+         */
+
+      };
+
+  // --------------------------------------------------------------------------
+  } /* namespace rtos */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+    inline
+    thread_pool::thread_pool (const char* name) :
+        object_named
+          { name }
+    {
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread_pool::workers (void) const
+    {
+      return workers_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread_pool::busy (void) const
+    {
+      return busy_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread_pool::pending (void) const
+    {
+      return queue_->length ();
+    }
+
+    // ========================================================================
+
+    template<std::size_t N, std::size_t S, std::size_t Q>
+      inline
+      thread_pool_inclusive<N, S, Q>::thread_pool_inclusive (
+          const thread::attributes& attr) :
+          thread_pool_inclusive
+            { nullptr, attr }
+      {
+      }
+
+    /**
+     * @details
+     * The workers are created and started, and wait for jobs.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t N, std::size_t S, std::size_t Q>
+      thread_pool_inclusive<N, S, Q>::thread_pool_inclusive (
+          const char* name, const thread::attributes& attr) :
+          thread_pool
+            { name }, //
+          queue_storage_
+            { name }
+      {
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+        internal::trace_printf ("%s() @%p %s\n", __func__, this,
+                                this->name ());
+#endif
+
+        internal_construct_ (queue_storage_, threads_pointers_, N);
+
+        for (std::size_t i = 0; i < N; ++i)
+          {
+            threads_pointers_[i] = new (&threads_storage_[i]) worker_type
+              { name, internal_worker_, this, attr };
+          }
+      }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t N, std::size_t S, std::size_t Q>
+      thread_pool_inclusive<N, S, Q>::~thread_pool_inclusive ()
+      {
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+        internal::trace_printf ("%s() @%p %s\n", __func__, this,
+                                this->name ());
+#endif
+
+        internal_stop_ ();
+
+        for (std::size_t i = 0; i < N; ++i)
+          {
+            static_cast<worker_type*> (threads_pointers_[i])->~worker_type ();
+          }
+      }
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace rtos */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_RTOS_OS_THREAD_POOL_H_ */
@@ -514,13 +514,13 @@ namespace os
 
         /**
          * @brief Align the pointers and initialise to a known pattern.
-         * @par Parameters
-         *  None.
+         * @param [in] fill If false, only the guard words at the
+         *  bottom and at the top of the stack are initialised.
          * @par Returns
          *  Nothing.
          */
         void
-        initialize (void);
+        initialize (bool fill = true);
 
         /**
          * @brief Get the stack lowest reserved address.
@@ -578,6 +578,15 @@ namespace os
         std::size_t
         available (void);
 
+        /**
+         * @brief Estimate the maximum stack usage.
+         * @par Parameters
+         *  None.
+         * @return Number of bytes used at the deepest point.
+         */
+        std::size_t
+        high_water_mark (void);
+
         /**
          * @}
          */
@@ -635,8 +644,15 @@ namespace os
 
         friend class rtos::thread;
 
+        // The number of consecutive magic words considered unused
+        // by the high water mark search.
+        static constexpr std::size_t watermark_probe_elements = 4;
+
         stack::element_t* bottom_address_;
         std::size_t size_bytes_;
+        // The lowest element known to be used, nullptr if not yet
+        // searched, or the bottom if the stack was not filled.
+        stack::element_t* watermark_;
 
         static std::size_t min_size_bytes_;
         static std::size_t default_size_bytes_;
@@ -870,6 +886,17 @@ namespace os
 
         bool th_enable_assert_reuse = false;
 
+        /**
+         * @brief Fill the entire stack with the magic word.
+         * @details
+         * The fill is required to measure the stack usage. For large
+         * stacks it may take a while, so, if false, only the guard
+         * words at both ends are set and the thread starts faster.
+         *
+         * The default is @ref OS_BOOL_RTOS_THREAD_STACK_FILL.
+         */
+        bool th_stack_fill = OS_BOOL_RTOS_THREAD_STACK_FILL;
+
         // Add more attributes here.
 
         /**
@@ -960,6 +987,78 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+        /**
+         * @brief Number of buckets in the histograms.
+         */
+        static constexpr std::size_t histogram_buckets =
+            OS_INTEGER_RTOS_STATISTICS_HISTOGRAM_BUCKETS;
+
+        /**
+         * @brief Type of the histogram buckets.
+         */
+        using bucket_t = uint32_t;
+
+        /**
+         * @brief Get the thread CPU load in the last window.
+         * @par Parameters
+         *  None.
+         * @return The load in hundredths of percent (0-10000).
+         */
+        uint32_t
+        cpu_load (void);
+
+        /**
+         * @brief Get the maximum wakeup latency.
+         * @par Parameters
+         *  None.
+         * @return The longest duration, in CPU cycles, from the
+         * moment the thread was made ready, to the moment it
+         * started to run.
+         */
+        rtos::statistics::duration_t
+        latency_max (void);
+
+        /**
+         * @brief Get an upper bound of a wakeup latency percentile.
+         * @param [in] per_mille The percentile, in thousandths
+         * (990 for p99, 999 for p99.9).
+         * @return A duration in CPU cycles, not lower than the
+         * requested percentile of the latencies.
+         */
+        rtos::statistics::duration_t
+        latency_percentile (unsigned int per_mille);
+
+        /**
+         * @brief Get the wakeup latency histogram.
+         * @par Parameters
+         *  None.
+         * @return An array of `histogram_buckets` counters.
+         */
+        const bucket_t*
+        latency_histogram (void);
+
+        /**
+         * @brief Get the run burst length histogram.
+         * @par Parameters
+         *  None.
+         * @return An array of `histogram_buckets` counters.
+         */
+        const bucket_t*
+        burst_histogram (void);
+
+        /**
+         * @brief Get the upper limit of a histogram bucket.
+         * @param [in] bucket The bucket index.
+         * @return The first duration, in CPU cycles, not counted
+         * in the bucket, or 0 for the last bucket, which is unbounded.
+         */
+        static rtos::statistics::duration_t
+        bucket_limit (std::size_t bucket);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
         /**
          * @brief Clear the thread statistic counters.
          * @par Parameters
@@ -983,6 +1082,25 @@ namespace os
         friend void
         rtos::scheduler::internal_switch_threads (void);
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+        friend class thread;
+
+        static std::size_t
+        internal_bucket_ (rtos::statistics::duration_t duration);
+
+        void
+        internal_account_cycles_ (rtos::statistics::duration_t delta,
+                                  clock::timestamp_t window);
+
+        void
+        internal_account_burst_ (void);
+
+        void
+        internal_account_run_ (clock::timestamp_t now);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
         rtos::statistics::counter_t context_switches_ = 0;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
@@ -991,6 +1109,23 @@ namespace os
         rtos::statistics::duration_t cpu_cycles_ = 0;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+        // The hrclock time stamp when made ready, 0 if not waiting to run.
+        clock::timestamp_t resume_timestamp_ = 0;
+        rtos::statistics::duration_t latency_max_ = 0;
+        // Cycles accumulated since the thread started to run.
+        rtos::statistics::duration_t burst_cycles_ = 0;
+        // The load window of window_cycles_, in sysclock windows.
+        clock::timestamp_t window_ = 0;
+        rtos::statistics::duration_t window_cycles_ = 0;
+        // Cycles in the window before window_.
+        rtos::statistics::duration_t load_cycles_ = 0;
+        bucket_t latency_histogram_[histogram_buckets] =
+          { };
+        bucket_t burst_histogram_[histogram_buckets] =
+          { };
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
         /**
          * @endcond
          */
@@ -1354,7 +1489,9 @@ namespace os
 
       friend void
       scheduler::internal_link_node (internal::waiting_threads_list& list,
-                                     internal::waiting_thread_node& node);
+                                     internal::waiting_thread_node& node,
+                                     const void* object,
+                                     internal::wait_reason_t reason);
 
       friend void
       scheduler::internal_unlink_node (internal::waiting_thread_node& node);
@@ -1364,7 +1501,8 @@ namespace os
           internal::waiting_threads_list& list,
           internal::waiting_thread_node& node,
           internal::clock_timestamps_list& timeout_list,
-          internal::timeout_thread_node& timeout_node);
+          internal::timeout_thread_node& timeout_node, const void* object,
+          internal::wait_reason_t reason);
 
       friend void
       scheduler::internal_unlink_node (
@@ -1391,9 +1529,12 @@ namespace os
       friend class internal::waiting_threads_list;
       friend class internal::clock_timestamps_list;
       friend class internal::terminated_threads_list;
+      friend class internal::timeout_thread_node;
 
       friend class clock;
       friend class condition_variable;
+      friend class event_flags;
+      friend class semaphore;
       /* friend class mutex; */
 
       /**
@@ -1430,13 +1571,23 @@ namespace os
 
       /**
        * @brief Suspend this thread and wait for an event.
-       * @par Parameters
-       *  None.
+       * @param [in] object Pointer to the object waited for, or `nullptr`.
+       * @param [in] reason Kind of the object.
        * @par Returns
        *  Nothing.
        */
       void
-      internal_suspend_ (void);
+      internal_suspend_ (const void* object, internal::wait_reason_t reason);
+
+      /**
+       * @brief Resume the thread, telling why.
+       * @param [in] object Pointer to the object posted, or `nullptr`.
+       * @param [in] reason Kind of the object.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_resume_ (const void* object, internal::wait_reason_t reason);
 
       /**
        * @brief Terminate thread by itself.
@@ -1572,6 +1723,27 @@ namespace os
       void
       internal_relink_running_ (void);
 
+      /**
+       * @brief Make the thread ready, without requesting a new switch.
+       * @param [in] object Pointer to the object posted, or `nullptr`.
+       * @param [in] reason Kind of the object.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_make_ready_ (const void* object,
+                            internal::wait_reason_t reason);
+
+      /**
+       * @brief Internal function used by mutexes to raise the
+       *  inherited priority, without yielding.
+       * @param [in] prio New inherited priority.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_inherit_priority_ (priority_t prio);
+
       /**
        * @par Parameters
        *  None.
@@ -1634,6 +1806,10 @@ namespace os
       // Pointer to waiting node (stored on stack)
       internal::waiting_thread_node* waiting_node_ = nullptr;
 
+      // Pointer to the mutex the thread is blocked on, if any;
+      // used to propagate the inherited priorities.
+      mutex* waiting_mutex_ = nullptr;
+
       // Pointer to timeout node (stored on stack)
       internal::timeout_thread_node* clock_node_ = nullptr;
 
@@ -1689,11 +1865,22 @@ namespace os
       os_thread_user_storage_t user_storage_;
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
-#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
       class statistics statistics_;
 
-#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
+
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+      friend class memory::allocation_cache;
+
+      // Small blocks used by malloc() & new, without locking.
+      memory::allocation_cache allocation_cache_;
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
 
       // Add other internal data
 
@@ -1926,7 +2113,8 @@ namespace os
       inline void
       suspend (void)
       {
-        this_thread::thread ().internal_suspend_ ();
+        this_thread::thread ().internal_suspend_ (nullptr,
+                                                  internal::wait_reason::none);
       }
 
       /**
@@ -2131,6 +2319,7 @@ namespace os
     {
       bottom_address_ = nullptr;
       size_bytes_ = 0;
+      watermark_ = nullptr;
     }
 
     /**
@@ -2142,6 +2331,7 @@ namespace os
       assert (size_bytes >= min_size_bytes_);
       bottom_address_ = address;
       size_bytes_ = size_bytes;
+      watermark_ = nullptr;
     }
 
     /**
@@ -2298,6 +2488,81 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+    /**
+     * @details
+     * The latency is measured from the moment `resume()` links the
+     * thread to the ready list, to the context switch that selects
+     * it to run; preemptions are not counted.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::latency_max (void)
+    {
+      return latency_max_;
+    }
+
+    /**
+     * @details
+     * Bucket 0 counts null durations, and bucket `n` counts
+     * durations from 2^(n-1) up to 2^n-1 CPU cycles; the last
+     * bucket also counts all longer durations.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline const thread::statistics::bucket_t*
+    thread::statistics::latency_histogram (void)
+    {
+      return latency_histogram_;
+    }
+
+    /**
+     * @details
+     * A burst is the time the thread runs from the context switch
+     * that selects it, to the context switch that selects another
+     * thread. The buckets are the same as for the latency histogram.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline const thread::statistics::bucket_t*
+    thread::statistics::burst_histogram (void)
+    {
+      return burst_histogram_;
+    }
+
+    /**
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::bucket_limit (std::size_t bucket)
+    {
+      if (bucket + 1 >= histogram_buckets)
+        {
+          return 0;
+        }
+      return static_cast<rtos::statistics::duration_t> (1) << bucket;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
   || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
@@ -2322,6 +2587,17 @@ namespace os
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
       cpu_cycles_ = 0;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+      latency_max_ = 0;
+      window_cycles_ = 0;
+      load_cycles_ = 0;
+      for (std::size_t i = 0; i < histogram_buckets; ++i)
+        {
+          latency_histogram_[i] = 0;
+          burst_histogram_[i] = 0;
+        }
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
     }
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
@@ -2447,7 +2723,8 @@ namespace os
       return context_.stack_;
     }
 
-#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
     /**
      * @warning Cannot be invoked from Interrupt Service Routines.
@@ -2458,7 +2735,8 @@ namespace os
       return statistics_;
     }
 
-#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
 #if defined(OS_INCLUDE_RTOS_THREAD_PUBLIC_FLAGS_CLEAR)
 
@@ -2572,7 +2850,7 @@ namespace os
             { name }
       {
 #if defined(OS_TRACE_RTOS_THREAD)
-        trace::printf ("%s @%p %s\n", __func__, this, this->name ());
+        internal::trace_printf ("%s @%p %s\n", __func__, this, this->name ());
 #endif
         if (attr.th_stack_address != nullptr
             && attr.th_stack_size_bytes > stack::min_size ())
@@ -2623,8 +2901,8 @@ namespace os
       thread_allocated<Allocator>::internal_destroy_ (void)
       {
 #if defined(OS_TRACE_RTOS_THREAD)
-        trace::printf ("thread_allocated::%s() @%p %s\n", __func__, this,
-                       name ());
+        internal::trace_printf ("thread_allocated::%s() @%p %s\n", __func__,
+                                this, name ());
 #endif
 
         if (allocated_stack_address_ != nullptr)
@@ -2667,7 +2945,7 @@ namespace os
       thread_allocated<Allocator>::~thread_allocated ()
       {
 #if defined(OS_TRACE_RTOS_THREAD)
-        trace::printf ("%s @%p %s\n", __func__, this, name ());
+        internal::trace_printf ("%s @%p %s\n", __func__, this, name ());
 #endif
       }
 
@@ -2782,7 +3060,7 @@ namespace os
             { name }
       {
 #if defined(OS_TRACE_RTOS_THREAD)
-        trace::printf ("%s @%p %s\n", __func__, this, this->name ());
+        internal::trace_printf ("%s @%p %s\n", __func__, this, this->name ());
 #endif
         internal_construct_ (function, args, attr, &stack_, stack_size_bytes);
       }
@@ -2802,7 +3080,7 @@ namespace os
       thread_inclusive<N>::~thread_inclusive ()
       {
 #if defined(OS_TRACE_RTOS_THREAD)
-        trace::printf ("%s @%p %s\n", __func__, this, name ());
+        internal::trace_printf ("%s @%p %s\n", __func__, this, name ());
 #endif
       }
 
@@ -0,0 +1,652 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef CMSIS_PLUS_RTOS_OS_WORK_QUEUE_H_
+#define CMSIS_PLUS_RTOS_OS_WORK_QUEUE_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os-decls.h>
+#include <cmsis-plus/rtos/os-clocks.h>
+#include <cmsis-plus/rtos/os-thread.h>
+#include <cmsis-plus/rtos/os-semaphore.h>
+
+#include <cmsis-plus/diag/trace.h>
+
+#include <new>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+
+    class work_queue;
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+    /**
+     * @brief **Work item**, a function deferred to a work queue.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-work-queue
+     *
+     * @details
+     * The item is intrusive, it includes the links used by the work
+     * queue and the clock list, so submitting it does not
+     * allocate memory. An item can be pending in at most one queue
+     * at a time.
+     */
+    class work_item
+    {
+    public:
+
+      /**
+       * @brief Work function arguments.
+       */
+      using func_args_t = void*;
+
+      /**
+       * @brief Entry point of a work function.
+       */
+      using func_t = void (*) (func_args_t args);
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a work item object instance.
+       * @param [in] function Pointer to function executed by the
+       *  service thread.
+       * @param [in] args Function arguments.
+       */
+      work_item (func_t function, func_args_t args = nullptr);
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      work_item (const work_item&) = delete;
+      work_item (work_item&&) = delete;
+      work_item&
+      operator= (const work_item&) = delete;
+      work_item&
+      operator= (work_item&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the work item object instance.
+       * @details
+       * The item must not be pending.
+       */
+      ~work_item ();
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Check if the item is queued or delayed.
+       * @par Parameters
+       *  None.
+       * @retval true The item is waiting to be executed.
+       * @retval false The item is idle or running.
+       */
+      bool
+      pending (void) const;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Friends
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      friend class work_queue;
+      friend class internal::work_node;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      void
+      internal_interrupt_service_routine (void);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      func_t func_;
+      func_args_t func_args_;
+
+      // The queue where the item is pending, or nullptr.
+      work_queue* queue_ = nullptr;
+
+      // Links in the queue list.
+      utils::double_list_links links_;
+
+      // Links in the clock list, while delayed.
+      internal::work_node work_node_
+        { 0, *this };
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief **Work queue**, executing deferred work items on
+     *  service threads.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-work-queue
+     *
+     * @details
+     * This class holds only the logic; the service threads are
+     * defined by the `work_queue_inclusive` class template.
+     */
+    class work_queue : public internal::object_named
+    {
+    public:
+
+      /**
+       * @brief Default priority of the service threads.
+       */
+      static constexpr thread::priority_t default_priority =
+          thread::priority::high;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+    protected:
+
+      /**
+       * @brief Construct a named work queue object instance.
+       * @param [in] name Pointer to name.
+       */
+      work_queue (const char* name);
+
+    public:
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      work_queue (const work_queue&) = delete;
+      work_queue (work_queue&&) = delete;
+      work_queue&
+      operator= (const work_queue&) = delete;
+      work_queue&
+      operator= (work_queue&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the work queue object instance.
+       */
+      ~work_queue ();
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Queue a work item for execution.
+       * @param [in] item Reference to the work item.
+       * @retval result::ok The item was queued.
+       * @retval EALREADY The item was already queued.
+       * @retval EBUSY The item is pending in another queue.
+       */
+      result_t
+      submit (work_item& item);
+
+      /**
+       * @brief Queue a work item after a delay.
+       * @param [in] item Reference to the work item.
+       * @param [in] ticks Number of system clock ticks to delay.
+       * @retval result::ok The item was scheduled.
+       * @retval EBUSY The item is pending in another queue.
+       */
+      result_t
+      submit_delayed (work_item& item, clock::duration_t ticks);
+
+      /**
+       * @brief Cancel a pending work item.
+       * @param [in] item Reference to the work item.
+       * @retval result::ok The item was removed.
+       * @retval EALREADY The item was not pending in this queue.
+       */
+      result_t
+      cancel (work_item& item);
+
+      /**
+       * @brief Get the number of service threads.
+       * @par Parameters
+       *  None.
+       * @return The number of threads.
+       */
+      std::size_t
+      threads (void) const;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Friends
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      friend class work_item;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Internal function used to initialise the queue.
+       * @param [in] threads Pointer to array of pointers to the
+       *  service threads.
+       * @param [in] count Number of service threads.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (thread** threads, std::size_t count);
+
+      /**
+       * @brief Internal function used to stop and join the
+       *  service threads.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_stop_ (void);
+
+      /**
+       * @brief Link the item in the queue and wake a service thread.
+       * @param [in] item Reference to the work item.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_enqueue_ (work_item& item);
+
+      /**
+       * @brief The service thread function.
+       * @param [in] args Pointer to the work queue.
+       * @return Always `nullptr`.
+       */
+      static void*
+      internal_service_ (thread::func_args_t args);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      using items_list = utils::intrusive_list<work_item,
+      utils::double_list_links, &work_item::links_>;
+
+      // The items ready to be executed, in submission order.
+      items_list list_;
+
+      // Wakes one service thread; the thread that takes an item
+      // wakes the next one if more items are available.
+      semaphore semaphore_;
+
+      thread** threads_ = nullptr;
+      std::size_t count_ = 0;
+
+      volatile bool stopping_ = false;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a **work queue** with local service threads.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-work-queue
+     *
+     * @tparam N The number of service threads.
+     * @tparam S The size of each service thread stack, in bytes.
+     */
+    template<std::size_t N = 1,
+        std::size_t S = port::stack::default_size_bytes>
+      class work_queue_inclusive : public work_queue
+      {
+      public:
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t threads_count = N;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t stack_size_bytes = S;
+
+        static_assert(N > 0, "The queue must have at least one thread.");
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a named work queue object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] prio Priority of the service threads.
+         */
+        work_queue_inclusive (const char* name = nullptr,
+                              thread::priority_t prio = default_priority);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        work_queue_inclusive (const work_queue_inclusive&) = delete;
+        work_queue_inclusive (work_queue_inclusive&&) = delete;
+        work_queue_inclusive&
+        operator= (const work_queue_inclusive&) = delete;
+        work_queue_inclusive&
+        operator= (work_queue_inclusive&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the work queue object instance.
+         * @details
+         * The items already queued are executed, then the service
+         * threads are stopped.
+         */
+        ~work_queue_inclusive ();
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        using service_type = thread_inclusive<S>;
+
+        thread* threads_pointers_[N];
+
+        typename std::aligned_storage<sizeof(service_type),
+            alignof(service_type)>::type threads_storage_[N];
+
+        /**
+         * @endcond
+         */
+
+      };
+
+#pragma GCC diagnostic pop
+
+  // --------------------------------------------------------------------------
+  } /* namespace rtos */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+    inline
+    work_item::work_item (func_t function, func_args_t args) :
+        func_ (function), //
+        func_args_ (args)
+    {
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline bool
+    work_item::pending (void) const
+    {
+      return queue_ != nullptr;
+    }
+
+    // ========================================================================
+
+    inline
+    work_queue::work_queue (const char* name) :
+        object_named
+          { name }, //
+        semaphore_
+          { name }
+    {
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    work_queue::threads (void) const
+    {
+      return count_;
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * The service threads are created and started, and wait
+     * for work items.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t N, std::size_t S>
+      work_queue_inclusive<N, S>::work_queue_inclusive (
+          const char* name, thread::priority_t prio) :
+          work_queue
+            { name }
+      {
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+        internal::trace_printf ("%s() @%p %s\n", __func__, this,
+                                this->name ());
+#endif
+
+        internal_construct_ (threads_pointers_, N);
+
+        thread::attributes attr;
+        attr.th_priority = prio;
+
+        for (std::size_t i = 0; i < N; ++i)
+          {
+            threads_pointers_[i] = new (&threads_storage_[i]) service_type
+              { name, internal_service_, this, attr };
+          }
+      }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t N, std::size_t S>
+      work_queue_inclusive<N, S>::~work_queue_inclusive ()
+      {
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+        internal::trace_printf ("%s() @%p %s\n", __func__, this,
+                                this->name ());
+#endif
+
+        internal_stop_ ();
+
+        for (std::size_t i = 0; i < N; ++i)
+          {
+            static_cast<service_type*> (threads_pointers_[i])->~service_type ();
+          }
+      }
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace rtos */
+} /* namespace os */
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+// ----------------------------------------------------------------------------
+
+#endif /* CMSIS_PLUS_RTOS_OS_WORK_QUEUE_H_ */
@@ -84,10 +84,14 @@
 #include <cmsis-plus/rtos/os-timer.h>
 #include <cmsis-plus/rtos/os-mutex.h>
 #include <cmsis-plus/rtos/os-condvar.h>
+#include <cmsis-plus/rtos/os-rwlock.h>
 #include <cmsis-plus/rtos/os-semaphore.h>
 #include <cmsis-plus/rtos/os-mempool.h>
 #include <cmsis-plus/rtos/os-mqueue.h>
 #include <cmsis-plus/rtos/os-evflags.h>
+#include <cmsis-plus/rtos/os-channel.h>
+#include <cmsis-plus/rtos/os-thread-pool.h>
+#include <cmsis-plus/rtos/os-work-queue.h>
 
 #include <cmsis-plus/rtos/os-hooks.h>
 
@@ -0,0 +1,421 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+# This file is part of the µOS++ distribution.
+#   (https://github.com/micro-os-plus)
+# Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+#
+# Permission to use, copy, modify, and/or distribute this software
+# for any purpose is hereby granted, under the terms of the MIT license.
+#
+# If a copy of the license was not distributed with this file, it can
+# be obtained from https://opensource.org/licenses/mit/.
+# -----------------------------------------------------------------------------
+
+"""
+Decode the binary trace events ring (see <cmsis-plus/diag/trace-events.h>).
+
+The input is either a raw dump of the `os_trace_events` object, for
+example obtained with GDB:
+
+    (gdb) dump binary value trace.bin os_trace_events
+
+or the text written by `os::trace::events::dump()` to the trace channel
+(semihosting, SWO, or the standard output of the native platform),
+possibly mixed with other output; the last dump is used.
+
+The ELF file of the application is used to read the format strings, the
+strings passed as `%s` arguments, and the symbols of the threads,
+objects and functions recorded by the scheduler events.
+
+With `--chrome`, the output is a Chrome JSON trace, which can be opened
+in Perfetto (https://ui.perfetto.dev) or chrome://tracing, showing the
+threads and the interrupt handlers on a timeline.
+
+Usage:
+
+    trace-events-decode.py [--chrome] trace.bin [app.elf]
+"""
+
+import argparse
+import json
+import re
+import shutil
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x56455254
+USER_ID_MAX = 0x10000
+MAX_ARGS = 4
+
+# Scheduler events, as defined in <cmsis-plus/diag/trace-events.h>.
+THREAD_SWITCH = 1
+THREAD_RESUME = 2
+THREAD_BLOCK = 3
+TIMEOUT_EXPIRED = 4
+ISR_ENTER = 5
+ISR_EXIT = 6
+
+# os::rtos::internal::wait_reason.
+WAIT_REASONS = ['none', 'semaphore', 'mutex', 'condition_variable',
+                'event_flags', 'memory_pool', 'message_queue', 'rwlock',
+                'thread_join', 'thread_flags', 'sleep', 'timeout', 'interrupt']
+
+# os::rtos::thread::state.
+THREAD_STATES = ['undefined', 'ready', 'running', 'suspended', 'terminated',
+                 'destroyed', 'initializing']
+
+# A C printf conversion; the groups are: flags, width, precision,
+# length modifier and conversion.
+CONVERSION = re.compile(
+    r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|L|j|z|t)?([diouxXcspnfFeEgGaA%])')
+
+
+class Elf:
+    """Minimal reader for the allocated sections of an ELF file."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError(f'{path}: not an ELF file')
+
+        is64 = self.data[4] == 2
+        endian = '<' if self.data[5] == 1 else '>'
+        machine, = struct.unpack_from(endian + 'H', self.data, 0x12)
+        # On ARM, the function symbols have the Thumb bit set.
+        thumb = ~1 if machine == 40 else ~0
+
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 0x3A)
+            section = endian + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 0x2E)
+            section = endian + 'IIIIIIIIII'
+
+        SHT_SYMTAB = 2
+        SHT_NOBITS = 8
+        SHF_ALLOC = 2
+
+        headers = [struct.unpack_from(section, self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+
+        self.sections = []
+        for (_, sh_type, sh_flags, sh_addr, sh_offset, sh_size,
+             *_) in headers:
+            if (sh_flags & SHF_ALLOC) and sh_type != SHT_NOBITS and sh_size:
+                self.sections.append((sh_addr, sh_offset, sh_size))
+
+        # Sized functions and objects, sorted by address.
+        self.symbols = []
+        for (_, sh_type, _, _, sh_offset, sh_size, sh_link, _, _,
+             sh_entsize) in headers:
+            if sh_type != SHT_SYMTAB:
+                continue
+            strtab = headers[sh_link][4]
+            for i in range(sh_size // sh_entsize):
+                if is64:
+                    (st_name, st_info, _, _, st_value,
+                     st_size) = struct.unpack_from(endian + 'IBBHQQ', self.data,
+                                                   sh_offset + i * sh_entsize)
+                else:
+                    (st_name, st_value, st_size, st_info, _,
+                     _) = struct.unpack_from(endian + 'IIIBBH', self.data,
+                                             sh_offset + i * sh_entsize)
+                # STT_OBJECT or STT_FUNC.
+                if (st_info & 0xF) in (1, 2) and st_size:
+                    end = self.data.find(b'\0', strtab + st_name)
+                    name = self.data[strtab + st_name:end].decode()
+                    self.symbols.append((st_value & thumb, st_size, name))
+        self.symbols.sort()
+        self.demangled = {}
+
+    def symbol(self, address):
+        """Return `name+offset` for the given address, or None."""
+        lo, hi = 0, len(self.symbols)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self.symbols[mid][0] <= address:
+                lo = mid + 1
+            else:
+                hi = mid
+        if lo == 0:
+            return None
+        value, size, name = self.symbols[lo - 1]
+        if address >= value + size:
+            return None
+        name = self.demangle(name)
+        return name if address == value else f'{name}+{address - value}'
+
+    def demangle(self, name):
+        if name not in self.demangled:
+            demangled = name
+            if name.startswith('_Z') and shutil.which('c++filt'):
+                demangled = subprocess.run(
+                    ['c++filt', '-p', name], capture_output=True,
+                    text=True).stdout.strip() or name
+            self.demangled[name] = demangled
+        return self.demangled[name]
+
+    def string(self, address):
+        """Return the string at the given address, or None."""
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                begin = offset + address - addr
+                end = self.data.find(b'\0', begin, offset + size)
+                if end < 0:
+                    return None
+                return self.data[begin:end].decode('utf-8', 'replace')
+        return None
+
+
+class Ring:
+    """The ring header and the complete records, in write order."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+
+        if not data.startswith(struct.pack('<I', MAGIC)) and \
+                not data.startswith(struct.pack('>I', MAGIC)):
+            data = self.from_text(data)
+
+        for endian in ('<', '>'):
+            (magic, version, record_bytes, arg_bytes, records, frequency_hz,
+             next_index) = struct.unpack_from(endian + 'IHBBIII', data, 0)
+            if magic == MAGIC:
+                break
+        else:
+            raise ValueError(f'{path}: not a trace events dump')
+
+        if version != 2:
+            raise ValueError(f'{path}: unsupported version {version}')
+
+        self.arg_bytes = arg_bytes
+        self.frequency_hz = frequency_hz
+        self.next = next_index
+
+        word = 'I' if arg_bytes == 4 else 'Q'
+        record = struct.Struct(endian + 'II' + word * (2 + MAX_ARGS))
+
+        # The records are aligned to the size of the arguments.
+        header_bytes = 20
+        align = max(4, arg_bytes)
+        offset = (header_bytes + align - 1) // align * align
+
+        self.records = []
+        for i in range(records):
+            sequence, timestamp, rid, thread, *args = record.unpack_from(
+                data, offset + i * record_bytes)
+            # Records being written when the dump was taken are 0.
+            if sequence != 0:
+                self.records.append((sequence, timestamp, rid, thread, args))
+
+        self.records.sort(key=lambda r: r[0])
+
+
+    @staticmethod
+    def from_text(data):
+        """Extract the last complete dump from the trace output."""
+        dump = None
+        lines = None
+        for line in data.decode('ascii', 'replace').splitlines():
+            line = line.strip()
+            if line.endswith('TREV-BEGIN'):
+                lines = []
+            elif line.endswith('TREV-END') and lines is not None:
+                dump = lines
+                lines = None
+            elif lines is not None and 'TREV ' in line:
+                lines.append(line.split('TREV ', 1)[1])
+        if dump is None:
+            raise ValueError('no complete TREV-BEGIN/TREV-END dump found')
+        return bytes.fromhex(''.join(dump))
+
+
+def signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def format_event(fmt, args, arg_bits, elf):
+    """Format the arguments like the target printf() would."""
+    values = iter(args)
+    missing = object()
+
+    def replace(m):
+        flags, width, precision, length, conv = m.groups()
+        if conv == '%':
+            return '%'
+        # The '*' arguments are not stored.
+        width = '' if width in (None, '*') else width
+        precision = '' if precision in (None, '*') else '.' + precision
+        spec = '%' + flags + width + precision
+
+        value = next(values, missing)
+        if value is missing:
+            return m.group(0)
+
+        # The int values are sign extended to the argument size.
+        bits = arg_bits if length in ('l', 'll', 'j', 'z', 't') else 32
+        if conv in 'di':
+            return (spec + 'd') % signed(value, bits)
+        if conv in 'ouxX':
+            return (spec + conv) % (value & ((1 << bits) - 1))
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'p':
+            return '0x%x' % value
+        if conv == 's':
+            s = elf.string(value) if elf else None
+            return (spec + 's') % (s if s is not None else '<0x%x>' % value)
+        if conv in 'fFeEgGaA':
+            f, = struct.unpack('<f', struct.pack('<I', value & 0xFFFFFFFF))
+            conv = 'f' if conv in 'aA' else conv
+            return (spec + conv) % f
+        return m.group(0)
+
+    return CONVERSION.sub(replace, fmt)
+
+
+def name_of(address, elf):
+    """Symbol of a static object or function, or the address."""
+    name = elf.symbol(address) if elf else None
+    return name if name else f'0x{address:x}'
+
+
+def reason_of(reason, obj, elf):
+    """Kind of the object, followed by its name, if any."""
+    text = WAIT_REASONS[reason] if reason < len(WAIT_REASONS) else str(reason)
+    if obj:
+        text += f' {name_of(obj, elf)}'
+    return text
+
+
+def describe(rid, args, elf):
+    """Text of the scheduler events."""
+    if rid == THREAD_SWITCH:
+        state = args[2]
+        state = THREAD_STATES[state] if state < len(THREAD_STATES) else state
+        return (f'switch {name_of(args[0], elf)} ({state}) -> '
+                f'{name_of(args[1], elf)}')
+    if rid == THREAD_RESUME:
+        return (f'resume {name_of(args[0], elf)} by '
+                f'{reason_of(args[2], args[1], elf)}')
+    if rid == THREAD_BLOCK:
+        text = (f'block {name_of(args[0], elf)} on '
+                f'{reason_of(args[2], args[1], elf)}')
+        if args[3]:
+            text += f' until {args[3]}'
+        return text
+    if rid == TIMEOUT_EXPIRED:
+        return f'timeout {name_of(args[0], elf)}'
+    if rid == ISR_ENTER:
+        return f'isr enter {name_of(args[0], elf)}'
+    if rid == ISR_EXIT:
+        return f'isr exit {name_of(args[0], elf)}'
+    return f'event {rid} ' + ' '.join(f'0x{a:x}' for a in args)
+
+
+def text_of(rid, args, arg_bits, elf):
+    fmt = None
+    if rid >= USER_ID_MAX and elf:
+        fmt = elf.string(rid)
+
+    if fmt is not None:
+        return format_event(fmt, args, arg_bits, elf).rstrip('\n')
+    if rid < USER_ID_MAX:
+        return describe(rid, args, elf)
+    return f'format 0x{rid:x} ' + ' '.join(f'0x{a:x}' for a in args)
+
+
+def chrome_trace(ring, elf, micros):
+    """
+    Convert to the Chrome JSON trace format; the thread run intervals
+    and the interrupt handlers are slices, the other events instants.
+    """
+    events = []
+    tids = {}
+
+    def tid(thread):
+        if thread not in tids:
+            tids[thread] = len(tids) + 1
+            name = name_of(thread, elf) if thread else 'handlers'
+            events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1,
+                           'tid': tids[thread], 'args': {'name': name}})
+        return tids[thread]
+
+    arg_bits = ring.arg_bytes * 8
+    running = None
+    since = 0
+    for sequence, timestamp, rid, thread, args in ring.records:
+        ts = micros(timestamp)
+        if rid == THREAD_SWITCH:
+            if running is not None:
+                events.append({'ph': 'X', 'name': 'running', 'pid': 1,
+                               'tid': tid(running), 'ts': since,
+                               'dur': ts - since})
+            running, since = args[1], ts
+        elif rid in (ISR_ENTER, ISR_EXIT):
+            events.append({'ph': 'B' if rid == ISR_ENTER else 'E',
+                           'name': name_of(args[0], elf), 'pid': 1,
+                           'tid': tid(0), 'ts': ts})
+        else:
+            events.append({'ph': 'i', 's': 't', 'pid': 1, 'tid': tid(thread),
+                           'ts': ts, 'name': text_of(rid, args, arg_bits, elf),
+                           'args': {'sequence': sequence}})
+
+    return {'traceEvents': events, 'displayTimeUnit': 'ns'}
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description='Decode the µOS++ binary trace events.')
+    parser.add_argument('--chrome', action='store_true',
+                        help='output a Chrome JSON trace, for Perfetto')
+    parser.add_argument('dump', help='binary or text dump of the ring')
+    parser.add_argument('elf', nargs='?', help='application ELF file')
+    args = parser.parse_args(argv[1:])
+
+    ring = Ring(args.dump)
+    elf = Elf(args.elf) if args.elf else None
+    arg_bits = ring.arg_bytes * 8
+
+    first = ring.records[0][1] if ring.records else 0
+    elapsed = 0
+    previous = first
+
+    def micros(timestamp):
+        # The time stamps are 32-bit, with wrap around; accumulate
+        # the differences, assuming the records are not too sparse.
+        nonlocal elapsed, previous
+        elapsed += (timestamp - previous) & 0xFFFFFFFF
+        previous = timestamp
+        if ring.frequency_hz:
+            return elapsed * 1000000 / ring.frequency_hz
+        return elapsed
+
+    if args.chrome:
+        json.dump(chrome_trace(ring, elf, micros), sys.stdout)
+        return 0
+
+    unit = 'us' if ring.frequency_hz else 'cy'
+    print(f'# {len(ring.records)} records, {ring.next} written, '
+          f'clock {ring.frequency_hz} Hz')
+
+    for sequence, timestamp, rid, thread, args in ring.records:
+        when = f'{micros(timestamp):12.3f} {unit}'
+
+        # No thread in handlers and before the scheduler is started.
+        context = name_of(thread, elf) if thread else '-'
+
+        text = text_of(rid, args, arg_bits, elf)
+        print(f'{sequence:8d} {when} {context:>10} {text}')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,331 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wempty-translation-unit"
+#endif
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#if defined(OS_USE_TRACE_EVENTS)
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace-events.h>
+
+#include <cstring>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#elif defined(__GNUC__)
+// The arguments types have different sizes on different platforms.
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+
+// ----------------------------------------------------------------------------
+
+using namespace os::trace::events;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#pragma clang diagnostic ignored "-Wmissing-field-initializers"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+
+// Statically initialised, so records can be written even before
+// the static constructors run.
+ring_t os_trace_events
+  { magic, version, sizeof(record_t), sizeof(arg_t),
+  OS_INTEGER_TRACE_EVENTS_RECORDS, 0, { 0 } };
+
+#pragma GCC diagnostic pop
+
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+    "The trace ring requires lock free 32-bit atomics.");
+#endif
+
+namespace os
+{
+  namespace trace
+  {
+    namespace events
+    {
+      // ----------------------------------------------------------------------
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        // Reserve a slot and fill in the common fields. The
+        // sequence is left 0 until the record is complete.
+        uint32_t
+        reserve_ (id_t id)
+        {
+          ring_t& r = os_trace_events;
+
+          if (r.frequency_hz == 0)
+            {
+              r.frequency_hz = rtos::hrclock.input_clock_frequency_hz ();
+            }
+
+          uint32_t index = r.next.fetch_add (1, std::memory_order_relaxed);
+          record_t& rec = r.buffer[index % OS_INTEGER_TRACE_EVENTS_RECORDS];
+
+          rec.sequence.store (0, std::memory_order_relaxed);
+          std::atomic_signal_fence (std::memory_order_release);
+
+          rec.timestamp = static_cast<uint32_t> (rtos::hrclock.now ());
+          rec.id = id;
+
+          rtos::thread* th = nullptr;
+          if (rtos::scheduler::started ()
+              && !rtos::interrupts::in_handler_mode ())
+            {
+              th = rtos::this_thread::_thread ();
+            }
+          rec.thread = reinterpret_cast<uintptr_t> (th);
+
+          return index;
+        }
+
+        // Store the arguments and publish the record.
+        void
+        commit_ (uint32_t index, const arg_t* args)
+        {
+          record_t& rec = os_trace_events.buffer[index
+              % OS_INTEGER_TRACE_EVENTS_RECORDS];
+
+          std::memcpy (rec.args, args, sizeof(rec.args));
+
+          // The sequence is never 0 for complete records.
+          uint32_t sequence = index + 1;
+          rec.sequence.store (sequence == 0 ? 1 : sequence,
+                              std::memory_order_release);
+        }
+      } /* namespace */
+
+      /**
+       * @endcond
+       */
+
+      void
+      record (id_t id, arg_t a0, arg_t a1, arg_t a2, arg_t a3)
+      {
+        arg_t args[max_args]
+          { a0, a1, a2, a3 };
+
+        commit_ (reserve_ (id), args);
+      }
+
+      /**
+       * @details
+       * Only the arguments are extracted, based on the conversions
+       * in the format string; the string itself is not copied.
+       * The `*` width and precision arguments are consumed
+       * but not stored, and the arguments after the fourth one
+       * are ignored.
+       */
+      void
+      vrecord (const char* format, std::va_list args)
+      {
+        uint32_t index = reserve_ (reinterpret_cast<id_t> (format));
+
+        arg_t values[max_args]
+          { 0, 0, 0, 0 };
+        std::size_t count = 0;
+
+        for (const char* p = format; *p != '\0'; ++p)
+          {
+            if (*p != '%')
+              {
+                continue;
+              }
+            ++p;
+            if (*p == '%')
+              {
+                continue;
+              }
+
+            // Flags.
+            while (*p != '\0' && std::strchr ("-+ #0", *p) != nullptr)
+              {
+                ++p;
+              }
+            // Width and precision.
+            while ((*p >= '0' && *p <= '9') || *p == '.' || *p == '*')
+              {
+                if (*p == '*')
+                  {
+                    (void) va_arg(args, int);
+                  }
+                ++p;
+              }
+
+            // Length modifiers.
+            int longs = 0;
+            bool size = false;
+            while (*p != '\0' && std::strchr ("hlLjzt", *p) != nullptr)
+              {
+                if (*p == 'l' || *p == 'j' || *p == 'L')
+                  {
+                    ++longs;
+                  }
+                else if (*p == 'z' || *p == 't')
+                  {
+                    size = true;
+                  }
+                ++p;
+              }
+
+            arg_t value;
+            switch (*p)
+              {
+              case '\0':
+                // Truncated format.
+                --p;
+                continue;
+
+              case 'p':
+              case 's':
+              case 'n':
+                value = reinterpret_cast<arg_t> (va_arg(args, void*));
+                break;
+
+              case 'f':
+              case 'F':
+              case 'e':
+              case 'E':
+              case 'g':
+              case 'G':
+              case 'a':
+              case 'A':
+                {
+                  float f;
+                  if (longs > 0)
+                    {
+                      f = static_cast<float> (va_arg(args, long double));
+                    }
+                  else
+                    {
+                      f = static_cast<float> (va_arg(args, double));
+                    }
+                  uint32_t u;
+                  std::memcpy (&u, &f, sizeof(u));
+                  value = u;
+                }
+                break;
+
+              default:
+                if (longs > 1)
+                  {
+                    value = static_cast<arg_t> (va_arg(args, long long));
+                  }
+                else if (longs == 1)
+                  {
+                    value = static_cast<arg_t> (va_arg(args, long));
+                  }
+                else if (size)
+                  {
+                    value = static_cast<arg_t> (va_arg(args, std::size_t));
+                  }
+                else
+                  {
+                    value = static_cast<arg_t> (va_arg(args, int));
+                  }
+                break;
+              }
+
+            if (count < max_args)
+              {
+                values[count++] = value;
+              }
+          }
+
+        commit_ (index, values);
+      }
+
+      void
+      clear (void)
+      {
+        ring_t& r = os_trace_events;
+
+        for (auto& rec : r.buffer)
+          {
+            rec.sequence.store (0, std::memory_order_relaxed);
+          }
+        r.next.store (0, std::memory_order_release);
+      }
+
+      ring_t&
+      ring (void)
+      {
+        return os_trace_events;
+      }
+
+      /**
+       * @details
+       * Each line has the `TREV ` prefix and up to 32 bytes, in hex.
+       */
+      void
+      dump (void)
+      {
+#if defined(TRACE)
+        static const char hex[] = "0123456789abcdef";
+
+        const uint8_t* p = reinterpret_cast<const uint8_t*> (&os_trace_events);
+        std::size_t bytes = sizeof(os_trace_events);
+
+        trace::write ("TREV-BEGIN\n", 11);
+
+        char line[5 + 2 * 32 + 1];
+        std::memcpy (line, "TREV ", 5);
+        while (bytes > 0)
+          {
+            std::size_t n = bytes < 32 ? bytes : 32;
+            char* q = line + 5;
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                *q++ = hex[p[i] >> 4];
+                *q++ = hex[p[i] & 0xF];
+              }
+            *q++ = '\n';
+            trace::write (line, static_cast<std::size_t> (q - line));
+
+            p += n;
+            bytes -= n;
+          }
+
+        trace::write ("TREV-END\n", 9);
+        trace::flush ();
+#endif /* defined(TRACE) */
+      }
+
+    // ------------------------------------------------------------------------
+    } /* namespace events */
+  } /* namespace trace */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
+
+#endif /* defined(OS_USE_TRACE_EVENTS) */
+
+// ----------------------------------------------------------------------------
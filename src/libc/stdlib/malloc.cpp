@@ -72,7 +72,8 @@ using namespace os;
  * null pointer and set `errno` to indicate the error.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. With `OS_USE_RTOS_THREAD_ALLOCATION_CACHE`,
+ * small blocks are served from a per thread cache, without locking.
  *
  * @par POSIX compatibility
  *  Inspired by [`malloc()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/malloc.html)
@@ -86,6 +87,22 @@ malloc (size_t bytes)
   assert(!rtos::interrupts::in_handler_mode ());
 
   void* mem;
+
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+  errno = 0;
+  mem = rtos::memory::allocation_cache::allocate (bytes);
+  if (mem == nullptr)
+    {
+      errno = ENOMEM;
+    }
+
+#if defined(OS_TRACE_LIBC_MALLOC)
+  trace::printf ("::%s(%d)=%p\n", __func__, bytes, mem);
+#endif
+
+#else
+
     {
       // ----- Begin of critical section --------------------------------------
       rtos::scheduler::critical_section scs;
@@ -103,6 +120,8 @@ malloc (size_t bytes)
       // ----- End of critical section ----------------------------------------
     }
 
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
   return mem;
 }
 
@@ -139,7 +158,8 @@ malloc (size_t bytes)
  * to indicate the error.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. With `OS_USE_RTOS_THREAD_ALLOCATION_CACHE`,
+ * small blocks are served from a per thread cache, without locking.
  *
  * @par POSIX compatibility
  *  Inspired by [`calloc()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/calloc.html)
@@ -159,6 +179,17 @@ calloc (size_t nelem, size_t elbytes)
     }
 
   void* mem;
+
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+  mem = rtos::memory::allocation_cache::allocate (nelem * elbytes);
+
+#if defined(OS_TRACE_LIBC_MALLOC)
+  trace::printf ("::%s(%u,%u)=%p\n", __func__, nelem, elbytes, mem);
+#endif
+
+#else
+
     {
       // ----- Begin of critical section --------------------------------------
       rtos::scheduler::critical_section scs;
@@ -171,6 +202,8 @@ calloc (size_t nelem, size_t elbytes)
       // ----- End of critical section ----------------------------------------
     }
 
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
   if (mem != nullptr)
     {
       memset (mem, 0, nelem * elbytes);
@@ -238,7 +271,8 @@ calloc (size_t nelem, size_t elbytes)
  * the memory referenced by _ptr_ shall not be changed.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. With `OS_USE_RTOS_THREAD_ALLOCATION_CACHE`,
+ * small blocks are served from a per thread cache, without locking.
  *
  * @par POSIX compatibility
  *  Inspired by [`realloc()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/realloc.html)
@@ -253,6 +287,57 @@ realloc (void* ptr, size_t bytes)
 
   void* mem;
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+  errno = 0;
+  if (ptr == nullptr)
+    {
+      mem = rtos::memory::allocation_cache::allocate (bytes);
+#if defined(OS_TRACE_LIBC_MALLOC)
+      trace::printf ("::%s(%p,%u)=%p\n", __func__, ptr, bytes, mem);
+#endif
+      if (mem == nullptr)
+        {
+          errno = ENOMEM;
+        }
+      return mem;
+    }
+
+  if (bytes == 0)
+    {
+      rtos::memory::allocation_cache::deallocate (ptr);
+#if defined(OS_TRACE_LIBC_MALLOC)
+      trace::printf ("::%s(%p,%u)=0\n", __func__, ptr, bytes);
+#endif
+      return nullptr;
+    }
+
+  // All blocks know their size; if the new size still fits,
+  // keep the block.
+  std::size_t usable = rtos::memory::allocation_cache::usable_size (ptr);
+  if (bytes <= usable)
+    {
+      return ptr;
+    }
+
+  mem = rtos::memory::allocation_cache::allocate (bytes);
+  if (mem != nullptr)
+    {
+      // The old block is smaller than the new one.
+      memcpy (mem, ptr, usable);
+      rtos::memory::allocation_cache::deallocate (ptr);
+    }
+  else
+    {
+      errno = ENOMEM;
+    }
+
+#if defined(OS_TRACE_LIBC_MALLOC)
+  trace::printf ("::%s(%p,%u)=%p", __func__, ptr, bytes, mem);
+#endif
+
+#else
+
     {
       // ----- Begin of critical section --------------------------------------
       rtos::scheduler::critical_section scs;
@@ -304,6 +389,8 @@ realloc (void* ptr, size_t bytes)
       // ----- End of critical section ----------------------------------------
     }
 
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
   return mem;
 }
 
@@ -329,7 +416,8 @@ realloc (void* ptr, size_t bytes)
  * The `free()` function shall not return a value.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. With `OS_USE_RTOS_THREAD_ALLOCATION_CACHE`,
+ * small blocks are served from a per thread cache, without locking.
  *
  * @par POSIX compatibility
  *  Inspired by [`free()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/free.html)
@@ -347,6 +435,16 @@ free (void* ptr)
       return;
     }
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+#if defined(OS_TRACE_LIBC_MALLOC)
+  trace::printf ("::%s(%p)\n", __func__, ptr);
+#endif
+
+  rtos::memory::allocation_cache::deallocate (ptr);
+
+#else
+
   // ----- Begin of critical section ------------------------------------------
   rtos::scheduler::critical_section scs;
 
@@ -357,6 +455,8 @@ free (void* ptr)
   // Size unknown, pass 0.
   estd::pmr::get_default_resource ()->deallocate (ptr, 0);
   // ----- End of critical section --------------------------------------------
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
 }
 
 /**
@@ -148,6 +148,15 @@ operator new (std::size_t bytes)
       bytes = 1;
     }
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+  while (true)
+    {
+      // Small blocks are served from the thread cache, without locking.
+      void* mem = rtos::memory::allocation_cache::allocate (bytes);
+
+#else
+
   // ----- Begin of critical section ------------------------------------------
   rtos::scheduler::critical_section scs;
 
@@ -155,6 +164,8 @@ operator new (std::size_t bytes)
     {
       void* mem = estd::pmr::get_default_resource ()->allocate (bytes);
 
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
       if (mem != nullptr)
         {
 #if defined(OS_TRACE_LIBCPP_OPERATOR_NEW)
@@ -212,6 +223,15 @@ operator new (std::size_t bytes,
       bytes = 1;
     }
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+  while (true)
+    {
+      // Small blocks are served from the thread cache, without locking.
+      void* mem = rtos::memory::allocation_cache::allocate (bytes);
+
+#else
+
   // ----- Begin of critical section ------------------------------------------
   rtos::scheduler::critical_section scs;
 
@@ -219,6 +239,8 @@ operator new (std::size_t bytes,
     {
       void* mem = estd::pmr::get_default_resource ()->allocate (bytes);
 
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
       if (mem != nullptr)
         {
 #if defined(OS_TRACE_LIBCPP_OPERATOR_NEW)
@@ -327,12 +349,16 @@ operator delete (void* ptr) noexcept
 
   if (ptr)
     {
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+      rtos::memory::allocation_cache::deallocate (ptr);
+#else
       // ----- Begin of critical section --------------------------------------
       rtos::scheduler::critical_section scs;
 
       // The unknown size is passed as 0.
       estd::pmr::get_default_resource ()->deallocate (ptr, 0);
       // ----- End of critical section ----------------------------------------
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
     }
 }
 
@@ -382,11 +408,17 @@ operator delete (void* ptr, std::size_t bytes) noexcept
 
   if (ptr)
     {
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+      // The size is stored in the block header.
+      (void) bytes;
+      rtos::memory::allocation_cache::deallocate (ptr);
+#else
       // ----- Begin of critical section --------------------------------------
       rtos::scheduler::critical_section scs;
 
       estd::pmr::get_default_resource ()->deallocate (ptr, bytes);
       // ----- End of critical section ----------------------------------------
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
     }
 }
 
@@ -423,11 +455,15 @@ operator delete (void* ptr,
 
   if (ptr)
     {
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+      rtos::memory::allocation_cache::deallocate (ptr);
+#else
       // ----- Begin of critical section --------------------------------------
       rtos::scheduler::critical_section scs;
 
       estd::pmr::get_default_resource ()->deallocate (ptr, 0);
       // ----- End of critical section ----------------------------------------
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
     }
 }
 
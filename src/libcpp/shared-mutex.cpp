@@ -0,0 +1,120 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cmsis-plus/estd/shared_mutex>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace estd
+  {
+    // ========================================================================
+
+    void
+    shared_mutex::lock ()
+    {
+      os::rtos::result_t res;
+      res = nrw_.write_lock ();
+      if (res != os::rtos::result::ok)
+        {
+          os::estd::__throw_cmsis_error (static_cast<int> (res),
+                                         "shared_mutex lock failed");
+        }
+    }
+
+    bool
+    shared_mutex::try_lock ()
+    {
+      os::rtos::result_t res;
+      res = nrw_.try_write_lock ();
+      if (res == os::rtos::result::ok)
+        {
+          return true;
+        }
+      else if (res == EWOULDBLOCK)
+        {
+          return false;
+        }
+
+      os::estd::__throw_cmsis_error (static_cast<int> (res),
+                                     "shared_mutex try_lock failed");
+      // return false;
+    }
+
+    void
+    shared_mutex::unlock ()
+    {
+      os::rtos::result_t res;
+      res = nrw_.unlock ();
+      if (res != os::rtos::result::ok)
+        {
+          os::estd::__throw_cmsis_error (static_cast<int> (res),
+                                         "shared_mutex unlock failed");
+        }
+    }
+
+    void
+    shared_mutex::lock_shared ()
+    {
+      os::rtos::result_t res;
+      res = nrw_.read_lock ();
+      if (res != os::rtos::result::ok)
+        {
+          os::estd::__throw_cmsis_error (static_cast<int> (res),
+                                         "shared_mutex lock_shared failed");
+        }
+    }
+
+    bool
+    shared_mutex::try_lock_shared ()
+    {
+      os::rtos::result_t res;
+      res = nrw_.try_read_lock ();
+      if (res == os::rtos::result::ok)
+        {
+          return true;
+        }
+      else if (res == EWOULDBLOCK || res == EAGAIN)
+        {
+          return false;
+        }
+
+      os::estd::__throw_cmsis_error (static_cast<int> (res),
+                                     "shared_mutex try_lock_shared failed");
+      // return false;
+    }
+
+    void
+    shared_mutex::unlock_shared ()
+    {
+      os::rtos::result_t res;
+      res = nrw_.unlock ();
+      if (res != os::rtos::result::ok)
+        {
+          os::estd::__throw_cmsis_error (static_cast<int> (res),
+                                         "shared_mutex unlock_shared failed");
+        }
+    }
+
+  // ==========================================================================
+
+  } /* namespace estd */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
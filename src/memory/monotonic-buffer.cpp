@@ -0,0 +1,255 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/memory/monotonic-buffer.h>
+#include <cmsis-plus/rtos/os.h>
+
+#include <memory>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+    /**
+     * @details
+     * The buffers allocated from upstream are returned to it.
+     */
+    monotonic_buffer::~monotonic_buffer ()
+    {
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+
+      internal_release_ (nullptr, initial_addr_);
+    }
+
+    void*
+    monotonic_buffer::do_allocate (std::size_t bytes, std::size_t alignment)
+    {
+      // Each allocation must return a distinct address.
+      if (bytes == 0)
+        {
+          bytes = 1;
+        }
+
+      for (;;)
+        {
+          void* p = current_;
+          std::size_t space = static_cast<std::size_t> (limit_ - current_);
+
+          // Possibly adjust the last two parameters.
+          if (std::align (alignment, bytes, p, space) != nullptr)
+            {
+              char* next = static_cast<char*> (p) + bytes;
+
+              // Update statistics; the alignment padding is also lost.
+              std::size_t used = static_cast<std::size_t> (next - current_);
+              allocated_bytes_ += used;
+              if (allocated_bytes_ > max_allocated_bytes_)
+                {
+                  max_allocated_bytes_ = allocated_bytes_;
+                }
+              free_bytes_ -= used;
+              ++allocated_chunks_;
+
+              current_ = next;
+
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+              trace::printf ("monotonic_buffer::%s(%u,%u)=%p @%p %s\n",
+                             __func__, bytes, alignment, p, this, name ());
+#endif
+              return p;
+            }
+
+          if (upstream_ != nullptr && internal_grow_ (bytes, alignment))
+            {
+              continue;
+            }
+
+          if (out_of_memory_handler_ == nullptr)
+            {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+              trace::printf ("monotonic_buffer::%s(%u,%u)=0 @%p %s\n",
+                             __func__, bytes, alignment, this, name ());
+#endif
+
+              return nullptr;
+            }
+
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+          trace::printf ("monotonic_buffer::%s(%u,%u) @%p %s out of memory\n",
+                         __func__, bytes, alignment, this, name ());
+#endif
+          out_of_memory_handler_ ();
+
+          // If the handler returned, assume it freed some memory
+          // and try again to allocate.
+        }
+    }
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+
+    /**
+     * @details
+     * The individual blocks are not released; the memory is
+     * reused only after `reset()` or at the end of a `scope`.
+     */
+    void
+    monotonic_buffer::do_deallocate (void* addr, std::size_t bytes,
+                                     std::size_t alignment) noexcept
+    {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("monotonic_buffer::%s(%p,%u,%u) @%p %s\n", __func__, addr,
+                     bytes, alignment, this, name ());
+#endif
+    }
+
+#pragma GCC diagnostic pop
+
+    std::size_t
+    monotonic_buffer::do_max_size (void) const noexcept
+    {
+      if (upstream_ != nullptr)
+        {
+          return upstream_->max_size ();
+        }
+
+      return initial_bytes_;
+    }
+
+    /**
+     * @details
+     * Release all blocks, return the buffers allocated from
+     * upstream and restart from the beginning of the initial buffer.
+     */
+    void
+    monotonic_buffer::do_reset (void) noexcept
+    {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("monotonic_buffer::%s() @%p %s\n", __func__, this,
+                     name ());
+#endif
+
+      internal_release_ (nullptr, initial_addr_);
+
+      next_buffer_bytes_ = rtos::memory::max (initial_bytes_,
+                                              upstream_min_bytes);
+
+      total_bytes_ = initial_bytes_;
+      allocated_bytes_ = 0;
+      max_allocated_bytes_ = 0;
+      free_bytes_ = initial_bytes_;
+      allocated_chunks_ = 0;
+      free_chunks_ = 1;
+    }
+
+    void
+    monotonic_buffer::internal_construct_ (
+        void* addr, std::size_t bytes,
+        rtos::memory::memory_resource* upstream) noexcept
+    {
+      // The initial buffer may be missing, if there is an upstream.
+      assert(addr != nullptr || upstream != nullptr);
+
+      initial_addr_ = static_cast<char*> (addr);
+      initial_bytes_ = (addr != nullptr) ? bytes : 0;
+
+      upstream_ = upstream;
+
+      do_reset ();
+    }
+
+    void
+    monotonic_buffer::internal_release_ (buffer_t* buffer,
+                                         char* current) noexcept
+    {
+      // Return the buffers allocated after the given one.
+      while (buffers_ != buffer)
+        {
+          assert(buffers_ != nullptr);
+
+          buffer_t* b = buffers_;
+          buffers_ = b->next;
+          upstream_->deallocate (b, b->bytes, max_align);
+        }
+
+      current_ = current;
+      if (buffers_ == nullptr)
+        {
+          limit_ = initial_addr_ + initial_bytes_;
+        }
+      else
+        {
+          limit_ = reinterpret_cast<char*> (buffers_) + buffers_->bytes;
+        }
+    }
+
+    /**
+     * @details
+     * The new buffer is at least twice as large as the previous
+     * one, to keep the number of upstream allocations low.
+     * The space left in the previous buffer is not used.
+     */
+    bool
+    monotonic_buffer::internal_grow_ (std::size_t bytes, std::size_t alignment)
+    {
+      std::size_t size = rtos::memory::max (
+          next_buffer_bytes_, sizeof(buffer_t) + bytes + alignment);
+
+      void* p = upstream_->allocate (size, max_align);
+      if (p == nullptr)
+        {
+          return false;
+        }
+
+      buffer_t* b = static_cast<buffer_t*> (p);
+      b->next = buffers_;
+      b->bytes = size;
+      buffers_ = b;
+
+      current_ = static_cast<char*> (p) + sizeof(buffer_t);
+      limit_ = static_cast<char*> (p) + size;
+
+      total_bytes_ += size;
+      free_bytes_ = static_cast<std::size_t> (limit_ - current_);
+
+      if (size <= std::numeric_limits<std::size_t>::max () / 2)
+        {
+          next_buffer_bytes_ = size * 2;
+        }
+
+      return true;
+    }
+
+  // --------------------------------------------------------------------------
+  } /* namespace memory */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
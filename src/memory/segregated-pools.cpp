@@ -0,0 +1,271 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/memory/segregated-pools.h>
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+    segregated_pools::~segregated_pools ()
+    {
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+    }
+
+    /**
+     * @details
+     * Select the first pool with blocks large enough and properly
+     * aligned; if it is exhausted, try the next ones, and, if
+     * none can serve the request, forward it to the upstream
+     * memory resource.
+     */
+    void*
+    segregated_pools::do_allocate (std::size_t bytes, std::size_t alignment)
+    {
+      for (;;)
+        {
+          for (std::size_t i = 0; i < classes_; ++i)
+            {
+              class_pool& cp = pools_[i];
+
+              std::size_t block_size = cp.block_size ();
+              if (block_size < bytes)
+                {
+                  continue;
+                }
+
+              // All blocks share the alignment of the first one.
+              if (((reinterpret_cast<uintptr_t> (cp.pool ()) | block_size)
+                  & (alignment - 1)) != 0)
+                {
+                  continue;
+                }
+
+              void* p = cp.allocate (bytes, alignment);
+              if (p != nullptr)
+                {
+                  // Update statistics.
+                  // What is subtracted from free is added to allocated.
+                  internal_increase_allocated_statistics (block_size);
+
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+                  trace::printf ("segregated_pools::%s(%u,%u)=%p,%u @%p %s\n",
+                                 __func__, bytes, alignment, p, block_size,
+                                 this, name ());
+#endif
+                  return p;
+                }
+            }
+
+          if (upstream_ != nullptr)
+            {
+              void* p = upstream_->allocate (bytes, alignment);
+              if (p != nullptr)
+                {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+                  trace::printf (
+                      "segregated_pools::%s(%u,%u)=%p upstream @%p %s\n",
+                      __func__, bytes, alignment, p, this, name ());
+#endif
+                  return p;
+                }
+            }
+
+          if (out_of_memory_handler_ == nullptr)
+            {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+              trace::printf ("segregated_pools::%s(%u,%u)=0 @%p %s\n",
+                             __func__, bytes, alignment, this, name ());
+#endif
+
+              return nullptr;
+            }
+
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+          trace::printf ("segregated_pools::%s(%u,%u) @%p %s out of memory\n",
+                         __func__, bytes, alignment, this, name ());
+#endif
+          out_of_memory_handler_ ();
+
+          // If the handler returned, assume it freed some memory
+          // and try again to allocate.
+        }
+    }
+
+    /**
+     * @details
+     * The block is returned to the pool whose storage contains it;
+     * otherwise it must have been allocated from the upstream
+     * memory resource.
+     */
+    void
+    segregated_pools::do_deallocate (void* addr, std::size_t bytes,
+                                     std::size_t alignment) noexcept
+    {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("segregated_pools::%s(%p,%u,%u) @%p %s\n", __func__, addr,
+                     bytes, alignment, this, name ());
+#endif
+
+      for (std::size_t i = 0; i < classes_; ++i)
+        {
+          class_pool& cp = pools_[i];
+
+          char* begin = static_cast<char*> (cp.pool ());
+          if ((addr >= begin)
+              && (addr < (begin + cp.capacity () * cp.block_size ())))
+            {
+              cp.deallocate (addr, bytes, alignment);
+
+              // Update statistics.
+              // What is subtracted from allocated is added to free.
+              internal_decrease_allocated_statistics (cp.block_size ());
+              return;
+            }
+        }
+
+      if (upstream_ != nullptr)
+        {
+          upstream_->deallocate (addr, bytes, alignment);
+          return;
+        }
+
+      assert(false);
+    }
+
+    std::size_t
+    segregated_pools::do_max_size (void) const noexcept
+    {
+      std::size_t size = 0;
+      if (classes_ > 0)
+        {
+          size = pools_[classes_ - 1].block_size ();
+        }
+
+      if (upstream_ != nullptr)
+        {
+          size = rtos::memory::max (size, upstream_->max_size ());
+        }
+
+      return size;
+    }
+
+    /**
+     * @details
+     * Only the pools are reset; the upstream memory resource is not
+     * owned by this object.
+     */
+    void
+    segregated_pools::do_reset (void) noexcept
+    {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("segregated_pools::%s() @%p %s\n", __func__, this,
+                     name ());
+#endif
+
+      for (std::size_t i = 0; i < classes_; ++i)
+        {
+          pools_[i].reset ();
+        }
+
+      internal_reset_ ();
+    }
+
+    void
+    segregated_pools::internal_construct_ (
+        class_pool* pools, std::size_t classes,
+        rtos::memory::memory_resource* upstream) noexcept
+    {
+      assert(pools != nullptr);
+      assert(classes > 0);
+
+      pools_ = pools;
+      classes_ = classes;
+      upstream_ = upstream;
+
+      total_bytes_ = 0;
+      for (std::size_t i = 0; i < classes_; ++i)
+        {
+          assert(i == 0 || pools_[i - 1].block_size () < pools_[i].block_size ());
+          total_bytes_ += pools_[i].total_bytes ();
+        }
+
+      internal_reset_ ();
+    }
+
+    void
+    segregated_pools::internal_reset_ (void) noexcept
+    {
+      allocated_bytes_ = 0;
+      max_allocated_bytes_ = 0;
+      free_bytes_ = total_bytes_;
+      allocated_chunks_ = 0;
+
+      free_chunks_ = 0;
+      for (std::size_t i = 0; i < classes_; ++i)
+        {
+          free_chunks_ += pools_[i].capacity ();
+        }
+    }
+
+    /**
+     * @details
+     * For each size class, print the number of blocks currently
+     * allocated, the maximum number of blocks allocated
+     * at the same time and the number of allocations, which
+     * helps tuning the pools.
+     */
+    void
+    segregated_pools::trace_print_classes (void)
+    {
+#if defined(TRACE)
+      trace::printf ("Memory '%s' @%p size classes: \n", name (), this);
+      for (std::size_t i = 0; i < classes_; ++i)
+        {
+          class_pool& cp = pools_[i];
+          trace::printf ("\t%u bytes: %u of %u blocks allocated, max %u, "
+                         "%u allocs\n",
+                         cp.block_size (), cp.allocated_chunks (),
+                         cp.capacity (),
+                         cp.max_allocated_bytes () / cp.block_size (),
+                         cp.allocations ());
+        }
+      if (upstream_ != nullptr)
+        {
+          trace::printf ("\tupstream '%s': %u bytes in %u chunk(s)\n",
+                         upstream_->name (), upstream_->allocated_bytes (),
+                         upstream_->allocated_chunks ());
+        }
+#endif /* defined(TRACE) */
+    }
+
+  // --------------------------------------------------------------------------
+  } /* namespace memory */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
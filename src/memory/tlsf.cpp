@@ -0,0 +1,625 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016-2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/memory/tlsf.h>
+#include <memory>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace memory
+  {
+
+    // ========================================================================
+
+    tlsf::~tlsf ()
+    {
+      trace::printf ("tlsf::%s() @%p %s\n", __func__, this, name ());
+    }
+
+    void
+    tlsf::internal_construct_ (void* addr, std::size_t bytes)
+    {
+      assert(bytes > 2 * block_overhead + block_size_min);
+
+      arena_addr_ = addr;
+      arena_bytes_ = bytes;
+
+      internal_reset_ ();
+    }
+
+    /**
+     * @details
+     * The arena is a single free block, followed by a zero size,
+     * used, sentinel block, which ends the physical links.
+     */
+    void
+    tlsf::internal_reset_ (void) noexcept
+    {
+      fl_bitmap_ = 0;
+      for (std::size_t fl = 0; fl < fl_count; ++fl)
+        {
+          sl_bitmap_[fl] = 0;
+          for (std::size_t sl = 0; sl < sl_count; ++sl)
+            {
+              free_lists_[fl][sl] = nullptr;
+            }
+        }
+
+      // Align the arena, such that the first payload, which starts
+      // after the block overhead, is aligned.
+      void* mem = arena_addr_;
+      std::size_t mem_bytes = arena_bytes_;
+      void* res;
+      res = std::align (block_align, 2 * block_overhead + block_size_min, mem,
+                        mem_bytes);
+      // std::align() will fail if it cannot fit the min block.
+      if (res == nullptr)
+        {
+          assert(res != nullptr);
+        }
+
+      // Leave room for the first and the sentinel size fields.
+      std::size_t pool_bytes = (mem_bytes - 2 * block_overhead)
+          & ~(block_align - 1);
+      if (pool_bytes >= block_size_max)
+        {
+          pool_bytes = block_size_max - block_align;
+        }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+      // The first block prev_phys field may be before the arena,
+      // but it is never used, since there is no previous block.
+      block_t* block = reinterpret_cast<block_t*> (static_cast<char*> (mem)
+          + block_overhead - block_offset);
+#pragma GCC diagnostic pop
+      block->size = pool_bytes | block_free_bit;
+
+      block_t* sentinel = next_block_ (block);
+      sentinel->prev_phys = block;
+      sentinel->size = block_prev_free_bit;
+
+      insert_free_ (block);
+
+      total_bytes_ = pool_bytes + block_overhead;
+      allocated_bytes_ = 0;
+      max_allocated_bytes_ = 0;
+      free_bytes_ = total_bytes_;
+      allocated_chunks_ = 0;
+      free_chunks_ = 1;
+    }
+
+    void
+    tlsf::do_reset (void) noexcept
+    {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("tlsf::%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      internal_reset_ ();
+    }
+
+#pragma GCC diagnostic push
+// Needed because 'alignment' is used only in trace calls.
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+    /**
+     * @details
+     * The request is rounded up to the next second level size,
+     * such that any block in the selected list is large enough;
+     * this is a good fit, not necessarily the best fit.
+     *
+     * If the block is larger, the remaining part is split as
+     * a new free block. All payloads are aligned to `max_align`;
+     * only blocks with larger alignment requirements
+     * are searched with enough extra space to split a leading
+     * free block.
+     *
+     * @par Exceptions
+     *   Throws nothing by itself, but the out of memory handler may
+     *   throw `bad_alloc()`.
+     */
+    void*
+    tlsf::do_allocate (std::size_t bytes, std::size_t alignment)
+    {
+      std::size_t size = rtos::memory::align_size (bytes, block_align);
+      size = rtos::memory::max (size, block_size_min);
+
+      // The minimum leading gap must fit a free block.
+      constexpr std::size_t gap_min = block_size_min + block_overhead;
+
+      std::size_t search_size = size;
+      if (alignment > block_align)
+        {
+          search_size = rtos::memory::align_size (size + alignment + gap_min,
+                                                  block_align);
+        }
+
+      block_t* block;
+
+      while (true)
+        {
+          block = nullptr;
+          if (bytes < block_size_max && search_size < block_size_max)
+            {
+              block = locate_free_ (search_size);
+            }
+
+          if (block != nullptr)
+            {
+              break;
+            }
+
+          if (out_of_memory_handler_ == nullptr)
+            {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+              trace::printf ("tlsf::%s(%u,%u)=0 @%p %s\n", __func__, bytes,
+                             alignment, this, name ());
+#endif
+
+              return nullptr;
+            }
+
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+          trace::printf ("tlsf::%s(%u,%u) @%p %s out of memory\n", __func__,
+                         bytes, alignment, this, name ());
+#endif
+          out_of_memory_handler_ ();
+
+          // If the handler returned, assume it freed some memory
+          // and try again to allocate.
+        }
+
+      if (alignment > block_align)
+        {
+          char* ptr = static_cast<char*> (payload_ (block));
+          char* aligned = reinterpret_cast<char*> (rtos::memory::align_size (
+              reinterpret_cast<std::uintptr_t> (ptr), alignment));
+          std::size_t gap = static_cast<std::size_t> (aligned - ptr);
+
+          // If the gap is too small for a free block, move to the
+          // next aligned address.
+          if (gap != 0 && gap < gap_min)
+            {
+              std::size_t offset = rtos::memory::max (gap_min - gap,
+                                                      alignment);
+              aligned = reinterpret_cast<char*> (rtos::memory::align_size (
+                  reinterpret_cast<std::uintptr_t> (aligned + offset),
+                  alignment));
+              gap = static_cast<std::size_t> (aligned - ptr);
+            }
+
+          if (gap != 0)
+            {
+              block = trim_leading_ (block, gap);
+            }
+        }
+
+      trim_trailing_ (block, size);
+      mark_as_used_ (block);
+
+      // Update statistics.
+      // The value subtracted from free is added to allocated.
+      internal_increase_allocated_statistics (
+          block_size_ (block) + block_overhead);
+
+      void* payload = payload_ (block);
+
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("tlsf::%s(%u,%u)=%p,%u @%p %s\n", __func__, bytes,
+                     alignment, payload, block_size_ (block), this, name ());
+#endif
+
+      assert((reinterpret_cast<uintptr_t> (payload) & (alignment - 1)) == 0);
+
+      return payload;
+    }
+
+    /**
+     * @details
+     * The block is immediately coalesced with the free physical
+     * neighbours and inserted in the free list matching its size,
+     * in constant time.
+     *
+     * If the block is already free, issue a trace message,
+     * but otherwise ignore the condition.
+     *
+     * @par Exceptions
+     *   Throws nothing.
+     */
+    void
+    tlsf::do_deallocate (void* addr, std::size_t bytes,
+                         std::size_t alignment) noexcept
+    {
+#if defined(OS_TRACE_LIBCPP_MEMORY_RESOURCE)
+      trace::printf ("tlsf::%s(%p,%u,%u) @%p %s\n", __func__, addr, bytes,
+                     alignment, this, name ());
+#endif
+
+      // The address must be inside the arena; no exceptions.
+      if ((addr < arena_addr_)
+          || (addr > (static_cast<char*> (arena_addr_) + arena_bytes_)))
+        {
+          assert(false);
+          return;
+        }
+
+      block_t* block = from_payload_ (addr);
+
+      if (block->size & block_free_bit)
+        {
+          trace::printf ("tlsf::%s(%p,%u,%u) @%p %s already freed\n",
+                         __func__, addr, bytes, alignment, this, name ());
+
+          return;
+        }
+
+      if (bytes)
+        {
+          // If size is known, validate.
+          // (when called from free(), the size is not known).
+          if (bytes > block_size_ (block))
+            {
+              assert(false);
+              return;
+            }
+        }
+
+      // Update statistics.
+      // What is subtracted from allocated is added to free.
+      internal_decrease_allocated_statistics (
+          block_size_ (block) + block_overhead);
+
+      mark_as_free_ (block);
+      block = merge_prev_ (block);
+      merge_next_ (block);
+
+      insert_free_ (block);
+    }
+
+#pragma GCC diagnostic pop
+
+    std::size_t
+    tlsf::do_max_size (void) const noexcept
+    {
+      return total_bytes_;
+    }
+
+    // ------------------------------------------------------------------------
+
+    std::size_t
+    tlsf::block_size_ (const block_t* block)
+    {
+      return block->size & ~block_flags;
+    }
+
+    /**
+     * @details
+     * The next block payload starts `block_overhead` bytes after
+     * the end of this payload; the next block header may overlap
+     * the last word of the payload, used only when the block is free.
+     */
+    tlsf::block_t*
+    tlsf::next_block_ (const block_t* block)
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+      return reinterpret_cast<block_t*> (static_cast<char*> (payload_ (block))
+          + (block_size_ (block) + block_overhead) - block_offset);
+#pragma GCC diagnostic pop
+    }
+
+    void*
+    tlsf::payload_ (const block_t* block)
+    {
+      return const_cast<char*> (reinterpret_cast<const char*> (block))
+          + block_offset;
+    }
+
+    tlsf::block_t*
+    tlsf::from_payload_ (const void* ptr)
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+      return reinterpret_cast<block_t*> (const_cast<char*> (static_cast<const char*> (ptr))
+          - block_offset);
+#pragma GCC diagnostic pop
+    }
+
+    void
+    tlsf::mark_as_free_ (block_t* block)
+    {
+      block_t* next = next_block_ (block);
+      next->prev_phys = block;
+      next->size |= block_prev_free_bit;
+      block->size |= block_free_bit;
+    }
+
+    void
+    tlsf::mark_as_used_ (block_t* block)
+    {
+      block_t* next = next_block_ (block);
+      next->size &= ~block_prev_free_bit;
+      block->size &= ~block_free_bit;
+    }
+
+    /**
+     * @details
+     * The first level is the index of the most significant bit,
+     * the second level are the next `sl_count_log2` bits.
+     * Small blocks are all in the first level 0.
+     */
+    void
+    tlsf::mapping_insert_ (std::size_t size, std::size_t& fl, std::size_t& sl)
+    {
+      if (size < small_block_size)
+        {
+          fl = 0;
+          sl = size / (small_block_size / sl_count);
+        }
+      else
+        {
+          std::size_t msb = static_cast<std::size_t> (63
+              - __builtin_clzll (static_cast<unsigned long long> (size)));
+          sl = (size >> (msb - sl_count_log2)) ^ sl_count;
+          fl = msb - (fl_shift - 1);
+        }
+    }
+
+    /**
+     * @details
+     * Round up the size to the next list, such that any block in
+     * it is large enough.
+     */
+    void
+    tlsf::mapping_search_ (std::size_t size, std::size_t& fl, std::size_t& sl)
+    {
+      if (size >= small_block_size)
+        {
+          std::size_t msb = static_cast<std::size_t> (63
+              - __builtin_clzll (static_cast<unsigned long long> (size)));
+          size += (static_cast<std::size_t> (1) << (msb - sl_count_log2)) - 1;
+        }
+      mapping_insert_ (size, fl, sl);
+    }
+
+    /**
+     * @details
+     * First search the lists with larger sizes on the same first
+     * level, then the lists on the next non empty first level.
+     */
+    tlsf::block_t*
+    tlsf::search_suitable_ (std::size_t& fl, std::size_t& sl)
+    {
+      if (fl >= fl_count)
+        {
+          return nullptr;
+        }
+
+      uint32_t sl_map = sl_bitmap_[fl] & (~static_cast<uint32_t> (0) << sl);
+      if (sl_map == 0)
+        {
+          uint32_t fl_map = fl_bitmap_ & (~static_cast<uint32_t> (0) << (fl + 1));
+          if (fl_map == 0)
+            {
+              // No block large enough.
+              return nullptr;
+            }
+
+          fl = static_cast<std::size_t> (__builtin_ctz (fl_map));
+          sl_map = sl_bitmap_[fl];
+        }
+
+      sl = static_cast<std::size_t> (__builtin_ctz (sl_map));
+      return free_lists_[fl][sl];
+    }
+
+    void
+    tlsf::insert_free_ (block_t* block)
+    {
+      std::size_t fl;
+      std::size_t sl;
+      mapping_insert_ (block_size_ (block), fl, sl);
+
+      block_t* current = free_lists_[fl][sl];
+      block->next_free = current;
+      block->prev_free = nullptr;
+      if (current != nullptr)
+        {
+          current->prev_free = block;
+        }
+      free_lists_[fl][sl] = block;
+
+      fl_bitmap_ |= static_cast<uint32_t> (1) << fl;
+      sl_bitmap_[fl] |= static_cast<uint32_t> (1) << sl;
+    }
+
+    void
+    tlsf::remove_free_ (block_t* block)
+    {
+      std::size_t fl;
+      std::size_t sl;
+      mapping_insert_ (block_size_ (block), fl, sl);
+
+      block_t* prev = block->prev_free;
+      block_t* next = block->next_free;
+      if (next != nullptr)
+        {
+          next->prev_free = prev;
+        }
+
+      if (prev != nullptr)
+        {
+          prev->next_free = next;
+        }
+      else
+        {
+          free_lists_[fl][sl] = next;
+          if (next == nullptr)
+            {
+              // The list is empty, clear the bits.
+              sl_bitmap_[fl] &= ~(static_cast<uint32_t> (1) << sl);
+              if (sl_bitmap_[fl] == 0)
+                {
+                  fl_bitmap_ &= ~(static_cast<uint32_t> (1) << fl);
+                }
+            }
+        }
+    }
+
+    /**
+     * @details
+     * Return a free block large enough, removed from the free list
+     * but still marked as free.
+     */
+    tlsf::block_t*
+    tlsf::locate_free_ (std::size_t size)
+    {
+      std::size_t fl;
+      std::size_t sl;
+      mapping_search_ (size, fl, sl);
+
+      block_t* block = search_suitable_ (fl, sl);
+      if (block != nullptr)
+        {
+          remove_free_ (block);
+        }
+      return block;
+    }
+
+    /**
+     * @details
+     * Split the free block such that the first part has the given
+     * size; return the second part, marked as free.
+     */
+    tlsf::block_t*
+    tlsf::split_ (block_t* block, std::size_t size)
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+      block_t* remaining =
+          reinterpret_cast<block_t*> (static_cast<char*> (payload_ (block))
+              + (size + block_overhead) - block_offset);
+#pragma GCC diagnostic pop
+
+      std::size_t remaining_size = block_size_ (block)
+          - (size + block_overhead);
+
+      // The block is free while being split.
+      remaining->prev_phys = block;
+      remaining->size = remaining_size | block_prev_free_bit;
+      block->size = size | (block->size & block_flags);
+
+      mark_as_free_ (remaining);
+
+      return remaining;
+    }
+
+    /**
+     * @details
+     * Add the block to the previous one; the result is the
+     * previous block.
+     */
+    tlsf::block_t*
+    tlsf::absorb_ (block_t* prev, block_t* block)
+    {
+      prev->size += block_size_ (block) + block_overhead;
+      next_block_ (prev)->prev_phys = prev;
+
+      // Coalescing means one less chunk.
+      --free_chunks_;
+
+      return prev;
+    }
+
+    tlsf::block_t*
+    tlsf::merge_prev_ (block_t* block)
+    {
+      if (block->size & block_prev_free_bit)
+        {
+          block_t* prev = block->prev_phys;
+          remove_free_ (prev);
+          block = absorb_ (prev, block);
+        }
+      return block;
+    }
+
+    void
+    tlsf::merge_next_ (block_t* block)
+    {
+      block_t* next = next_block_ (block);
+      if (next->size & block_free_bit)
+        {
+          remove_free_ (next);
+          absorb_ (block, next);
+        }
+    }
+
+    /**
+     * @details
+     * Split a leading free block, such that the payload of the
+     * returned block starts `size` bytes later.
+     */
+    tlsf::block_t*
+    tlsf::trim_leading_ (block_t* block, std::size_t size)
+    {
+      if (block_size_ (block) < size + block_size_min)
+        {
+          return block;
+        }
+
+      block_t* remaining = split_ (block, size - block_overhead);
+      insert_free_ (block);
+
+      // Splitting one block creates one more chunk.
+      ++free_chunks_;
+
+      return remaining;
+    }
+
+    /**
+     * @details
+     * If the block is larger, split the trailing part as
+     * a new free block.
+     */
+    void
+    tlsf::trim_trailing_ (block_t* block, std::size_t size)
+    {
+      if (block_size_ (block) < size + block_overhead + block_size_min)
+        {
+          return;
+        }
+
+      block_t* remaining = split_ (block, size);
+      insert_free_ (remaining);
+
+      // Splitting one block creates one more chunk.
+      ++free_chunks_;
+    }
+
+  // --------------------------------------------------------------------------
+  } /* namespace memory */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
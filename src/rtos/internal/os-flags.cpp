@@ -109,6 +109,25 @@ namespace os
         return false;
       }
 
+      /**
+       * @details
+       * Used by the objects that keep waiting threads, to select the
+       * threads whose condition is satisfied; should be called from
+       * inside a critical section.
+       */
+      bool
+      event_flags::is_raised (flags::mask_t mask, flags::mode_t mode) const
+      {
+        if (mask == flags::any)
+          {
+            return (flags_mask_ != 0);
+          }
+
+        return ((((mode & flags::mode::all) != 0)
+            && ((flags_mask_ & mask) == mask))
+            || (((mode & flags::mode::any) != 0) && ((flags_mask_ & mask) != 0)));
+      }
+
       flags::mask_t
       event_flags::get (flags::mask_t mask, flags::mode_t mode)
       {
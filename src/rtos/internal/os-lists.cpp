@@ -16,6 +16,10 @@
 
 #include <cmsis-plus/rtos/os.h>
 
+#if defined(OS_USE_TRACE_EVENTS)
+#include <cmsis-plus/diag/trace-events.h>
+#endif
+
 #include <cmsis-plus/diag/trace.h>
 
 // ----------------------------------------------------------------------------
@@ -44,6 +48,8 @@ namespace os
 
       // ======================================================================
 
+#if !defined(OS_USE_RTOS_READY_THREADS_BITMAP)
+
       void
       ready_threads_list::link (waiting_thread_node& node)
       {
@@ -62,15 +68,15 @@ namespace os
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() empty +%u\n", __func__, prio);
+            internal::trace_printf ("ready %s() empty +%u\n", __func__, prio);
 #endif
           }
         else if (prio <= after->thread_->priority ())
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() back %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            internal::trace_printf ("ready %s() back %u +%u \n", __func__,
+                                    after->thread_->priority (), prio);
 #endif
           }
         else if (prio > head ()->thread_->priority ())
@@ -86,8 +92,8 @@ namespace os
 #pragma GCC diagnostic pop
 
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() front +%u %u \n", __func__, prio,
-                           head ()->thread_->priority ());
+            internal::trace_printf ("ready %s() front +%u %u \n", __func__,
+                                    prio, head ()->thread_->priority ());
 #endif
           }
         else
@@ -108,8 +114,8 @@ namespace os
 #pragma GCC diagnostic pop
 
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() middle %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            internal::trace_printf ("ready %s() middle %u +%u \n", __func__,
+                                    after->thread_->priority (), prio);
 #endif
           }
 
@@ -130,7 +136,8 @@ namespace os
         thread* th = head ()->thread_;
 
 #if defined(OS_TRACE_RTOS_LISTS)
-        trace::printf ("ready %s() %p %s\n", __func__, th, th->name ());
+        internal::trace_printf ("ready %s() %p %s\n", __func__, th,
+                                th->name ());
 #endif
 
         const_cast<waiting_thread_node*> (head ())->unlink ();
@@ -145,6 +152,162 @@ namespace os
         return th;
       }
 
+#else
+
+      /**
+       * @class ready_threads_list
+       * @details
+       * Instead of a single list ordered by priorities, which requires
+       * a partial list traversal for each insert, this variant keeps
+       * a separate FIFO list for each priority level and a bitmap
+       * with the non empty levels.
+       *
+       * Both inserting a node and retrieving the top priority node
+       * are constant time operations, regardless of the number of
+       * ready threads; the price is the RAM used by the
+       * lists heads (two pointers for each priority level).
+       *
+       * The FIFO order for threads with the same priority is
+       * preserved, so scheduling is identical to the default list.
+       *
+       * To be usable before the static constructors run, the object
+       * must be BSS initialised; a zero bitmap means all lists
+       * are empty, and the lists are initialised when first used.
+       */
+
+      static_assert(ready_threads_list::levels == (16u << thread::priority::range),
+          "adjust ready_threads_list::levels");
+
+      void
+      ready_threads_list::bucket::link (waiting_thread_node& node)
+      {
+        // Add the node at the end of the list, after all threads
+        // with the same priority.
+        insert_after (node,
+                      const_cast<utils::static_double_list_links*> (tail ()));
+      }
+
+      /**
+       * @details
+       * Must be called in a critical section.
+       */
+      void
+      ready_threads_list::link (waiting_thread_node& node)
+      {
+        thread::priority_t prio = node.thread_->priority ();
+
+        std::size_t word = prio / map_bits;
+        map_t mask = static_cast<map_t> (1) << (prio % map_bits);
+
+        if ((map_[word] & mask) == 0)
+          {
+            // The bucket was empty, possibly never used,
+            // initialise it to empty.
+            buckets_[prio].clear ();
+
+            map_[word] |= mask;
+            summary_ |= static_cast<map_t> (1) << word;
+
+#if defined(OS_TRACE_RTOS_LISTS)
+            internal::trace_printf ("ready %s() empty +%u\n", __func__, prio);
+#endif
+          }
+        else
+          {
+#if defined(OS_TRACE_RTOS_LISTS)
+            internal::trace_printf ("ready %s() back +%u \n", __func__, prio);
+#endif
+          }
+
+        buckets_[prio].link (node);
+
+        node.thread_->state_ = thread::state::ready;
+      }
+
+      /**
+       * @details
+       * Must be called in a critical section.
+       */
+      thread*
+      ready_threads_list::unlink_head (void)
+      {
+        assert (!empty ());
+
+        std::size_t level = top_level_ ();
+        bucket& bk = buckets_[level];
+
+        waiting_thread_node* node =
+            const_cast<waiting_thread_node*> (static_cast<volatile waiting_thread_node*> (bk.head ()));
+        thread* th = node->thread_;
+
+#if defined(OS_TRACE_RTOS_LISTS)
+        internal::trace_printf ("ready %s() %p %s\n", __func__, th,
+                                th->name ());
+#endif
+
+        node->unlink ();
+
+        if (bk.empty ())
+          {
+            mark_empty_ (level);
+          }
+
+        assert (th != nullptr);
+
+        // Unlinking is immediately followed by a context switch,
+        // so in order to guarantee that the thread is marked as
+        // running, it is saver to do it here.
+
+        th->state_ = thread::state::running;
+        return th;
+      }
+
+      /**
+       * @details
+       * The node may be linked in any list (for example the
+       * terminated threads list) or not linked at all.
+       *
+       * The priority of the thread may have already been changed,
+       * so the bucket is identified by the node neighbours; if
+       * the node is the only one in one of the buckets, the bucket
+       * is marked as empty.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      ready_threads_list::unlink (waiting_thread_node& node)
+      {
+        utils::static_double_list_links* next = node.next ();
+        if (next != nullptr && next == node.prev ())
+          {
+            std::uintptr_t addr = reinterpret_cast<std::uintptr_t> (next);
+            std::uintptr_t first = reinterpret_cast<std::uintptr_t> (&buckets_[0]);
+            std::uintptr_t last = reinterpret_cast<std::uintptr_t> (&buckets_[levels]);
+
+            if (addr >= first && addr < last)
+              {
+                // The list head is the first member of the bucket.
+                mark_empty_ ((addr - first) / sizeof(bucket));
+              }
+          }
+
+        node.unlink ();
+      }
+
+      void
+      ready_threads_list::mark_empty_ (std::size_t level)
+      {
+        std::size_t word = level / map_bits;
+
+        map_[word] &= ~(static_cast<map_t> (1) << (level % map_bits));
+        if (map_[word] == 0)
+          {
+            summary_ &= ~(static_cast<map_t> (1) << word);
+          }
+      }
+
+#endif /* !defined(OS_USE_RTOS_READY_THREADS_BITMAP) */
+
       // ======================================================================
 
       /**
@@ -201,15 +364,15 @@ namespace os
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() empty +%u\n", __func__, prio);
+            internal::trace_printf ("wait %s() empty +%u\n", __func__, prio);
 #endif
           }
         else if (prio <= after->thread_->priority ())
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() back %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            internal::trace_printf ("wait %s() back %u +%u \n", __func__,
+                                    after->thread_->priority (), prio);
 #endif
           }
         else if (prio > head ()->thread_->priority ())
@@ -225,8 +388,8 @@ namespace os
 #pragma GCC diagnostic pop
 
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() front +%u %u \n", __func__, prio,
-                           head ()->thread_->priority ());
+            internal::trace_printf ("wait %s() front +%u %u \n", __func__,
+                                    prio, head ()->thread_->priority ());
 #endif
           }
         else
@@ -247,8 +410,8 @@ namespace os
 #pragma GCC diagnostic pop
 
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() middle %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            internal::trace_printf ("wait %s() middle %u +%u \n", __func__,
+                                    after->thread_->priority (), prio);
 #endif
           }
 
@@ -261,7 +424,8 @@ namespace os
        * and wake-up the thread.
        */
       bool
-      waiting_threads_list::resume_one (void)
+      waiting_threads_list::resume_one (const void* object,
+                                        wait_reason_t reason)
       {
         thread* th;
           {
@@ -285,12 +449,12 @@ namespace os
         thread::state_t state = th->state ();
         if (state != thread::state::destroyed)
           {
-            th->resume ();
+            th->internal_resume_ (object, reason);
           }
         else
           {
 #if defined(OS_TRACE_RTOS_LISTS)
-            trace::printf ("%s() gone \n", __func__);
+            internal::trace_printf ("%s() gone \n", __func__);
 #endif
           }
 
@@ -298,26 +462,83 @@ namespace os
       }
 
       void
-      waiting_threads_list::resume_all (void)
+      waiting_threads_list::resume_all (const void* object,
+                                        wait_reason_t reason)
       {
-        while (resume_one ())
+        while (resume_one (object, reason))
           ;
       }
 
+      /**
+       * @details
+       * Remove up to _count_ threads from the top of the list and
+       * make them ready in a single critical section, then
+       * reschedule once, instead of once per thread.
+       */
+      std::size_t
+      waiting_threads_list::resume_n (const void* object,
+                                      wait_reason_t reason,
+                                      std::size_t count)
+      {
+#if defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+        std::size_t n;
+        for (n = 0; n < count; ++n)
+          {
+            if (!resume_one (object, reason))
+              {
+                break;
+              }
+          }
+        return n;
+
+#else
+
+        // Don't call this from high priority interrupts.
+        assert (port::interrupts::is_priority_valid ());
+
+        std::size_t n = 0;
+          {
+            // ----- Enter critical section -----------------------------------
+            interrupts::critical_section ics;
+
+            for (; n < count && !empty (); ++n)
+              {
+                thread* th = head ()->thread_;
+                const_cast<waiting_thread_node*> (head ())->unlink ();
+
+                assert (th != nullptr);
+                if (th->state () != thread::state::destroyed)
+                  {
+                    th->internal_make_ready_ (object, reason);
+                  }
+              }
+            // ----- Exit critical section ------------------------------------
+          }
+
+        if (n > 0)
+          {
+            port::scheduler::reschedule ();
+          }
+        return n;
+
+#endif
+      }
+
       // ======================================================================
 
       timestamp_node::timestamp_node (clock::timestamp_t ts) :
           timestamp (ts)
       {
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
-        trace::printf ("%s() %p \n", __func__, this);
+        internal::trace_printf ("%s() %p \n", __func__, this);
 #endif
       }
 
       timestamp_node::~timestamp_node ()
       {
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
-        trace::printf ("%s() %p \n", __func__, this);
+        internal::trace_printf ("%s() %p \n", __func__, this);
 #endif
       }
 
@@ -330,14 +551,14 @@ namespace os
           thread (th)
       {
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
-        trace::printf ("%s() %p \n", __func__, this);
+        internal::trace_printf ("%s() %p \n", __func__, this);
 #endif
       }
 
       timeout_thread_node::~timeout_thread_node ()
       {
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
-        trace::printf ("%s() %p \n", __func__, this);
+        internal::trace_printf ("%s() %p \n", __func__, this);
 #endif
       }
 
@@ -348,10 +569,15 @@ namespace os
         rtos::thread* th = &this->thread;
         this->unlink ();
 
+#if defined(OS_TRACE_EVENTS_TIMEOUT)
+        trace::events::record (trace::events::timeout_expired,
+                               reinterpret_cast<trace::events::arg_t> (th));
+#endif
+
         thread::state_t state = th->state ();
         if (state != thread::state::destroyed)
           {
-            th->resume ();
+            th->internal_resume_ (nullptr, wait_reason::timeout);
           }
       }
 
@@ -365,14 +591,14 @@ namespace os
           tmr (tm)
       {
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
-        trace::printf ("%s() %p \n", __func__, this);
+        internal::trace_printf ("%s() %p \n", __func__, this);
 #endif
       }
 
       timer_node::~timer_node ()
       {
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
-        trace::printf ("%s() %p \n", __func__, this);
+        internal::trace_printf ("%s() %p \n", __func__, this);
 #endif
       }
 
@@ -391,6 +617,38 @@ namespace os
 
       // ======================================================================
 
+      work_node::work_node (clock::timestamp_t ts, work_item& wi) :
+          timestamp_node
+            { ts }, //
+          item (wi)
+      {
+#if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
+        internal::trace_printf ("%s() %p \n", __func__, this);
+#endif
+      }
+
+      work_node::~work_node ()
+      {
+#if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
+        internal::trace_printf ("%s() %p \n", __func__, this);
+#endif
+      }
+
+      /**
+       * @details
+       * Remove the node from the list and queue the work item.
+       */
+      void
+      work_node::action (void)
+      {
+        this->unlink ();
+        item.internal_interrupt_service_routine ();
+      }
+
+      // ======================================================================
+
+#if !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL)
+
       /**
        * @details
        * The list is kept in ascending time stamp order.
@@ -422,17 +680,17 @@ namespace os
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
-            trace::printf ("clock %s() empty +%u\n", __func__,
-                static_cast<uint32_t> (timestamp));
+            internal::trace_printf ("clock %s() empty +%u\n", __func__,
+                         static_cast<uint32_t> (timestamp));
 #endif
           }
         else if (timestamp >= after->timestamp)
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
-            trace::printf ("clock %s() back %u +%u\n", __func__,
-                static_cast<uint32_t> (after->timestamp),
-                static_cast<uint32_t> (timestamp));
+            internal::trace_printf ("clock %s() back %u +%u\n", __func__,
+                         static_cast<uint32_t> (after->timestamp),
+                         static_cast<uint32_t> (timestamp));
 #endif
           }
         else if (timestamp < head ()->timestamp)
@@ -447,9 +705,9 @@ namespace os
             after =
                 static_cast<timeout_thread_node*> (const_cast<utils::static_double_list_links *> (&head_));
 #if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
-            trace::printf ("clock %s() front +%u %u\n", __func__,
-                static_cast<uint32_t> (timestamp),
-                static_cast<uint32_t> (head ()->timestamp));
+            internal::trace_printf ("clock %s() front +%u %u\n", __func__,
+                         static_cast<uint32_t> (timestamp),
+                         static_cast<uint32_t> (head ()->timestamp));
 #endif
 #pragma GCC diagnostic pop
           }
@@ -468,9 +726,9 @@ namespace os
                     static_cast<timeout_thread_node*> (const_cast<utils::static_double_list_links *> (after->prev ()));
               }
 #if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
-            trace::printf ("clock %s() middle %u +%u\n", __func__,
-                static_cast<uint32_t> (after->timestamp),
-                static_cast<uint32_t> (timestamp));
+            internal::trace_printf ("clock %s() middle %u +%u\n", __func__,
+                         static_cast<uint32_t> (after->timestamp),
+                         static_cast<uint32_t> (timestamp));
 #endif
 #pragma GCC diagnostic pop
           }
@@ -516,8 +774,8 @@ namespace os
             if (now >= head_ts)
               {
 #if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
-                trace::printf ("%s() %u \n", __func__,
-                    static_cast<uint32_t> (sysclock.now ()));
+                internal::trace_printf ("%s() %u \n", __func__,
+                             static_cast<uint32_t> (sysclock.now ()));
 #endif
                 const_cast<timestamp_node*> (head ())->action ();
               }
@@ -529,6 +787,458 @@ namespace os
           }
       }
 
+#else
+
+      /**
+       * @class clock_timestamps_list
+       * @details
+       * Instead of a single list ordered by time stamps, which requires
+       * a partial list traversal for each insert, this variant
+       * distributes the nodes in a hierarchical timing wheel.
+       *
+       * Each level has `slots` unordered lists; a slot on level 0
+       * covers one clock unit, a slot on level 1 covers `slots`
+       * clock units, and so on. A node is added to the lowest level
+       * where its time stamp shares the upper bits with the current
+       * time, so inserting is a constant time operation.
+       *
+       * When the current time reaches the beginning of a slot on an upper
+       * level, the nodes in that slot are moved (cascaded) to lower
+       * levels, and when a level 0 slot is reached, all its nodes
+       * are expired. Each node is moved at most `levels` times,
+       * so expiring is amortised constant time.
+       *
+       * Time stamps farther than the wheel range are kept in an
+       * overflow list, re-inserted each time the current time enters
+       * a new top level period, either by stepping or by skipping
+       * over an empty wheel.
+       *
+       * Nodes are removed with `unlink()` (for example when a
+       * timeout is cancelled), without the list knowing about it,
+       * so the bitmaps used to skip empty slots are only hints,
+       * cleared when the slots are found empty.
+       *
+       * Large jumps of the current time (for example when adjusting
+       * the real time clock), either forward or backward, rebuild
+       * the wheel; this is linear in the number of nodes.
+       *
+       * Nodes expired in the same call are processed in slot order,
+       * which is not necessarily the time stamp order.
+       */
+
+      void
+      clock_timestamps_list::slot::link (timestamp_node& node)
+      {
+        insert_after (node,
+                      const_cast<utils::static_double_list_links*> (tail ()));
+      }
+
+      /**
+       * @details
+       * Move all nodes from the given slot to the end of this slot,
+       * in constant time.
+       */
+      void
+      clock_timestamps_list::slot::splice (slot& from)
+      {
+        if (from.empty ())
+          {
+            return;
+          }
+
+        utils::static_double_list_links* first = from.head_.next ();
+        utils::static_double_list_links* last = from.head_.prev ();
+        utils::static_double_list_links* after = head_.prev ();
+
+        after->next (first);
+        first->prev (after);
+        last->next (&head_);
+        head_.prev (last);
+
+        from.clear ();
+      }
+
+      /**
+       * @details
+       * Move the nodes with time stamps not after `now` to the
+       * end of the given slot.
+       */
+      void
+      clock_timestamps_list::slot::take_due (clock::timestamp_t now, slot& to)
+      {
+        utils::static_double_list_links* p = head_.next ();
+        while (p != &head_)
+          {
+            utils::static_double_list_links* next = p->next ();
+            timestamp_node* node = static_cast<timestamp_node*> (p);
+            if (node->timestamp <= now)
+              {
+                node->unlink ();
+                to.link (*node);
+              }
+            p = next;
+          }
+      }
+
+      std::size_t
+      clock_timestamps_list::index_ (clock::timestamp_t ts, std::size_t level)
+      {
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+        return static_cast<std::size_t> (ts >> (slot_bits * level))
+            & (slots - 1);
+#pragma GCC diagnostic pop
+      }
+
+      /**
+       * @details
+       * Must be called in a critical section.
+       */
+      void
+      clock_timestamps_list::link (timestamp_node& node)
+      {
+#if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
+        internal::trace_printf ("clock %s() +%u\n", __func__,
+                     static_cast<uint32_t> (node.timestamp));
+#endif
+
+        insert_ (node);
+      }
+
+      void
+      clock_timestamps_list::insert_ (timestamp_node& node)
+      {
+        clock::timestamp_t ts = node.timestamp;
+        if (ts < now_)
+          {
+            // Already in the past, expire it with the current slot.
+            ts = now_;
+            overdue_ = true;
+          }
+
+        for (std::size_t level = 0; level < levels; ++level)
+          {
+            std::size_t shift = slot_bits * (level + 1);
+            if ((ts >> shift) == (now_ >> shift))
+              {
+                std::size_t ix = index_ (ts, level);
+
+                slots_[level][ix].link (node);
+                maps_[level] |= static_cast<map_t> (1) << ix;
+                return;
+              }
+          }
+
+        overflow_.link (node);
+      }
+
+      /**
+       * @details
+       * Also clear the stale bits of the slots found empty.
+       */
+      bool
+      clock_timestamps_list::wheel_empty_ (void)
+      {
+        for (std::size_t level = 0; level < levels; ++level)
+          {
+            map_t map = maps_[level];
+            while (map != 0)
+              {
+                std::size_t ix = static_cast<std::size_t> (__builtin_ctz (map));
+                map &= map - 1;
+
+                if (!slots_[level][ix].empty ())
+                  {
+                    return false;
+                  }
+                maps_[level] &= ~(static_cast<map_t> (1) << ix);
+              }
+          }
+        return true;
+      }
+
+      void
+      clock_timestamps_list::take_ (std::size_t level, std::size_t ix,
+                                    slot& to)
+      {
+        to.splice (slots_[level][ix]);
+        maps_[level] &= ~(static_cast<map_t> (1) << ix);
+      }
+
+      void
+      clock_timestamps_list::reinsert_ (slot& from)
+      {
+        while (!from.empty ())
+          {
+            timestamp_node* node =
+                const_cast<timestamp_node*> (static_cast<volatile timestamp_node*> (from.head ()));
+            node->unlink ();
+            insert_ (*node);
+          }
+      }
+
+      /**
+       * @details
+       * Set the current time, and, if it entered a new top level
+       * period, bring in the overflow nodes, some of which may now
+       * be in the wheel range.
+       *
+       * Must be called in a critical section, with `now_ <= ts`.
+       */
+      void
+      clock_timestamps_list::move_now_ (clock::timestamp_t ts)
+      {
+        bool wrapped = ((ts ^ now_) & ~(range - 1)) != 0;
+
+        now_ = ts;
+
+        if (wrapped && !overflow_.empty ())
+          {
+            slot tmp;
+            tmp.splice (overflow_);
+            reinsert_ (tmp);
+          }
+      }
+
+      /**
+       * @details
+       * Advance the current time by the largest possible step
+       * not beyond `now`, and move the expired nodes to the given slot.
+       *
+       * Must be called in a critical section, with `now_ <= now`.
+       */
+      void
+      clock_timestamps_list::advance_ (clock::timestamp_t now, slot& expired)
+      {
+        if (wheel_empty_ ())
+          {
+            // Nothing to expire until the top level wraps.
+            clock::timestamp_t wrap = (now_ | (range - 1)) + 1;
+            if (overflow_.empty () || wrap > now)
+              {
+                move_now_ (now + 1);
+                return;
+              }
+            move_now_ (wrap);
+          }
+
+        // Find the largest level whose current slot is entirely
+        // expired; the slots below it are also expired.
+        std::size_t level = 0;
+        while (level + 1 < levels)
+          {
+            clock::timestamp_t span = 1ull << (slot_bits * (level + 1));
+            if ((now_ & (span - 1)) != 0 || (now - now_) < (span - 1))
+              {
+                break;
+              }
+            ++level;
+          }
+
+        // Cascade the upper levels that reached a new slot,
+        // starting from the top.
+        for (std::size_t up = levels - 1; up > level; --up)
+          {
+            clock::timestamp_t span = 1ull << (slot_bits * up);
+            if ((now_ & (span - 1)) == 0)
+              {
+                std::size_t ix = index_ (now_, up);
+
+                slot tmp;
+                take_ (up, ix, tmp);
+                reinsert_ (tmp);
+              }
+          }
+
+        std::size_t ix = index_ (now_, level);
+        take_ (level, ix, expired);
+
+        for (std::size_t down = 0; down < level; ++down)
+          {
+            map_t map = maps_[down];
+            while (map != 0)
+              {
+                std::size_t i = static_cast<std::size_t> (__builtin_ctz (map));
+                map &= map - 1;
+
+                take_ (down, i, expired);
+              }
+          }
+
+        overdue_ = false;
+        move_now_ (now_ + (1ull << (slot_bits * level)));
+      }
+
+      /**
+       * @details
+       * Nodes with past time stamps added after the current time
+       * was advanced beyond `now` are kept in the current
+       * level 0 slot; move those already due to the given slot.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      clock_timestamps_list::take_overdue_ (clock::timestamp_t now,
+                                            slot& expired)
+      {
+        overdue_ = false;
+
+        slots_[0][index_ (now_, 0)].take_due (now, expired);
+      }
+
+      /**
+       * @details
+       * Re-insert all nodes relative to a new current time.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      clock_timestamps_list::rebuild_ (clock::timestamp_t ts)
+      {
+        slot tmp;
+
+        for (std::size_t level = 0; level < levels; ++level)
+          {
+            for (std::size_t ix = 0; ix < slots; ++ix)
+              {
+                tmp.splice (slots_[level][ix]);
+              }
+            maps_[level] = 0;
+          }
+        tmp.splice (overflow_);
+
+        now_ = ts;
+        overdue_ = false;
+
+        reinsert_ (tmp);
+      }
+
+      /**
+       * @details
+       * Level 0 slots hold single time stamps, but the upper level
+       * slots and the overflow list are not ordered, so the
+       * result is the beginning of the first non empty slot,
+       * which may be earlier than the actual time stamp.
+       *
+       * Must be called in a critical section.
+       */
+      clock::timestamp_t
+      clock_timestamps_list::earliest_timestamp (void)
+      {
+        for (std::size_t level = 0; level < levels; ++level)
+          {
+            std::size_t crt = index_ (now_, level);
+            map_t map = maps_[level] & ~((static_cast<map_t> (1) << crt) - 1);
+            while (map != 0)
+              {
+                std::size_t ix = static_cast<std::size_t> (__builtin_ctz (map));
+                map &= map - 1;
+
+                if (slots_[level][ix].empty ())
+                  {
+                    maps_[level] &= ~(static_cast<map_t> (1) << ix);
+                    continue;
+                  }
+
+                std::size_t shift = slot_bits * level;
+                clock::timestamp_t ts = (now_ >> shift) - crt + ix;
+                ts <<= shift;
+
+                return (ts > now_) ? ts : now_;
+              }
+          }
+
+        if (!overflow_.empty ())
+          {
+            return (now_ | (range - 1)) + 1;
+          }
+
+        return std::numeric_limits<clock::timestamp_t>::max ();
+      }
+
+      /**
+       * @details
+       * Advance the wheel up to the given time stamp and run the
+       * actions of all expired nodes.
+       *
+       * The actions are performed one by one, each in its own
+       * critical section, as for the ordered list.
+       */
+      void
+      clock_timestamps_list::check_timestamp (clock::timestamp_t now)
+      {
+        if (overflow_.uninitialized ())
+          {
+            // This happens before the constructors are executed.
+            return;
+          }
+
+        for (;;)
+          {
+            slot expired;
+
+              {
+                // ----- Enter critical section -------------------------------
+                interrupts::critical_section ics;
+
+                if (now < now_)
+                  {
+                    if (now + 1 < now_)
+                      {
+                        // The clock was moved backwards.
+                        rebuild_ (now + 1);
+                      }
+
+                    if (!overdue_)
+                      {
+                        break;
+                      }
+                    take_overdue_ (now, expired);
+                    if (expired.empty ())
+                      {
+                        break;
+                      }
+                  }
+                else
+                  {
+                    if (now - now_ >= range)
+                      {
+                        // Too far in the future, stepping is not
+                        // efficient, rebuild the wheel from the new time.
+                        rebuild_ (now);
+                      }
+
+                    advance_ (now, expired);
+                  }
+                // ----- Exit critical section --------------------------------
+              }
+
+            for (;;)
+              {
+                // ----- Enter critical section -------------------------------
+                interrupts::critical_section ics;
+
+                if (expired.empty ())
+                  {
+                    break;
+                  }
+
+#if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
+                internal::trace_printf ("%s() %u \n", __func__,
+                             static_cast<uint32_t> (sysclock.now ()));
+#endif
+                // The action also unlinks the node.
+                const_cast<timestamp_node*> (static_cast<volatile timestamp_node*> (expired.head ()))->action ();
+                // ----- Exit critical section --------------------------------
+              }
+          }
+      }
+
+#endif /* !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL) */
+
       // ======================================================================
 
       void
@@ -544,8 +1254,8 @@ namespace os
             static_cast<waiting_thread_node*> (const_cast<utils::static_double_list_links *> (tail ()));
 
 #if defined(OS_TRACE_RTOS_THREAD)
-        trace::printf ("terminated %s() %p %s\n", __func__, &node.thread_,
-                       node.thread_->name ());
+        internal::trace_printf ("terminated %s() %p %s\n", __func__,
+                                &node.thread_, node.thread_->name ());
 #endif
 
         node.thread_->state_ = thread::state::terminated;
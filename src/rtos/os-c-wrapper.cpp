@@ -108,6 +108,9 @@ static_assert(alignof(os_mutex_robustness_t) == alignof(mutex::robustness_t), "a
 static_assert(sizeof(os_semaphore_count_t) == sizeof(semaphore::count_t), "adjust size of os_semaphore_count_t");
 static_assert(alignof(os_semaphore_count_t) == alignof(semaphore::count_t), "adjust align of os_semaphore_count_t");
 
+static_assert(sizeof(os_rwlock_count_t) == sizeof(rwlock::count_t), "adjust size of os_rwlock_count_t");
+static_assert(alignof(os_rwlock_count_t) == alignof(rwlock::count_t), "adjust align of os_rwlock_count_t");
+
 static_assert(sizeof(os_mempool_size_t) == sizeof(memory_pool::size_t), "adjust size of os_mempool_size_t");
 static_assert(alignof(os_mempool_size_t) == alignof(memory_pool::size_t), "adjust align of os_mempool_size_t");
 
@@ -122,6 +125,8 @@ static_assert(alignof(os_mqueue_index_t) == alignof(message_queue::index_t), "ad
 
 static_assert(sizeof(os_mqueue_prio_t) == sizeof(message_queue::priority_t), "adjust size of os_mqueue_prio_t");
 static_assert(alignof(os_mqueue_prio_t) == alignof(message_queue::priority_t), "adjust align of os_mqueue_prio_t");
+static_assert(sizeof(os_mqueue_ordering_t) == sizeof(message_queue::ordering_t), "adjust size of os_mqueue_ordering_t");
+static_assert(alignof(os_mqueue_ordering_t) == alignof(message_queue::ordering_t), "adjust align of os_mqueue_ordering_t");
 
 // ----------------------------------------------------------------------------
 
@@ -171,6 +176,10 @@ static_assert(os_mutex_type_errorcheck == mutex::type::errorcheck, "adjust os_mu
 static_assert(os_mutex_type_recursive == mutex::type::recursive, "adjust os_mutex_type_recursive");
 static_assert(os_mutex_type_default == mutex::type::default_, "adjust os_mutex_type_default");
 
+static_assert(os_mqueue_ordering_linear == message_queue::ordering::linear, "adjust os_mqueue_ordering_linear");
+static_assert(os_mqueue_ordering_indexed == message_queue::ordering::indexed, "adjust os_mqueue_ordering_indexed");
+static_assert(os_mqueue_ordering_default == message_queue::ordering::default_, "adjust os_mqueue_ordering_default");
+
 #pragma GCC diagnostic pop
 
 // ----------------------------------------------------------------------------
@@ -192,6 +201,7 @@ static_assert(offsetof(rtos::thread::attributes, th_stack_address) == offsetof(o
 static_assert(offsetof(rtos::thread::attributes, th_stack_size_bytes) == offsetof(os_thread_attr_t, th_stack_size_bytes), "adjust os_thread_attr_t members");
 static_assert(offsetof(rtos::thread::attributes, th_priority) == offsetof(os_thread_attr_t, th_priority), "adjust os_thread_attr_t members");
 static_assert(offsetof(rtos::thread::attributes, th_enable_assert_reuse) == offsetof(os_thread_attr_t, th_enable_assert_reuse), "adjust os_thread_attr_t members");
+static_assert(offsetof(rtos::thread::attributes, th_stack_fill) == offsetof(os_thread_attr_t, th_stack_fill), "adjust os_thread_attr_t members");
 
 static_assert(sizeof(rtos::timer) == sizeof(os_timer_t), "adjust size of os_timer_t");
 static_assert(sizeof(rtos::timer::attributes) == sizeof(os_timer_attr_t), "adjust size of os_timer_attr_t");
@@ -204,10 +214,14 @@ static_assert(offsetof(rtos::mutex::attributes, mx_protocol) == offsetof(os_mute
 static_assert(offsetof(rtos::mutex::attributes, mx_robustness) == offsetof(os_mutex_attr_t, mx_robustness), "adjust os_mutex_attr_t members");
 static_assert(offsetof(rtos::mutex::attributes, mx_type) == offsetof(os_mutex_attr_t, mx_type), "adjust os_mutex_attr_t members");
 static_assert(offsetof(rtos::mutex::attributes, mx_max_count) == offsetof(os_mutex_attr_t, mx_max_count), "adjust os_mutex_attr_t members");
+static_assert(offsetof(rtos::mutex::attributes, mx_adaptive_yields) == offsetof(os_mutex_attr_t, mx_adaptive_yields), "adjust os_mutex_attr_t members");
 
 static_assert(sizeof(rtos::condition_variable) == sizeof(os_condvar_t), "adjust size of os_condvar_t");
 static_assert(sizeof(rtos::condition_variable::attributes) == sizeof(os_condvar_attr_t), "adjust size of os_condvar_attr_t");
 
+static_assert(sizeof(rtos::rwlock) == sizeof(os_rwlock_t), "adjust size of os_rwlock_t");
+static_assert(sizeof(rtos::rwlock::attributes) == sizeof(os_rwlock_attr_t), "adjust size of os_rwlock_attr_t");
+
 static_assert(sizeof(rtos::semaphore) == sizeof(os_semaphore_t), "adjust size of os_semaphore_t");
 static_assert(sizeof(rtos::semaphore::attributes) == sizeof(os_semaphore_attr_t), "adjust size of os_semaphore_attr_t");
 static_assert(offsetof(rtos::semaphore::attributes, sm_initial_value) == offsetof(os_semaphore_attr_t, sm_initial_value), "adjust os_semaphore_attr_t members");
@@ -222,6 +236,7 @@ static_assert(sizeof(rtos::message_queue) == sizeof(os_mqueue_t), "adjust size o
 static_assert(sizeof(rtos::message_queue::attributes) == sizeof(os_mqueue_attr_t), "adjust size of os_mqueue_attr_t");
 static_assert(offsetof(rtos::message_queue::attributes, mq_queue_address) == offsetof(os_mqueue_attr_t, mq_queue_addr), "adjust os_mqueue_attr_t members");
 static_assert(offsetof(rtos::message_queue::attributes, mq_queue_size_bytes) == offsetof(os_mqueue_attr_t, mq_queue_size_bytes), "adjust os_mqueue_attr_t members");
+static_assert(offsetof(rtos::message_queue::attributes, mq_ordering) == offsetof(os_mqueue_attr_t, mq_ordering), "adjust os_mqueue_attr_t members");
 
 static_assert(sizeof(rtos::event_flags) == sizeof(os_evflags_t), "adjust size of os_evflags_t");
 static_assert(sizeof(rtos::event_flags::attributes) == sizeof(os_evflags_attr_t), "adjust size of os_evflags_attr_t");
@@ -929,6 +944,19 @@ os_thread_stack_get_available (os_thread_stack_t* stack)
   return (reinterpret_cast<class rtos::thread::stack&> (*stack)).available ();
 }
 
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::stack::high_water_mark()
+ */
+size_t
+os_thread_stack_get_high_water_mark (os_thread_stack_t* stack)
+{
+  assert (stack != nullptr);
+  return (reinterpret_cast<class rtos::thread::stack&> (*stack)).high_water_mark ();
+}
+
 /**
  * @note Can be invoked from Interrupt Service Routines.
  *
@@ -1935,6 +1963,234 @@ os_condvar_timed_wait (os_condvar_t* condvar, os_mutex_t* mutex,
 
 // ----------------------------------------------------------------------------
 
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::attributes
+ */
+void
+os_rwlock_attr_init (os_rwlock_attr_t* attr)
+{
+  assert (attr != nullptr);
+  new (attr) rwlock::attributes ();
+}
+
+/**
+ * @note Must be paired with `os_rwlock_destruct ()`.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock
+ */
+void
+os_rwlock_construct (os_rwlock_t* rwlock, const char* name,
+                     const os_rwlock_attr_t* attr)
+{
+  assert (rwlock != nullptr);
+  if (attr == nullptr)
+    {
+      attr = (const os_rwlock_attr_t*) &rwlock::initializer;
+    }
+  new (rwlock) rtos::rwlock (name, (const rwlock::attributes&) *attr);
+}
+
+/**
+ * @note Must be paired with `os_rwlock_construct ()`.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock
+ */
+void
+os_rwlock_destruct (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  (reinterpret_cast<rtos::rwlock&> (*rwlock)).~rwlock ();
+}
+
+/**
+ * @details
+ * Dynamically allocate the read-write lock object instance using the RTOS
+ * system allocator and construct it.
+ *
+ * @note Equivalent of C++ `new rwlock(...)`.
+ * @note Must be paired with `os_rwlock_delete ()`.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock
+ */
+os_rwlock_t*
+os_rwlock_new (const char* name, const os_rwlock_attr_t* attr)
+{
+  if (attr == nullptr)
+    {
+      attr = (const os_rwlock_attr_t*) &rwlock::initializer;
+    }
+  return reinterpret_cast<os_rwlock_t*> (new rtos::rwlock (
+      name, (const rwlock::attributes&) *attr));
+}
+
+/**
+ * @details
+ * Destruct the read-write lock and deallocate the dynamically allocated
+ * space using the RTOS system allocator.
+ *
+ * @note Equivalent of C++ `delete ptr_rwlock`.
+ * @note Must be paired with `os_rwlock_new ()`.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock
+ */
+void
+os_rwlock_delete (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  delete reinterpret_cast<rtos::rwlock*> (rwlock);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::name()
+ */
+const char*
+os_rwlock_get_name (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (reinterpret_cast<rtos::rwlock&> (*rwlock)).name ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::read_lock()
+ */
+os_result_t
+os_rwlock_read_lock (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).read_lock ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::try_read_lock()
+ */
+os_result_t
+os_rwlock_try_read_lock (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).try_read_lock ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::timed_read_lock()
+ */
+os_result_t
+os_rwlock_timed_read_lock (os_rwlock_t* rwlock,
+                           os_clock_duration_t timeout)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).timed_read_lock (
+      timeout);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::write_lock()
+ */
+os_result_t
+os_rwlock_write_lock (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).write_lock ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::try_write_lock()
+ */
+os_result_t
+os_rwlock_try_write_lock (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).try_write_lock ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::timed_write_lock()
+ */
+os_result_t
+os_rwlock_timed_write_lock (os_rwlock_t* rwlock,
+                            os_clock_duration_t timeout)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).timed_write_lock (
+      timeout);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::unlock()
+ */
+os_result_t
+os_rwlock_unlock (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::rwlock&> (*rwlock)).unlock ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::readers()
+ */
+os_rwlock_count_t
+os_rwlock_get_readers (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (reinterpret_cast<rtos::rwlock&> (*rwlock)).readers ();
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::rwlock::writer()
+ */
+os_thread_t*
+os_rwlock_get_writer (os_rwlock_t* rwlock)
+{
+  assert (rwlock != nullptr);
+  return (os_thread_t*) (reinterpret_cast<rtos::rwlock&> (*rwlock)).writer ();
+}
+
+// ----------------------------------------------------------------------------
+
 /**
  * @warning Cannot be invoked from Interrupt Service Routines.
  *
@@ -2218,6 +2474,67 @@ os_semaphore_timed_wait (os_semaphore_t* semaphore, os_clock_duration_t timeout)
       timeout);
 }
 
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::semaphore::post(count_t)
+ */
+os_result_t
+os_semaphore_post_count (os_semaphore_t* semaphore,
+                         os_semaphore_count_t count)
+{
+  assert (semaphore != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::semaphore&> (*semaphore)).post (
+      count);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::semaphore::wait(count_t)
+ */
+os_result_t
+os_semaphore_wait_count (os_semaphore_t* semaphore,
+                         os_semaphore_count_t count)
+{
+  assert (semaphore != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::semaphore&> (*semaphore)).wait (
+      count);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::semaphore::try_wait(count_t)
+ */
+os_result_t
+os_semaphore_try_wait_count (os_semaphore_t* semaphore,
+                             os_semaphore_count_t count)
+{
+  assert (semaphore != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::semaphore&> (*semaphore)).try_wait (
+      count);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::semaphore::timed_wait(count_t, clock::duration_t)
+ */
+os_result_t
+os_semaphore_timed_wait_count (os_semaphore_t* semaphore,
+                               os_semaphore_count_t count,
+                               os_clock_duration_t timeout)
+{
+  assert (semaphore != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::semaphore&> (*semaphore)).timed_wait (
+      count, timeout);
+}
+
 /**
  * @note Can be invoked from Interrupt Service Routines.
  *
@@ -2721,6 +3038,219 @@ os_mqueue_timed_receive (os_mqueue_t* mqueue, void* msg, size_t nbytes,
       msg, nbytes, timeout, mprio);
 }
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::reserve()
+ */
+os_result_t
+os_mqueue_reserve (os_mqueue_t* mqueue, void** slot)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).reserve (slot);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::try_reserve()
+ */
+os_result_t
+os_mqueue_try_reserve (os_mqueue_t* mqueue, void** slot)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).try_reserve (
+      slot);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::timed_reserve()
+ */
+os_result_t
+os_mqueue_timed_reserve (os_mqueue_t* mqueue, void** slot,
+                         os_clock_duration_t timeout)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).timed_reserve (
+      slot, timeout);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::commit()
+ */
+os_result_t
+os_mqueue_commit (os_mqueue_t* mqueue, void* slot, os_mqueue_prio_t mprio)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).commit (
+      slot, mprio);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::borrow()
+ */
+os_result_t
+os_mqueue_borrow (os_mqueue_t* mqueue, void** slot, os_mqueue_prio_t* mprio)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).borrow (
+      slot, mprio);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::try_borrow()
+ */
+os_result_t
+os_mqueue_try_borrow (os_mqueue_t* mqueue, void** slot,
+                      os_mqueue_prio_t* mprio)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).try_borrow (
+      slot, mprio);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::timed_borrow()
+ */
+os_result_t
+os_mqueue_timed_borrow (os_mqueue_t* mqueue, void** slot,
+                        os_clock_duration_t timeout, os_mqueue_prio_t* mprio)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).timed_borrow (
+      slot, timeout, mprio);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::release()
+ */
+os_result_t
+os_mqueue_release (os_mqueue_t* mqueue, void* slot)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).release (slot);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::send_n()
+ */
+os_result_t
+os_mqueue_send_n (os_mqueue_t* mqueue, const void* msg_array, size_t count,
+                  size_t nbytes, os_mqueue_prio_t mprio, size_t* sent)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).send_n (
+      msg_array, count, nbytes, mprio, sent);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::try_send_n()
+ */
+os_result_t
+os_mqueue_try_send_n (os_mqueue_t* mqueue, const void* msg_array,
+                      size_t count, size_t nbytes, os_mqueue_prio_t mprio,
+                      size_t* sent)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).try_send_n (
+      msg_array, count, nbytes, mprio, sent);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::timed_send_n()
+ */
+os_result_t
+os_mqueue_timed_send_n (os_mqueue_t* mqueue, const void* msg_array,
+                        size_t count, size_t nbytes,
+                        os_clock_duration_t timeout,
+                        os_mqueue_prio_t mprio, size_t* sent)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).timed_send_n (
+      msg_array, count, nbytes, timeout, mprio, sent);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::receive_n()
+ */
+os_result_t
+os_mqueue_receive_n (os_mqueue_t* mqueue, void* msg_array, size_t count,
+                     size_t nbytes, size_t* received,
+                     os_mqueue_prio_t* mprios)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).receive_n (
+      msg_array, count, nbytes, received, mprios);
+}
+
+/**
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::try_receive_n()
+ */
+os_result_t
+os_mqueue_try_receive_n (os_mqueue_t* mqueue, void* msg_array, size_t count,
+                         size_t nbytes, size_t* received,
+                         os_mqueue_prio_t* mprios)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).try_receive_n (
+      msg_array, count, nbytes, received, mprios);
+}
+
+/**
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::message_queue::timed_receive_n()
+ */
+os_result_t
+os_mqueue_timed_receive_n (os_mqueue_t* mqueue, void* msg_array, size_t count,
+                           size_t nbytes, os_clock_duration_t timeout,
+                           size_t* received, os_mqueue_prio_t* mprios)
+{
+  assert (mqueue != nullptr);
+  return (os_result_t) (reinterpret_cast<message_queue&> (*mqueue)).timed_receive_n (
+      msg_array, count, nbytes, timeout, received, mprios);
+}
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
 /**
  * @note Can be invoked from Interrupt Service Routines.
  *
@@ -16,6 +16,10 @@
 
 #include <cmsis-plus/rtos/os.h>
 
+#if defined(OS_USE_TRACE_EVENTS)
+#include <cmsis-plus/diag/trace-events.h>
+#endif
+
 // ----------------------------------------------------------------------------
 
 #if defined(__clang__)
@@ -29,6 +33,20 @@ using namespace os::rtos;
 
 // ----------------------------------------------------------------------------
 
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+
+// Ticks left until the next simulated RTC interrupt.
+static uint32_t rtc_ticks = clock_systick::frequency_hz;
+
+#if defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS)
+
+// Simulated RTC interrupts skipped during a tickless sleep.
+static uint32_t rtc_skipped_seconds = 0;
+
+#endif /* defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS) */
+
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
 /**
  * @details
  * Must be called from the physical interrupt handler.
@@ -38,6 +56,11 @@ os_systick_handler (void)
 {
   using namespace os::rtos;
 
+#if defined(OS_TRACE_EVENTS_ISR)
+  os::trace::events::isr_scope isr
+    { reinterpret_cast<const void*> (&os_systick_handler) };
+#endif
+
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
   // Prevent scheduler actions before starting it.
   if (scheduler::started ())
@@ -49,7 +72,7 @@ os_systick_handler (void)
 #if defined(OS_TRACE_RTOS_SYSCLOCK_TICK)
   trace::putchar ('.');
 #elif defined(OS_TRACE_RTOS_SYSCLOCK_TICK_BRACES)
-  trace::printf ("{t ");
+  internal::trace_printf ("{t ");
 #endif
 
     {
@@ -65,12 +88,22 @@ os_systick_handler (void)
 
 #if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
 
-  // Simulate an RTC driver.
-  static uint32_t ticks = clock_systick::frequency_hz;
+#if defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS)
+
+  // Replay the seconds which ended while sleeping without ticks.
+  while (rtc_skipped_seconds > 0)
+    {
+      --rtc_skipped_seconds;
 
-  if (--ticks == 0)
+      os_rtc_handler ();
+    }
+
+#endif /* defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS) */
+
+  // Simulate an RTC driver.
+  if (--rtc_ticks == 0)
     {
-      ticks = clock_systick::frequency_hz;
+      rtc_ticks = clock_systick::frequency_hz;
 
       os_rtc_handler ();
     }
@@ -84,7 +117,7 @@ os_systick_handler (void)
 #endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
 
 #if defined(OS_TRACE_RTOS_SYSCLOCK_TICK_BRACES)
-  trace::printf (" t}");
+  internal::trace_printf (" t}");
 #endif
 }
 
@@ -196,9 +229,10 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u) %p %s\n", __func__,
-                     static_cast<unsigned int> (duration),
-                     &this_thread::thread (), this_thread::thread ().name ());
+      internal::trace_printf ("%s(%u) %p %s\n", __func__,
+                              static_cast<unsigned int> (duration),
+                              &this_thread::thread (),
+                              this_thread::thread ().name ());
 #pragma GCC diagnostic pop
 
 #endif // defined(OS_TRACE_RTOS_CLOCKS)
@@ -240,7 +274,7 @@ namespace os
     clock::sleep_until (timestamp_t timestamp)
     {
 #if defined(OS_TRACE_RTOS_CLOCKS)
-      trace::printf ("%s()\n", __func__);
+      internal::trace_printf ("%s()\n", __func__);
 #endif
 
       // Don't call this from interrupt handlers.
@@ -285,7 +319,8 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u)\n", __func__, static_cast<unsigned int> (timeout));
+      internal::trace_printf ("%s(%u)\n", __func__,
+                              static_cast<unsigned int> (timeout));
 #pragma GCC diagnostic pop
 
 #endif // defined(OS_TRACE_RTOS_CLOCKS)
@@ -383,6 +418,21 @@ namespace os
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
 
+#if defined(OS_TRACE_EVENTS_BLOCK)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+          trace::events::record (
+              trace::events::thread_block,
+              reinterpret_cast<trace::events::arg_t> (&crt_thread),
+              reinterpret_cast<trace::events::arg_t> (this),
+              internal::wait_reason::sleep,
+              static_cast<trace::events::arg_t> (timestamp));
+#pragma GCC diagnostic pop
+#endif
+
           // Remove this thread from the ready list, if there.
           port::this_thread::prepare_suspend ();
 
@@ -456,7 +506,7 @@ namespace os
     adjustable_clock::sleep_until (timestamp_t timestamp)
     {
 #if defined(OS_TRACE_RTOS_CLOCKS)
-      trace::printf ("%s()\n", __func__);
+      internal::trace_printf ("%s()\n", __func__);
 #endif
 
       // Don't call this from interrupt handlers.
@@ -590,7 +640,7 @@ namespace os
     clock_systick::start (void)
     {
 #if defined(OS_TRACE_RTOS_CLOCKS)
-      trace::printf ("clock_systick::%s()\n", __func__);
+      internal::trace_printf ("clock_systick::%s()\n", __func__);
 #endif
       port::clock_systick::start ();
     }
@@ -617,6 +667,122 @@ namespace os
 
 #endif /* defined(OS_USE_RTOS_PORT_CLOCK_SYSTICK_WAIT_FOR) */
 
+#if defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS)
+
+    /**
+     * @details
+     * Called by the idle thread instead of waiting for the next
+     * interrupt.
+     *
+     * Compute the number of ticks until the earliest deadline of
+     * the tick driven clocks (the system clock, the high resolution
+     * clock and, if not driven by a separate device, the real
+     * time clock), and, if more than one, ask the
+     * `os_rtos_idle_tickless_sleep_hook()` to suppress the ticks
+     * and sleep.
+     *
+     * The hook is called in a critical section, so it must
+     * use a way to sleep which is ended by the interrupts
+     * masked by the critical section (like `WFI` with `PRIMASK`
+     * on Cortex-M).
+     *
+     * When the hook returns, only the clock counts are advanced
+     * by the slept time; the tick that ended the sleep is
+     * counted by the regular interrupt, which also processes
+     * the timeouts expired meanwhile, so the timer callbacks
+     * run in the SysTick interrupt context, as without
+     * tickless, and the critical section is not extended by
+     * them.
+     *
+     * @retval true Ticks were skipped, or a thread is ready.
+     * @retval false The next deadline is too close, or the hook
+     *  did not skip any tick; wait for the next interrupt as usual.
+     */
+    bool
+    clock_systick::internal_tickless_sleep (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+      if (!scheduler::ready_threads_list_.empty ())
+        {
+          // Resumed by an interrupt, do not sleep.
+          return true;
+        }
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+      timestamp_t nw = steady_count_;
+      timestamp_t ts = steady_list_.earliest_timestamp ();
+      if (ts <= nw + 1)
+        {
+          return false;
+        }
+      timestamp_t ticks = ts - nw;
+
+      // The high resolution clock deadlines, rounded up to ticks.
+      timestamp_t cycles = port::clock_highres::cycles_per_tick ();
+      nw = hrclock.steady_now ();
+      ts = hrclock.steady_list ().earliest_timestamp ();
+      if (ts <= nw + cycles)
+        {
+          return false;
+        }
+      if ((ts - nw + cycles - 1) / cycles < ticks)
+        {
+          ticks = (ts - nw + cycles - 1) / cycles;
+        }
+
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+      if (rtc_ticks < ticks)
+        {
+          ticks = rtc_ticks;
+        }
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
+      // Keep the high resolution count increment in range.
+      timestamp_t max_ticks = std::numeric_limits<duration_t>::max () / cycles;
+      if (max_ticks < ticks)
+        {
+          ticks = max_ticks;
+        }
+
+      if (ticks < 2)
+        {
+          return false;
+        }
+
+      duration_t slept = os_rtos_idle_tickless_sleep_hook (
+          static_cast<duration_t> (ticks));
+
+      if (slept == 0)
+        {
+          return false;
+        }
+
+      // The timestamps are checked by the pending tick interrupt.
+      internal_add_count (slept);
+      hrclock.internal_add_count (static_cast<duration_t> (slept * cycles));
+
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+      // Leave at least one tick, so the pending tick interrupt
+      // signals the RTC when due.
+      while (slept >= rtc_ticks)
+        {
+          slept -= rtc_ticks;
+          rtc_ticks = clock_systick::frequency_hz;
+
+          ++rtc_skipped_seconds;
+        }
+      rtc_ticks -= slept;
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
+      return true;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif /* defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS) */
+
     // ========================================================================
 
     /**
@@ -696,7 +862,7 @@ namespace os
     clock_rtc::start (void)
     {
 #if defined(OS_TRACE_RTOS_CLOCKS)
-      trace::printf ("clock_rtc::%s()\n", __func__);
+      internal::trace_printf ("clock_rtc::%s()\n", __func__);
 #endif
       // Don't call this from interrupt handlers.
       assert (!interrupts::in_handler_mode ());
@@ -742,7 +908,7 @@ namespace os
     clock_highres::start (void)
     {
 #if defined(OS_TRACE_RTOS_CLOCKS)
-      trace::printf ("clock_highres::%s()\n", __func__);
+      internal::trace_printf ("clock_highres::%s()\n", __func__);
 #endif
 
       port::clock_highres::start ();
@@ -266,7 +266,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_CONDVAR)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -294,7 +294,7 @@ namespace os
     condition_variable::~condition_variable ()
     {
 #if defined(OS_TRACE_RTOS_CONDVAR)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // There must be no threads waiting for this condition.
@@ -339,13 +339,21 @@ namespace os
     condition_variable::signal ()
     {
 #if defined(OS_TRACE_RTOS_CONDVAR)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
       os_assert_err(!interrupts::in_handler_mode (), EPERM);
 
-      list_.resume_one ();
+#if defined(OS_USE_RTOS_PORT_MUTEX)
+
+      list_.resume_one (this, internal::wait_reason::condition_variable);
+
+#else
+
+      internal_notify_ (false);
+
+#endif
 
       return result::ok;
     }
@@ -381,6 +389,11 @@ namespace os
      * have no effect if there are no threads currently
      * blocked on this condition variable.
      *
+     * If the mutex is locked, the threads are not resumed, but
+     * moved to the mutex waiting list (wait morphing), and
+     * become ready one at a time, as the mutex is unlocked;
+     * otherwise only the first thread is resumed.
+     *
      * @par Application usage
      * The `broadcast()` function is used whenever
      * the shared-variable state has been changed in a way that more
@@ -409,20 +422,102 @@ namespace os
     condition_variable::broadcast ()
     {
 #if defined(OS_TRACE_RTOS_CONDVAR)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
       os_assert_err(!interrupts::in_handler_mode (), EPERM);
 
+#if defined(OS_USE_RTOS_PORT_MUTEX)
+
       // Wake-up all threads, if any.
       // Need not be inside the critical section,
       // the list is protected by inner `resume_one()`.
-      list_.resume_all ();
+      list_.resume_all (this, internal::wait_reason::condition_variable);
+
+#else
+
+      internal_notify_ (true);
+
+#endif
 
       return result::ok;
     }
 
+#if !defined(OS_USE_RTOS_PORT_MUTEX)
+
+    /**
+     * @cond ignore
+     */
+
+    /*
+     * Internal function.
+     *
+     * Waking up all threads would be useless, since all but one
+     * would block again on the mutex. Instead, the threads are
+     * moved, still suspended, to the waiting list of the mutex
+     * (wait morphing), and each `mutex::unlock()` will resume
+     * the next one.
+     *
+     * If the mutex is not locked, the first thread is resumed to lock
+     * it, and the rest are moved to the mutex list, since its
+     * unlock will follow.
+     */
+    void
+    condition_variable::internal_notify_ (bool all)
+    {
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      // The mutex for which a thread was resumed.
+      mutex* resumed = nullptr;
+
+      for (;;)
+        {
+          internal::waiting_condvar_node* node;
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              if (list_.empty ())
+                {
+                  return;
+                }
+
+              // All nodes in the list are condition variable nodes.
+              node = static_cast<internal::waiting_condvar_node*> (
+                  const_cast<internal::waiting_thread_node*> (list_.head ()));
+              // ----- Exit critical section ----------------------------------
+            }
+
+          mutex* mx = node->mutex_;
+          if (mx->owner_ != nullptr || mx == resumed)
+            {
+              // The thread will be resumed by the mutex unlock.
+              mx->internal_enqueue_ (*node);
+            }
+          else
+            {
+              // Delayed until end of critical section.
+              list_.resume_one (this,
+                                internal::wait_reason::condition_variable);
+              resumed = mx;
+            }
+
+          if (!all)
+            {
+              return;
+            }
+        }
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @endcond
+     */
+
+#endif /* !defined(OS_USE_RTOS_PORT_MUTEX) */
+
     /**
      * @details
      * Block on a condition variable. The application shall ensure
@@ -509,7 +604,7 @@ namespace os
     condition_variable::wait (mutex& mutex)
     {
 #if defined(OS_TRACE_RTOS_CONDVAR)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -519,6 +614,8 @@ namespace os
 
       thread& crt_thread = this_thread::thread ();
 
+#if defined(OS_USE_RTOS_PORT_MUTEX)
+
       // Prepare a list node pointing to the current thread.
       // Do not worry for being on stack, it is temporarily linked to the
       // list and guaranteed to be removed before this function returns.
@@ -549,6 +646,55 @@ namespace os
         }
 
       return res;
+
+#else
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_condvar_node node
+        { crt_thread, mutex };
+
+      result_t res;
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          // Release the mutex and block in the same critical section,
+          // to not miss a notification.
+          res = mutex.internal_unlock_ (&crt_thread);
+          if (res != result::ok)
+            {
+              return res;
+            }
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              // Add this thread to the condition variable waiting list.
+              scheduler::internal_link_node (
+                  list_, node, this,
+                  internal::wait_reason::condition_variable);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      port::scheduler::reschedule ();
+
+      // Remove the thread from the condition variable waiting list,
+      // if not already removed by signal(), or from the mutex waiting
+      // list, if moved there by broadcast() and not already removed
+      // by unlock().
+      scheduler::internal_unlink_node (node);
+      crt_thread.waiting_mutex_ = nullptr;
+
+      // Interrupted threads return as after a spurious wakeup.
+      return mutex.lock ();
+
+#endif
     }
 
     /**
@@ -660,8 +806,9 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u) @%p %s\n", __func__,
-                     static_cast<unsigned int> (timeout), this, name ());
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__,
+                              static_cast<unsigned int> (timeout), this,
+                              name ());
 #pragma GCC diagnostic pop
 
 #endif // defined(OS_TRACE_RTOS_CONDVAR)
@@ -673,6 +820,8 @@ namespace os
 
       thread& crt_thread = this_thread::thread ();
 
+#if defined(OS_USE_RTOS_PORT_MUTEX)
+
       // Prepare a list node pointing to the current thread.
       // Do not worry for being on stack, it is temporarily linked to the
       // list and guaranteed to be removed before this function returns.
@@ -703,6 +852,91 @@ namespace os
         }
 
       return res;
+
+#else
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_condvar_node node
+        { crt_thread, mutex };
+
+      // The timeout is measured with the mutex clock.
+      internal::clock_timestamps_list& clock_list =
+          mutex.clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = mutex.clock_->steady_now ()
+          + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      result_t res;
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          // Release the mutex and block in the same critical section,
+          // to not miss a notification.
+          res = mutex.internal_unlock_ (&crt_thread);
+          if (res != result::ok)
+            {
+              return res;
+            }
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              // Add this thread to the condition variable waiting list,
+              // and the clock timeout list.
+              scheduler::internal_link_node (
+                  list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::condition_variable);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      port::scheduler::reschedule ();
+
+      bool notified;
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          // A thread still in the condition variable list was neither
+          // signalled nor moved to the mutex list.
+          notified = node.unlinked () || (crt_thread.waiting_mutex_ != nullptr);
+
+          // Remove the thread from the condition variable or the mutex
+          // waiting list, and from the clock timeout list, if not
+          // already removed.
+          scheduler::internal_unlink_node (node, timeout_node);
+          crt_thread.waiting_mutex_ = nullptr;
+          // ----- Exit critical section --------------------------------------
+        }
+
+      // The mutex must be locked again, even after a timeout.
+      res = mutex.lock ();
+      if (res != result::ok)
+        {
+          return res;
+        }
+
+      if (!notified && !crt_thread.interrupted ())
+        {
+#if defined(OS_TRACE_RTOS_CONDVAR)
+          internal::trace_printf ("%s() ETIMEDOUT @%p %s\n", __func__, this,
+                                  name ());
+#endif
+          return ETIMEDOUT;
+        }
+
+      return result::ok;
+
+#endif
     }
 
   // --------------------------------------------------------------------------
@@ -16,6 +16,10 @@
 
 #include <cmsis-plus/rtos/os.h>
 
+#if defined(OS_USE_TRACE_EVENTS)
+#include <cmsis-plus/diag/trace-events.h>
+#endif
+
 // ----------------------------------------------------------------------------
 
 #if defined(__clang__)
@@ -160,7 +164,7 @@ namespace os
       initialize (void)
       {
 #if defined(OS_TRACE_RTOS_SCHEDULER)
-        trace::printf ("scheduler::%s() \n", __func__);
+        internal::trace_printf ("scheduler::%s() \n", __func__);
 #endif
 
         // Don't call this from interrupt handlers.
@@ -227,7 +231,7 @@ namespace os
       preemptive (bool state)
       {
 #if defined(OS_TRACE_RTOS_SCHEDULER)
-        trace::printf ("scheduler::%s(%d) \n", __func__, state);
+        internal::trace_printf ("scheduler::%s(%d) \n", __func__, state);
 #endif
         // Don't call this from interrupt handlers.
         os_assert_throw(!interrupts::in_handler_mode (), EPERM);
@@ -331,8 +335,17 @@ namespace os
 
       void
       internal_link_node (internal::waiting_threads_list& list,
-                          internal::waiting_thread_node& node)
+                          internal::waiting_thread_node& node,
+                          const void* object __attribute__((unused)),
+                          internal::wait_reason_t reason __attribute__((unused)))
       {
+#if defined(OS_TRACE_EVENTS_BLOCK)
+        trace::events::record (
+            trace::events::thread_block,
+            reinterpret_cast<trace::events::arg_t> (node.thread_),
+            reinterpret_cast<trace::events::arg_t> (object), reason);
+#endif
+
         // Remove this thread from the ready list, if there.
         port::this_thread::prepare_suspend ();
 
@@ -362,8 +375,24 @@ namespace os
       internal_link_node (internal::waiting_threads_list& list,
                           internal::waiting_thread_node& node,
                           internal::clock_timestamps_list& timeout_list,
-                          internal::timeout_thread_node& timeout_node)
+                          internal::timeout_thread_node& timeout_node,
+                          const void* object __attribute__((unused)),
+                          internal::wait_reason_t reason __attribute__((unused)))
       {
+#if defined(OS_TRACE_EVENTS_BLOCK)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+        trace::events::record (
+            trace::events::thread_block,
+            reinterpret_cast<trace::events::arg_t> (node.thread_),
+            reinterpret_cast<trace::events::arg_t> (object), reason,
+            static_cast<trace::events::arg_t> (timeout_node.timestamp));
+#pragma GCC diagnostic pop
+#endif
+
         // Remove this thread from the ready list, if there.
         port::this_thread::prepare_suspend ();
 
@@ -429,11 +458,35 @@ namespace os
         // Accumulate durations to old thread.
         scheduler::current_thread_->statistics_.cpu_cycles_ += delta;
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+        // Accumulate the load window and the run burst of the old thread.
+        scheduler::current_thread_->statistics_.internal_account_cycles_ (
+            delta, sysclock.now () / OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
         // Remember the timestamp for the next context switch.
         scheduler::statistics::switch_timestamp_ = now;
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+
+        // Fold the semaphore posts deferred by the interrupt handlers,
+        // which may make more threads ready.
+        semaphore::internal_fold_deferred_posts_ ();
+
+#endif /* defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS) */
+
+#if defined(OS_TRACE_EVENTS_SWITCH) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+        thread* old_thread = scheduler::current_thread_;
+#endif
+#if defined(OS_TRACE_EVENTS_SWITCH)
+        thread::state_t old_state = old_thread->state_;
+#endif
+
         // The very core of the scheduler, if not locked, re-link the
         // current thread and return the top priority thread.
         if (!locked ())
@@ -448,6 +501,30 @@ namespace os
 
         // ***** Pointer switched to new thread! *****
 
+#if defined(OS_TRACE_EVENTS_SWITCH)
+        if (scheduler::current_thread_ != old_thread)
+          {
+            trace::events::record (
+                trace::events::thread_switch,
+                reinterpret_cast<trace::events::arg_t> (old_thread),
+                reinterpret_cast<trace::events::arg_t> (scheduler::current_thread_),
+                old_state);
+          }
+#endif
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+        if (scheduler::current_thread_ != old_thread)
+          {
+            // The old thread run burst ended.
+            old_thread->statistics_.internal_account_burst_ ();
+          }
+
+        // Wakeup latency, if the new thread was resumed.
+        scheduler::current_thread_->statistics_.internal_account_run_ (now);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
         // The new thread was marked as running in unlink_head(),
         // so in case the handler is re-entered immediately,
         // the relink_running() will simply reschedule it,
@@ -482,6 +559,84 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+        namespace
+        {
+          const char* const thread_states[] =
+            { "undf", "rdy", "run", "wait", "term", "dead", "init" };
+
+          unsigned int
+          to_microseconds (rtos::statistics::duration_t cycles)
+          {
+            return static_cast<unsigned int> (cycles * 1000000u
+                / hrclock.input_clock_frequency_hz ());
+          }
+
+          void
+          top_threads (thread* th, unsigned int depth)
+          {
+            for (auto&& p : scheduler::children_threads (th))
+              {
+                class thread::statistics& st = p.statistics ();
+                class thread::stack& stk = p.stack ();
+
+                unsigned int load = st.cpu_load ();
+                unsigned int state = static_cast<unsigned int> (p.state ());
+
+                trace::printf (
+                    "%*s%-*s %-4s %3u %3u.%02u%% %8u %8u %8u %6u\n",
+                    static_cast<int> (depth), "", 16 - static_cast<int> (depth),
+                    p.name (),
+                    state < sizeof(thread_states) / sizeof(thread_states[0]) ?
+                        thread_states[state] : "?",
+                    static_cast<unsigned int> (p.priority ()),
+                    load / 100, load % 100,
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+                    static_cast<unsigned int> (st.context_switches ()),
+#else
+                    0u,
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+                    to_microseconds (st.latency_percentile (990)),
+                    to_microseconds (st.latency_max ()),
+                    static_cast<unsigned int> (stk.high_water_mark ()));
+
+                top_threads (&p, depth + 1);
+              }
+          }
+        } /* namespace */
+
+        /**
+         * @details
+         * For each thread, in the order of the children lists,
+         * one line shows the name, the state, the priority,
+         * the CPU load in the last window, the number of context
+         * switches, the p99 and the maximum wakeup latency, in
+         * microseconds, and the used stack, in bytes.
+         *
+         * The tail latencies are more relevant than the averages,
+         * so the histograms are summarised by percentiles.
+         *
+         * @note This function is available only when
+         * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+         * is defined.
+         *
+         * @warning Cannot be invoked from Interrupt Service Routines.
+         */
+        void
+        top (void)
+        {
+          trace::printf ("%-16s %-4s %3s %7s %8s %8s %8s %6s\n", "thread",
+                         "st", "pri", "load", "switches", "p99 us", "max us",
+                         "stack");
+
+          scheduler::critical_section scs;
+
+          top_threads (nullptr, 0);
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
       } /* namespace statistics */
 
     /**
@@ -623,6 +778,32 @@ namespace os
       {
       }
 
+      // ----------------------------------------------------------------------
+
+      /**
+       * @details
+       * Only the RTOS trace messages are recorded as binary
+       * events, since they are frequent and their timing matters;
+       * the other messages, like the assert ones, must be
+       * readable without the decoder.
+       */
+      int
+      trace_printf (const char* format, ...)
+      {
+        std::va_list args;
+        va_start(args, format);
+
+#if defined(OS_USE_TRACE_EVENTS)
+        trace::events::vrecord (format, args);
+        int ret = 0;
+#else
+        int ret = trace::vprintf (format, args);
+#endif
+
+        va_end(args);
+        return ret;
+      }
+
     } /* namespace internal */
 
   // ==========================================================================
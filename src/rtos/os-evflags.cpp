@@ -164,7 +164,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -202,7 +202,7 @@ namespace os
     event_flags::~event_flags ()
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
@@ -243,8 +243,8 @@ namespace os
                        flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask, mode, this,
-                     name (), event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask,
+                              mode, this, name (), event_flags_.mask ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -265,8 +265,9 @@ namespace os
           if (event_flags_.check_raised (mask, oflags, mode))
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__, mask, mode,
-                             this, name (), event_flags_.mask ());
+              internal::trace_printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__,
+                                      mask, mode, this, name (),
+                                      event_flags_.mask ());
 #endif
               return result::ok;
             }
@@ -278,8 +279,8 @@ namespace os
       // Prepare a list node pointing to the current thread.
       // Do not worry for being on stack, it is temporarily linked to the
       // list and guaranteed to be removed before this function returns.
-      internal::waiting_thread_node node
-        { crt_thread };
+      internal::waiting_flags_node node
+        { crt_thread, mask, mode };
 
       for (;;)
         {
@@ -290,14 +291,16 @@ namespace os
               if (event_flags_.check_raised (mask, oflags, mode))
                 {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-                  trace::printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__, mask,
-                                 mode, this, name (), event_flags_.mask ());
+                  internal::trace_printf ("%s(0x%X,%u) @%p %s >0x%X\n",
+                                          __func__, mask, mode, this, name (),
+                                          event_flags_.mask ());
 #endif
                   return result::ok;
                 }
 
               // Add this thread to the event flags waiting list.
-              scheduler::internal_link_node (list_, node);
+              scheduler::internal_link_node (
+                  list_, node, this, internal::wait_reason::event_flags);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -317,8 +320,8 @@ namespace os
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u) EINTR @%p %s\n", __func__, mask, mode,
-                             this, name ());
+              internal::trace_printf ("%s(0x%X,%u) EINTR @%p %s\n", __func__,
+                                      mask, mode, this, name ());
 #endif
               return EINTR;
             }
@@ -346,8 +349,8 @@ namespace os
                            flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask, mode, this,
-                     name (), event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask,
+                              mode, this, name (), event_flags_.mask ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
@@ -366,16 +369,17 @@ namespace os
           if (event_flags_.check_raised (mask, oflags, mode))
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__, mask, mode,
-                             this, name (), event_flags_.mask ());
+              internal::trace_printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__,
+                                      mask, mode, this, name (),
+                                      event_flags_.mask ());
 #endif
               return result::ok;
             }
           else
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u) EWOULDBLOCK @%p %s \n", __func__,
-                             mask, mode, this, name ());
+              internal::trace_printf ("%s(0x%X,%u) EWOULDBLOCK @%p %s \n",
+                                      __func__, mask, mode, this, name ());
 #endif
               return EWOULDBLOCK;
             }
@@ -428,8 +432,9 @@ namespace os
                              flags::mask_t* oflags, flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X,%u,%u) @%p %s <0x%X\n", __func__, mask, timeout,
-                     mode, this, name (), event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X,%u,%u) @%p %s <0x%X\n", __func__, mask,
+                              timeout, mode, this, name (),
+                              event_flags_.mask ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -452,9 +457,9 @@ namespace os
           if (event_flags_.check_raised (mask, oflags, mode))
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u,%u) @%p %s >0x%X\n", __func__, mask,
-                             timeout, mode, this, name (),
-                             event_flags_.mask ());
+              internal::trace_printf ("%s(0x%X,%u,%u) @%p %s >0x%X\n",
+                                      __func__, mask, timeout, mode, this,
+                                      name (), event_flags_.mask ());
 #endif
               return result::ok;
             }
@@ -466,8 +471,8 @@ namespace os
       // Prepare a list node pointing to the current thread.
       // Do not worry for being on stack, it is temporarily linked to the
       // list and guaranteed to be removed before this function returns.
-      internal::waiting_thread_node node
-        { crt_thread };
+      internal::waiting_flags_node node
+        { crt_thread, mask, mode };
 
       internal::clock_timestamps_list& clock_list = clock_->steady_list ();
       clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
@@ -485,17 +490,18 @@ namespace os
               if (event_flags_.check_raised (mask, oflags, mode))
                 {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-                  trace::printf ("%s(0x%X,%u,%u) @%p %s >0x%X\n", __func__,
-                                 mask, timeout, mode, this, name (),
-                                 event_flags_.mask ());
+                  internal::trace_printf ("%s(0x%X,%u,%u) @%p %s >0x%X\n",
+                                          __func__, mask, timeout, mode, this,
+                                          name (), event_flags_.mask ());
 #endif
                   return result::ok;
                 }
 
               // Add this thread to the event flags waiting list,
               // and the clock timeout list.
-              scheduler::internal_link_node (list_, node, clock_list,
-                                             timeout_node);
+              scheduler::internal_link_node (
+                  list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::event_flags);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -510,8 +516,9 @@ namespace os
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u,%u) EINTR @%p %s 0x%X \n", __func__,
-                             mask, timeout, mode, this, name ());
+              internal::trace_printf ("%s(0x%X,%u,%u) EINTR @%p %s 0x%X \n",
+                                      __func__, mask, timeout, mode, this,
+                                      name ());
 #endif
               return EINTR;
             }
@@ -519,8 +526,9 @@ namespace os
           if (clock_->steady_now () >= timeout_timestamp)
             {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-              trace::printf ("%s(0x%X,%u,%u) ETIMEDOUT @%p %s 0x%X \n",
-                             __func__, mask, timeout, mode, this, name ());
+              internal::trace_printf (
+                  "%s(0x%X,%u,%u) ETIMEDOUT @%p %s 0x%X \n", __func__, mask,
+                  timeout, mode, this, name ());
 #endif
               return ETIMEDOUT;
             }
@@ -536,7 +544,8 @@ namespace os
      * @details
      * Set more bits in the thread current signal mask.
      * Use OR at bit-mask level.
-     * Wake-up all waiting threads, if any.
+     * Wake-up the waiting threads whose condition is satisfied
+     * by the new flags, if any; the other threads are not disturbed.
      *
      * @note Can be invoked from Interrupt Service Routines.
      */
@@ -544,8 +553,8 @@ namespace os
     event_flags::raise (flags::mask_t mask, flags::mask_t* oflags)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X) @%p %s <0x%X \n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s <0x%X \n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
@@ -558,14 +567,46 @@ namespace os
 
       result_t res = event_flags_.raise (mask, oflags);
 
-      // Wake-up all threads, if any.
-      // Need not be inside the critical section,
-      // the list is protected by inner `resume_one()`.
-      list_.resume_all ();
+      // Wake-up only the threads whose condition is satisfied, if any.
+      // The threads are resumed one by one, outside the critical
+      // section, so the list is searched again from the beginning,
+      // since it may be changed meanwhile.
+      for (;;)
+        {
+          thread* th = nullptr;
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              for (auto it = list_.begin (); it != list_.end (); ++it)
+                {
+                  // All nodes linked to this list are flags nodes.
+                  internal::waiting_flags_node* node =
+                      static_cast<internal::waiting_flags_node*> (it.get_iterator_pointer ());
+                  if (event_flags_.is_raised (node->mask_, node->mode_))
+                    {
+                      th = node->thread_;
+                      node->unlink ();
+                      break;
+                    }
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          if (th == nullptr)
+            {
+              break;
+            }
+
+          if (th->state () != thread::state::destroyed)
+            {
+              th->internal_resume_ (this, internal::wait_reason::event_flags);
+            }
+        }
 
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
       return res;
 
@@ -579,8 +620,8 @@ namespace os
     event_flags::clear (flags::mask_t mask, flags::mask_t* oflags)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X) @%p %s <0x%X \n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s <0x%X \n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
@@ -594,8 +635,8 @@ namespace os
       result_t res = event_flags_.clear (mask, oflags);
 
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
 
       return res;
@@ -618,7 +659,8 @@ namespace os
     event_flags::get (flags::mask_t mask, flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X) @%p %s  \n", __func__, mask, this, name ());
+      internal::trace_printf ("%s(0x%X) @%p %s  \n", __func__, mask, this,
+                              name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
@@ -630,8 +672,8 @@ namespace os
       flags::mask_t ret = event_flags_.get (mask, mode);
 
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s(0x%X)=0x%X @%p %s \n", __func__, mask,
-                     event_flags_.mask (), this, name ());
+      internal::trace_printf ("%s(0x%X)=0x%X @%p %s \n", __func__, mask,
+                              event_flags_.mask (), this, name ());
 #endif
       // Return the selected flags.
       return ret;
@@ -646,7 +688,7 @@ namespace os
     event_flags::waiting (void)
     {
 #if defined(OS_TRACE_RTOS_EVFLAGS)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
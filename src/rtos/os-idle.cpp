@@ -61,6 +61,26 @@ os_rtos_idle_enter_power_saving_mode_hook (void)
   return false;
 }
 
+#if defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS)
+
+/**
+ * @details
+ * The hook must stop the system ticks, sleep until the given number
+ * of ticks pass or an interrupt occurs, restart the ticks, and
+ * return how many ticks were skipped.
+ *
+ * The default does not sleep and returns 0, which makes the idle
+ * thread wait for the next interrupt as usual.
+ */
+uint32_t
+__attribute__((weak))
+os_rtos_idle_tickless_sleep_hook (uint32_t ticks __attribute__((unused)))
+{
+  return 0;
+}
+
+#endif /* defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS) */
+
 void
 __attribute__((weak))
 os_rtos_idle_actions (void)
@@ -89,6 +109,12 @@ os_rtos_idle_actions (void)
 
   if (!os_rtos_idle_enter_power_saving_mode_hook ())
     {
+#if defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS)
+      if (sysclock.internal_tickless_sleep ())
+        {
+          return;
+        }
+#endif /* defined(OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS) */
       port::scheduler::wait_for_interrupt ();
     }
 }
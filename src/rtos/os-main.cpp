@@ -203,7 +203,7 @@ os_terminate_goodbye (void)
   class rtos::thread::stack& st = os_main_thread->stack ();
 
   trace::printf ("Main thread stack: %u/%u bytes used\n",
-                 st.size () - st.available (), st.size ());
+                 st.high_water_mark (), st.size ());
 
 #if defined(OS_HAS_INTERRUPTS_STACK)
   trace::printf (
@@ -495,6 +495,331 @@ namespace os
 
       }
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        // The header of each block stores the class index plus 1,
+        // or 0 for the large blocks, not managed by the caches.
+        inline std::size_t&
+        header_tag (void* addr)
+        {
+          return *static_cast<std::size_t*> (static_cast<void*> (static_cast<char*> (addr)
+              - allocation_cache::header_bytes));
+        }
+
+        // For the large blocks, the second word of the header
+        // stores the requested size.
+        inline std::size_t&
+        header_size (void* addr)
+        {
+          return *static_cast<std::size_t*> (static_cast<void*> (static_cast<char*> (addr)
+              - allocation_cache::header_bytes + sizeof(std::size_t)));
+        }
+
+        inline std::size_t
+        class_bytes (std::size_t index)
+        {
+          return allocation_cache::min_class_bytes << index;
+        }
+
+        // Must be called inside a scheduler critical section.
+        void*
+        allocate_block (memory_resource* mr, std::size_t index,
+                        std::size_t bytes)
+        {
+          if (index < allocation_cache::classes)
+            {
+              bytes = class_bytes (index);
+            }
+          else if (bytes > std::numeric_limits<std::size_t>::max ()
+              - allocation_cache::header_bytes)
+            {
+              return nullptr;
+            }
+
+          void* mem = mr->allocate (allocation_cache::header_bytes + bytes);
+          if (mem == nullptr)
+            {
+              return nullptr;
+            }
+
+          mem = static_cast<char*> (mem) + allocation_cache::header_bytes;
+          if (index < allocation_cache::classes)
+            {
+              header_tag (mem) = index + 1;
+            }
+          else
+            {
+              header_tag (mem) = 0;
+              header_size (mem) = bytes;
+            }
+
+          return mem;
+        }
+      } /* namespace */
+
+      static_assert(2 * sizeof(std::size_t) <= allocation_cache::header_bytes,
+          "The header must fit the tag and the size");
+
+      std::size_t
+      allocation_cache::class_index_ (std::size_t bytes) noexcept
+      {
+        std::size_t index = 0;
+        while (index < classes && bytes > class_bytes (index))
+          {
+            ++index;
+          }
+        return index;
+      }
+
+      allocation_cache*
+      allocation_cache::current_ (void) noexcept
+      {
+        // Before the scheduler is started there is no valid thread.
+        if (!scheduler::started ())
+          {
+            return nullptr;
+          }
+
+        thread* th = this_thread::_thread ();
+        if (th == nullptr)
+          {
+            return nullptr;
+          }
+        return &th->allocation_cache_;
+      }
+
+      void*
+      allocation_cache::refill_ (memory_resource* mr, std::size_t index)
+      {
+        // The first block may invoke the out of memory handler.
+        void* mem = allocate_block (mr, index, 0);
+        if (mem == nullptr)
+          {
+            return nullptr;
+          }
+
+        // Prefetch the rest of the batch, but give up quietly
+        // if memory is short.
+        out_of_memory_handler_t handler = mr->out_of_memory_handler_;
+        mr->out_of_memory_handler_ = nullptr;
+
+        while (counts_[index] + 1 < batch)
+          {
+            void* block = allocate_block (mr, index, 0);
+            if (block == nullptr)
+              {
+                break;
+              }
+            static_cast<free_block*> (block)->next = lists_[index];
+            lists_[index] = static_cast<free_block*> (block);
+            ++counts_[index];
+          }
+
+        mr->out_of_memory_handler_ = handler;
+
+        return mem;
+      }
+
+      void
+      allocation_cache::drain_ (memory_resource* mr, std::size_t index,
+                                std::size_t count) noexcept
+      {
+        while (count > 0 && lists_[index] != nullptr)
+          {
+            free_block* block = lists_[index];
+            lists_[index] = block->next;
+            --counts_[index];
+            --count;
+
+            mr->deallocate (static_cast<char*> (static_cast<void*> (block))
+                                - header_bytes,
+                            header_bytes + class_bytes (index));
+          }
+      }
+
+      void
+      allocation_cache::report_ (memory_resource* mr) noexcept
+      {
+        mr->cache_hits_ += hits_;
+        mr->cache_misses_ += misses_;
+
+        hits_ = 0;
+        misses_ = 0;
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * If the size fits one of the classes and the current thread
+       * cache has a free block of that class, return it without
+       * any locking.
+       *
+       * Otherwise, inside a scheduler critical section, refill
+       * the cache with a batch of blocks, or, for large blocks,
+       * allocate them directly from the default application
+       * memory resource.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void*
+      allocation_cache::allocate (std::size_t bytes)
+      {
+        std::size_t index = class_index_ (bytes);
+
+        allocation_cache* cache = nullptr;
+        if (index < classes)
+          {
+            cache = current_ ();
+            if (cache != nullptr && cache->lists_[index] != nullptr)
+              {
+                free_block* block = cache->lists_[index];
+                cache->lists_[index] = block->next;
+                --cache->counts_[index];
+                ++cache->hits_;
+
+                return block;
+              }
+          }
+
+        void* mem;
+          {
+            // ----- Enter critical section -----------------------------------
+            scheduler::critical_section scs;
+
+            memory_resource* mr = estd::pmr::get_default_resource ();
+            if (cache != nullptr)
+              {
+                ++cache->misses_;
+                cache->report_ (mr);
+
+                mem = cache->refill_ (mr, index);
+              }
+            else
+              {
+                mem = allocate_block (mr, index, bytes);
+              }
+            // ----- Exit critical section ------------------------------------
+          }
+
+        return mem;
+      }
+
+      /**
+       * @details
+       * If the block belongs to one of the classes and the current
+       * thread cache is not full, keep it there, without any locking.
+       *
+       * Otherwise, inside a scheduler critical section, drain
+       * a batch of blocks from the cache, or, for large blocks,
+       * return them directly to the default application
+       * memory resource.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void
+      allocation_cache::deallocate (void* addr) noexcept
+      {
+        if (addr == nullptr)
+          {
+            return;
+          }
+
+        std::size_t tag = header_tag (addr);
+        assert(tag <= classes);
+
+        allocation_cache* cache = nullptr;
+        std::size_t index = 0;
+        if (tag != 0)
+          {
+            index = tag - 1;
+            cache = current_ ();
+            if (cache != nullptr && cache->counts_[index] < depth)
+              {
+                static_cast<free_block*> (addr)->next = cache->lists_[index];
+                cache->lists_[index] = static_cast<free_block*> (addr);
+                ++cache->counts_[index];
+
+                return;
+              }
+          }
+
+        // ----- Enter critical section ---------------------------------------
+        scheduler::critical_section scs;
+
+        memory_resource* mr = estd::pmr::get_default_resource ();
+        if (cache != nullptr)
+          {
+            cache->report_ (mr);
+            cache->drain_ (mr, index, batch);
+
+            static_cast<free_block*> (addr)->next = cache->lists_[index];
+            cache->lists_[index] = static_cast<free_block*> (addr);
+            ++cache->counts_[index];
+          }
+        else
+          {
+            mr->deallocate (
+                static_cast<char*> (addr) - header_bytes,
+                header_bytes
+                    + ((tag != 0) ? class_bytes (index) : header_size (addr)));
+          }
+        // ----- Exit critical section ----------------------------------------
+      }
+
+      /**
+       * @details
+       * For blocks belonging to one of the classes, return the
+       * class size; for large blocks, return the requested size,
+       * stored in the header.
+       */
+      std::size_t
+      allocation_cache::usable_size (void* addr) noexcept
+      {
+        if (addr == nullptr)
+          {
+            return 0;
+          }
+
+        std::size_t tag = header_tag (addr);
+        return (tag != 0) ? class_bytes (tag - 1) : header_size (addr);
+      }
+
+      /**
+       * @details
+       * Called when the thread is destroyed, to return all blocks
+       * to the memory resource.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void
+      allocation_cache::flush (void) noexcept
+      {
+        // ----- Enter critical section ---------------------------------------
+        scheduler::critical_section scs;
+
+        memory_resource* mr = estd::pmr::get_default_resource ();
+        report_ (mr);
+
+        for (std::size_t index = 0; index < classes; ++index)
+          {
+            drain_ (mr, index, counts_[index]);
+          }
+        // ----- Exit critical section ----------------------------------------
+      }
+
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
     // ------------------------------------------------------------------------
 
     } /* namespace memory */
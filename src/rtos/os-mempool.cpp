@@ -181,7 +181,7 @@ namespace os
     memory_pool::memory_pool ()
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
     }
 
@@ -190,7 +190,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
     }
 
@@ -270,8 +270,8 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s %u %u\n", __func__, this, this->name (),
-                     blocks, block_size_bytes);
+      internal::trace_printf ("%s() @%p %s %u %u\n", __func__, this,
+                              this->name (), blocks, block_size_bytes);
 #endif
 
       if (attr.mp_pool_address != nullptr)
@@ -358,8 +358,9 @@ namespace os
       );
 
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s %u %u %p %u\n", __func__, this, name (),
-                     blocks_, block_size_bytes_, pool_addr_, pool_size_bytes_);
+      internal::trace_printf ("%s() @%p %s %u %u %p %u\n", __func__, this,
+                              name (), blocks_, block_size_bytes_, pool_addr_,
+                              pool_size_bytes_);
 #endif
 
       std::size_t storage_size = compute_allocated_size_bytes<void*> (
@@ -403,7 +404,7 @@ namespace os
     memory_pool::~memory_pool ()
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // There must be no threads waiting for this pool.
@@ -430,6 +431,31 @@ namespace os
     void
     memory_pool::internal_init_ (void)
     {
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+
+      // Construct a linked list of blocks. Store the 1-based index of
+      // the next free block at the beginning of each block, or 0 at
+      // the end.
+      char* p = static_cast<char*> (pool_addr_);
+      for (std::size_t i = 1; i < blocks_; ++i)
+        {
+          *(static_cast<std::uintptr_t*> (static_cast<void*> (p))) = i + 1;
+          p += block_size_bytes_;
+        }
+
+      // Mark end of list.
+      *(static_cast<std::uintptr_t*> (static_cast<void*> (p))) = 0;
+
+      // Index of first block; keep the tag, to invalidate any
+      // pending update.
+      uint32_t head = head_.load (std::memory_order_relaxed);
+      head_.store (((head + tag_increment) & ~link_mask) | 1,
+                   std::memory_order_release);
+
+      count_.store (0, std::memory_order_relaxed); // No allocated blocks.
+
+#else
+
       // Construct a linked list of blocks. Store the pointer at
       // the beginning of each block. Each block
       // will hold the address of the next free block, or nullptr at the end.
@@ -451,8 +477,79 @@ namespace os
       first_ = pool_addr_; // Pointer to first block.
 
       count_ = 0; // No allocated blocks.
+
+#endif
     }
 
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+        "The lock-free memory pools require lock-free 32-bit atomics.");
+#endif
+
+    /*
+     * Internal function used to return the first block in the
+     * free list (a Treiber stack).
+     * Can be called from any context, without a critical section.
+     */
+    void*
+    memory_pool::internal_try_first_ (void)
+    {
+      uint32_t head = head_.load (std::memory_order_acquire);
+      for (;;)
+        {
+          uint32_t link = head & link_mask;
+          if (link == 0)
+            {
+              return nullptr;
+            }
+
+          char* p = static_cast<char*> (pool_addr_)
+              + (link - 1) * block_size_bytes_;
+
+          // If the block was allocated meanwhile, the link may be
+          // garbage, but then the tag changed and the exchange fails.
+          uint32_t next =
+              static_cast<uint32_t> (*(static_cast<volatile std::uintptr_t*> (
+                  static_cast<void*> (p)))) & link_mask;
+
+          if (head_.compare_exchange_weak (
+              head, ((head + tag_increment) & ~link_mask) | next,
+              std::memory_order_acquire, std::memory_order_acquire))
+            {
+              count_.fetch_add (1, std::memory_order_relaxed);
+              return p;
+            }
+        }
+    }
+
+    /*
+     * Internal function used to push a block back to the
+     * free list.
+     * Can be called from any context, without a critical section.
+     */
+    void
+    memory_pool::internal_push_ (void* block)
+    {
+      uint32_t link = static_cast<uint32_t> ((static_cast<char*> (block)
+          - static_cast<char*> (pool_addr_)) / block_size_bytes_) + 1;
+
+      uint32_t head = head_.load (std::memory_order_relaxed);
+      do
+        {
+          // Link previous list to this block.
+          *(static_cast<volatile std::uintptr_t*> (block)) = head & link_mask;
+        }
+      while (!head_.compare_exchange_weak (
+          head, ((head + tag_increment) & ~link_mask) | link,
+          std::memory_order_acq_rel, std::memory_order_relaxed));
+
+      count_.fetch_sub (1, std::memory_order_relaxed);
+    }
+
+#else
+
     /*
      * Internal function used to return the first block in the
      * free list.
@@ -481,6 +578,8 @@ namespace os
       return nullptr;
     }
 
+#endif
+
     /**
      * @endcond
      */
@@ -508,7 +607,7 @@ namespace os
     memory_pool::alloc (void)
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -520,6 +619,17 @@ namespace os
 
       // Extra test before entering the loop, with its inherent weight.
       // Trade size for speed.
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+      p = internal_try_first_ ();
+      if (p != nullptr)
+        {
+#if defined(OS_TRACE_RTOS_MEMPOOL)
+          internal::trace_printf ("%s()=%p @%p %s\n", __func__, p, this,
+                                  name ());
+#endif
+          return p;
+        }
+#else
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
@@ -528,12 +638,14 @@ namespace os
           if (p != nullptr)
             {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-              trace::printf ("%s()=%p @%p %s\n", __func__, p, this, name ());
+              internal::trace_printf ("%s()=%p @%p %s\n", __func__, p, this,
+                                      name ());
 #endif
               return p;
             }
           // ----- Exit critical section --------------------------------------
         }
+#endif
 
       thread& crt_thread = this_thread::thread ();
 
@@ -553,14 +665,15 @@ namespace os
               if (p != nullptr)
                 {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-                  trace::printf ("%s()=%p @%p %s\n", __func__, p, this,
-                                 name ());
+                  internal::trace_printf ("%s()=%p @%p %s\n", __func__, p,
+                                          this, name ());
 #endif
                   return p;
                 }
 
               // Add this thread to the memory pool waiting list.
-              scheduler::internal_link_node (list_, node);
+              scheduler::internal_link_node (
+                  list_, node, this, internal::wait_reason::memory_pool);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -574,7 +687,8 @@ namespace os
           if (this_thread::thread ().interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-              trace::printf ("%s() INTR @%p %s\n", __func__, this, name ());
+              internal::trace_printf ("%s() INTR @%p %s\n", __func__, this,
+                                      name ());
 #endif
               return nullptr;
             }
@@ -604,13 +718,16 @@ namespace os
     memory_pool::try_alloc (void)
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from high priority interrupts.
       assert(port::interrupts::is_priority_valid ());
 
       void* p;
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+      p = internal_try_first_ ();
+#else
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
@@ -618,9 +735,10 @@ namespace os
           p = internal_try_first_ ();
           // ----- Exit critical section --------------------------------------
         }
+#endif
 
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s()=%p @%p %s\n", __func__, p, this, name ());
+      internal::trace_printf ("%s()=%p @%p %s\n", __func__, p, this, name ());
 #endif
       return p;
     }
@@ -674,8 +792,9 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u) @%p %s\n", __func__,
-                     static_cast<unsigned int> (timeout), this, name ());
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__,
+                              static_cast<unsigned int> (timeout), this,
+                              name ());
 #pragma GCC diagnostic pop
 #endif
 
@@ -688,6 +807,17 @@ namespace os
 
       // Extra test before entering the loop, with its inherent weight.
       // Trade size for speed.
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+      p = internal_try_first_ ();
+      if (p != nullptr)
+        {
+#if defined(OS_TRACE_RTOS_MEMPOOL)
+          internal::trace_printf ("%s()=%p @%p %s\n", __func__, p, this,
+                                  name ());
+#endif
+          return p;
+        }
+#else
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
@@ -696,12 +826,14 @@ namespace os
           if (p != nullptr)
             {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-              trace::printf ("%s()=%p @%p %s\n", __func__, p, this, name ());
+              internal::trace_printf ("%s()=%p @%p %s\n", __func__, p, this,
+                                      name ());
 #endif
               return p;
             }
           // ----- Exit critical section --------------------------------------
         }
+#endif
 
       thread& crt_thread = this_thread::thread ();
 
@@ -728,16 +860,17 @@ namespace os
               if (p != nullptr)
                 {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-                  trace::printf ("%s()=%p @%p %s\n", __func__, p, this,
-                                 name ());
+                  internal::trace_printf ("%s()=%p @%p %s\n", __func__, p,
+                                          this, name ());
 #endif
                   return p;
                 }
 
               // Add this thread to the memory pool waiting list,
               // and the clock timeout list.
-              scheduler::internal_link_node (list_, node, clock_list,
-                                             timeout_node);
+              scheduler::internal_link_node (
+                  list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::memory_pool);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -752,7 +885,8 @@ namespace os
           if (this_thread::thread ().interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-              trace::printf ("%s() INTR @%p %s\n", __func__, this, name ());
+              internal::trace_printf ("%s() INTR @%p %s\n", __func__, this,
+                                      name ());
 #endif
               return nullptr;
             }
@@ -760,7 +894,8 @@ namespace os
           if (clock_->steady_now () >= timeout_timestamp)
             {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-              trace::printf ("%s() TMO @%p %s\n", __func__, this, name ());
+              internal::trace_printf ("%s() TMO @%p %s\n", __func__, this,
+                                      name ());
 #endif
               return nullptr;
             }
@@ -783,7 +918,8 @@ namespace os
     memory_pool::free (void* block)
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s(%p) @%p %s\n", __func__, block, this, name ());
+      internal::trace_printf ("%s(%p) @%p %s\n", __func__, block, this,
+                              name ());
 #endif
 
       // Don't call this from high priority interrupts.
@@ -795,12 +931,26 @@ namespace os
               >= (static_cast<char*> (pool_addr_) + blocks_ * block_size_bytes_)))
         {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-          trace::printf ("%s(%p) EINVAL @%p %s\n", __func__, block, this,
-                         name ());
+          internal::trace_printf ("%s(%p) EINVAL @%p %s\n", __func__, block,
+                                  this, name ());
 #endif
           return EINVAL;
         }
 
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+
+      internal_push_ (block);
+
+      // Wake-up one thread, if any. The waiting threads are linked
+      // inside a critical section, after checking again the free list,
+      // so a thread that did not see this block is already in the list.
+      if (!list_.empty ())
+        {
+          list_.resume_one (this, internal::wait_reason::memory_pool);
+        }
+
+#else
+
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
@@ -828,7 +978,9 @@ namespace os
         }
 
       // Wake-up one thread, if any.
-      list_.resume_one ();
+      list_.resume_one (this, internal::wait_reason::memory_pool);
+
+#endif
 
       return result::ok;
     }
@@ -843,7 +995,7 @@ namespace os
     memory_pool::reset (void)
     {
 #if defined(OS_TRACE_RTOS_MEMPOOL)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -860,7 +1012,7 @@ namespace os
       // Wake-up all threads, if any.
       // Need not be inside the critical section,
       // the list is protected by inner `resume_one()`.
-      list_.resume_all ();
+      list_.resume_all (this, internal::wait_reason::memory_pool);
 
       return result::ok;
     }
@@ -334,7 +334,7 @@ namespace os
     message_queue::message_queue ()
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
     }
 
@@ -343,7 +343,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
     }
 
@@ -425,8 +425,8 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s() @%p %s %u %u\n", __func__, this, this->name (), msgs,
-                     msg_size_bytes);
+      internal::trace_printf ("%s() @%p %s %u %u\n", __func__, this,
+                              this->name (), msgs, msg_size_bytes);
 #endif
 
       if (attr.mq_queue_address != nullptr)
@@ -441,7 +441,8 @@ namespace os
           // If no user storage was provided via attributes,
           // allocate it dynamically via the allocator.
           allocated_queue_size_elements_ = (compute_allocated_size_bytes<
-              typename allocator_type::value_type> (msgs, msg_size_bytes)
+              typename allocator_type::value_type> (msgs, msg_size_bytes,
+                                                    attr.mq_ordering)
               + sizeof(typename allocator_type::value_type) - 1)
               / sizeof(typename allocator_type::value_type);
 
@@ -476,7 +477,7 @@ namespace os
     message_queue::~message_queue ()
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
 #if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
@@ -548,13 +549,14 @@ namespace os
         }
 
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s() @%p %s %u %u %p %u\n", __func__, this, name (),
-                     msgs_, msg_size_bytes_, queue_addr_, queue_size_bytes_);
+      internal::trace_printf ("%s() @%p %s %u %u %p %u\n", __func__, this,
+                              name (), msgs_, msg_size_bytes_, queue_addr_,
+                              queue_size_bytes_);
 #endif
 
 #if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
       std::size_t storage_size = compute_allocated_size_bytes<void*> (
-          msgs, msg_size_bytes);
+          msgs, msg_size_bytes, attr.mq_ordering);
 #endif
       if (queue_addr_ != nullptr)
         {
@@ -613,6 +615,27 @@ namespace os
               <= static_cast<ptrdiff_t> (queue_size_bytes_));
 #endif
 
+      os_assert_throw(attr.mq_ordering <= ordering::max_, EINVAL);
+      if (attr.mq_ordering == ordering::indexed)
+        {
+          // The priority index follows the priority array, aligned
+          // as in compute_allocated_size_bytes().
+          prio_map_ =
+              reinterpret_cast<uint32_t*> (static_cast<char*> (queue_addr_)
+                  + storage_size
+                  - ((ordering_index_size_bytes + (sizeof(void*) - 1))
+                      & ~(sizeof(void*) - 1)));
+          // The array of tails follows immediately the bitmap.
+          prio_tails_ =
+              reinterpret_cast<index_t*> (const_cast<uint32_t*> (prio_map_)
+                  + 1 + (max_priority + 1) / 32);
+        }
+      else
+        {
+          prio_map_ = nullptr;
+          prio_tails_ = nullptr;
+        }
+
       internal_init_ ();
 #endif
     }
@@ -645,14 +668,31 @@ namespace os
 
       first_free_ = queue_addr_; // Pointer to first block.
 
+      // All slots are free; the slots reserved or borrowed before
+      // the reset are no longer accepted by commit() and release().
+      for (std::size_t i = 0; i < msgs_; ++i)
+        {
+          prev_array_[i] = no_index;
+          next_array_[i] = slot_free;
+        }
+
       head_ = no_index;
 
+      if (prio_map_ != nullptr)
+        {
+          // No priorities present.
+          for (std::size_t i = 0; i < 1 + (max_priority + 1) / 32; ++i)
+            {
+              prio_map_[i] = 0;
+            }
+        }
+
       // Need not be inside the critical section,
       // the lists are protected by inner `resume_one()`.
 
       // Wake-up all threads, if any.
-      send_list_.resume_all ();
-      receive_list_.resume_all ();
+      send_list_.resume_all (this, internal::wait_reason::message_queue);
+      receive_list_.resume_all (this, internal::wait_reason::message_queue);
 
 #endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
 
@@ -664,46 +704,49 @@ namespace os
      * Internal function.
      * Should be called from an interrupts critical section.
      */
-    bool
-    message_queue::internal_try_send_ (const void* msg, std::size_t nbytes,
-                                       priority_t mprio)
+    void*
+    message_queue::internal_try_reserve_ (void)
     {
       if (first_free_ == nullptr)
         {
           // No available space to send the message.
-          return false;
+          return nullptr;
         }
 
-      // The first step is to remove the free block from the list,
+      // Remove the free block from the list,
       // so another concurrent call will not get it too.
-
-      // Get the address where the message will be copied.
-      // This is the first free memory block.
-      char* dest = static_cast<char*> (first_free_);
+      void* slot = first_free_;
 
       // Update to next free, if any (the last one has nullptr).
       first_free_ = *(static_cast<void**> (first_free_));
 
-      // The second step is to copy the message from the user buffer.
-        {
-          // ----- Enter uncritical section -----------------------------------
-          // interrupts::uncritical_section iucs;
+      next_array_[internal_index_ (slot)] = slot_reserved;
 
-          // Copy message from user buffer to queue storage.
-          std::memcpy (dest, msg, nbytes);
-          if (nbytes < msg_size_bytes_)
-            {
-              // Fill in the remaining space with 0x00.
-              std::memset (dest + nbytes, 0x00, msg_size_bytes_ - nbytes);
-            }
-          // ----- Exit uncritical section ------------------------------------
-        }
+      return slot;
+    }
 
-      // The third step is to link the buffer to the list.
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    void
+    message_queue::internal_commit_ (void* slot, priority_t mprio)
+    {
+      internal_enlist_ (slot, mprio);
 
+      // Wake-up one thread, if any.
+      receive_list_.resume_one (this, internal::wait_reason::message_queue);
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    void
+    message_queue::internal_enlist_ (void* slot, priority_t mprio)
+    {
       // Using the address, compute the index in the array.
-      std::size_t msg_ix = (static_cast<std::size_t> (dest
-          - static_cast<char*> (queue_addr_)) / msg_size_bytes_);
+      std::size_t msg_ix = internal_index_ (slot);
       prio_array_[msg_ix] = mprio;
 
       if (head_ == no_index)
@@ -719,8 +762,32 @@ namespace os
           std::size_t ix;
           // Arrange to insert between head and tail.
           ix = prev_array_[head_];
+          if (prio_map_ != nullptr)
+            {
+              if ((prio_map_[1 + mprio / 32] & (1u << (mprio % 32))) != 0)
+                {
+                  // Insert after the last message with the same priority.
+                  ix = prio_tails_[mprio];
+                }
+              else
+                {
+                  std::size_t hprio = internal_higher_priority_ (mprio);
+                  if (hprio > max_priority)
+                    {
+                      // Having the highest priority, the new message
+                      // becomes the new head.
+                      head_ = static_cast<index_t> (msg_ix);
+                    }
+                  else
+                    {
+                      // Insert after the last message with the
+                      // closest higher priority.
+                      ix = prio_tails_[hprio];
+                    }
+                }
+            }
           // Check if the priority is higher than the head priority.
-          if (mprio > prio_array_[head_])
+          else if (mprio > prio_array_[head_])
             {
               // Having the highest priority, the new message
               // becomes the new head.
@@ -744,42 +811,52 @@ namespace os
           prev_array_[tmp_ix] = static_cast<index_t> (msg_ix);
         }
 
+      if (prio_map_ != nullptr)
+        {
+          // The new message is the last one with its priority.
+          prio_tails_[mprio] = static_cast<index_t> (msg_ix);
+          std::size_t word = 1 + mprio / 32;
+          prio_map_[word] = prio_map_[word] | (1u << (mprio % 32));
+          prio_map_[0] = prio_map_[0] | (1u << (mprio / 32));
+        }
+
       // One more message added to the queue.
       ++count_;
-
-      // Wake-up one thread, if any.
-      receive_list_.resume_one ();
-
-      return true;
     }
 
-#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
-
-#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
-
     /*
      * Internal function.
      * Should be called from an interrupts critical section.
      */
-    bool
-    message_queue::internal_try_receive_ (void* msg, std::size_t nbytes,
-                                          priority_t* mprio)
+    void*
+    message_queue::internal_try_borrow_ (priority_t* mprio)
     {
-
       if (head_ == no_index)
         {
-          return false;
+          return nullptr;
         }
 
       // Compute the message source address.
-      char* src = static_cast<char*> (queue_addr_) + head_ * msg_size_bytes_;
-      priority_t prio = prio_array_[head_];
+      std::size_t msg_ix = head_;
+      char* src = static_cast<char*> (queue_addr_) + msg_ix * msg_size_bytes_;
+      *mprio = prio_array_[msg_ix];
 
 #if defined(OS_TRACE_RTOS_MQUEUE_)
-      trace::printf ("%s(%p,%u) @%p %s src %p %p\n", __func__, msg, nbytes,
-          this, name (), src, first_free_);
+      internal::trace_printf ("%s() @%p %s src %p %p\n", __func__, this,
+                              name (), src, first_free_);
 #endif
 
+      if ((prio_map_ != nullptr) && (prio_tails_[*mprio] == head_))
+        {
+          // The last message with this priority was removed.
+          std::size_t word = 1 + *mprio / 32;
+          prio_map_[word] = prio_map_[word] & ~(1u << (*mprio % 32));
+          if (prio_map_[word] == 0)
+            {
+              prio_map_[0] = prio_map_[0] & ~(1u << (*mprio / 32));
+            }
+        }
+
       // Unlink it from the list, so another concurrent call will
       // not get it too.
       if (count_ > 1)
@@ -797,8 +874,161 @@ namespace os
           head_ = no_index;
         }
 
+      prev_array_[msg_ix] = no_index;
+      next_array_[msg_ix] = slot_borrowed;
+
       --count_;
 
+      return src;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    void
+    message_queue::internal_release_ (void* slot)
+    {
+      internal_free_ (slot);
+
+      // Wake-up one thread, if any.
+      send_list_.resume_one (this, internal::wait_reason::message_queue);
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    void
+    message_queue::internal_free_ (void* slot)
+    {
+      // Perform a push_front() on the single linked LIFO list,
+      // i.e. add the block to the beginning of the list.
+
+      // Link previous list to this block; may be null, but it does
+      // not matter.
+      *(static_cast<void**> (slot)) = first_free_;
+
+      // Now this block is the first one.
+      first_free_ = slot;
+
+      next_array_[internal_index_ (slot)] = slot_free;
+    }
+
+    std::size_t
+    message_queue::internal_index_ (const void* slot) const
+    {
+      return static_cast<std::size_t> (static_cast<const char*> (slot)
+          - static_cast<const char*> (queue_addr_)) / msg_size_bytes_;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    message_queue::internal_is_slot_ (const void* slot, index_t state) const
+    {
+      if (slot < queue_addr_)
+        {
+          return false;
+        }
+
+      std::size_t offset = static_cast<std::size_t> (
+          static_cast<const char*> (slot)
+              - static_cast<const char*> (queue_addr_));
+      if ((offset >= static_cast<std::size_t> (msgs_) * msg_size_bytes_)
+          || (offset % msg_size_bytes_ != 0))
+        {
+          return false;
+        }
+
+      // Queued slots have a valid previous index.
+      std::size_t msg_ix = offset / msg_size_bytes_;
+      return (prev_array_[msg_ix] == no_index)
+          && (next_array_[msg_ix] == state);
+    }
+
+    std::size_t
+    message_queue::internal_higher_priority_ (priority_t mprio) const
+    {
+      std::size_t word = mprio / 32;
+      std::size_t bit = mprio % 32;
+
+      // Priorities above mprio in the same word.
+      uint32_t map =
+          (bit < 31) ? (prio_map_[1 + word] & (~0u << (bit + 1))) : 0;
+      if (map == 0)
+        {
+          // Non-empty words above the current one.
+          uint32_t summary = prio_map_[0] & (~0u << (word + 1));
+          if (summary == 0)
+            {
+              return max_priority + 1;
+            }
+          word = static_cast<std::size_t> (__builtin_ctz (summary));
+          map = prio_map_[1 + word];
+        }
+
+      return word * 32 + static_cast<std::size_t> (__builtin_ctz (map));
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    message_queue::internal_try_send_ (const void* msg, std::size_t nbytes,
+                                       priority_t mprio)
+    {
+      // The first step is to remove the free block from the list,
+      // so another concurrent call will not get it too.
+
+      // Get the address where the message will be copied.
+      // This is the first free memory block.
+      char* dest = static_cast<char*> (internal_try_reserve_ ());
+      if (dest == nullptr)
+        {
+          // No available space to send the message.
+          return false;
+        }
+
+      // The second step is to copy the message from the user buffer.
+        {
+          // ----- Enter uncritical section -----------------------------------
+          // interrupts::uncritical_section iucs;
+
+          // Copy message from user buffer to queue storage.
+          std::memcpy (dest, msg, nbytes);
+          if (nbytes < msg_size_bytes_)
+            {
+              // Fill in the remaining space with 0x00.
+              std::memset (dest + nbytes, 0x00, msg_size_bytes_ - nbytes);
+            }
+          // ----- Exit uncritical section ------------------------------------
+        }
+
+      // The third step is to link the buffer to the list.
+      internal_commit_ (dest, mprio);
+
+      return true;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    message_queue::internal_try_receive_ (void* msg, std::size_t nbytes,
+                                          priority_t* mprio)
+    {
+      priority_t prio;
+      char* src = static_cast<char*> (internal_try_borrow_ (&prio));
+      if (src == nullptr)
+        {
+          return false;
+        }
+
       // Copy to destination
         {
           // ----- Enter uncritical section -----------------------------------
@@ -814,21 +1044,103 @@ namespace os
         }
 
       // After the message was copied, the block can be released.
+      internal_release_ (src);
 
-      // Perform a push_front() on the single linked LIFO list,
-      // i.e. add the block to the beginning of the list.
+      return true;
+    }
 
-      // Link previous list to this block; may be null, but it does
-      // not matter.
-      *(static_cast<void**> (static_cast<void*> (src))) = first_free_;
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    std::size_t
+    message_queue::internal_try_send_n_ (const void* msg_array,
+                                         std::size_t count, std::size_t nbytes,
+                                         priority_t mprio)
+    {
+      const char* src = static_cast<const char*> (msg_array);
+      std::size_t n;
+      for (n = 0; n < count; ++n, src += nbytes)
+        {
+          char* dest = static_cast<char*> (internal_try_reserve_ ());
+          if (dest == nullptr)
+            {
+              // No more space in the queue.
+              break;
+            }
 
-      // Now this block is the first one.
-      first_free_ = src;
+          // Copy outside the critical section, such that the
+          // interrupts latency does not depend on the batch size;
+          // the reserved slot is not reachable by other calls.
+            {
+              // ----- Enter uncritical section -------------------------------
+              interrupts::uncritical_section iucs;
 
-      // Wake-up one thread, if any.
-      send_list_.resume_one ();
+              // Copy message from user buffer to queue storage.
+              std::memcpy (dest, src, nbytes);
+              if (nbytes < msg_size_bytes_)
+                {
+                  // Fill in the remaining space with 0x00.
+                  std::memset (dest + nbytes, 0x00, msg_size_bytes_ - nbytes);
+                }
+              // ----- Exit uncritical section --------------------------------
+            }
 
-      return true;
+          internal_enlist_ (dest, mprio);
+        }
+
+      // Wake-up the receivers once per batch, at most one
+      // for each message added.
+      receive_list_.resume_n (this, internal::wait_reason::message_queue, n);
+
+      return n;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    std::size_t
+    message_queue::internal_try_receive_n_ (void* msg_array, std::size_t count,
+                                            std::size_t nbytes,
+                                            priority_t* mprios)
+    {
+      char* dest = static_cast<char*> (msg_array);
+      std::size_t n;
+      for (n = 0; n < count; ++n, dest += nbytes)
+        {
+          priority_t prio;
+          char* src = static_cast<char*> (internal_try_borrow_ (&prio));
+          if (src == nullptr)
+            {
+              // No more messages in the queue.
+              break;
+            }
+
+          // Copy outside the critical section, such that the
+          // interrupts latency does not depend on the batch size;
+          // the borrowed slot is not reachable by other calls.
+            {
+              // ----- Enter uncritical section -------------------------------
+              interrupts::uncritical_section iucs;
+
+              // Copy message from queue to user buffer.
+              std::memcpy (dest, src, nbytes);
+              if (mprios != nullptr)
+                {
+                  mprios[n] = prio;
+                }
+              // ----- Exit uncritical section --------------------------------
+            }
+
+          internal_free_ (src);
+        }
+
+      // Wake-up the senders once per batch, at most one
+      // for each message removed.
+      send_list_.resume_n (this, internal::wait_reason::message_queue, n);
+
+      return n;
     }
 
 #endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
@@ -879,8 +1191,8 @@ namespace os
     message_queue::send (const void* msg, std::size_t nbytes, priority_t mprio)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s(%p,%d,%d) @%p %s\n", __func__, msg, nbytes, mprio,
-                     this, name ());
+      internal::trace_printf ("%s(%p,%d,%d) @%p %s\n", __func__, msg, nbytes,
+                              mprio, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -928,7 +1240,9 @@ namespace os
                 }
 
               // Add this thread to the message queue send waiting list.
-              scheduler::internal_link_node (send_list_, node);
+              scheduler::internal_link_node (
+                  send_list_, node, this,
+                  internal::wait_reason::message_queue);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -942,8 +1256,8 @@ namespace os
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-              trace::printf ("%s(%p,%d,%d) EINTR @%p %s\n", __func__, msg,
-                             nbytes, mprio, this, name ());
+              internal::trace_printf ("%s(%p,%d,%d) EINTR @%p %s\n", __func__,
+                                      msg, nbytes, mprio, this, name ());
 #endif
               return EINTR;
             }
@@ -991,8 +1305,8 @@ namespace os
                              priority_t mprio)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s(%p,%u,%u) @%p %s\n", __func__, msg, nbytes, mprio,
-                     this, name ());
+      internal::trace_printf ("%s(%p,%u,%u) @%p %s\n", __func__, msg, nbytes,
+                              mprio, this, name ());
 #endif
 
       os_assert_err(msg != nullptr, EINVAL);
@@ -1075,8 +1389,8 @@ namespace os
                                clock::duration_t timeout, priority_t mprio)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s(%p,%u,%u,%u) @%p %s\n", __func__, msg, nbytes, mprio,
-                     timeout, this, name ());
+      internal::trace_printf ("%s(%p,%u,%u,%u) @%p %s\n", __func__, msg,
+                              nbytes, mprio, timeout, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1135,8 +1449,9 @@ namespace os
 
               // Add this thread to the semaphore waiting list,
               // and the clock timeout list.
-              scheduler::internal_link_node (send_list_, node, clock_list,
-                                             timeout_node);
+              scheduler::internal_link_node (
+                  send_list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::message_queue);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -1151,8 +1466,9 @@ namespace os
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-              trace::printf ("%s(%p,%u,%u,%u) EINTR @%p %s\n", __func__, msg,
-                             nbytes, mprio, timeout, this, name ());
+              internal::trace_printf ("%s(%p,%u,%u,%u) EINTR @%p %s\n",
+                                      __func__, msg, nbytes, mprio, timeout,
+                                      this, name ());
 #endif
               return EINTR;
             }
@@ -1160,8 +1476,9 @@ namespace os
           if (clock_->steady_now () >= timeout_timestamp)
             {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-              trace::printf ("%s(%p,%u,%u,%u) ETIMEDOUT @%p %s\n", __func__,
-                             msg, nbytes, mprio, timeout, this, name ());
+              internal::trace_printf ("%s(%p,%u,%u,%u) ETIMEDOUT @%p %s\n",
+                                      __func__, msg, nbytes, mprio, timeout,
+                                      this, name ());
 #endif
               return ETIMEDOUT;
             }
@@ -1211,8 +1528,8 @@ namespace os
     message_queue::receive (void* msg, std::size_t nbytes, priority_t* mprio)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s(%p,%u) @%p %s\n", __func__, msg, nbytes, this,
-                     name ());
+      internal::trace_printf ("%s(%p,%u) @%p %s\n", __func__, msg, nbytes,
+                              this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1262,7 +1579,9 @@ namespace os
                 }
 
               // Add this thread to the message queue receive waiting list.
-              scheduler::internal_link_node (receive_list_, node);
+              scheduler::internal_link_node (
+                  receive_list_, node, this,
+                  internal::wait_reason::message_queue);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -1276,8 +1595,8 @@ namespace os
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-              trace::printf ("%s(%p,%u) EINTR @%p %s\n", __func__, msg, nbytes,
-                             this, name ());
+              internal::trace_printf ("%s(%p,%u) EINTR @%p %s\n", __func__,
+                                      msg, nbytes, this, name ());
 #endif
               return EINTR;
             }
@@ -1324,8 +1643,8 @@ namespace os
                                 priority_t* mprio)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s(%p,%u) @%p %s\n", __func__, msg, nbytes, this,
-                     name ());
+      internal::trace_printf ("%s(%p,%u) @%p %s\n", __func__, msg, nbytes,
+                              this, name ());
 #endif
 
       os_assert_err(msg != nullptr, EINVAL);
@@ -1422,8 +1741,8 @@ namespace os
                                   clock::duration_t timeout, priority_t* mprio)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s(%p,%u,%u) @%p %s\n", __func__, msg, nbytes, timeout,
-                     this, name ());
+      internal::trace_printf ("%s(%p,%u,%u) @%p %s\n", __func__, msg, nbytes,
+                              timeout, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1482,8 +1801,9 @@ namespace os
 
               // Add this thread to the message queue receive waiting list,
               // and the clock timeout list.
-              scheduler::internal_link_node (receive_list_, node, clock_list,
-                                             timeout_node);
+              scheduler::internal_link_node (
+                  receive_list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::message_queue);
               // state::suspended set in above link().
               // ----- Exit critical section ----------------------------------
             }
@@ -1498,8 +1818,8 @@ namespace os
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-              trace::printf ("%s(%p,%u,%u) EINTR @%p %s\n", __func__, msg,
-                             nbytes, timeout, this, name ());
+              internal::trace_printf ("%s(%p,%u,%u) EINTR @%p %s\n", __func__,
+                                      msg, nbytes, timeout, this, name ());
 #endif
               return EINTR;
             }
@@ -1507,8 +1827,9 @@ namespace os
           if (clock_->steady_now () >= timeout_timestamp)
             {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-              trace::printf ("%s(%p,%u,%u) ETIMEDOUT @%p %s\n", __func__, msg,
-                             nbytes, timeout, this, name ());
+              internal::trace_printf ("%s(%p,%u,%u) ETIMEDOUT @%p %s\n",
+                                      __func__, msg, nbytes, timeout, this,
+                                      name ());
 #endif
               return ETIMEDOUT;
             }
@@ -1525,6 +1846,12 @@ namespace os
      * Clear both send and receive counter and return the queue to the
      * initial state.
      *
+     * All slots obtained with `reserve()` or `borrow()` and not yet
+     * committed or released are returned to the free slots;
+     * `commit()` and `release()` reject them with `EINVAL`, unless
+     * they are reserved or borrowed again, so the owners must
+     * no longer use them.
+     *
      * @par POSIX compatibility
      *  Extension to standard, no POSIX similar functionality identified.
      *
@@ -1534,7 +1861,7 @@ namespace os
     message_queue::reset (void)
     {
 #if defined(OS_TRACE_RTOS_MQUEUE)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1558,6 +1885,1151 @@ namespace os
 #endif
     }
 
+#if !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE)
+
+    /**
+     * @details
+     * The `reserve()` function shall remove a free slot from the
+     * message queue storage and return its address in the location
+     * referenced by _slot_. The slot has `msg_size()` bytes, and
+     * the caller can fill it in place, then pass it to `commit()`
+     * to enqueue it, or to `release()` to abandon it.
+     *
+     * If the message queue is full, `reserve()` shall block
+     * until a slot becomes available, or until `reserve()` is
+     * cancelled/interrupted, exactly like `send()`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::reserve (void** slot)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(slot != nullptr, EINVAL);
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          *slot = internal_try_reserve_ ();
+          if (*slot != nullptr)
+            {
+              return result::ok;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              *slot = internal_try_reserve_ ();
+              if (*slot != nullptr)
+                {
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue send waiting list.
+              scheduler::internal_link_node (
+                  send_list_, node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue send waiting list,
+          // if not already removed by receive().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s() EINTR @%p %s\n", __func__, this,
+                                      name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_reserve()` function shall try to remove a free slot
+     * from the message queue storage, like `reserve()`.
+     *
+     * If the message queue is full, `try_reserve()` shall
+     * return an error.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::try_reserve (void** slot)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      os_assert_err(slot != nullptr, EINVAL);
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          *slot = internal_try_reserve_ ();
+          if (*slot != nullptr)
+            {
+              return result::ok;
+            }
+          else
+            {
+              return EWOULDBLOCK;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+    }
+
+    /**
+     * @details
+     * The `timed_reserve()` function shall remove a free slot
+     * from the message queue storage, like `reserve()`.
+     *
+     * If the message queue is full, the wait for a free slot
+     * shall be terminated when the specified timeout expires,
+     * exactly like `timed_send()`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::timed_reserve (void** slot, clock::duration_t timeout)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__, timeout, this,
+                              name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(slot != nullptr, EINVAL);
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          *slot = internal_try_reserve_ ();
+          if (*slot != nullptr)
+            {
+              return result::ok;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              *slot = internal_try_reserve_ ();
+              if (*slot != nullptr)
+                {
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue send waiting list,
+              // and the clock timeout list.
+              scheduler::internal_link_node (
+                  send_list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue send waiting list,
+          // if not already removed by receive() and from the clock timeout list,
+          // if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%u) EINTR @%p %s\n", __func__,
+                                      timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%u) ETIMEDOUT @%p %s\n", __func__,
+                                      timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `commit()` function shall add the slot previously
+     * obtained with `reserve()` to the message queue, at the
+     * position indicated by the _mprio_ argument, with the same
+     * ordering rules as `send()`. The content is not copied, and
+     * the slot must not be accessed by the sender after this call.
+     *
+     * If the slot is not reserved, for example if it was already
+     * committed or released, or the queue was reset, `commit()`
+     * shall fail with `EINVAL`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::commit (void* slot, priority_t mprio)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u) @%p %s\n", __func__, slot, mprio,
+                              this, name ());
+#endif
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          if (!internal_is_slot_ (slot, slot_reserved))
+            {
+              return EINVAL;
+            }
+
+          internal_commit_ (slot, mprio);
+          return result::ok;
+          // ----- Exit critical section --------------------------------------
+        }
+    }
+
+    /**
+     * @details
+     * The `borrow()` function shall remove the oldest of the highest
+     * priority message(s) from the message queue, like `receive()`,
+     * but instead of copying it, return the address of its slot in
+     * the location referenced by _slot_. The slot must be
+     * returned with `release()` after the content was processed.
+     *
+     * If the argument _mprio_ is not nullptr, the priority of the selected
+     * message shall be stored in the location referenced by _mprio_.
+     *
+     * If the message queue is empty, `borrow()` shall block
+     * until a message is enqueued on the message queue or until
+     * `borrow()` is cancelled/interrupted, exactly like `receive()`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::borrow (void** slot, priority_t* mprio)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(slot != nullptr, EINVAL);
+
+      priority_t prio;
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          *slot = internal_try_borrow_ (&prio);
+          if (*slot != nullptr)
+            {
+              if (mprio != nullptr)
+                {
+                  *mprio = prio;
+                }
+              return result::ok;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              *slot = internal_try_borrow_ (&prio);
+              if (*slot != nullptr)
+                {
+                  if (mprio != nullptr)
+                    {
+                      *mprio = prio;
+                    }
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue receive waiting list.
+              scheduler::internal_link_node (
+                  receive_list_, node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue receive waiting list,
+          // if not already removed by send().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s() EINTR @%p %s\n", __func__, this,
+                                      name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_borrow()` function shall try to remove the oldest of
+     * the highest priority message(s) from the message queue,
+     * like `borrow()`.
+     *
+     * If the message queue is empty, `try_borrow()` shall
+     * return an error.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::try_borrow (void** slot, priority_t* mprio)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      os_assert_err(slot != nullptr, EINVAL);
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+      priority_t prio;
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          *slot = internal_try_borrow_ (&prio);
+          if (*slot != nullptr)
+            {
+              if (mprio != nullptr)
+                {
+                  *mprio = prio;
+                }
+              return result::ok;
+            }
+          else
+            {
+              return EWOULDBLOCK;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+    }
+
+    /**
+     * @details
+     * The `timed_borrow()` function shall remove the oldest of
+     * the highest priority message(s) from the message queue,
+     * like `borrow()`.
+     *
+     * If the message queue is empty, the wait for a message
+     * shall be terminated when the specified timeout expires,
+     * exactly like `timed_receive()`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::timed_borrow (void** slot, clock::duration_t timeout,
+                                 priority_t* mprio)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__, timeout, this,
+                              name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(slot != nullptr, EINVAL);
+
+      priority_t prio;
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          *slot = internal_try_borrow_ (&prio);
+          if (*slot != nullptr)
+            {
+              if (mprio != nullptr)
+                {
+                  *mprio = prio;
+                }
+              return result::ok;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              *slot = internal_try_borrow_ (&prio);
+              if (*slot != nullptr)
+                {
+                  if (mprio != nullptr)
+                    {
+                      *mprio = prio;
+                    }
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue receive waiting list,
+              // and the clock timeout list.
+              scheduler::internal_link_node (
+                  receive_list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue receive waiting list,
+          // if not already removed by send() and from the clock timeout list,
+          // if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%u) EINTR @%p %s\n", __func__,
+                                      timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%u) ETIMEDOUT @%p %s\n", __func__,
+                                      timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `release()` function shall return to the message queue
+     * storage a slot obtained with `borrow()`, after its content
+     * was processed, or a slot obtained with `reserve()` and not
+     * committed. One thread waiting to send, if any, is resumed.
+     *
+     * If the slot is neither borrowed nor reserved, for example if
+     * it was already released, or the queue was reset, `release()`
+     * shall fail with `EINVAL`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::release (void* slot)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p) @%p %s\n", __func__, slot, this,
+                              name ());
+#endif
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          if (!internal_is_slot_ (slot, slot_borrowed)
+              && !internal_is_slot_ (slot, slot_reserved))
+            {
+              return EINVAL;
+            }
+
+          internal_release_ (slot);
+          return result::ok;
+          // ----- Exit critical section --------------------------------------
+        }
+    }
+
+    /**
+     * @details
+     * The `send_n()` function shall add up to _count_ messages,
+     * stored consecutively in the array pointed to by _msg_array_, each
+     * _nbytes_ long, to the message queue, all with the priority
+     * _mprio_, in array order. The messages are inserted as if
+     * `send()` was called for each of them, and the threads waiting
+     * to receive are resumed once per batch. Only the slot links
+     * are updated in critical sections, the messages are copied
+     * with the interrupts enabled, so the interrupts latency does not
+     * depend on the batch size; messages sent concurrently by other
+     * threads or interrupts may be interleaved with the batch.
+     *
+     * If the message queue is full, `send_n()` shall block until
+     * space becomes available for at least one message, or until
+     * `send_n()` is cancelled/interrupted; then it shall add as
+     * many messages as there is room for.
+     *
+     * If _sent_ is not `nullptr`, the number of messages
+     * added to the queue is stored there.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::send_n (const void* msg_array, std::size_t count,
+                           std::size_t nbytes, priority_t mprio,
+                           std::size_t* sent)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u,%u,%u) @%p %s\n", __func__, msg_array,
+                              count, nbytes, mprio, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(msg_array != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+      os_assert_err(nbytes <= msg_size_bytes_, EMSGSIZE);
+
+      if (sent != nullptr)
+        {
+          *sent = 0;
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              std::size_t n = internal_try_send_n_ (msg_array, count, nbytes,
+                                                    mprio);
+              if (n > 0)
+                {
+                  if (sent != nullptr)
+                    {
+                      *sent = n;
+                    }
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue send waiting list.
+              scheduler::internal_link_node (
+                  send_list_, node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue send waiting list,
+          // if not already removed by receive().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%p,%u,%u,%u) EINTR @%p %s\n",
+                                      __func__, msg_array, count, nbytes,
+                                      mprio, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_send_n()` function shall try to add up to _count_
+     * messages to the message queue, like `send_n()`.
+     *
+     * If the message queue is full, no message shall be
+     * queued and `try_send_n()` shall return an error.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::try_send_n (const void* msg_array, std::size_t count,
+                               std::size_t nbytes, priority_t mprio,
+                               std::size_t* sent)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u,%u,%u) @%p %s\n", __func__, msg_array,
+                              count, nbytes, mprio, this, name ());
+#endif
+
+      os_assert_err(msg_array != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+      os_assert_err(nbytes <= msg_size_bytes_, EMSGSIZE);
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+      std::size_t n;
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          n = internal_try_send_n_ (msg_array, count, nbytes, mprio);
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (sent != nullptr)
+        {
+          *sent = n;
+        }
+      if (n == 0)
+        {
+          return EWOULDBLOCK;
+        }
+      return result::ok;
+    }
+
+    /**
+     * @details
+     * The `timed_send_n()` function shall add up to _count_
+     * messages to the message queue, like `send_n()`.
+     *
+     * If the message queue is full, the wait for sufficient
+     * room in the queue for at least one message shall be terminated
+     * when the specified timeout expires.
+     *
+     * Under no circumstance shall the operation fail with a timeout
+     * if there is room in the queue to add a message immediately.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::timed_send_n (const void* msg_array, std::size_t count,
+                                 std::size_t nbytes, clock::duration_t timeout,
+                                 priority_t mprio, std::size_t* sent)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u,%u,%u,%u) @%p %s\n", __func__,
+                              msg_array, count, nbytes, mprio, timeout, this,
+                              name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(msg_array != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+      os_assert_err(nbytes <= msg_size_bytes_, EMSGSIZE);
+
+      if (sent != nullptr)
+        {
+          *sent = 0;
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              std::size_t n = internal_try_send_n_ (msg_array, count, nbytes,
+                                                    mprio);
+              if (n > 0)
+                {
+                  if (sent != nullptr)
+                    {
+                      *sent = n;
+                    }
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue send waiting list,
+              // and the clock timeout list.
+              scheduler::internal_link_node (
+                  send_list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue send waiting list,
+          // if not already removed by receive() and from the clock timeout list,
+          // if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%p,%u,%u,%u,%u) EINTR @%p %s\n",
+                                      __func__, msg_array, count, nbytes,
+                                      mprio, timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%p,%u,%u,%u,%u) ETIMEDOUT @%p %s\n",
+                                      __func__, msg_array, count, nbytes,
+                                      mprio, timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `receive_n()` function shall remove up to _count_ messages
+     * from the message queue, in the same order as `receive()`,
+     * and copy them to the array pointed to by _msg_array_, each
+     * element being _nbytes_ long. The threads waiting to send
+     * are resumed once per batch. Only the slot links are updated
+     * in critical sections, the messages are copied with the
+     * interrupts enabled, so the interrupts latency does not depend
+     * on the batch size.
+     *
+     * If the message queue is empty, `receive_n()` shall block
+     * until at least one message is enqueued, or until
+     * `receive_n()` is cancelled/interrupted.
+     *
+     * If _received_ is not `nullptr`, the number of messages
+     * removed from the queue is stored there. If _mprios_ is
+     * not `nullptr`, the priority of each message is stored in the
+     * corresponding element of the array.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::receive_n (void* msg_array, std::size_t count,
+                              std::size_t nbytes, std::size_t* received,
+                              priority_t* mprios)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u,%u) @%p %s\n", __func__, msg_array,
+                              count, nbytes, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(msg_array != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+      os_assert_err(nbytes <= msg_size_bytes_, EMSGSIZE);
+
+      if (received != nullptr)
+        {
+          *received = 0;
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              std::size_t n = internal_try_receive_n_ (msg_array, count, nbytes,
+                                                       mprios);
+              if (n > 0)
+                {
+                  if (received != nullptr)
+                    {
+                      *received = n;
+                    }
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue receive waiting list.
+              scheduler::internal_link_node (
+                  receive_list_, node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue receive waiting list,
+          // if not already removed by send().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%p,%u,%u) EINTR @%p %s\n", __func__,
+                                      msg_array, count, nbytes, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_receive_n()` function shall try to remove up to _count_
+     * messages from the message queue, like `receive_n()`.
+     *
+     * If the message queue is empty, no message shall be
+     * removed and `try_receive_n()` shall return an error.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::try_receive_n (void* msg_array, std::size_t count,
+                                  std::size_t nbytes, std::size_t* received,
+                                  priority_t* mprios)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u,%u) @%p %s\n", __func__, msg_array,
+                              count, nbytes, this, name ());
+#endif
+
+      os_assert_err(msg_array != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+      os_assert_err(nbytes <= msg_size_bytes_, EMSGSIZE);
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+      std::size_t n;
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          n = internal_try_receive_n_ (msg_array, count, nbytes, mprios);
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (received != nullptr)
+        {
+          *received = n;
+        }
+      if (n == 0)
+        {
+          return EWOULDBLOCK;
+        }
+      return result::ok;
+    }
+
+    /**
+     * @details
+     * The `timed_receive_n()` function shall remove up to _count_
+     * messages from the message queue, like `receive_n()`.
+     *
+     * If the message queue is empty, the wait for a message to
+     * arrive shall be terminated when the specified timeout expires.
+     *
+     * Under no circumstance shall the operation fail with a timeout
+     * if a message can be removed from the queue immediately.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    message_queue::timed_receive_n (void* msg_array, std::size_t count,
+                                    std::size_t nbytes,
+                                    clock::duration_t timeout,
+                                    std::size_t* received, priority_t* mprios)
+    {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+      internal::trace_printf ("%s(%p,%u,%u,%u) @%p %s\n", __func__, msg_array,
+                              count, nbytes, timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      os_assert_err(msg_array != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+      os_assert_err(nbytes <= msg_size_bytes_, EMSGSIZE);
+
+      if (received != nullptr)
+        {
+          *received = 0;
+        }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              std::size_t n = internal_try_receive_n_ (msg_array, count, nbytes,
+                                                       mprios);
+              if (n > 0)
+                {
+                  if (received != nullptr)
+                    {
+                      *received = n;
+                    }
+                  return result::ok;
+                }
+
+              // Add this thread to the message queue receive waiting list,
+              // and the clock timeout list.
+              scheduler::internal_link_node (
+                  receive_list_, node, clock_list, timeout_node, this,
+                  internal::wait_reason::message_queue);
+              // state::suspended set in above link().
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the message queue receive waiting list,
+          // if not already removed by send() and from the clock timeout list,
+          // if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%p,%u,%u,%u) EINTR @%p %s\n",
+                                      __func__, msg_array, count, nbytes,
+                                      timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(OS_TRACE_RTOS_MQUEUE)
+              internal::trace_printf ("%s(%p,%u,%u,%u) ETIMEDOUT @%p %s\n",
+                                      __func__, msg_array, count, nbytes,
+                                      timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+#endif /* !defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) */
+
   // --------------------------------------------------------------------------
 
   } /* namespace rtos */
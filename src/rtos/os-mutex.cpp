@@ -68,6 +68,30 @@ namespace os
      * the mutex will result in `EAGAIN`.
      */
 
+    /**
+     * @var uint8_t mutex::attributes::mx_adaptive_yields
+     * @details
+     * The @ref mx_adaptive_yields attribute defines how many times
+     * `lock()` and `timed_lock()` yield the CPU to an owner that
+     * was preempted while holding the mutex, before suspending the
+     * calling thread in the waiting list.
+     *
+     * Critical sections are usually short, and an owner preempted
+     * by a thread of the same priority is likely to release the mutex
+     * soon after it gets the CPU back; yielding to it avoids
+     * linking the calling thread in the waiting list and the
+     * additional context switches required to resume it.
+     *
+     * The CPU is yielded only while the owner is ready to run and has
+     * a priority at least equal to the caller, since
+     * otherwise it would not run before the caller blocks.
+     * On a single core the owner cannot run while the caller spins,
+     * so yielding replaces the busy spin of the multi-core
+     * implementations.
+     *
+     * The default value is 0, which blocks immediately.
+     */
+
     /**
      * @var thread::priority_t mutex::attributes::mx_priority_ceiling
      * @details
@@ -469,10 +493,11 @@ namespace os
         type_ (attr.mx_type), //
         protocol_ (attr.mx_protocol), //
         robustness_ (attr.mx_robustness), //
-        max_count_ ((attr.mx_type == type::recursive) ? attr.mx_max_count : 1)
+        max_count_ ((attr.mx_type == type::recursive) ? attr.mx_max_count : 1), //
+        adaptive_yields_ (attr.mx_adaptive_yields)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -526,7 +551,7 @@ namespace os
     mutex::~mutex ()
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_MUTEX)
@@ -564,7 +589,7 @@ namespace os
       // Wake-up all threads, if any.
       // Need not be inside the critical section,
       // the list is protected by inner `resume_one()`.
-      list_.resume_all ();
+      list_.resume_all (this, internal::wait_reason::mutex);
 
 #endif
     }
@@ -634,10 +659,19 @@ namespace os
                   // ----- Exit uncritical section ----------------------------
                 }
             }
+          else if (protocol_ == protocol::inherit)
+            {
+              // The threads still waiting for the mutex, if any,
+              // boost the new owner.
+              if (boosted_prio_ > owner_->priority_inherited ())
+                {
+                  owner_->internal_inherit_priority_ (boosted_prio_);
+                }
+            }
 
 #if defined(OS_TRACE_RTOS_MUTEX)
-          trace::printf ("%s() @%p %s by %p %s LCK\n", __func__, this, name (),
-                         th, th->name ());
+          internal::trace_printf ("%s() @%p %s by %p %s LCK\n", __func__, this,
+                                  name (), th, th->name ());
 #endif
           // If the owning thread of a robust mutex terminates while
           // holding the mutex lock, the next thread that acquires the
@@ -661,8 +695,8 @@ namespace os
                 {
                   // The recursive mutex reached its limit.
 #if defined(OS_TRACE_RTOS_MUTEX)
-                  trace::printf ("%s() @%p %s EAGAIN\n", __func__, this,
-                                 name ());
+                  internal::trace_printf ("%s() @%p %s EAGAIN\n", __func__,
+                                          this, name ());
 #endif
                   return EAGAIN;
                 }
@@ -678,8 +712,8 @@ namespace os
 #pragma GCC diagnostic pop
 
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() @%p %s by %p %s >%u\n", __func__, this,
-                             name (), th, th->name (), count_);
+              internal::trace_printf ("%s() @%p %s by %p %s >%u\n", __func__,
+                                      this, name (), th, th->name (), count_);
 #endif
               return result::ok;
             }
@@ -687,14 +721,16 @@ namespace os
             {
               // Errorcheck mutexes do not block, but return an error.
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() @%p %s EDEADLK\n", __func__, this, name ());
+              internal::trace_printf ("%s() @%p %s EDEADLK\n", __func__, this,
+                                      name ());
 #endif
               return EDEADLK;
             }
           else if (type_ == type::normal)
             {
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() @%p %s deadlock\n", __func__, this, name ());
+              internal::trace_printf ("%s() @%p %s deadlock\n", __func__, this,
+                                      name ());
 #endif
               return EWOULDBLOCK;
             }
@@ -720,9 +756,6 @@ namespace os
           // manner.
           if (protocol_ == protocol::inherit)
             {
-              thread::priority_t prio = th->priority ();
-              boosted_prio_ = prio;
-
               if (owner_links_.unlinked ())
                 {
                   mutexes_list* th_list =
@@ -730,19 +763,16 @@ namespace os
                   th_list->link (*this);
                 }
 
-              // Boost owner priority.
-              if ((boosted_prio_ > owner_->priority_inherited ()))
-                {
-                  // ----- Enter uncritical section ---------------------------
-                  scheduler::uncritical_section sucs;
-
-                  owner_->priority_inherited (boosted_prio_);
-                  // ----- Exit uncritical section ----------------------------
-                }
+              // Boost the owner priority and, if the owner is itself
+              // blocked, the priorities along the chain of owners.
+              // There is no need to yield, the calling thread
+              // has at least the same priority.
+              internal_inherit_ (th->priority ());
 
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() @%p %s boost %u by %p %s \n", __func__, this,
-                             name (), boosted_prio_, th, th->name ());
+              internal::trace_printf ("%s() @%p %s boost %u by %p %s \n",
+                                      __func__, this, name (), boosted_prio_,
+                                      th, th->name ());
 #endif
 
               return EWOULDBLOCK;
@@ -753,6 +783,178 @@ namespace os
       return EWOULDBLOCK;
     }
 
+    /*
+     * Internal function.
+     * Should be called from a scheduler critical section.
+     *
+     * The mutex boosted priority is the highest priority of the
+     * threads waiting for it, directly or further along the chain.
+     *
+     * The walk stops when an owner already runs at the given
+     * priority (then the rest of the chain was already boosted),
+     * when the owner is not blocked on another mutex with the
+     * inherit protocol, or after visiting
+     * `OS_INTEGER_RTOS_MUTEX_INHERITANCE_MAX_DEPTH` mutexes.
+     */
+    void
+    mutex::internal_inherit_ (thread::priority_t prio)
+    {
+      mutex* mx = this;
+      for (std::size_t depth = 0;
+          depth < OS_INTEGER_RTOS_MUTEX_INHERITANCE_MAX_DEPTH; ++depth)
+        {
+          if (prio > mx->boosted_prio_)
+            {
+              mx->boosted_prio_ = prio;
+            }
+
+          thread* owner = mx->owner_;
+          if (owner == nullptr || prio <= owner->priority ())
+            {
+              break;
+            }
+
+          owner->internal_inherit_priority_ (prio);
+
+          mutex* next = owner->waiting_mutex_;
+          if (next == nullptr || next->protocol_ != protocol::inherit)
+            {
+              break;
+            }
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              internal::waiting_thread_node* node = owner->waiting_node_;
+              if (node == nullptr || node->unlinked ())
+                {
+                  // Already resumed, it will retry to lock.
+                  break;
+                }
+
+              // Keep the waiting list ordered by the new priority.
+              node->unlink ();
+              next->list_.link (*node);
+              // ----- Exit critical section ----------------------------------
+            }
+
+#if defined(OS_TRACE_RTOS_MUTEX)
+          internal::trace_printf ("%s() @%p %s chain %u to @%p %s\n", __func__,
+                                  mx, mx->name (), prio, next, next->name ());
+#endif
+          mx = next;
+        }
+    }
+
+    /*
+     * Internal function.
+     * Should be called from a scheduler critical section.
+     *
+     * Move a thread waiting for a condition variable, still suspended,
+     * to the list of threads waiting for this mutex (wait morphing).
+     * The thread is resumed by `unlock()`, like the threads blocked
+     * in `lock()`, and meanwhile it boosts the owner as they do.
+     */
+    void
+    mutex::internal_enqueue_ (internal::waiting_thread_node& node)
+    {
+      thread* th = node.thread_;
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          node.unlink ();
+          list_.link (node);
+          th->waiting_mutex_ = this;
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (protocol_ == protocol::inherit)
+        {
+          internal_inherit_ (th->priority ());
+        }
+    }
+
+    /*
+     * Internal function.
+     * Should be called from a scheduler critical section.
+     */
+    thread::priority_t
+    mutex::internal_inherited_priority_ (thread* th)
+    {
+      mutexes_list* thread_mutexes =
+          reinterpret_cast<mutexes_list*> (&th->mutexes_);
+
+      thread::priority_t max_prio = thread::priority::none;
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#endif
+      for (auto&& mx : *thread_mutexes)
+        {
+          if (mx.boosted_prio_ > max_prio)
+            {
+              max_prio = mx.boosted_prio_;
+            }
+        }
+#pragma GCC diagnostic pop
+
+      return max_prio;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from a thread, outside critical sections.
+     */
+    result_t
+    mutex::internal_try_lock_adaptive_ (/* class */ thread* th)
+    {
+      result_t res;
+      for (uint8_t i = 0;; ++i)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              res = internal_try_lock_ (th);
+              if (res != EWOULDBLOCK)
+                {
+                  return res;
+                }
+
+              if (i >= adaptive_yields_)
+                {
+                  return EWOULDBLOCK;
+                }
+
+              // Yielding helps only if the owner was preempted by
+              // threads of the same priority; a running or suspended
+              // owner, or one with a lower priority, will not release
+              // the mutex before the current thread blocks.
+              thread* owner = owner_;
+              if ((owner == nullptr)
+                  || (owner->state () != thread::state::ready)
+                  || (owner->priority () < th->priority ()))
+                {
+                  return EWOULDBLOCK;
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+#if defined(OS_TRACE_RTOS_MUTEX)
+          internal::trace_printf ("%s() @%p %s yield\n", __func__, this,
+                                  name ());
+#endif
+
+          this_thread::yield ();
+        }
+
+      /* NOTREACHED */
+      return EWOULDBLOCK;
+    }
+
     result_t
     mutex::internal_unlock_ (thread* th)
     {
@@ -781,8 +983,8 @@ namespace os
 #pragma GCC diagnostic pop
 
 #if defined(OS_TRACE_RTOS_MUTEX)
-                  trace::printf ("%s() @%p %s >%u\n", __func__, this, name (),
-                                 count_);
+                  internal::trace_printf ("%s() @%p %s >%u\n", __func__, this,
+                                          name (), count_);
 #endif
                   return result::ok;
                 }
@@ -802,49 +1004,44 @@ namespace os
 
               if (boosted_prio_ != thread::priority::none)
                 {
-                  mutexes_list* thread_mutexes =
-                      reinterpret_cast<mutexes_list*> (&owner_->mutexes_);
+                  // Recompute the inherited priority from the mutexes
+                  // still owned by the thread, if any; otherwise the
+                  // assigned priority will take precedence.
+                  // Delayed until end of critical section.
+                  owner_->priority_inherited (
+                      internal_inherited_priority_ (owner_));
+                }
 
-                  if (thread_mutexes->empty ())
+              // Delayed until end of critical section. The list is
+              // changed only by threads, thus it can be checked with
+              // the scheduler locked, and the uncontended unlock does
+              // not need to disable the interrupts.
+              if (!list_.empty ())
+                {
+                  list_.resume_one (this, internal::wait_reason::mutex);
+                }
+
+              if (protocol_ == protocol::inherit)
+                {
+                  // The remaining waiting threads, if any, will boost
+                  // the next owner; the list is ordered by priorities.
+                  if (list_.empty ())
                     {
-                      // If the owner thread has no more mutexes,
-                      // clear the inherited priority,
-                      // and the assigned priority will take precedence.
                       boosted_prio_ = thread::priority::none;
                     }
                   else
                     {
-                      // If the owner thread acquired other mutexes too,
-                      // compute the maximum boosted priority.
-                      thread::priority_t max_prio = 0;
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#elif defined(__GNUC__)
-#pragma GCC diagnostic ignored "-Waggregate-return"
-#endif
-                      for (auto&& mx : *thread_mutexes)
-                        {
-                          if (mx.boosted_prio_ > max_prio)
-                            {
-                              max_prio = mx.boosted_prio_;
-                            }
-                        }
-#pragma GCC diagnostic pop
-                      boosted_prio_ = max_prio;
+                      boosted_prio_ = list_.head ()->thread_->priority ();
                     }
-                  // Delayed until end of critical section.
-                  owner_->priority_inherited (boosted_prio_);
                 }
 
-              // Delayed until end of critical section.
-              list_.resume_one ();
-
               // Finally release the mutex.
               owner_ = nullptr;
               count_ = 0;
 
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() @%p %s ULCK\n", __func__, this, name ());
+              internal::trace_printf ("%s() @%p %s ULCK\n", __func__, this,
+                                      name ());
 #endif
 
               // POSIX: If a robust mutex whose owner died is unlocked without
@@ -871,7 +1068,8 @@ namespace os
               || robustness_ == robustness::robust)
             {
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() EPERM @%p %s \n", __func__, this, name ());
+              internal::trace_printf ("%s() EPERM @%p %s \n", __func__, this,
+                                      name ());
 #endif
               return EPERM;
             }
@@ -880,8 +1078,8 @@ namespace os
           // undefined behaviour.
 
 #if defined(OS_TRACE_RTOS_MUTEX)
-          trace::printf ("%s() ENOTRECOVERABLE @%p %s \n", __func__, this,
-                         name ());
+          internal::trace_printf ("%s() ENOTRECOVERABLE @%p %s \n", __func__,
+                                  this, name ());
 #endif
           return ENOTRECOVERABLE;
           // ----- Exit critical section --------------------------------------
@@ -955,8 +1153,9 @@ namespace os
     mutex::lock (void)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s by %p %s\n", __func__, this, name (),
-                     &this_thread::thread (), this_thread::thread ().name ());
+      internal::trace_printf ("%s() @%p %s by %p %s\n", __func__, this,
+                              name (), &this_thread::thread (),
+                              this_thread::thread ().name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -978,16 +1177,13 @@ namespace os
       thread& crt_thread = this_thread::thread ();
 
       result_t res;
-        {
-          // ----- Enter critical section -------------------------------------
-          scheduler::critical_section scs;
 
-          res = internal_try_lock_ (&crt_thread);
-          if (res != EWOULDBLOCK)
-            {
-              return res;
-            }
-          // ----- Exit critical section --------------------------------------
+      // With `mx_adaptive_yields`, try again after yielding to a
+      // preempted owner, before preparing to block.
+      res = internal_try_lock_adaptive_ (&crt_thread);
+      if (res != EWOULDBLOCK)
+        {
+          return res;
         }
 
       // Prepare a list node pointing to the current thread.
@@ -1013,8 +1209,10 @@ namespace os
                   interrupts::critical_section ics;
 
                   // Add this thread to the mutex waiting list.
-                  scheduler::internal_link_node (list_, node);
+                  scheduler::internal_link_node (list_, node, this,
+                                                 internal::wait_reason::mutex);
                   // state::suspended set in above link().
+                  crt_thread.waiting_mutex_ = this;
                   // ----- Exit critical section ------------------------------
                 }
               // ----- Exit critical section ----------------------------------
@@ -1025,11 +1223,13 @@ namespace os
           // Remove the thread from the semaphore waiting list,
           // if not already removed by unlock().
           scheduler::internal_unlink_node (node);
+          crt_thread.waiting_mutex_ = nullptr;
 
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() EINTR @%p %s\n", __func__, this, name ());
+              internal::trace_printf ("%s() EINTR @%p %s\n", __func__, this,
+                                      name ());
 #endif
               return EINTR;
             }
@@ -1076,8 +1276,9 @@ namespace os
     mutex::try_lock (void)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s by %p %s\n", __func__, this, name (),
-                     &this_thread::thread (), this_thread::thread ().name ());
+      internal::trace_printf ("%s() @%p %s by %p %s\n", __func__, this,
+                              name (), &this_thread::thread (),
+                              this_thread::thread ().name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1157,9 +1358,10 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u) @%p %s by %p %s\n", __func__,
-                     static_cast<unsigned int> (timeout), this, name (),
-                     &this_thread::thread (), this_thread::thread ().name ());
+      internal::trace_printf ("%s(%u) @%p %s by %p %s\n", __func__,
+                              static_cast<unsigned int> (timeout), this,
+                              name (), &this_thread::thread (),
+                              this_thread::thread ().name ());
 #pragma GCC diagnostic pop
 #endif /* defined(OS_TRACE_RTOS_MUTEX) */
 
@@ -1184,17 +1386,13 @@ namespace os
       result_t res;
 
       // Extra test before entering the loop, with its inherent weight.
-      // Trade size for speed.
+      // Trade size for speed. With `mx_adaptive_yields`, try again
+      // after yielding to a preempted owner; the yields are not
+      // accounted in the timeout.
+      res = internal_try_lock_adaptive_ (&crt_thread);
+      if (res != EWOULDBLOCK)
         {
-          // ----- Enter critical section -------------------------------------
-          scheduler::critical_section scs;
-
-          res = internal_try_lock_ (&crt_thread);
-          if (res != EWOULDBLOCK)
-            {
-              return res;
-            }
-          // ----- Exit critical section --------------------------------------
+          return res;
         }
 
       // Prepare a list node pointing to the current thread.
@@ -1229,8 +1427,10 @@ namespace os
                   // Add this thread to the mutex waiting list,
                   // and the clock timeout list.
                   scheduler::internal_link_node (list_, node, clock_list,
-                                                 timeout_node);
+                                                 timeout_node, this,
+                                                 internal::wait_reason::mutex);
                   // state::suspended set in above link().
+                  crt_thread.waiting_mutex_ = this;
                   // ----- Exit critical section ------------------------------
                 }
               // ----- Exit critical section ----------------------------------
@@ -1242,53 +1442,52 @@ namespace os
           // if not already removed by unlock() and from the clock
           // timeout list, if not already removed by the timer.
           scheduler::internal_unlink_node (node, timeout_node);
+          crt_thread.waiting_mutex_ = nullptr;
 
           res = result::ok;
 
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() EINTR @%p %s \n", __func__, this, name ());
+              internal::trace_printf ("%s() EINTR @%p %s \n", __func__, this,
+                                      name ());
 #endif
               res = EINTR;
             }
           else if (clock_->steady_now () >= timeout_timestamp)
             {
 #if defined(OS_TRACE_RTOS_MUTEX)
-              trace::printf ("%s() ETIMEDOUT @%p %s \n", __func__, this,
-                             name ());
+              internal::trace_printf ("%s() ETIMEDOUT @%p %s \n", __func__,
+                                      this, name ());
 #endif
               res = ETIMEDOUT;
             }
           if (res != result::ok)
             {
-              if (boosted_prio_ != thread::priority::none)
+              if (protocol_ == protocol::inherit)
                 {
-                  // If the priority was boosted, it must be restored
-                  // to the highest priority of the waiting threads, if any.
-
-                  thread::priority_t max_prio = thread::priority::none;
+                  // ----- Enter critical section -----------------------------
+                  scheduler::critical_section scs;
 
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#elif defined(__GNUC__)
-#pragma GCC diagnostic ignored "-Waggregate-return"
-#endif
-                  for (auto&& th : list_)
+                  // This thread no longer boosts the owner; restore the
+                  // highest priority of the remaining waiting threads,
+                  // if any. Owners further along the chain keep their
+                  // priorities until they unlock.
+                  if (list_.empty ())
                     {
-                      thread::priority_t prio = th.priority ();
-                      if (prio > max_prio)
-                        {
-                          max_prio = prio;
-                        }
+                      boosted_prio_ = thread::priority::none;
+                    }
+                  else
+                    {
+                      boosted_prio_ = list_.head ()->thread_->priority ();
                     }
-#pragma GCC diagnostic pop
 
-                  if (max_prio != thread::priority::none)
+                  if (owner_ != nullptr)
                     {
-                      boosted_prio_ = max_prio;
-                      owner_->priority (boosted_prio_);
+                      owner_->priority_inherited (
+                          internal_inherited_priority_ (owner_));
                     }
+                  // ----- Exit critical section ------------------------------
                 }
               return res;
             }
@@ -1324,8 +1523,9 @@ namespace os
     mutex::unlock (void)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s by %p %s\n", __func__, this, name (),
-                     &this_thread::thread (), this_thread::thread ().name ());
+      internal::trace_printf ("%s() @%p %s by %p %s\n", __func__, this,
+                              name (), &this_thread::thread (),
+                              this_thread::thread ().name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1359,7 +1559,7 @@ namespace os
     mutex::prio_ceiling (void) const
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1401,7 +1601,7 @@ namespace os
                          thread::priority_t* old_prio_ceiling)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1466,7 +1666,7 @@ namespace os
     mutex::consistent (void)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1503,7 +1703,7 @@ namespace os
     mutex::reset (void)
     {
 #if defined(OS_TRACE_RTOS_MUTEX)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -0,0 +1,949 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class rwlock::attributes
+     * @details
+     * Allow to assign a name and a custom clock to the read-write lock.
+     *
+     * If the attributes are modified **after** the read-write lock
+     * creation, the read-write lock attributes shall not be affected.
+     *
+     * @par POSIX compatibility
+     *  Inspired by `pthread_rwlockattr_t`
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     */
+
+    /**
+     * @details
+     * This variable is used by the default constructor.
+     */
+    const rwlock::attributes rwlock::initializer;
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class rwlock
+     * @details
+     * A read-write lock allows multiple threads to access shared
+     * data for reading at the same time, while only one thread
+     * at a time can access it for writing.
+     *
+     * Writers are preferred: a thread trying to lock for reading
+     * is blocked not only while a writer holds the lock, but also
+     * while a writer with at least the same priority is waiting,
+     * otherwise a steady flow of readers would starve the writers.
+     * Readers with a higher priority than all waiting writers
+     * are not blocked by them.
+     *
+     * The waiting threads are kept in priority order, and
+     * when the lock is released the higher priority readers, or
+     * otherwise the highest priority writer, are resumed.
+     *
+     * The readers are not tracked individually, thus their priority
+     * cannot be boosted when a higher priority writer waits; the
+     * read critical sections should be kept short.
+     *
+     * @par Example
+     *
+     * @code{.cpp}
+     * rwlock rw;
+     *
+     * void
+     * reader(void)
+     * {
+     *   rw.read_lock();
+     *   // Read the shared data, possibly in parallel with other readers.
+     *   rw.unlock();
+     * }
+     *
+     * void
+     * writer(void)
+     * {
+     *   rw.write_lock();
+     *   // Update the shared data.
+     *   rw.unlock();
+     * }
+     * @endcode
+     *
+     * @par POSIX compatibility
+     *  Inspired by `pthread_rwlock_t`
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     */
+
+    /**
+     * @details
+     * This constructor shall initialise a read-write lock object
+     * with attributes referenced by _attr_.
+     * If the attributes specified by _attr_ are modified later,
+     * the read-write lock attributes shall not be affected.
+     * Upon successful initialisation, the state of the read-write
+     * lock object shall become initialised and unlocked.
+     *
+     * Only the read-write lock object itself may be used for performing
+     * synchronisation. It is not allowed to make copies of
+     * read-write lock objects.
+     *
+     * In cases where default read-write lock attributes are
+     * appropriate, the variable `rwlock::initializer` can be used to
+     * initialise read-write locks.
+     * The effect shall be equivalent to creating a read-write lock
+     * object with the default constructor.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_init()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_init.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    rwlock::rwlock (const attributes& attr) :
+        rwlock
+          { nullptr, attr }
+    {
+    }
+
+    /**
+     * @details
+     * This constructor shall initialise a named read-write lock object
+     * with attributes referenced by _attr_.
+     * If the attributes specified by _attr_ are modified later,
+     * the read-write lock attributes shall not be affected.
+     * Upon successful initialisation, the state of the read-write
+     * lock object shall become initialised and unlocked.
+     *
+     * Only the read-write lock object itself may be used for performing
+     * synchronisation. It is not allowed to make copies of
+     * read-write lock objects.
+     *
+     * In cases where default read-write lock attributes are
+     * appropriate, the variable `rwlock::initializer` can be used to
+     * initialise read-write locks.
+     * The effect shall be equivalent to creating a read-write lock
+     * object with the default constructor.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_init()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_init.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    rwlock::rwlock (const char* name, const attributes& attr) :
+        object_named_system
+          { name }
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_throw(!interrupts::in_handler_mode (), EPERM);
+
+      clock_ = attr.clock != nullptr ? attr.clock : &sysclock;
+    }
+
+    /**
+     * @details
+     * This destructor shall destroy the read-write lock object; the
+     * object becomes, in effect, uninitialised.
+     *
+     * It shall be safe to destroy an initialised read-write lock
+     * that is unlocked. Attempting to destroy a locked read-write
+     * lock, or one on which threads are waiting, results in
+     * undefined behaviour (for example it may trigger an assert).
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_destroy()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_destroy.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    rwlock::~rwlock ()
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // The lock must have been released.
+      assert(writer_ == nullptr);
+      assert(readers_ == 0);
+      // There must be no threads waiting for this lock.
+      assert(readers_list_.empty ());
+      assert(writers_list_.empty ());
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    /*
+     * Internal function.
+     * Should be called from a scheduler critical section.
+     */
+    result_t
+    rwlock::internal_try_read_lock_ (thread* th)
+    {
+      if (writer_ == th)
+        {
+          return EDEADLK;
+        }
+
+      if (writer_ != nullptr)
+        {
+          return EWOULDBLOCK;
+        }
+
+      // Writers preference; a writer with at least the same priority
+      // blocks the new readers.
+      if (!writers_list_.empty ()
+          && writers_list_.head ()->thread_->priority () >= th->priority ())
+        {
+          return EWOULDBLOCK;
+        }
+
+      if (readers_ == max_readers)
+        {
+          return EAGAIN;
+        }
+
+      readers_ = static_cast<count_t> (readers_ + 1);
+
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s by %p %s >%u\n", __func__, this,
+                              name (), th, th->name (), readers_);
+#endif
+      return result::ok;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from a scheduler critical section.
+     */
+    result_t
+    rwlock::internal_try_write_lock_ (thread* th)
+    {
+      if (writer_ == th)
+        {
+          return EDEADLK;
+        }
+
+      if (writer_ != nullptr || readers_ != 0)
+        {
+          return EWOULDBLOCK;
+        }
+
+      writer_ = th;
+
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s by %p %s LCK\n", __func__, this,
+                              name (), th, th->name ());
+#endif
+      return result::ok;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from a scheduler critical section.
+     *
+     * Resume the readers with a higher priority than all waiting
+     * writers, if any; otherwise, if the lock is free, resume the
+     * highest priority writer. The resumed threads retry to lock,
+     * and block again if they lost the race.
+     */
+    void
+    rwlock::internal_resume_waiters_ (void)
+    {
+      if (writer_ != nullptr)
+        {
+          return;
+        }
+
+      thread::priority_t writer_prio = thread::priority::none;
+      if (!writers_list_.empty ())
+        {
+          writer_prio = writers_list_.head ()->thread_->priority ();
+        }
+
+      bool resumed_readers = false;
+
+      // The list is ordered by priorities, the readers allowed to
+      // pass the writers are at the beginning.
+      while (!readers_list_.empty ()
+          && readers_list_.head ()->thread_->priority () > writer_prio)
+        {
+          // Delayed until end of critical section.
+          readers_list_.resume_one (this, internal::wait_reason::rwlock);
+          resumed_readers = true;
+        }
+
+      if (!resumed_readers && readers_ == 0 && !writers_list_.empty ())
+        {
+          // Delayed until end of critical section.
+          writers_list_.resume_one (this, internal::wait_reason::rwlock);
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * Apply a read lock to the read-write lock. The calling
+     * thread shall acquire the read lock if a writer does not hold
+     * the lock and there are no writers with at least the same
+     * priority waiting for the lock.
+     *
+     * If the read lock is not acquired, the calling thread shall
+     * block until it can acquire the lock.
+     *
+     * A thread may hold multiple concurrent read locks
+     * (that is, successfully call `read_lock()` _n_ times). If so,
+     * the thread shall perform matching unlocks (that is, it
+     * shall call `unlock()` _n_ times).
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_rdlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_rdlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *  <br>Differences from the standard:
+     *  - a recursive read lock may block if a higher priority writer
+     *    is waiting.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::read_lock (void)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+      result_t res;
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              res = internal_try_read_lock_ (&crt_thread);
+              if (res != EWOULDBLOCK)
+                {
+                  return res;
+                }
+
+                {
+                  // ----- Enter critical section -----------------------------
+                  interrupts::critical_section ics;
+
+                  // Add this thread to the readers waiting list.
+                  scheduler::internal_link_node (
+                      readers_list_, node, this,
+                      internal::wait_reason::rwlock);
+                  // state::suspended set in above link().
+                  // ----- Exit critical section ------------------------------
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              // Remove the thread from the readers waiting list,
+              // if not already removed by unlock().
+              scheduler::internal_unlink_node (node);
+
+              if (crt_thread.interrupted ())
+                {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+                  internal::trace_printf ("%s() EINTR @%p %s\n", __func__,
+                                          this, name ());
+#endif
+                  // A reader resumed by unlock() prevented the writers
+                  // from being resumed; pass the turn to them.
+                  internal_resume_waiters_ ();
+                  return EINTR;
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Apply a read lock as in the `read_lock()` function, with
+     * the exception that the function shall fail if the
+     * equivalent `read_lock()` call would have blocked the
+     * calling thread. In no case shall the `try_read_lock()`
+     * function ever block; it always either acquires the lock or
+     * fails and returns immediately.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_tryrdlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_tryrdlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::try_read_lock (void)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          return internal_try_read_lock_ (&crt_thread);
+          // ----- Exit critical section --------------------------------------
+        }
+    }
+
+    /**
+     * @details
+     * Apply a read lock as in the `read_lock()` function, with
+     * the exception that if the lock cannot be acquired without
+     * waiting for other threads to unlock the lock, this wait
+     * shall be terminated when the specified timeout expires.
+     *
+     * The timeout shall expire after the number of time units (that
+     * is when the value of that clock equals or exceeds (now()+duration).
+     * The resolution of the timeout shall be the resolution of the
+     * clock on which it is based.
+     *
+     * Under no circumstance shall the function fail with a timeout
+     * if the lock can be acquired immediately.
+     *
+     * The clock used for timeouts can be specified via the `clock`
+     * attribute. By default, the clock derived from the scheduler
+     * timer is used, and the durations are expressed in ticks.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_timedrdlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_timedrdlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *  <br>Differences from the standard:
+     *  - the timeout is not expressed as an absolute time point, but
+     * as a relative number of timer ticks (by default, the SysTick
+     * clock for Cortex-M).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::timed_read_lock (clock::duration_t timeout)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__,
+                              static_cast<unsigned int> (timeout), this,
+                              name ());
+#pragma GCC diagnostic pop
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+      result_t res;
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          res = internal_try_read_lock_ (&crt_thread);
+          if (res != EWOULDBLOCK)
+            {
+              return res;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              res = internal_try_read_lock_ (&crt_thread);
+              if (res != EWOULDBLOCK)
+                {
+                  return res;
+                }
+
+                {
+                  // ----- Enter critical section -----------------------------
+                  interrupts::critical_section ics;
+
+                  // Add this thread to the readers waiting list,
+                  // and the clock timeout list.
+                  scheduler::internal_link_node (
+                      readers_list_, node, clock_list, timeout_node, this,
+                      internal::wait_reason::rwlock);
+                  // state::suspended set in above link().
+                  // ----- Exit critical section ------------------------------
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              // Remove the thread from the readers waiting list,
+              // if not already removed by unlock() and from the clock
+              // timeout list, if not already removed by the timer.
+              scheduler::internal_unlink_node (node, timeout_node);
+
+              if (crt_thread.interrupted ())
+                {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+                  internal::trace_printf ("%s() EINTR @%p %s\n", __func__,
+                                          this, name ());
+#endif
+                  // A reader resumed by unlock() prevented the writers
+                  // from being resumed; pass the turn to them.
+                  internal_resume_waiters_ ();
+                  return EINTR;
+                }
+
+              if (clock_->steady_now () >= timeout_timestamp)
+                {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+                  internal::trace_printf ("%s() ETIMEDOUT @%p %s\n",
+                                          __func__, this, name ());
+#endif
+                  // A reader resumed by unlock() prevented the writers
+                  // from being resumed; pass the turn to them.
+                  internal_resume_waiters_ ();
+                  return ETIMEDOUT;
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Apply a write lock to the read-write lock. The calling
+     * thread shall acquire the write lock if no thread (reader or
+     * writer) holds the lock. Otherwise, the thread shall
+     * block until it can acquire the lock.
+     *
+     * While the writer waits, the new readers with a lower or equal
+     * priority are blocked, so the writer waits only for the
+     * readers already holding the lock.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_wrlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_wrlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::write_lock (void)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+      result_t res;
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              res = internal_try_write_lock_ (&crt_thread);
+              if (res != EWOULDBLOCK)
+                {
+                  return res;
+                }
+
+                {
+                  // ----- Enter critical section -----------------------------
+                  interrupts::critical_section ics;
+
+                  // Add this thread to the writers waiting list.
+                  scheduler::internal_link_node (
+                      writers_list_, node, this,
+                      internal::wait_reason::rwlock);
+                  // state::suspended set in above link().
+                  // ----- Exit critical section ------------------------------
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              // Remove the thread from the writers waiting list,
+              // if not already removed by unlock().
+              scheduler::internal_unlink_node (node);
+
+              if (crt_thread.interrupted ())
+                {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+                  internal::trace_printf ("%s() EINTR @%p %s\n", __func__,
+                                          this, name ());
+#endif
+                  // The readers blocked by this writer may proceed.
+                  internal_resume_waiters_ ();
+                  return EINTR;
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Apply a write lock like the `write_lock()` function, with
+     * the exception that the function shall fail if any thread
+     * currently holds the lock (for reading or writing).
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_trywrlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_trywrlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::try_write_lock (void)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          return internal_try_write_lock_ (&crt_thread);
+          // ----- Exit critical section --------------------------------------
+        }
+    }
+
+    /**
+     * @details
+     * Apply a write lock as in the `write_lock()` function, with
+     * the exception that if the lock cannot be acquired without
+     * waiting for other threads to unlock the lock, this wait
+     * shall be terminated when the specified timeout expires.
+     *
+     * The timeout shall expire after the number of time units (that
+     * is when the value of that clock equals or exceeds (now()+duration).
+     * The resolution of the timeout shall be the resolution of the
+     * clock on which it is based.
+     *
+     * Under no circumstance shall the function fail with a timeout
+     * if the lock can be acquired immediately.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_timedwrlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_timedwrlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *  <br>Differences from the standard:
+     *  - the timeout is not expressed as an absolute time point, but
+     * as a relative number of timer ticks (by default, the SysTick
+     * clock for Cortex-M).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::timed_write_lock (clock::duration_t timeout)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__,
+                              static_cast<unsigned int> (timeout), this,
+                              name ());
+#pragma GCC diagnostic pop
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+      result_t res;
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          res = internal_try_write_lock_ (&crt_thread);
+          if (res != EWOULDBLOCK)
+            {
+              return res;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node
+        { crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              res = internal_try_write_lock_ (&crt_thread);
+              if (res != EWOULDBLOCK)
+                {
+                  return res;
+                }
+
+                {
+                  // ----- Enter critical section -----------------------------
+                  interrupts::critical_section ics;
+
+                  // Add this thread to the writers waiting list,
+                  // and the clock timeout list.
+                  scheduler::internal_link_node (
+                      writers_list_, node, clock_list, timeout_node, this,
+                      internal::wait_reason::rwlock);
+                  // state::suspended set in above link().
+                  // ----- Exit critical section ------------------------------
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              // Remove the thread from the writers waiting list,
+              // if not already removed by unlock() and from the clock
+              // timeout list, if not already removed by the timer.
+              scheduler::internal_unlink_node (node, timeout_node);
+
+              if (crt_thread.interrupted ())
+                {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+                  internal::trace_printf ("%s() EINTR @%p %s\n", __func__,
+                                          this, name ());
+#endif
+                  // The readers blocked by this writer may proceed.
+                  internal_resume_waiters_ ();
+                  return EINTR;
+                }
+
+              if (clock_->steady_now () >= timeout_timestamp)
+                {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+                  internal::trace_printf ("%s() ETIMEDOUT @%p %s\n", __func__,
+                                          this, name ());
+#endif
+                  // The readers blocked by this writer may proceed.
+                  internal_resume_waiters_ ();
+                  return ETIMEDOUT;
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Release a lock held on the read-write lock.
+     *
+     * If this function is called to release a read lock and there
+     * are other read locks currently held, the read-write lock
+     * shall remain in the read locked state. If this function
+     * releases the last read lock, or a write lock, the object
+     * shall be put in the unlocked state.
+     *
+     * When the lock becomes available, the waiting readers with a
+     * higher priority than all waiting writers are resumed; if there
+     * are none, the highest priority writer is resumed.
+     *
+     * The read locks are not tracked individually, so a thread
+     * not holding a read lock is not detected.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_rwlock_unlock()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_rwlock_unlock.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    rwlock::unlock (void)
+    {
+#if defined(OS_TRACE_RTOS_RWLOCK)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      thread* crt_thread = &this_thread::thread ();
+
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          if (writer_ == crt_thread)
+            {
+              writer_ = nullptr;
+            }
+          else if (writer_ == nullptr && readers_ != 0)
+            {
+              readers_ = static_cast<count_t> (readers_ - 1);
+            }
+          else
+            {
+              return EPERM;
+            }
+
+          internal_resume_waiters_ ();
+          // ----- Exit critical section --------------------------------------
+        }
+
+      return result::ok;
+    }
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace rtos */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
@@ -169,8 +169,8 @@ namespace os
         initial_value_ (initial_value)
     {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s %u %u\n", __func__, this, this->name (),
-                     initial_value, max_value_);
+      internal::trace_printf ("%s() @%p %s %u %u\n", __func__, this,
+                              this->name (), initial_value, max_value_);
 #endif
 
       // Don't call this from interrupt handlers.
@@ -224,7 +224,7 @@ namespace os
     semaphore::~semaphore ()
     {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
@@ -236,6 +236,42 @@ namespace os
       // There must be no threads waiting for this semaphore.
       assert(list_.empty ());
 
+#endif
+
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          // Remove the semaphore from the deferred list, if posted
+          // from an interrupt and not yet folded.
+          if (deferred_next_ != nullptr)
+            {
+              semaphore* prev = nullptr;
+              semaphore* sem = deferred_list_;
+              while (sem != this)
+                {
+                  prev = sem;
+                  sem = sem->deferred_next_;
+                }
+
+              semaphore* next =
+                  (deferred_next_ == this) ? nullptr : deferred_next_;
+              if (prev == nullptr)
+                {
+                  deferred_list_ = next;
+                }
+              else
+                {
+                  // If this was the last, the previous becomes the last.
+                  prev->deferred_next_ = (next == nullptr) ? prev : next;
+                }
+              deferred_next_ = nullptr;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
 #endif
     }
 
@@ -249,12 +285,18 @@ namespace os
 
       count_ = initial_value_;
 
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+      // Drop the posts not yet folded; the semaphore remains in the
+      // deferred list, and folding nothing is harmless.
+      pending_ = 0;
+#endif
+
 #if !defined(OS_USE_RTOS_PORT_SEMAPHORE)
 
       // Wake-up all threads, if any.
       // Need not be inside the critical section,
       // the list is protected by inner `resume_one()`.
-      list_.resume_all ();
+      list_.resume_all (this, internal::wait_reason::semaphore);
 
 #endif /* !defined(OS_USE_RTOS_PORT_SEMAPHORE) */
     }
@@ -264,32 +306,233 @@ namespace os
      * Should be called from an interrupts critical section.
      */
     bool
-    semaphore::internal_try_wait_ (void)
+    semaphore::internal_try_wait_ (count_t count)
     {
-      if (count_ > 0)
+#if !defined(OS_USE_RTOS_PORT_SEMAPHORE)
+      // Do not overtake the threads already waiting; the units
+      // are handed over to them in order.
+      if (!list_.empty ())
         {
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#pragma clang diagnostic ignored "-Wdeprecated-volatile"
-#elif defined(__GNUC__)
-#pragma GCC diagnostic ignored "-Wvolatile"
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+          internal::trace_printf ("%s() @%p %s queued\n", __func__, this,
+                                  name ());
 #endif
-          --count_;
-#pragma GCC diagnostic pop
+          return false;
+        }
+#endif
+
+      if (count_ >= count)
+        {
+          count_ = static_cast<count_t> (count_ - count);
 
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-          trace::printf ("%s() @%p %s >%u\n", __func__, this, name (), count_);
+          internal::trace_printf ("%s() @%p %s >%u\n", __func__, this, name (),
+                                  count_);
 #endif
           return true;
         }
 
-      // Count may be 0.
+      // Count may be 0, or not enough.
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s false\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s false\n", __func__, this, name ());
 #endif
       return false;
     }
 
+#if !defined(OS_USE_RTOS_PORT_SEMAPHORE)
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     *
+     * If the available units satisfy the first waiting thread,
+     * hand them over, remove the thread from the list and return it,
+     * to be resumed outside the critical section.
+     *
+     * Only the first thread is checked; if it expects more units
+     * than available, the threads behind it are not served either,
+     * so that large requests are not starved by smaller ones.
+     */
+    thread*
+    semaphore::internal_hand_over_ (void)
+    {
+      if (list_.empty ())
+        {
+          return nullptr;
+        }
+
+      // All nodes linked to this list are count nodes.
+      internal::waiting_count_node* node =
+          static_cast<internal::waiting_count_node*> (const_cast<internal::waiting_thread_node*> (list_.head ()));
+
+      if (node->count_ > static_cast<uint32_t> (count_))
+        {
+          return nullptr;
+        }
+
+      count_ = static_cast<count_t> (count_
+          - static_cast<count_t> (node->count_));
+      // Tell the thread the units are already taken.
+      node->count_ = 0;
+
+      thread* th = node->thread_;
+      node->unlink ();
+
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+      internal::trace_printf ("%s() @%p %s to %p %s >%u\n", __func__, this,
+                              name (), th, th->name (), count_);
+#endif
+      return th;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     *
+     * All threads served by the available units are made ready
+     * while still in the critical section; the caller reschedules
+     * once, if needed. With a port scheduler, the threads are
+     * resumed one at a time.
+     */
+    std::size_t
+    semaphore::internal_ready_satisfied_ (void)
+    {
+      std::size_t n = 0;
+      thread* th;
+      while ((th = internal_hand_over_ ()) != nullptr)
+        {
+          if (th->state () != thread::state::destroyed)
+            {
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+              th->internal_make_ready_ (this,
+                                        internal::wait_reason::semaphore);
+#else
+              th->internal_resume_ (this, internal::wait_reason::semaphore);
+#endif
+              ++n;
+            }
+        }
+      return n;
+    }
+
+    /*
+     * Internal function.
+     * Called when a waiting thread leaves the list without being
+     * served, so that the threads behind it are not delayed.
+     */
+    void
+    semaphore::internal_resume_satisfied_ (void)
+    {
+      std::size_t resumed;
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          resumed = internal_ready_satisfied_ ();
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (resumed > 0)
+        {
+          port::scheduler::reschedule ();
+        }
+    }
+
+#endif /* !defined(OS_USE_RTOS_PORT_SEMAPHORE) */
+
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+
+    semaphore* volatile semaphore::deferred_list_;
+
+    /*
+     * Internal function.
+     * Called from interrupt handlers.
+     *
+     * Only the pending count is updated; the semaphore is added to
+     * the deferred list, and a context switch is requested only by
+     * the first post; all posts to any semaphore until the context
+     * switch are coalesced.
+     */
+    result_t
+    semaphore::internal_post_deferred_ (count_t count)
+    {
+      bool first;
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          if (count > max_value_ - count_ - pending_)
+            {
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+              internal::trace_printf ("%s() @%p %s EAGAIN\n", __func__, this,
+                                      name ());
+#endif
+              return EAGAIN;
+            }
+
+          pending_ = static_cast<count_t> (pending_ + count);
+
+          first = (deferred_list_ == nullptr);
+          if (deferred_next_ == nullptr)
+            {
+              // The last semaphore in the list points to itself.
+              deferred_next_ = first ? this : deferred_list_;
+              deferred_list_ = this;
+            }
+
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+          internal::trace_printf ("%s() @%p %s pending %u\n", __func__, this,
+                                  name (), pending_);
+#endif
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (first)
+        {
+          // The pending posts are folded before selecting the
+          // next thread to run.
+          port::scheduler::reschedule ();
+        }
+
+      return result::ok;
+    }
+
+    /*
+     * Internal function.
+     * Called during context switches, before selecting the next
+     * thread to run, so the resumed threads are only made ready.
+     */
+    void
+    semaphore::internal_fold_deferred_posts_ (void)
+    {
+      for (;;)
+        {
+          semaphore* sem;
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              sem = deferred_list_;
+              if (sem == nullptr)
+                {
+                  return;
+                }
+
+              semaphore* next = sem->deferred_next_;
+              deferred_list_ = (next == sem) ? nullptr : next;
+              sem->deferred_next_ = nullptr;
+
+              sem->count_ = static_cast<count_t> (sem->count_ + sem->pending_);
+              sem->pending_ = 0;
+
+              sem->internal_ready_satisfied_ ();
+              // ----- Exit critical section ----------------------------------
+            }
+        }
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS) */
+
     /**
      * @endcond
      */
@@ -338,46 +581,113 @@ namespace os
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
 
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       return port::semaphore::post (this);
 
 #else
 
+      return post (1);
+
+#endif
+    }
+
+    /**
+     * @details
+     * Perform a post operation on the semaphore, adding _count_
+     * units at once. Either all units are added, or, if the
+     * maximum value would be exceeded, none.
+     *
+     * The units are handed over to the waiting threads,
+     * in the order of the waiting list, as long as the first
+     * waiting thread is satisfied.
+     *
+     * If `OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS` is defined,
+     * the posts from interrupt handlers only accumulate into a
+     * pending count, which is folded into the semaphore count
+     * once, during the next context switch, when the waiting
+     * threads are also resumed. This is useful when an interrupt
+     * posts many times in a row, since only the first post
+     * requests a context switch.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     *
+     * @warning Applications using these functions may be subject to priority inversion.
+     */
+    result_t
+    semaphore::post (count_t count)
+    {
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+      internal::trace_printf ("%s(%d) @%p %s\n", __func__, count, this,
+                              name ());
+#endif
+
       // Don't call this from high priority interrupts.
       assert(port::interrupts::is_priority_valid ());
 
+      if (count <= 0)
+        {
+          return EINVAL;
+        }
+
+#if defined(OS_USE_RTOS_PORT_SEMAPHORE)
+
+      if (count == 1)
+        {
+          return post ();
+        }
+
+      return ENOTSUP;
+
+#else
+
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS) && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      if (interrupts::in_handler_mode ())
+        {
+          return internal_post_deferred_ (count);
+        }
+
+#endif
+
+      std::size_t resumed;
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
 
-          if (count_ >= this->max_value_)
+          int avail = max_value_ - count_;
+#if defined(OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS)
+          avail -= pending_;
+#endif
+          if (count > avail)
             {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-              trace::printf ("%s() @%p %s EAGAIN\n", __func__, this, name ());
+              internal::trace_printf ("%s() @%p %s EAGAIN\n", __func__, this,
+                                      name ());
 #endif
               return EAGAIN;
             }
 
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#pragma clang diagnostic ignored "-Wdeprecated-volatile"
-#elif defined(__GNUC__)
-#pragma GCC diagnostic ignored "-Wvolatile"
-#endif
-          ++count_;
-#pragma GCC diagnostic pop
+          count_ = static_cast<count_t> (count_ + count);
 
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-          trace::printf ("%s() @%p %s count %u\n", __func__, this, name (),
-                         count_);
+          internal::trace_printf ("%s() @%p %s count %u\n", __func__, this,
+                                  name (), count_);
 #endif
+
+          // Make ready all the satisfied threads at once.
+          resumed = internal_ready_satisfied_ ();
           // ----- Exit critical section --------------------------------------
         }
 
-      // Wake-up one thread.
-      list_.resume_one ();
+      if (resumed > 0)
+        {
+          port::scheduler::reschedule ();
+        }
 
       return result::ok;
 
@@ -415,8 +725,11 @@ namespace os
     result_t
     semaphore::wait ()
     {
+#if defined(OS_USE_RTOS_PORT_SEMAPHORE)
+
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s <%u\n", __func__, this, name (), count_);
+      internal::trace_printf ("%s() @%p %s <%u\n", __func__, this, name (),
+                              count_);
 #endif
 
       // Don't call this from interrupt handlers.
@@ -424,9 +737,66 @@ namespace os
       // Don't call this from critical regions.
       os_assert_err(!scheduler::locked (), EPERM);
 
+      return port::semaphore::wait (this);
+
+#else
+
+      return wait (1);
+
+#endif
+    }
+
+    /**
+     * @details
+     * Perform a lock operation on the semaphore, acquiring
+     * _count_ units at once.
+     *
+     * If enough units are available, the count is decreased and
+     * the call returns immediately; otherwise the calling thread
+     * blocks until all units are handed over by `post()`. Partial
+     * counts are never acquired.
+     *
+     * The waiting threads are served in the order of the waiting
+     * list; a thread expecting more units than available also
+     * delays the threads behind it, and new callers queue behind
+     * the waiting threads, even if enough units are available.
+     *
+     * The function is interruptible by the delivery of an external
+     * event (signal, thread cancel, etc).
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     *
+     * @warning Applications using these functions may be subject to priority inversion.
+     */
+    result_t
+    semaphore::wait (count_t count)
+    {
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+      internal::trace_printf ("%s(%d) @%p %s <%u\n", __func__, count, this,
+                              name (), count_);
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      if (count <= 0 || count > max_value_)
+        {
+          return EINVAL;
+        }
+
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
 
-      return port::semaphore::wait (this);
+      if (count == 1)
+        {
+          return wait ();
+        }
+
+      return ENOTSUP;
 
 #else
 
@@ -436,7 +806,7 @@ namespace os
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
 
-          if (internal_try_wait_ ())
+          if (internal_try_wait_ (count))
             {
               return result::ok;
             }
@@ -448,8 +818,8 @@ namespace os
       // Prepare a list node pointing to the current thread.
       // Do not worry for being on stack, it is temporarily linked to the
       // list and guaranteed to be removed before this function returns.
-      internal::waiting_thread_node node
-        { crt_thread };
+      internal::waiting_count_node node
+        { crt_thread, static_cast<uint32_t> (count) };
 
       for (;;)
         {
@@ -457,14 +827,19 @@ namespace os
               // ----- Enter critical section ---------------------------------
               interrupts::critical_section ics;
 
-              if (internal_try_wait_ ())
+              if (internal_try_wait_ (count))
                 {
                   return result::ok;
                 }
 
               // Add this thread to the semaphore waiting list.
-              scheduler::internal_link_node (list_, node);
+              scheduler::internal_link_node (list_, node, this,
+                                             internal::wait_reason::semaphore);
               // state::suspended set in above link().
+
+              // If linked at the top of the list, this thread may
+              // already be satisfied by the available units.
+              internal_ready_satisfied_ ();
               // ----- Exit critical section ----------------------------------
             }
 
@@ -474,10 +849,21 @@ namespace os
           // if not already removed by post().
           scheduler::internal_unlink_node (node);
 
+          if (node.count_ == 0)
+            {
+              // The units were handed over by post().
+              return result::ok;
+            }
+
+          // Not served; the threads queued behind this one
+          // may be satisfied now.
+          internal_resume_satisfied_ ();
+
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-              trace::printf ("%s() EINTR @%p %s\n", __func__, this, name ());
+              internal::trace_printf ("%s() EINTR @%p %s\n", __func__, this,
+                                      name ());
 #endif
               return EINTR;
             }
@@ -512,16 +898,62 @@ namespace os
     result_t
     semaphore::try_wait ()
     {
+#if defined(OS_USE_RTOS_PORT_SEMAPHORE)
+
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+      internal::trace_printf ("%s() @%p %s <%u\n", __func__, this, name (),
+                              count_);
+#endif
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+      return port::semaphore::try_wait (this);
+
+#else
+
+      return try_wait (1);
+
+#endif
+    }
+
+    /**
+     * @details
+     * Try to acquire _count_ units at once, only if they are
+     * currently available and no other threads are waiting;
+     * otherwise, do not change the semaphore and return immediately.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     *
+     * @warning Applications using these functions may be subject to priority inversion.
+     */
+    result_t
+    semaphore::try_wait (count_t count)
+    {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s <%u\n", __func__, this, name (), count_);
+      internal::trace_printf ("%s(%d) @%p %s <%u\n", __func__, count, this,
+                              name (), count_);
 #endif
 
       // Don't call this from high priority interrupts.
       assert(port::interrupts::is_priority_valid ());
 
+      if (count <= 0 || count > max_value_)
+        {
+          return EINVAL;
+        }
+
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
 
-      return port::semaphore::try_wait (this);
+      if (count == 1)
+        {
+          return try_wait ();
+        }
+
+      return ENOTSUP;
 
 #else
 
@@ -529,7 +961,7 @@ namespace os
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
 
-          if (internal_try_wait_ ())
+          if (internal_try_wait_ (count))
             {
               return result::ok;
             }
@@ -582,15 +1014,17 @@ namespace os
     result_t
     semaphore::timed_wait (clock::duration_t timeout)
     {
+#if defined(OS_USE_RTOS_PORT_SEMAPHORE)
+
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
 #pragma GCC diagnostic push
 #if defined(__clang__)
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u) @%p %s <%u\n", __func__,
-                     static_cast<unsigned int> (timeout), this, name (),
-                     count_);
+      internal::trace_printf ("%s(%u) @%p %s <%u\n", __func__,
+                              static_cast<unsigned int> (timeout), this,
+                              name (), count_);
 #pragma GCC diagnostic pop
 #endif
 
@@ -599,9 +1033,64 @@ namespace os
       // Don't call this from critical regions.
       os_assert_err(!scheduler::locked (), EPERM);
 
+      return port::semaphore::timed_wait (this, timeout);
+
+#else
+
+      return timed_wait (1, timeout);
+
+#endif
+    }
+
+    /**
+     * @details
+     * Acquire _count_ units at once, as in `wait(count_t)`,
+     * but if they cannot be acquired without waiting, the wait
+     * shall be terminated when the specified timeout expires.
+     *
+     * Under no circumstance shall the function fail with a timeout
+     * if the units can be acquired immediately.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     *
+     * @warning Applications using these functions may be subject to priority inversion.
+     */
+    result_t
+    semaphore::timed_wait (count_t count, clock::duration_t timeout)
+    {
+#if defined(OS_TRACE_RTOS_SEMAPHORE)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+      internal::trace_printf ("%s(%d,%u) @%p %s <%u\n", __func__, count,
+                              static_cast<unsigned int> (timeout), this,
+                              name (), count_);
+#pragma GCC diagnostic pop
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      os_assert_err(!scheduler::locked (), EPERM);
+
+      if (count <= 0 || count > max_value_)
+        {
+          return EINVAL;
+        }
+
 #if defined(OS_USE_RTOS_PORT_SEMAPHORE)
 
-      return port::semaphore::timed_wait (this, timeout);
+      if (count == 1)
+        {
+          return timed_wait (timeout);
+        }
+
+      return ENOTSUP;
 
 #else
 
@@ -611,7 +1100,7 @@ namespace os
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
 
-          if (internal_try_wait_ ())
+          if (internal_try_wait_ (count))
             {
               return result::ok;
             }
@@ -623,8 +1112,8 @@ namespace os
       // Prepare a list node pointing to the current thread.
       // Do not worry for being on stack, it is temporarily linked to the
       // list and guaranteed to be removed before this function returns.
-      internal::waiting_thread_node node
-        { crt_thread };
+      internal::waiting_count_node node
+        { crt_thread, static_cast<uint32_t> (count) };
 
       internal::clock_timestamps_list& clock_list = clock_->steady_list ();
       clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
@@ -639,7 +1128,7 @@ namespace os
               // ----- Enter critical section ---------------------------------
               interrupts::critical_section ics;
 
-              if (internal_try_wait_ ())
+              if (internal_try_wait_ (count))
                 {
                   return result::ok;
                 }
@@ -647,8 +1136,13 @@ namespace os
               // Add this thread to the semaphore waiting list,
               // and the clock timeout list.
               scheduler::internal_link_node (list_, node, clock_list,
-                                             timeout_node);
+                                             timeout_node, this,
+                                             internal::wait_reason::semaphore);
               // state::suspended set in above link().
+
+              // If linked at the top of the list, this thread may
+              // already be satisfied by the available units.
+              internal_ready_satisfied_ ();
               // ----- Exit critical section ----------------------------------
             }
 
@@ -659,6 +1153,16 @@ namespace os
           // timeout list, if not already removed by the timer.
           scheduler::internal_unlink_node (node, timeout_node);
 
+          if (node.count_ == 0)
+            {
+              // The units were handed over by post().
+              return result::ok;
+            }
+
+          // Not served; the threads queued behind this one
+          // may be satisfied now.
+          internal_resume_satisfied_ ();
+
           if (crt_thread.interrupted ())
             {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
@@ -667,9 +1171,9 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-              trace::printf ("%s(%u) EINTR @%p %s\n", __func__,
-                             static_cast<unsigned int> (timeout), this,
-                             name ());
+              internal::trace_printf ("%s(%u) EINTR @%p %s\n", __func__,
+                                      static_cast<unsigned int> (timeout),
+                                      this, name ());
 #pragma GCC diagnostic pop
 #endif
               return EINTR;
@@ -683,9 +1187,9 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-              trace::printf ("%s(%u) ETIMEDOUT @%p %s\n", __func__,
-                             static_cast<unsigned int> (timeout), this,
-                             name ());
+              internal::trace_printf ("%s(%u) ETIMEDOUT @%p %s\n", __func__,
+                                      static_cast<unsigned int> (timeout),
+                                      this, name ());
 #pragma GCC diagnostic pop
 #endif
               return ETIMEDOUT;
@@ -742,7 +1246,8 @@ namespace os
     semaphore::reset (void)
     {
 #if defined(OS_TRACE_RTOS_SEMAPHORE)
-      trace::printf ("%s() @%p %s <%u\n", __func__, this, name (), count_);
+      internal::trace_printf ("%s() @%p %s <%u\n", __func__, this, name (),
+                              count_);
 #endif
 
       // Don't call this from interrupt handlers.
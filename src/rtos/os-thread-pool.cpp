@@ -0,0 +1,248 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/rtos/os-thread-pool.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class thread_pool
+     * @details
+     * Creating a thread requires initialising its stack and context,
+     * and, when the thread terminates, going through the idle
+     * thread to destroy it; for short jobs started often, this
+     * cost is significant.
+     *
+     * A thread pool creates its threads once; the jobs are
+     * functions queued to the pool and executed by the first
+     * available worker, which, when the function returns, waits
+     * for the next job instead of terminating.
+     *
+     * The workers have the same priority and the jobs are
+     * executed in the order they were dispatched, possibly in
+     * parallel.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     */
+
+    /**
+     * @details
+     * The workers must be already stopped by the derived class.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    thread_pool::~thread_pool ()
+    {
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+    }
+
+    void
+    thread_pool::internal_construct_ (message_queue& queue, thread** threads,
+                                      std::size_t workers)
+    {
+      assert(threads != nullptr);
+      assert(workers > 0);
+
+      queue_ = &queue;
+      threads_ = threads;
+      workers_ = workers;
+      busy_ = 0;
+    }
+
+    /**
+     * @details
+     * The stop requests are queued after the existing jobs, so the
+     * workers first execute all pending jobs.
+     */
+    void
+    thread_pool::internal_stop_ (void)
+    {
+      job_t job
+        { nullptr, nullptr };
+
+      for (std::size_t i = 0; i < workers_; ++i)
+        {
+          queue_->send (&job, sizeof(job));
+        }
+
+      for (std::size_t i = 0; i < workers_; ++i)
+        {
+          threads_[i]->join ();
+        }
+    }
+
+    /**
+     * @details
+     * Receive jobs and execute them, until a `nullptr` function is
+     * received.
+     */
+    void*
+    thread_pool::internal_worker_ (func_args_t args)
+    {
+      thread_pool* self = static_cast<thread_pool*> (args);
+
+      for (;;)
+        {
+          job_t job;
+          result_t res = self->queue_->receive (&job, sizeof(job));
+          if (res != result::ok)
+            {
+              // Interrupted; keep waiting.
+              continue;
+            }
+
+          if (job.function == nullptr)
+            {
+              break;
+            }
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              self->busy_ = self->busy_ + 1;
+              // ----- Exit critical section ----------------------------------
+            }
+
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+          internal::trace_printf ("%s() @%p %s run %p(%p) on %s\n", __func__,
+                                  self, self->name (), job.function, job.args,
+                                  this_thread::thread ().name ());
+#endif
+
+          job.function (job.args);
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              self->busy_ = self->busy_ - 1;
+              // ----- Exit critical section ----------------------------------
+            }
+        }
+
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+      internal::trace_printf ("%s() @%p %s %s stopped\n", __func__, self,
+                              self->name (), this_thread::thread ().name ());
+#endif
+
+      return nullptr;
+    }
+
+    /**
+     * @details
+     * Queue the job to be executed by the first available worker.
+     * If the queue is full, the calling thread is suspended until
+     * a worker takes a job.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread_pool::dispatch (func_t function, func_args_t args)
+    {
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+      internal::trace_printf ("%s(%p,%p) @%p %s\n", __func__, function, args,
+                              this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      os_assert_err(function != nullptr, EINVAL);
+
+      job_t job
+        { function, args };
+
+      return queue_->send (&job, sizeof(job));
+    }
+
+    /**
+     * @details
+     * Queue the job, if there is space in the queue.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread_pool::try_dispatch (func_t function, func_args_t args)
+    {
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+      internal::trace_printf ("%s(%p,%p) @%p %s\n", __func__, function, args,
+                              this, name ());
+#endif
+
+      os_assert_err(function != nullptr, EINVAL);
+
+      job_t job
+        { function, args };
+
+      return queue_->try_send (&job, sizeof(job));
+    }
+
+    /**
+     * @details
+     * Queue the job; if the queue is full, the calling thread is
+     * suspended until a worker takes a job or the timeout expires.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread_pool::timed_dispatch (func_t function, func_args_t args,
+                                 clock::duration_t timeout)
+    {
+#if defined(OS_TRACE_RTOS_THREAD_POOL)
+      internal::trace_printf ("%s(%p,%p,%u) @%p %s\n", __func__, function,
+                              args, timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      os_assert_err(function != nullptr, EINVAL);
+
+      job_t job
+        { function, args };
+
+      return queue_->timed_send (&job, sizeof(job), timeout);
+    }
+
+  // --------------------------------------------------------------------------
+  } /* namespace rtos */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
@@ -16,6 +16,10 @@
 
 #include <cmsis-plus/rtos/os.h>
 
+#if defined(OS_USE_TRACE_EVENTS)
+#include <cmsis-plus/diag/trace-events.h>
+#endif
+
 #include <memory>
 #include <stdexcept>
 
@@ -150,7 +154,7 @@ namespace os
      */
 
     void
-    thread::stack::initialize (void)
+    thread::stack::initialize (bool fill)
     {
       // Align the bottom of the stack.
       void* pa = bottom_address_;
@@ -161,17 +165,27 @@ namespace os
       // If there is not enough space for the minimal stack, fail.
       os_assert_throw(bottom_address_ != nullptr, ENOMEM);
 
-      element_t* p = bottom_address_;
       element_t* pend = top ();
 
-      // Initialise the entire stack with the magic word.
-      for (; p < pend; ++p)
+      if (fill)
         {
-          *p = magic;
+          // Initialise the entire stack with the magic word.
+          for (element_t* p = bottom_address_; p < pend; ++p)
+            {
+              *p = magic;
+            }
+          watermark_ = nullptr;
+        }
+      else
+        {
+          // Only the guard words; the usage cannot be measured.
+          *bottom_address_ = magic;
+          *(pend - 1) = magic;
+          watermark_ = bottom_address_;
         }
 
       // Compute the actual size. The -1 is to leave space for the magic.
-      size_bytes_ = ((static_cast<std::size_t> (p - bottom_address_) - 1)
+      size_bytes_ = ((static_cast<std::size_t> (pend - bottom_address_) - 1)
           * sizeof(element_t));
     }
 
@@ -183,13 +197,21 @@ namespace os
      * @details
      * Count the number of bytes where the magic is still there.
      *
-     * @warning: For large stacks it may be an expensive operation.
+     * If the stack was not filled, return 0.
+     *
+     * @warning: For large stacks it may be an expensive operation;
+     * prefer `high_water_mark()` for periodic checks.
      *
      * @warning Cannot be invoked from Interrupt Service Routines.
      */
     std::size_t
     thread::stack::available (void)
     {
+      if (watermark_ == bottom_address_)
+        {
+          return 0;
+        }
+
       element_t* p = bottom_address_;
       std::size_t count = 0;
       while (*p == magic)
@@ -198,9 +220,78 @@ namespace os
           ++p;
         }
 
+      // The exact value also improves the estimate.
+      if (watermark_ == nullptr || p < watermark_)
+        {
+          watermark_ = p;
+        }
+
       return count;
     }
 
+    /**
+     * @details
+     * Instead of counting all the magic words, perform a binary
+     * search for the boundary between the unused area, still
+     * filled with the magic word, and the used area, which is
+     * considered to start where there are no
+     * `watermark_probe_elements` consecutive magic words.
+     *
+     * The result is remembered, and the next searches are limited
+     * to the area below it, so the cost is logarithmic in
+     * the available size.
+     *
+     * Large local buffers not yet written may look unused;
+     * if an exact value is needed, use `available()`.
+     *
+     * If the stack was not filled, return the entire size.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    thread::stack::high_water_mark (void)
+    {
+      element_t* pend = top ();
+
+      if (watermark_ == bottom_address_)
+        {
+          return size_bytes_;
+        }
+
+      // Invariants: lo is unused, hi is used, or the top guard.
+      element_t* lo = bottom_address_;
+      element_t* hi = (watermark_ == nullptr) ? pend : watermark_;
+
+      while (hi - lo > 1)
+        {
+          element_t* mid = lo + (hi - lo) / 2;
+
+          bool unused = true;
+          for (element_t* p = mid;
+              p < hi && p < mid + watermark_probe_elements; ++p)
+            {
+              if (*p != magic)
+                {
+                  unused = false;
+                  break;
+                }
+            }
+
+          if (unused)
+            {
+              lo = mid;
+            }
+          else
+            {
+              hi = mid;
+            }
+        }
+
+      watermark_ = hi;
+
+      return static_cast<std::size_t> (pend - hi) * sizeof(element_t);
+    }
+
     /**
      * @cond ignore
      */
@@ -217,7 +308,8 @@ namespace os
     thread::internal_invoke_with_exit_ (thread* thread)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, thread, thread->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, thread,
+                              thread->name ());
 #endif
 
       void* exit_ptr;
@@ -247,7 +339,7 @@ namespace os
     thread::thread ()
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
       // Must be explicit here, since they are not done in the members
       // declarations to allow th_enable_assert_reuse.
@@ -260,7 +352,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
       // Must be explicit here, since they are not done in the members
       // declarations to allow th_enable_assert_reuse.
@@ -399,7 +491,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
 
 #if defined(DEBUG)
@@ -496,9 +588,9 @@ namespace os
         }
 
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s p%u stack{%p,%u}\n", __func__, this, name (),
-                     attr.th_priority, stack ().bottom_address_,
-                     stack ().size_bytes_);
+      internal::trace_printf ("%s() @%p %s p%u stack{%p,%u}\n", __func__, this,
+                              name (), attr.th_priority,
+                              stack ().bottom_address_, stack ().size_bytes_);
 #endif
 
         {
@@ -522,7 +614,7 @@ namespace os
               scheduler::top_threads_list_.link (*this);
             }
 
-          stack ().initialize ();
+          stack ().initialize (attr.th_stack_fill);
 
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
 
@@ -577,7 +669,7 @@ namespace os
     thread::~thread ()
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s \n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s \n", __func__, this, name ());
 #endif
 
       // Prevent the main thread to destroy itself while running
@@ -593,8 +685,8 @@ namespace os
       else
         {
 #if defined(OS_TRACE_RTOS_THREAD)
-          trace::printf ("%s() @%p %s nop, cannot commit suicide\n", __func__,
-                         this, name ());
+          internal::trace_printf ("%s() @%p %s nop, cannot commit suicide\n",
+                                  __func__, this, name ());
 #endif
         }
     }
@@ -611,44 +703,7 @@ namespace os
     void
     thread::resume (void)
     {
-#if defined(OS_TRACE_RTOS_THREAD_CONTEXT)
-      trace::printf ("%s() @%p %s %u\n", __func__, this, name (),
-                     prio_assigned_);
-#endif
-
-#if defined(OS_USE_RTOS_PORT_SCHEDULER)
-
-        {
-          // ----- Enter critical section -------------------------------------
-          interrupts::critical_section ics;
-
-          state_ = state::ready;
-          port::thread::resume (this);
-          // ----- Exit critical section --------------------------------------
-        }
-
-#else
-
-      // Don't call this from high priority interrupts.
-      assert(port::interrupts::is_priority_valid ());
-
-        {
-          // ----- Enter critical section -------------------------------------
-          interrupts::critical_section ics;
-
-          // If the thread is not already in the ready list, enqueue it.
-          if (ready_node_.next () == nullptr)
-            {
-              scheduler::ready_threads_list_.link (ready_node_);
-              // state::ready set in above link().
-            }
-          // ----- Exit critical section --------------------------------------
-        }
-
-      port::scheduler::reschedule ();
-
-#endif
-
+      internal_resume_ (nullptr, internal::wait_reason::none);
     }
 
     /**
@@ -715,7 +770,8 @@ namespace os
     thread::priority (priority_t prio)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s(%u) @%p %s\n", __func__, prio, this, name ());
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__, prio, this,
+                              name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -748,7 +804,7 @@ namespace os
 
           // Remove from initial location and reinsert according
           // to new priority.
-          ready_node_.unlink ();
+          scheduler::ready_threads_list_.unlink (ready_node_);
           scheduler::ready_threads_list_.link (ready_node_);
           // ----- Exit critical section --------------------------------------
         }
@@ -783,7 +839,8 @@ namespace os
     thread::priority_inherited (priority_t prio)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s(%u) @%p %s\n", __func__, prio, this, name ());
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__, prio, this,
+                              name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -825,7 +882,7 @@ namespace os
 
           // Remove from initial location and reinsert according
           // to new priority.
-          ready_node_.unlink ();
+          scheduler::ready_threads_list_.unlink (ready_node_);
           scheduler::ready_threads_list_.link (ready_node_);
           // ----- Exit critical section --------------------------------------
         }
@@ -839,6 +896,65 @@ namespace os
       return res;
     }
 
+    /**
+     * @cond ignore
+     */
+
+    /**
+     * @details
+     * Used by mutexes to propagate the priority of the blocking
+     * threads along the chain of owners. Unlike `priority_inherited()`,
+     * it does not yield; the caller is about to block, and the
+     * context switch will be performed at that moment.
+     *
+     * Should be called from a scheduler critical section.
+     */
+    void
+    thread::internal_inherit_priority_ (priority_t prio)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__, prio, this,
+                              name ());
+#endif
+
+      if (prio <= prio_inherited_)
+        {
+          return;
+        }
+
+      prio_inherited_ = prio;
+
+      if (prio_inherited_ < prio_assigned_)
+        {
+          // Optimise, the effective priority did not change.
+          return;
+        }
+
+#if defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      port::thread::priority (this, prio);
+
+#else
+
+      if (state_ == state::ready)
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          // Remove from initial location and reinsert according
+          // to new priority.
+          scheduler::ready_threads_list_.unlink (ready_node_);
+          scheduler::ready_threads_list_.link (ready_node_);
+          // ----- Exit critical section --------------------------------------
+        }
+
+#endif
+    }
+
+    /**
+     * @endcond
+     */
+
     /**
      * @details
      * Indicate to the implementation that storage for the thread
@@ -861,7 +977,7 @@ namespace os
     thread::detach (void)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -916,7 +1032,7 @@ namespace os
     thread::join (void** exit_ptr)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -930,11 +1046,12 @@ namespace os
       while (state_ != state::destroyed)
         {
           joiner_ = this_thread::_thread ();
-          this_thread::_thread ()->internal_suspend_ ();
+          this_thread::_thread ()->internal_suspend_ (
+              this, internal::wait_reason::thread_join);
         }
 
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s joined\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s joined\n", __func__, this, name ());
 #endif
 
       if (exit_ptr != nullptr)
@@ -967,7 +1084,7 @@ namespace os
     thread::cancel (void)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -992,13 +1109,13 @@ namespace os
     thread::interrupt (bool interrupt)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       bool tmp = interrupted_;
       interrupted_ = interrupt;
 
-      resume ();
+      internal_resume_ (nullptr, internal::wait_reason::interrupt);
       return tmp;
     }
 
@@ -1006,15 +1123,103 @@ namespace os
      * @cond ignore
      */
 
+    void
+    thread::internal_resume_ (
+        const void* object __attribute__((unused)),
+        internal::wait_reason_t reason __attribute__((unused)))
+    {
+#if defined(OS_TRACE_RTOS_THREAD_CONTEXT)
+      internal::trace_printf ("%s() @%p %s %u\n", __func__, this, name (),
+                              prio_assigned_);
+#endif
+
+#if defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+#if defined(OS_TRACE_EVENTS_RESUME)
+      trace::events::record (trace::events::thread_resume,
+                             reinterpret_cast<trace::events::arg_t> (this),
+                             reinterpret_cast<trace::events::arg_t> (object),
+                             reason);
+#endif
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          state_ = state::ready;
+          port::thread::resume (this);
+          // ----- Exit critical section --------------------------------------
+        }
+
+#else
+
+      // Don't call this from high priority interrupts.
+      assert(port::interrupts::is_priority_valid ());
+
+      internal_make_ready_ (object, reason);
+
+      port::scheduler::reschedule ();
+
+#endif
+    }
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+    // Also used during context switches, for the deferred semaphore
+    // posts, before the next thread is selected, so there is no
+    // need to reschedule.
+    void
+    thread::internal_make_ready_ (
+        const void* object __attribute__((unused)),
+        internal::wait_reason_t reason __attribute__((unused)))
+    {
+#if defined(OS_TRACE_EVENTS_RESUME)
+      trace::events::record (trace::events::thread_resume,
+                             reinterpret_cast<trace::events::arg_t> (this),
+                             reinterpret_cast<trace::events::arg_t> (object),
+                             reason);
+#endif
+
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      // If the thread is not already in the ready list, enqueue it.
+      if (ready_node_.next () == nullptr)
+        {
+          scheduler::ready_threads_list_.link (ready_node_);
+          // state::ready set in above link().
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+          // Start measuring the wakeup latency.
+          if (statistics_.resume_timestamp_ == 0)
+            {
+              statistics_.resume_timestamp_ = hrclock.now ();
+            }
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+        }
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
     /**
      * @par POSIX compatibility
      *  Extension to standard, no POSIX similar functionality identified.
      */
     void
-    thread::internal_suspend_ (void)
+    thread::internal_suspend_ (
+        const void* object __attribute__((unused)),
+        internal::wait_reason_t reason __attribute__((unused)))
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+#if defined(OS_TRACE_EVENTS_BLOCK)
+      trace::events::record (trace::events::thread_block,
+                             reinterpret_cast<trace::events::arg_t> (this),
+                             reinterpret_cast<trace::events::arg_t> (object),
+                             reason);
 #endif
 
         {
@@ -1035,7 +1240,7 @@ namespace os
     thread::internal_exit_ (void* exit_ptr)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1049,7 +1254,11 @@ namespace os
               // ----- Enter critical section ---------------------------------
               interrupts::critical_section ics;
 
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+              scheduler::ready_threads_list_.unlink (ready_node_);
+#else
               ready_node_.unlink ();
+#endif
 
               child_links_.unlink ();
               // ----- Exit critical section ----------------------------------
@@ -1113,10 +1322,10 @@ namespace os
             }
 
 #if defined(OS_TRACE_RTOS_THREAD)
-          trace::printf ("%s() @%p %s stack: %u/%u bytes used\n", __func__,
-                         this, name (),
-                         stack ().size () - stack ().available (),
-                         stack ().size ());
+          internal::trace_printf ("%s() @%p %s stack: %u/%u bytes used\n",
+                                  __func__, this, name (),
+                                  stack ().high_water_mark (),
+                                  stack ().size ());
 #endif
 
           // Clear stack to avoid further checks
@@ -1134,7 +1343,7 @@ namespace os
     thread::internal_destroy_ (void)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       internal_check_stack_ ();
@@ -1157,6 +1366,11 @@ namespace os
           allocated_stack_address_ = nullptr;
         }
 
+#if defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE)
+      // Return the cached small blocks to the application free store.
+      allocation_cache_.flush ();
+#endif /* defined(OS_USE_RTOS_THREAD_ALLOCATION_CACHE) */
+
         {
           // ----- Enter critical section -------------------------------------
           scheduler::critical_section scs;
@@ -1178,7 +1392,7 @@ namespace os
 
       if (joiner_ != nullptr)
         {
-          joiner_->resume ();
+          joiner_->internal_resume_ (this, internal::wait_reason::thread_join);
         }
     }
 #pragma GCC diagnostic pop
@@ -1199,7 +1413,7 @@ namespace os
     thread::kill (void)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1212,8 +1426,8 @@ namespace os
           if (state_ == state::destroyed)
             {
 #if defined(OS_TRACE_RTOS_THREAD)
-              trace::printf ("%s() @%p %s already gone\n", __func__, this,
-                             name ());
+              internal::trace_printf ("%s() @%p %s already gone\n", __func__,
+                                      this, name ());
 #endif
               return result::ok; // Already exited itself
             }
@@ -1223,7 +1437,11 @@ namespace os
               interrupts::critical_section ics;
 
               // Remove thread from the funeral list and kill it here.
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+              scheduler::ready_threads_list_.unlink (ready_node_);
+#else
               ready_node_.unlink ();
+#endif
 
               // If the thread is waiting on an event, remove it from the list.
               if (waiting_node_ != nullptr)
@@ -1281,17 +1499,17 @@ namespace os
     thread::flags_raise (flags::mask_t mask, flags::mask_t* oflags)
     {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X) @%p %s <0x%X\n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s <0x%X\n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
 
       result_t res = event_flags_.raise (mask, oflags);
 
-      this->resume ();
+      internal_resume_ (this, internal::wait_reason::thread_flags);
 
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
 
       return res;
@@ -1306,8 +1524,8 @@ namespace os
                                   flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask, mode, this,
-                     name (), event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask,
+                              mode, this, name (), event_flags_.mask ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1322,8 +1540,9 @@ namespace os
           if (event_flags_.check_raised (mask, oflags, mode))
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__, mask, mode,
-                             this, name (), event_flags_.mask ());
+              internal::trace_printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__,
+                                      mask, mode, this, name (),
+                                      event_flags_.mask ());
 #endif
               return result::ok;
             }
@@ -1345,22 +1564,22 @@ namespace os
                   clock::duration_t slept_ticks =
                       static_cast<clock::duration_t> (clock_->now ()
                           - begin_timestamp);
-                  trace::printf ("%s(0x%X,%u) in %d @%p %s >0x%X\n", __func__,
-                                 mask, mode, slept_ticks, this, name (),
-                                 event_flags_.mask ());
+                  internal::trace_printf ("%s(0x%X,%u) in %d @%p %s >0x%X\n",
+                                          __func__, mask, mode, slept_ticks,
+                                          this, name (), event_flags_.mask ());
 #endif
                   return result::ok;
                 }
               // ----- Exit critical section ----------------------------------
             }
 
-          internal_suspend_ ();
+          internal_suspend_ (this, internal::wait_reason::thread_flags);
 
           if (interrupted ())
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u) EINTR @%p %s\n", __func__, mask, mode,
-                             this, name ());
+              internal::trace_printf ("%s(0x%X,%u) EINTR @%p %s\n", __func__,
+                                      mask, mode, this, name ());
 #endif
               return EINTR;
             }
@@ -1375,8 +1594,8 @@ namespace os
                                       flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask, mode, this,
-                     name (), event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X,%u) @%p %s <0x%X\n", __func__, mask,
+                              mode, this, name (), event_flags_.mask ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1389,16 +1608,17 @@ namespace os
           if (event_flags_.check_raised (mask, oflags, mode))
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__, mask, mode,
-                             this, name (), event_flags_.mask ());
+              internal::trace_printf ("%s(0x%X,%u) @%p %s >0x%X\n", __func__,
+                                      mask, mode, this, name (),
+                                      event_flags_.mask ());
 #endif
               return result::ok;
             }
           else
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u) EWOULDBLOCK @%p %s \n", __func__,
-                             mask, mode, this, name ());
+              internal::trace_printf ("%s(0x%X,%u) EWOULDBLOCK @%p %s \n",
+                                      __func__, mask, mode, this, name ());
 #endif
               return EWOULDBLOCK;
             }
@@ -1413,8 +1633,9 @@ namespace os
                                         flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X,%u,%u) @%p %s <0x%X\n", __func__, mask, timeout,
-                     mode, this, name (), event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X,%u,%u) @%p %s <0x%X\n", __func__, mask,
+                              timeout, mode, this, name (),
+                              event_flags_.mask ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1429,9 +1650,9 @@ namespace os
           if (event_flags_.check_raised (mask, oflags, mode))
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u,%u) @%p %s >0x%X\n", __func__, mask,
-                             timeout, mode, this, name (),
-                             event_flags_.mask ());
+              internal::trace_printf ("%s(0x%X,%u,%u) @%p %s >0x%X\n",
+                                      __func__, mask, timeout, mode, this,
+                                      name (), event_flags_.mask ());
 #endif
               return result::ok;
             }
@@ -1466,15 +1687,30 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-                  trace::printf ("%s(0x%X,%u,%u) in %u @%p %s >0x%X\n",
-                                 __func__, mask, timeout, mode,
-                                 static_cast<unsigned int> (slept_ticks), this,
-                                 name (), event_flags_.mask ());
+                  internal::trace_printf (
+                      "%s(0x%X,%u,%u) in %u @%p %s >0x%X\n", __func__, mask,
+                      timeout, mode, static_cast<unsigned int> (slept_ticks),
+                      this, name (), event_flags_.mask ());
 #pragma GCC diagnostic pop
 #endif
                   return result::ok;
                 }
 
+#if defined(OS_TRACE_EVENTS_BLOCK)
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+              trace::events::record (
+                  trace::events::thread_block,
+                  reinterpret_cast<trace::events::arg_t> (this),
+                  reinterpret_cast<trace::events::arg_t> (this),
+                  internal::wait_reason::thread_flags,
+                  static_cast<trace::events::arg_t> (timeout_timestamp));
+#pragma GCC diagnostic pop
+#endif
+
               // Remove this thread from the ready list, if there.
               port::this_thread::prepare_suspend ();
 
@@ -1502,8 +1738,9 @@ namespace os
           if (interrupted ())
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u,%u) EINTR @%p %s\n", __func__, mask,
-                             timeout, mode, this, name ());
+              internal::trace_printf ("%s(0x%X,%u,%u) EINTR @%p %s\n",
+                                      __func__, mask, timeout, mode, this,
+                                      name ());
 #endif
               return EINTR;
             }
@@ -1511,8 +1748,9 @@ namespace os
           if (clock_->steady_now () >= timeout_timestamp)
             {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-              trace::printf ("%s(0x%X,%u,%u) ETIMEDOUT @%p %s\n", __func__,
-                             mask, timeout, mode, this, name ());
+              internal::trace_printf ("%s(0x%X,%u,%u) ETIMEDOUT @%p %s\n",
+                                      __func__, mask, timeout, mode, this,
+                                      name ());
 #endif
               return ETIMEDOUT;
             }
@@ -1536,7 +1774,8 @@ namespace os
     thread::internal_flags_get_ (flags::mask_t mask, flags::mode_t mode)
     {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X) @%p %s\n", __func__, mask, this, name ());
+      internal::trace_printf ("%s(0x%X) @%p %s\n", __func__, mask, this,
+                              name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1545,8 +1784,8 @@ namespace os
       flags::mask_t ret = event_flags_.get (mask, mode);
 
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X)=0x%X @%p %s\n", __func__, mask,
-                     event_flags_.mask (), this, name ());
+      internal::trace_printf ("%s(0x%X)=0x%X @%p %s\n", __func__, mask,
+                              event_flags_.mask (), this, name ());
 #endif
       // Return the selected bits.
       return ret;
@@ -1559,8 +1798,8 @@ namespace os
     thread::internal_flags_clear_ (flags::mask_t mask, flags::mask_t* oflags)
     {
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X) @%p %s <0x%X\n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s <0x%X\n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -1569,8 +1808,8 @@ namespace os
       result_t res = event_flags_.clear (mask, oflags);
 
 #if defined(OS_TRACE_RTOS_THREAD_FLAGS)
-      trace::printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this, name (),
-                     event_flags_.mask ());
+      internal::trace_printf ("%s(0x%X) @%p %s >0x%X\n", __func__, mask, this,
+                              name (), event_flags_.mask ());
 #endif
       return res;
     }
@@ -1579,6 +1818,196 @@ namespace os
      * @endcond
      */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @details
+     * The time is split in windows of
+     * @ref OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS system clock
+     * ticks; the load is the number of cycles the thread ran in
+     * the last complete window, relative to the window duration.
+     *
+     * The cycles are accounted at context switches, which,
+     * with the default scheduler, occur at least once per tick.
+     * With @ref OS_USE_RTOS_CLOCK_SYSTICK_TICKLESS, the idle
+     * thread may sleep over several windows without a switch,
+     * and all its cycles are accounted to the window in
+     * which it is switched out, so the load of the previous
+     * windows is under-reported.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    uint32_t
+    thread::statistics::cpu_load (void)
+    {
+      clock::timestamp_t window = sysclock.now ()
+          / OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS;
+
+      rtos::statistics::duration_t cycles;
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          if (window_ == window)
+            {
+              cycles = load_cycles_;
+            }
+          else if (window_ + 1 == window)
+            {
+              // The thread did not run in the current window.
+              cycles = window_cycles_;
+            }
+          else
+            {
+              cycles = 0;
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      rtos::statistics::duration_t total =
+          static_cast<rtos::statistics::duration_t> (hrclock.input_clock_frequency_hz ())
+              * OS_INTEGER_RTOS_STATISTICS_LOAD_WINDOW_TICKS
+              / clock_systick::frequency_hz;
+
+      if (cycles >= total)
+        {
+          return 10000;
+        }
+
+      return static_cast<uint32_t> (cycles * 10000 / total);
+    }
+
+    /**
+     * @details
+     * The histogram has a logarithmic scale, so the result is
+     * rounded up to the limit of the bucket where the percentile
+     * falls, but never exceeds the maximum latency.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    rtos::statistics::duration_t
+    thread::statistics::latency_percentile (unsigned int per_mille)
+    {
+      rtos::statistics::counter_t total = 0;
+      for (std::size_t i = 0; i < histogram_buckets; ++i)
+        {
+          total += latency_histogram_[i];
+        }
+
+      if (total == 0)
+        {
+          return 0;
+        }
+
+      rtos::statistics::counter_t target = (total * per_mille + 999) / 1000;
+      rtos::statistics::counter_t count = 0;
+      for (std::size_t i = 0; i < histogram_buckets; ++i)
+        {
+          count += latency_histogram_[i];
+          if (count >= target)
+            {
+              rtos::statistics::duration_t limit = bucket_limit (i);
+              if (limit == 0 || limit - 1 > latency_max_)
+                {
+                  break;
+                }
+              return limit - 1;
+            }
+        }
+
+      return latency_max_;
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    std::size_t
+    thread::statistics::internal_bucket_ (rtos::statistics::duration_t duration)
+    {
+      if (duration == 0)
+        {
+          return 0;
+        }
+
+      std::size_t bucket = 64
+          - static_cast<std::size_t> (__builtin_clzll (
+              static_cast<unsigned long long> (duration)));
+
+      return bucket < histogram_buckets ? bucket : histogram_buckets - 1;
+    }
+
+    // Called from the context switch, for the thread that ran.
+    void
+    thread::statistics::internal_account_cycles_ (
+        rtos::statistics::duration_t delta, clock::timestamp_t window)
+    {
+      if (window_ != window)
+        {
+          load_cycles_ = (window_ + 1 == window) ? window_cycles_ : 0;
+          window_cycles_ = 0;
+          window_ = window;
+        }
+
+      window_cycles_ += delta;
+      burst_cycles_ += delta;
+    }
+
+    // Called from the context switch, when the thread leaves the CPU.
+    void
+    thread::statistics::internal_account_burst_ (void)
+    {
+      ++burst_histogram_[internal_bucket_ (burst_cycles_)];
+      burst_cycles_ = 0;
+    }
+
+    // Called from the context switch, when the thread is selected to run.
+    void
+    thread::statistics::internal_account_run_ (clock::timestamp_t now)
+    {
+      if (resume_timestamp_ == 0)
+        {
+          // Preempted, not resumed.
+          return;
+        }
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+
+      rtos::statistics::duration_t latency =
+          static_cast<rtos::statistics::duration_t> (now - resume_timestamp_);
+
+#pragma GCC diagnostic pop
+
+      resume_timestamp_ = 0;
+
+      if (latency > latency_max_)
+        {
+          latency_max_ = latency;
+        }
+      ++latency_histogram_[internal_bucket_ (latency)];
+    }
+
+    /**
+     * @endcond
+     */
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
     // ------------------------------------------------------------------------
     /**
      * @details
@@ -1646,13 +2075,15 @@ namespace os
         if (!scheduler::started ())
           {
 #if defined(OS_TRACE_RTOS_THREAD_CONTEXT)
-            trace::printf ("%s() nop %s \n", __func__, _thread ()->name ());
+            internal::trace_printf ("%s() nop %s \n", __func__,
+                                    _thread ()->name ());
 #endif
             return;
           }
 
 #if defined(OS_TRACE_RTOS_THREAD_CONTEXT)
-        trace::printf ("%s() from %s\n", __func__, _thread ()->name ());
+        internal::trace_printf ("%s() from %s\n", __func__,
+                                _thread ()->name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
@@ -1666,7 +2097,7 @@ namespace os
 #endif
 
 #if defined(OS_TRACE_RTOS_THREAD_CONTEXT)
-        trace::printf ("%s() to %s\n", __func__, _thread ()->name ());
+        internal::trace_printf ("%s() to %s\n", __func__, _thread ()->name ());
 #endif
       }
 
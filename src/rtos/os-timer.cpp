@@ -174,7 +174,7 @@ namespace os
           { name }
     {
 #if defined(OS_TRACE_RTOS_TIMER)
-      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, this->name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -215,7 +215,7 @@ namespace os
     timer::~timer ()
     {
 #if defined(OS_TRACE_RTOS_TIMER)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
 #if defined(OS_USE_RTOS_PORT_TIMER)
@@ -254,8 +254,9 @@ namespace os
 #elif defined(__GNUC__)
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #endif
-      trace::printf ("%s(%u) @%p %s\n", __func__,
-                     static_cast<unsigned int> (period), this, name ());
+      internal::trace_printf ("%s(%u) @%p %s\n", __func__,
+                              static_cast<unsigned int> (period), this,
+                              name ());
 #pragma GCC diagnostic pop
 #endif
 
@@ -313,7 +314,7 @@ namespace os
     timer::stop (void)
     {
 #if defined(OS_TRACE_RTOS_TIMER)
-      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
       // Don't call this from interrupt handlers.
@@ -0,0 +1,342 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#if defined(OS_USE_OS_APP_CONFIG_H)
+#include <cmsis-plus/os-app-config.h>
+#endif
+
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class work_item
+     * @details
+     * A work item is a function and its argument, which can be
+     * submitted to a work queue from threads or from interrupt
+     * service routines, possibly with a delay, and is later
+     * executed by one of the queue service threads.
+     *
+     * The item can be submitted again after it was taken by a
+     * service thread, including from its own function.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     */
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    work_item::~work_item ()
+    {
+      // Destroying a pending item would leave dangling links.
+      assert(queue_ == nullptr);
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    // Called from the clock interrupt, in a critical section,
+    // when the delay expired.
+    void
+    work_item::internal_interrupt_service_routine (void)
+    {
+      queue_->internal_enqueue_ (*this);
+    }
+
+    /**
+     * @endcond
+     */
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class work_queue
+     * @details
+     * Interrupt service routines and timer callbacks should be
+     * short; the work that does not need to be done in the
+     * interrupt context can be deferred to a work queue, whose
+     * service threads execute it at thread level.
+     *
+     * The work items are intrusive, so submitting them does not
+     * allocate memory and can be done from interrupt service
+     * routines.
+     *
+     * Delayed items are linked in the system clock list, like
+     * the timers, and are queued when the delay expires.
+     *
+     * The items are executed in the order they were queued; with
+     * multiple service threads, they may run in parallel.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     */
+
+    /**
+     * @details
+     * The service threads must be already stopped by the derived
+     * class.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    work_queue::~work_queue ()
+    {
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+      internal::trace_printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      assert(list_.empty ());
+    }
+
+    /**
+     * @details
+     * If the item is waiting for a delay, the delay is cancelled
+     * and the item is queued immediately.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    work_queue::submit (work_item& item)
+    {
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+      internal::trace_printf ("%s(%p) @%p %s\n", __func__, &item, this,
+                              name ());
+#endif
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          if (item.queue_ != nullptr && item.queue_ != this)
+            {
+              return EBUSY;
+            }
+
+          if (!item.links_.unlinked ())
+            {
+              return EALREADY;
+            }
+
+          // If delayed, do not wait any more.
+          item.work_node_.unlink ();
+
+          item.queue_ = this;
+          list_.link (item);
+          // ----- Exit critical section --------------------------------------
+        }
+
+      semaphore_.post ();
+
+      return result::ok;
+    }
+
+    /**
+     * @details
+     * The item is linked in the system clock list and is queued
+     * when the delay expires. If the item is already pending,
+     * it is rescheduled.
+     *
+     * A delay of 0 ticks queues the item immediately.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    work_queue::submit_delayed (work_item& item, clock::duration_t ticks)
+    {
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+      internal::trace_printf ("%s(%p,%u) @%p %s\n", __func__, &item, ticks,
+                              this, name ());
+#endif
+
+      if (ticks == 0)
+        {
+          return submit (item);
+        }
+
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      if (item.queue_ != nullptr && item.queue_ != this)
+        {
+          return EBUSY;
+        }
+
+      item.links_.unlink ();
+      item.work_node_.unlink ();
+
+      item.queue_ = this;
+      item.work_node_.timestamp = sysclock.steady_now () + ticks;
+      sysclock.steady_list ().link (item.work_node_);
+
+      return result::ok;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @details
+     * Remove the item from the queue or from the clock list.
+     * An item already taken by a service thread cannot be cancelled.
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    work_queue::cancel (work_item& item)
+    {
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+      internal::trace_printf ("%s(%p) @%p %s\n", __func__, &item, this,
+                              name ());
+#endif
+
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      if (item.queue_ != this)
+        {
+          return EALREADY;
+        }
+
+      item.links_.unlink ();
+      item.work_node_.unlink ();
+      item.queue_ = nullptr;
+
+      return result::ok;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    void
+    work_queue::internal_construct_ (thread** threads, std::size_t count)
+    {
+      assert(threads != nullptr);
+      assert(count > 0);
+
+      threads_ = threads;
+      count_ = count;
+      stopping_ = false;
+    }
+
+    /**
+     * @details
+     * The items already queued are executed before the service
+     * threads exit; delayed items must be cancelled before
+     * destroying the queue.
+     */
+    void
+    work_queue::internal_stop_ (void)
+    {
+      stopping_ = true;
+      semaphore_.post ();
+
+      for (std::size_t i = 0; i < count_; ++i)
+        {
+          threads_[i]->join ();
+        }
+    }
+
+    // Must be called in a critical section.
+    void
+    work_queue::internal_enqueue_ (work_item& item)
+    {
+      list_.link (item);
+      semaphore_.post ();
+    }
+
+    void*
+    work_queue::internal_service_ (thread::func_args_t args)
+    {
+      work_queue* self = static_cast<work_queue*> (args);
+
+      for (;;)
+        {
+          self->semaphore_.wait ();
+
+          work_item* item = nullptr;
+          bool more;
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              if (!self->list_.empty ())
+                {
+                  item = self->list_.unlink_head ();
+                  item->queue_ = nullptr;
+                }
+              more = !self->list_.empty ();
+              // ----- Exit critical section ----------------------------------
+            }
+
+          // The semaphore is binary, so multiple submits may
+          // have been folded into a single post; wake the next
+          // service thread if there is more work, or to
+          // pass on the stop request.
+          if (more || (item == nullptr && self->stopping_))
+            {
+              self->semaphore_.post ();
+            }
+
+          if (item == nullptr)
+            {
+              if (self->stopping_)
+                {
+                  break;
+                }
+              // Cancelled before being taken.
+              continue;
+            }
+
+#if defined(OS_TRACE_RTOS_WORK_QUEUE)
+          internal::trace_printf ("%s() @%p %s run %p on %s\n", __func__, self,
+                                  self->name (), item,
+                                  this_thread::thread ().name ());
+#endif
+
+          item->func_ (item->func_args_);
+        }
+
+      return nullptr;
+    }
+
+    /**
+     * @endcond
+     */
+
+  // --------------------------------------------------------------------------
+  } /* namespace rtos */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
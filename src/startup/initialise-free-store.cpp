@@ -27,6 +27,7 @@
 #include <cmsis-plus/rtos/os-hooks.h>
 #include <cmsis-plus/memory/first-fit-top.h>
 #include <cmsis-plus/memory/lifo.h>
+#include <cmsis-plus/memory/tlsf.h>
 #include <cmsis-plus/memory/block-pool.h>
 #include <cmsis-plus/estd/memory_resource>
 
@@ -40,6 +41,7 @@ using namespace os;
 using application_memory_resource = OS_TYPE_APPLICATION_MEMORY_RESOURCE;
 #else
 //using free_store_memory_resource = os::memory::lifo;
+//using free_store_memory_resource = os::memory::tlsf;
 using application_memory_resource = os::memory::first_fit_top;
 #endif
 
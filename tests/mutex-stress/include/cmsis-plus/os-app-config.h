@@ -19,6 +19,9 @@
 
 #define OS_INTEGER_SYSTICK_FREQUENCY_HZ                     (1000)
 
+// Required by the lock/unlock measurements.
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES  (1)
+
 #if defined(__ARM_EABI__)
 
 // With 4 bits NVIC, there are 16 levels, 0 = highest, 15 = lowest
@@ -255,9 +255,195 @@ periodic::object_main (void)
 
 // ----------------------------------------------------------------------------
 
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// Lock/unlock durations, in `hrclock` cycles.
+struct lock_cycles
+{
+  void
+  add (const lock_cycles& other);
+
+  uint64_t lock_sum = 0;
+  uint64_t unlock_sum = 0;
+  clock::timestamp_t lock_max = 0;
+  clock::timestamp_t unlock_max = 0;
+  unsigned int count = 0;
+};
+
+// A thread hammering a shared mutex with short critical sections.
+class cycles_test
+{
+public:
+
+  cycles_test (const char* name, mutex& m, unsigned int rounds);
+
+  void*
+  object_main (void);
+
+  rtos::thread&
+  thread (void)
+  {
+    return th_;
+  }
+
+  lock_cycles cycles_;
+
+protected:
+
+  mutex& mx_;
+  unsigned int rounds_;
+
+  rtos::thread th_;
+};
+
+#pragma GCC diagnostic pop
+
+void
+lock_cycles::add (const lock_cycles& other)
+{
+  lock_sum += other.lock_sum;
+  unlock_sum += other.unlock_sum;
+  if (other.lock_max > lock_max)
+    lock_max = other.lock_max;
+  if (other.unlock_max > unlock_max)
+    unlock_max = other.unlock_max;
+  count += other.count;
+}
+
+static void
+measure_lock_unlock (mutex& m, lock_cycles& cycles)
+{
+  clock::timestamp_t begin = hrclock.now ();
+  m.lock ();
+  clock::timestamp_t locked = hrclock.now ();
+  m.unlock ();
+  clock::timestamp_t end = hrclock.now ();
+
+  cycles.lock_sum += locked - begin;
+  cycles.unlock_sum += end - locked;
+  if (locked - begin > cycles.lock_max)
+    cycles.lock_max = locked - begin;
+  if (end - locked > cycles.unlock_max)
+    cycles.unlock_max = end - locked;
+  cycles.count++;
+}
+
+cycles_test::cycles_test (const char* name, mutex& m, unsigned int rounds) :
+    mx_ (m), //
+    rounds_ (rounds), //
+    th_
+      { name, [](void* attr)-> void*
+        { return static_cast<cycles_test*> (attr)->object_main ();}, this }
+{
+}
+
+void*
+cycles_test::object_main (void)
+{
+  for (unsigned int i = 0; i < rounds_; ++i)
+    {
+      // Spend some time in the critical section, to be preempted
+      // by the round robin scheduling while owning the mutex.
+      mx_.lock ();
+      busy_wait (2);
+      mx_.unlock ();
+
+      measure_lock_unlock (mx_, cycles_);
+    }
+  return nullptr;
+}
+
+static void
+print_cycles (const char* what, const lock_cycles& cycles,
+              statistics::counter_t switches)
+{
+  unsigned int n = cycles.count != 0 ? cycles.count : 1;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+  printf ("%-22s lock avg %5u max %8u, unlock avg %5u max %8u cycles",
+          what, static_cast<unsigned int> (cycles.lock_sum / n),
+          static_cast<unsigned int> (cycles.lock_max),
+          static_cast<unsigned int> (cycles.unlock_sum / n),
+          static_cast<unsigned int> (cycles.unlock_max));
+  printf (", %u context switches", static_cast<unsigned int> (switches));
+#pragma GCC diagnostic pop
+  puts ("");
+}
+
+/*
+ * Measure the lock and unlock durations through `hrclock`, for a
+ * default mutex and for an adaptive one, first without and then with
+ * contention from threads of the same priority.
+ */
+static void
+run_cycles (const char* name, const mutex::attributes& attr)
+{
+  constexpr unsigned int uncontended_rounds = 10000;
+  constexpr unsigned int contended_rounds = 2000;
+
+  mutex m
+    { name, attr };
+
+  char what[30];
+  statistics::counter_t begin;
+
+  lock_cycles uncontended;
+  begin = scheduler::statistics::context_switches ();
+  for (unsigned int i = 0; i < uncontended_rounds; ++i)
+    {
+      measure_lock_unlock (m, uncontended);
+    }
+  snprintf (what, sizeof(what), "%s uncontended:", name);
+  print_cycles (what, uncontended,
+                scheduler::statistics::context_switches () - begin);
+
+  lock_cycles contended;
+  begin = scheduler::statistics::context_switches ();
+    {
+      cycles_test ct0
+        { "c0", m, contended_rounds };
+      cycles_test ct1
+        { "c1", m, contended_rounds };
+      cycles_test ct2
+        { "c2", m, contended_rounds };
+      cycles_test ct3
+        { "c3", m, contended_rounds };
+
+      ct0.thread ().join ();
+      ct1.thread ().join ();
+      ct2.thread ().join ();
+      ct3.thread ().join ();
+
+      contended.add (ct0.cycles_);
+      contended.add (ct1.cycles_);
+      contended.add (ct2.cycles_);
+      contended.add (ct3.cycles_);
+    }
+  snprintf (what, sizeof(what), "%s contended:", name);
+  print_cycles (what, contended,
+                scheduler::statistics::context_switches () - begin);
+}
+
+// ----------------------------------------------------------------------------
+
 int
 run_tests (unsigned int seconds)
 {
+  mutex::attributes adaptive_attr;
+  adaptive_attr.mx_adaptive_yields = 3;
+
+  run_cycles ("default", mutex::initializer_normal);
+  run_cycles ("adaptive", adaptive_attr);
+
 #if 1
   mutex_test mt0 ("t0");
   mutex_test mt1 ("t1");
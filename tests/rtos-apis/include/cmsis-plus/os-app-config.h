@@ -59,6 +59,7 @@
 
 #define OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES  (1)
 #define OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES        (1)
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY           (1)
 
 // ----------------------------------------------------------------------------
 
@@ -80,6 +81,27 @@
 
 // ----------------------------------------------------------------------------
 
+#if defined(RTOS_APIS_OPTIONS)
+
+// The optional implementations, built by `rtos-apis-options-test`.
+#define OS_USE_RTOS_READY_THREADS_BITMAP
+#define OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS
+
+#if !defined(__ARM_ARCH_6M__)
+// Requires lock-free 32-bit atomics.
+#define OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE
+#endif
+
+#define OS_USE_TRACE_EVENTS
+#define OS_TRACE_EVENTS_SWITCH
+#define OS_TRACE_EVENTS_RESUME
+#define OS_TRACE_EVENTS_BLOCK
+#define OS_TRACE_EVENTS_TIMEOUT
+
+#endif // defined(RTOS_APIS_OPTIONS)
+
+// ----------------------------------------------------------------------------
+
 #if defined(DEBUG)
 
 // #define OS_TRACE_RTOS_CLOCKS
@@ -491,6 +491,52 @@ test_c_api (void)
 
   // ==========================================================================
 
+  printf ("\n%s - Read-write locks\n", test_name);
+  // fflush(stdout);
+
+    {
+      os_rwlock_t rw1;
+      os_rwlock_construct (&rw1, "rw1", NULL);
+
+      os_rwlock_read_lock (&rw1);
+      os_rwlock_try_read_lock (&rw1);
+      assert(os_rwlock_get_readers (&rw1) == 2);
+      os_rwlock_unlock (&rw1);
+      os_rwlock_unlock (&rw1);
+
+      os_rwlock_write_lock (&rw1);
+      assert(os_rwlock_get_writer (&rw1) == os_this_thread ());
+      os_rwlock_unlock (&rw1);
+
+      os_rwlock_timed_read_lock (&rw1, 1);
+      os_rwlock_unlock (&rw1);
+
+      os_rwlock_try_write_lock (&rw1);
+      os_rwlock_unlock (&rw1);
+
+      os_rwlock_timed_write_lock (&rw1, 1);
+      os_rwlock_unlock (&rw1);
+
+      name = os_rwlock_get_name (&rw1);
+
+      os_rwlock_destruct (&rw1);
+    }
+
+    {
+      os_rwlock_attr_t ra2;
+      os_rwlock_attr_init (&ra2);
+
+      os_rwlock_t* rw2;
+      rw2 = os_rwlock_new ("rw2", &ra2);
+
+      os_rwlock_write_lock (rw2);
+      os_rwlock_unlock (rw2);
+
+      os_rwlock_delete (rw2);
+    }
+
+  // ==========================================================================
+
   printf ("\n%s - Semaphores\n", test_name);
   // fflush(stdout);
 
@@ -539,6 +585,13 @@ test_c_api (void)
       os_semaphore_t sp3;
       os_semaphore_counting_construct (&sp3, "sp3", 7, 7);
 
+      os_semaphore_wait_count (&sp3, 3);
+      os_semaphore_try_wait_count (&sp3, 2);
+      os_semaphore_timed_wait_count (&sp3, 2, 1);
+      assert(os_semaphore_get_value (&sp3) == 0);
+
+      os_semaphore_post_count (&sp3, 7);
+
       os_semaphore_destruct (&sp3);
     }
 
@@ -658,6 +711,41 @@ test_c_api (void)
       os_mqueue_timed_receive (&q1, &msg_in, sizeof(msg_in), 1, NULL);
       assert(msg_in.i = 1);
 
+      // Zero-copy usage.
+      void* slot;
+      os_mqueue_reserve (&q1, &slot);
+      os_mqueue_commit (&q1, slot, 0);
+      os_mqueue_try_reserve (&q1, &slot);
+      os_mqueue_release (&q1, slot);
+      os_mqueue_timed_reserve (&q1, &slot, 1);
+      os_mqueue_commit (&q1, slot, 0);
+
+      os_mqueue_borrow (&q1, &slot, NULL);
+      os_mqueue_release (&q1, slot);
+      os_mqueue_try_borrow (&q1, &slot, NULL);
+      os_mqueue_release (&q1, slot);
+      os_mqueue_timed_borrow (&q1, &slot, 1, NULL);
+      os_mqueue_release (&q1, slot);
+
+      // Batch usage.
+      my_msg_t batch[3] =
+        {
+          { 1, "b1" },
+          { 2, "b2" },
+          { 3, "b3" } };
+      size_t moved;
+      os_mqueue_send_n (&q1, batch, 2, sizeof(my_msg_t), 0, &moved);
+      os_mqueue_try_send_n (&q1, &batch[2], 1, sizeof(my_msg_t), 0, NULL);
+      os_mqueue_receive_n (&q1, batch, 2, sizeof(my_msg_t), &moved, NULL);
+      os_mqueue_timed_send_n (&q1, batch, 1, sizeof(my_msg_t), 1, 0, NULL);
+
+      os_mqueue_prio_t prios[3];
+      os_mqueue_try_receive_n (&q1, batch, 3, sizeof(my_msg_t), &moved, prios);
+      assert(moved == 2);
+      os_mqueue_timed_send_n (&q1, batch, 1, sizeof(my_msg_t), 1, 0, NULL);
+      os_mqueue_timed_receive_n (&q1, batch, 3, sizeof(my_msg_t), 1, &moved,
+                                 NULL);
+
 #pragma GCC diagnostic push
 #if defined(__clang__)
 #pragma clang diagnostic ignored "-Wunused-but-set-variable"
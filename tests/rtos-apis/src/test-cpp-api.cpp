@@ -23,9 +23,16 @@
 #include <cmsis-plus/rtos/os.h>
 #include <cmsis-plus/memory/block-pool.h>
 #include <cmsis-plus/memory/lifo.h>
+#include <cmsis-plus/memory/monotonic-buffer.h>
+#include <cmsis-plus/memory/segregated-pools.h>
+#include <cmsis-plus/memory/tlsf.h>
 #include <cmsis-plus/estd/memory_resource>
 #include <cmsis-plus/estd/mutex>
 
+#if defined(OS_USE_TRACE_EVENTS)
+#include <cmsis-plus/diag/trace-events.h>
+#endif
+
 #include <algorithm>
 
 #include <test-cpp-api.h>
@@ -82,6 +89,65 @@ func (void* args __attribute__((unused)))
   return nullptr;
 }
 
+void*
+post_func (void* args);
+
+void*
+post_func (void* args)
+{
+  static_cast<semaphore*> (args)->post ();
+
+  return nullptr;
+}
+
+void*
+wait_func (void* args);
+
+void*
+wait_func (void* args)
+{
+  static_cast<semaphore*> (args)->wait ();
+
+  return nullptr;
+}
+
+void
+post_work (void* args);
+
+void
+post_work (void* args)
+{
+  static_cast<semaphore*> (args)->post ();
+}
+
+static result_t rw_read_result;
+
+void*
+rw_read_func (void* args);
+
+void*
+rw_read_func (void* args)
+{
+  rw_read_result = static_cast<rwlock*> (args)->timed_read_lock (5);
+
+  return nullptr;
+}
+
+static semaphore* rw_write_sem;
+
+void*
+rw_write_func (void* args);
+
+void*
+rw_write_func (void* args)
+{
+  static_cast<rwlock*> (args)->write_lock ();
+  rw_write_sem->post ();
+  static_cast<rwlock*> (args)->unlock ();
+
+  return nullptr;
+}
+
 void
 tmfunc (void* args);
 
@@ -267,6 +333,163 @@ test_cpp_api (void)
       bp3.deallocate (b2, 0, 1);
     }
 
+    {
+      // The arena is included in the memory resource object.
+      os::memory::tlsf_inclusive<1000> tm1
+        { "tm1" };
+
+      void* b1;
+      b1 = tm1.allocate (10, 8);
+
+      void* b2;
+      b2 = tm1.allocate (100, 64);
+      assert((reinterpret_cast<uintptr_t> (b2) & 63) == 0);
+
+      // Too large, must fail.
+      void* b3;
+      b3 = tm1.allocate (2000, 8);
+      assert(b3 == nullptr);
+      (void) b3;
+
+      tm1.deallocate (b1, 10, 8);
+      tm1.deallocate (b2, 100, 64);
+
+      // The free blocks were coalesced back to a single chunk.
+      assert(tm1.allocated_chunks () == 0);
+      assert(tm1.free_chunks () == 1);
+
+      // The default alignment must not split leading free blocks.
+      void* bb[12];
+      for (std::size_t i = 0; i < 12; ++i)
+        {
+          bb[i] = tm1.allocate (24 + 8 * (i % 3));
+          assert(bb[i] != nullptr);
+          assert((reinterpret_cast<uintptr_t> (bb[i])
+              & (os::rtos::memory::memory_resource::max_align - 1)) == 0);
+        }
+      assert(tm1.free_chunks () == 1);
+
+      for (std::size_t i = 0; i < 12; ++i)
+        {
+          tm1.deallocate (bb[i], 24 + 8 * (i % 3));
+        }
+      assert(tm1.free_chunks () == 1);
+    }
+
+    {
+      os::memory::tlsf_inclusive<1000> tm2
+        { "tm2" };
+
+      // Two blocks in each class, the large ones from upstream.
+      os::memory::segregated_pools_inclusive<2, 16, 32, 64> sp1
+        { "sp1", &tm2 };
+
+      void* b1;
+      b1 = sp1.allocate (10, 8);
+      assert(sp1.pool (0).allocated_chunks () == 1);
+
+      void* b2;
+      b2 = sp1.allocate (40, 8);
+      assert(sp1.pool (2).allocated_chunks () == 1);
+
+      // Class exhausted, the next larger class is used.
+      void* b3;
+      b3 = sp1.allocate (20, 8);
+      void* b4;
+      b4 = sp1.allocate (20, 8);
+      void* b5;
+      b5 = sp1.allocate (20, 8);
+      assert(sp1.pool (1).allocated_chunks () == 2);
+      assert(sp1.pool (2).allocated_chunks () == 2);
+
+      // Too large for the pools.
+      void* b6;
+      b6 = sp1.allocate (100, 8);
+      assert(b6 != nullptr);
+      assert(tm2.allocated_chunks () == 1);
+
+      // The size is not needed to route the deallocations.
+      sp1.deallocate (b1, 0, 8);
+      sp1.deallocate (b2, 0, 8);
+      sp1.deallocate (b3, 0, 8);
+      sp1.deallocate (b4, 0, 8);
+      sp1.deallocate (b5, 0, 8);
+      sp1.deallocate (b6, 0, 8);
+
+      assert(sp1.allocated_chunks () == 0);
+      assert(tm2.allocated_chunks () == 0);
+
+      sp1.trace_print_classes ();
+    }
+
+    {
+      // Two blocks in each class, no upstream.
+      os::memory::segregated_pools_inclusive<2, 12, 24> sp2
+        { "sp2" };
+
+      // The block sizes are rounded to the maximum alignment,
+      // so the smallest class serves the default aligned requests.
+      void* b1;
+      b1 = sp2.allocate (12);
+      void* b2;
+      b2 = sp2.allocate (12);
+      assert(sp2.pool (0).allocated_chunks () == 2);
+      assert(
+          (reinterpret_cast<uintptr_t> (b2)
+              & (os::rtos::memory::memory_resource::max_align - 1)) == 0);
+
+      sp2.deallocate (b1, 0);
+      sp2.deallocate (b2, 0);
+      assert(sp2.allocated_chunks () == 0);
+    }
+
+    {
+      os::memory::tlsf_inclusive<1000> tm3
+        { "tm3" };
+
+      // Small buffer, the overflow comes from upstream.
+      os::memory::monotonic_buffer_inclusive<64> mb1
+        { "mb1", &tm3 };
+
+      void* b1;
+      b1 = mb1.allocate (10, 8);
+
+        {
+          os::memory::monotonic_buffer::scope s1
+            { mb1 };
+
+          os::estd::pmr::polymorphic_allocator<int> pa
+            { &mb1 };
+
+          int* b2;
+          b2 = pa.allocate (4);
+          assert((reinterpret_cast<uintptr_t> (b2) & (alignof(int) - 1)) == 0);
+
+          // Larger than the buffer, a new buffer from upstream.
+          int* b3;
+          b3 = pa.allocate (100);
+          assert(b3 != nullptr);
+          assert(tm3.allocated_chunks () == 1);
+
+          // No effect.
+          pa.deallocate (b3, 100);
+          pa.deallocate (b2, 4);
+          assert(mb1.allocated_chunks () == 3);
+        }
+
+      // The scope released the upstream buffer and the blocks
+      // allocated inside it.
+      assert(tm3.allocated_chunks () == 0);
+      assert(mb1.allocated_chunks () == 1);
+
+      void* b4;
+      b4 = mb1.allocate (10, 8);
+      assert(b4 != b1);
+
+      mb1.release ();
+      assert(mb1.allocated_chunks () == 0);
+    }
+
   // ==========================================================================
 
   printf ("\n%s - Threads\n", test_name);
@@ -389,6 +612,107 @@ test_cpp_api (void)
 
   // ==========================================================================
 
+  printf ("\n%s - Thread pools\n", test_name);
+  // fflush(stdout);
+
+    {
+      semaphore sp
+        { "sp" };
+
+      thread_pool_inclusive<2, port::stack::default_size_bytes, 4> tp
+        { "tp" };
+      assert(tp.workers () == 2);
+
+      tp.dispatch (func);
+      tp.dispatch (post_func, &sp);
+      tp.try_dispatch (post_func, &sp);
+      tp.timed_dispatch (post_func, &sp, 1);
+
+      sp.wait ();
+      sp.wait ();
+      sp.wait ();
+      // The pool destructor stops and joins the workers.
+    }
+
+  // ==========================================================================
+
+  printf ("\n%s - Work queues\n", test_name);
+  // fflush(stdout);
+
+    {
+      semaphore sp
+        { "sp" };
+
+      work_queue_inclusive<> wq1
+        { "wq1" };
+      assert(wq1.threads () == 1);
+
+      work_item wi1
+        { post_work, &sp };
+      work_item wi2
+        { post_work, &sp };
+
+      wq1.submit (wi1);
+      sp.wait ();
+      assert(!wi1.pending ());
+
+      wq1.submit_delayed (wi2, 2);
+      sp.wait ();
+
+      wq1.submit_delayed (wi2, 1000);
+      assert(wi2.pending ());
+      assert(wq1.cancel (wi2) == result::ok);
+      assert(wq1.cancel (wi2) == EALREADY);
+
+      // Two service threads, above the default priority.
+      work_queue_inclusive<2> wq2
+        { "wq2", thread::priority::realtime };
+      assert(wq2.submit (wi1) == result::ok);
+      sp.wait ();
+    }
+
+  // ==========================================================================
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY)
+
+  printf ("\n%s - Thread statistics\n", test_name);
+  // fflush(stdout);
+
+    {
+      semaphore sp
+        { "sp" };
+
+      thread_inclusive<> th1
+        { "th1", wait_func, &sp };
+
+      // Let th1 block, then wake it up.
+      sysclock.sleep_for (2);
+      sp.post ();
+      th1.join ();
+
+      class thread::statistics& st = th1.statistics ();
+
+      statistics::counter_t count = 0;
+      for (std::size_t i = 0; i < thread::statistics::histogram_buckets; ++i)
+        {
+          count += st.latency_histogram ()[i];
+        }
+      assert(count >= 1);
+      assert(st.latency_percentile (500) <= st.latency_percentile (999));
+      assert(st.latency_percentile (999) <= st.latency_max ());
+      assert(st.cpu_load () <= 10000);
+
+      assert(thread::statistics::bucket_limit (1) == 2);
+      assert(thread::statistics::bucket_limit (
+          thread::statistics::histogram_buckets - 1) == 0);
+
+      scheduler::statistics::top ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_LATENCY) */
+
+  // ==========================================================================
+
   printf ("\n%s - Thread stack\n", test_name);
   // fflush(stdout);
 
@@ -409,6 +733,28 @@ test_cpp_api (void)
 
       stack.check_bottom_magic ();
       stack.check_top_magic ();
+
+      std::size_t used = stack.high_water_mark ();
+      assert(used > 0 && used <= stack.size ());
+      // The exact scan also refines the estimate.
+      assert(stack.size () - stack.available () >= used);
+      assert(stack.high_water_mark () >= used);
+
+      semaphore sp
+        { "sp" };
+
+      thread::attributes attr;
+      attr.th_stack_fill = false;
+
+      thread_inclusive<> th1
+        { "th1", post_func, &sp, attr };
+      sp.wait ();
+
+      assert(th1.stack ().check_bottom_magic ());
+      assert(th1.stack ().available () == 0);
+      assert(th1.stack ().high_water_mark () == th1.stack ().size ());
+
+      th1.join ();
     }
 
   // ==========================================================================
@@ -523,6 +869,109 @@ test_cpp_api (void)
       tq2.receive (&msg_in);
     }
 
+    {
+      // Zero-copy usage; the message is constructed in place.
+      My_queue tq
+        { "tqz", 3 };
+
+      my_msg_t* slot;
+      tq.reserve (&slot);
+      slot->i = 2;
+      tq.commit (slot, 1);
+
+      tq.try_reserve (&slot);
+      slot->i = 3;
+      tq.commit (slot, 2);
+
+      message_queue::priority_t prio;
+      tq.borrow (&slot, &prio);
+      assert(slot->i == 3 && prio == 2);
+      tq.release (slot);
+
+      tq.timed_borrow (&slot, 1);
+      assert(slot->i == 2);
+      tq.release (slot);
+
+      assert(tq.try_borrow (&slot) == EWOULDBLOCK);
+
+      // A slot can be released only once.
+      assert(tq.release (slot) == EINVAL);
+
+      // A free slot cannot be committed.
+      assert(tq.commit (slot, 1) == EINVAL);
+      assert(tq.try_borrow (&slot) == EWOULDBLOCK);
+
+      // The outstanding slots are freed by reset().
+      tq.reserve (&slot);
+      tq.reset ();
+      assert(tq.commit (slot, 1) == EINVAL);
+    }
+
+    {
+      // Constant time priority ordering; FIFO within a priority.
+      message_queue::attributes amq;
+      amq.mq_ordering = message_queue::ordering::indexed;
+
+      My_queue tq
+        { "tqi", 5, amq };
+
+      msg_out.i = 1;
+      tq.send (&msg_out, 1);
+      msg_out.i = 2;
+      tq.send (&msg_out, 200);
+      msg_out.i = 3;
+      tq.send (&msg_out, 1);
+      msg_out.i = 4;
+      tq.send (&msg_out, 40);
+      msg_out.i = 5;
+      tq.send (&msg_out, 200);
+
+      tq.receive (&msg_in);
+      assert(msg_in.i == 2);
+      tq.receive (&msg_in);
+      assert(msg_in.i == 5);
+      tq.receive (&msg_in);
+      assert(msg_in.i == 4);
+      tq.receive (&msg_in);
+      assert(msg_in.i == 1);
+      tq.receive (&msg_in);
+      assert(msg_in.i == 3);
+
+      msg_out.i = 1;
+    }
+
+    {
+      // Batch usage; several messages moved under one critical section.
+      My_queue tq
+        { "tqn", 3 };
+
+      my_msg_t batch_out[4] =
+        {
+          { 1, "b1" },
+          { 2, "b2" },
+          { 3, "b3" },
+          { 4, "b4" } };
+      my_msg_t batch_in[4];
+      std::size_t n;
+
+      // Only 3 fit in the queue.
+      tq.send_n (batch_out, 4, 0, &n);
+      assert(n == 3);
+
+      tq.receive_n (batch_in, 2, &n);
+      assert(n == 2 && batch_in[1].i == 2);
+
+      tq.try_send_n (&batch_out[3], 1);
+      tq.timed_send_n (batch_out, 1, 1);
+      assert(tq.try_send_n (batch_out, 1) == EWOULDBLOCK);
+
+      message_queue::priority_t prios[4];
+      tq.timed_receive_n (batch_in, 4, 1, &n, prios);
+      assert(n == 3 && batch_in[2].i == 1);
+
+      assert(tq.try_receive_n (batch_in, 4, &n) == EWOULDBLOCK);
+    }
+
   // --------------------------------------------------------------------------
 
     {
@@ -603,6 +1052,65 @@ test_cpp_api (void)
 
   // ==========================================================================
 
+  printf ("\n%s - Channels\n", test_name);
+  // fflush(stdout);
+
+  // Single producer/single consumer channel; the storage is inside
+  // the channel object, in this case on the stack.
+    {
+      spsc_channel<my_msg_t, 2> ch1;
+
+      ch1.push (msg_out);
+      ch1.pop (&msg_in);
+
+      ch1.try_push (msg_out);
+      ch1.try_pop (&msg_in);
+
+      ch1.timed_push (msg_out, 1);
+      ch1.timed_pop (&msg_in, 1);
+
+      spsc_channel<uint32_t, 3> ch2
+        { "ch2" };
+
+      uint32_t v;
+      result_t res;
+
+      assert(ch2.capacity () == 3);
+      assert(ch2.empty ());
+
+      res = ch2.try_pop (&v);
+      assert(res == EWOULDBLOCK);
+
+      res = ch2.timed_pop (&v, 1);
+      assert(res == ETIMEDOUT);
+
+      ch2.try_push (1);
+      ch2.push (2);
+      ch2.timed_push (3, 1);
+      assert(ch2.full ());
+      assert(ch2.length () == 3);
+
+      res = ch2.try_push (4);
+      assert(res == EWOULDBLOCK);
+
+      res = ch2.timed_push (4, 1);
+      assert(res == ETIMEDOUT);
+
+      // Messages are retrieved in FIFO order, across the buffer wrap.
+      for (uint32_t i = 1; i <= 6; ++i)
+        {
+          ch2.pop (&v);
+          assert(v == i);
+          ch2.try_push (i + 3);
+        }
+      assert(ch2.length () == 3);
+
+      (void) res;
+      (void) v;
+    }
+
+  // ==========================================================================
+
   my_blk_t* blk;
 
   printf ("\n%s - Memory pools\n", test_name);
@@ -1040,6 +1548,93 @@ test_cpp_api (void)
 
   // ==========================================================================
 
+  printf ("\n%s - Read-write locks\n", test_name);
+  // fflush(stdout);
+
+    {
+      rwlock rw1;
+      rw1.read_lock ();
+      rw1.read_lock ();
+      assert(rw1.readers () == 2);
+      assert(rw1.try_write_lock () == EWOULDBLOCK);
+      rw1.unlock ();
+      rw1.unlock ();
+      assert(rw1.unlock () == EPERM);
+
+      rwlock rw2
+        { "rw2" };
+      rw2.write_lock ();
+      assert(rw2.writer () == &this_thread::thread ());
+      assert(rw2.try_read_lock () == EDEADLK);
+      assert(rw2.timed_write_lock (1) == EDEADLK);
+      rw2.unlock ();
+
+      rw2.timed_read_lock (1);
+      rw2.unlock ();
+      rw2.timed_write_lock (1);
+      rw2.unlock ();
+    }
+
+    {
+      // A reader resumed by unlock() times out before retrying,
+      // the waiting writer must get the lock.
+      rwlock rw4
+        { "rw4" };
+      semaphore sp
+        { "sp" };
+      rw_write_sem = &sp;
+
+      thread& crt_thread = this_thread::thread ();
+      thread::priority_t prio = crt_thread.priority ();
+      crt_thread.priority (thread::priority::high);
+
+      rw4.write_lock ();
+
+      thread::attributes ra;
+      ra.th_priority = thread::priority::above_normal;
+      thread_inclusive<> thr
+        { "thr", rw_read_func, &rw4, ra };
+
+      thread::attributes wa;
+      wa.th_priority = thread::priority::normal;
+      thread_inclusive<> thw
+        { "thw", rw_write_func, &rw4, wa };
+
+      // Let both threads block.
+      sysclock.sleep_for (1);
+
+      clock::timestamp_t deadline = sysclock.steady_now () + 6;
+      rw4.unlock ();
+
+      // Keep the reader from running until its timeout expires.
+      while (sysclock.steady_now () < deadline)
+        {
+          ;
+        }
+
+      assert(sp.timed_wait (10) == result::ok);
+      assert(rw_read_result == ETIMEDOUT);
+
+      thr.join ();
+      thw.join ();
+
+      crt_thread.priority (prio);
+    }
+
+    {
+      rwlock* rw;
+      rw = new rwlock
+        { "rw3" };
+
+      rw->write_lock ();
+      rw->unlock ();
+
+      // Mandatory delete.
+      delete rw;
+    }
+
+  // ==========================================================================
+
   printf ("\n%s - Semaphores\n", test_name);
   // fflush(stdout);
 
@@ -1067,6 +1662,39 @@ test_cpp_api (void)
       sp.timed_wait (0xFFFFFFFF);
     }
 
+    {
+      // Counting semaphore, with multiple units posted and
+      // acquired at once.
+      semaphore_counting sp
+        { "sp2c", 8, 0 };
+
+      result_t res;
+
+      res = sp.post (3);
+      assert(res == result::ok && sp.value () == 3);
+
+      res = sp.post (6);
+      assert(res == EAGAIN && sp.value () == 3);
+
+      res = sp.wait (2);
+      assert(res == result::ok && sp.value () == 1);
+
+      res = sp.try_wait (2);
+      assert(res == EWOULDBLOCK && sp.value () == 1);
+
+      res = sp.timed_wait (2, 1);
+      assert(res == ETIMEDOUT && sp.value () == 1);
+
+      res = sp.wait (9);
+      assert(res == EINVAL);
+
+      sp.post (7);
+      res = sp.timed_wait (8, 1);
+      assert(res == result::ok && sp.value () == 0);
+
+      (void) res;
+    }
+
     {
       // Named binary semaphore.
       semaphore sp
@@ -1222,6 +1850,39 @@ test_cpp_api (void)
       tm2->stop ();
     }
 
+    {
+      // The callback posts the semaphore from the clock interrupt;
+      // with OS_INCLUDE_RTOS_SEMAPHORE_DEFERRED_POSTS the post
+      // is folded at the next context switch.
+      semaphore sp
+        { "sp" };
+      timer tm
+        { "tm9", post_work, &sp };
+      tm.start (1);
+
+      assert(sp.timed_wait (10) == result::ok);
+    }
+
+  // ==========================================================================
+
+#if defined(OS_USE_TRACE_EVENTS)
+
+  printf ("\n%s - Trace events\n", test_name);
+  // fflush(stdout);
+
+    {
+      trace::events::clear ();
+      trace::events::record (1, 2, 3);
+
+      // The context switches are recorded too.
+      sysclock.sleep_for (1);
+      assert(trace::events::ring ().next.load () >= 2);
+
+      trace::events::clear ();
+    }
+
+#endif /* defined(OS_USE_TRACE_EVENTS) */
+
   // ==========================================================================
 
   printf ("\n%s - done\n", test_name);
@@ -21,6 +21,7 @@
 #include <cmsis-plus/estd/chrono>
 #include <cmsis-plus/estd/condition_variable>
 #include <cmsis-plus/estd/mutex>
+#include <cmsis-plus/estd/shared_mutex>
 #include <cmsis-plus/estd/thread>
 #include <type_traits>
 #include <atomic>
@@ -334,6 +335,52 @@ test_iso_api (bool extra)
 #endif
     }
 
+  // ==========================================================================
+  printf ("\n%s - Shared mutexes\n", test_name);
+
+    {
+        {
+          estd::shared_mutex smx11;
+
+          smx11.lock ();
+          smx11.unlock ();
+
+          smx11.lock_shared ();
+          smx11.lock_shared ();
+          if (smx11.try_lock ())
+            smx11.unlock ();
+          smx11.unlock_shared ();
+          smx11.unlock_shared ();
+
+          smx11.try_lock_shared ();
+          smx11.unlock_shared ();
+        }
+
+        {
+          estd::shared_timed_mutex smx21;
+
+          smx21.try_lock_for (systicks (2999));
+          smx21.unlock ();
+          smx21.try_lock_shared_for (milliseconds (3001)); // 3001 ticks
+          smx21.unlock_shared ();
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#endif
+
+          if (smx21.try_lock_until (estd::chrono::systick_clock::now () + 5ms))
+            smx21.unlock ();
+          if (smx21.try_lock_shared_until (
+              estd::chrono::systick_clock::now () + 5ms))
+            smx21.unlock_shared ();
+
+#pragma GCC diagnostic pop
+
+        }
+    }
+
   // ==========================================================================
 
   printf ("\n%s - Condition variables\n", test_name);
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef BENCH_LIMITS_H_
+#define BENCH_LIMITS_H_
+
+// The regression thresholds of the micro-benchmarks, as the median
+// number of `hrclock` cycles per operation; 0 disables the check.
+//
+// Each limit can be redefined on the command line, for example via
+// the `RTOS_BENCH_LIMITS` CMake variable:
+//
+// `-D RTOS_BENCH_LIMITS="BENCH_LIMIT_CONTEXT_SWITCH=900"`
+
+// ----------------------------------------------------------------------------
+
+#if defined(__ARM_EABI__)
+
+// Generous values for the QEMU emulated boards, which are not
+// cycle accurate; tighten them for physical boards.
+
+#if defined(DEBUG)
+#define BENCH_LIMIT_SCALE                                   (4)
+#else
+#define BENCH_LIMIT_SCALE                                   (1)
+#endif
+
+#if !defined(BENCH_LIMIT_CONTEXT_SWITCH)
+#define BENCH_LIMIT_CONTEXT_SWITCH                          (4000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_SEMAPHORE_PING_PONG)
+#define BENCH_LIMIT_SEMAPHORE_PING_PONG                     (10000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_MUTEX_UNCONTENDED)
+#define BENCH_LIMIT_MUTEX_UNCONTENDED                       (2000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_MUTEX_CONTENDED)
+#define BENCH_LIMIT_MUTEX_CONTENDED                         (15000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_MQUEUE_SEND_RECEIVE)
+#define BENCH_LIMIT_MQUEUE_SEND_RECEIVE                     (4000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_MQUEUE_PER_BYTE)
+#define BENCH_LIMIT_MQUEUE_PER_BYTE                         (8 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_MEMPOOL_ALLOC_FREE)
+#define BENCH_LIMIT_MEMPOOL_ALLOC_FREE                      (1500 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_EVFLAGS_RAISE_WAIT)
+#define BENCH_LIMIT_EVFLAGS_RAISE_WAIT                      (2000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_TIMER_START_STOP)
+#define BENCH_LIMIT_TIMER_START_STOP                        (3000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_FIRST_FIT_TOP)
+#define BENCH_LIMIT_FIRST_FIT_TOP                           (3000 * BENCH_LIMIT_SCALE)
+#endif
+
+#if !defined(BENCH_LIMIT_BLOCK_POOL)
+#define BENCH_LIMIT_BLOCK_POOL                              (1000 * BENCH_LIMIT_SCALE)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#else
+
+// On the native platform the durations depend on the host and on
+// its load, so the checks are disabled unless explicitly configured.
+
+#if !defined(BENCH_LIMIT_CONTEXT_SWITCH)
+#define BENCH_LIMIT_CONTEXT_SWITCH                          (0)
+#endif
+
+#if !defined(BENCH_LIMIT_SEMAPHORE_PING_PONG)
+#define BENCH_LIMIT_SEMAPHORE_PING_PONG                     (0)
+#endif
+
+#if !defined(BENCH_LIMIT_MUTEX_UNCONTENDED)
+#define BENCH_LIMIT_MUTEX_UNCONTENDED                       (0)
+#endif
+
+#if !defined(BENCH_LIMIT_MUTEX_CONTENDED)
+#define BENCH_LIMIT_MUTEX_CONTENDED                         (0)
+#endif
+
+#if !defined(BENCH_LIMIT_MQUEUE_SEND_RECEIVE)
+#define BENCH_LIMIT_MQUEUE_SEND_RECEIVE                     (0)
+#endif
+
+#if !defined(BENCH_LIMIT_MQUEUE_PER_BYTE)
+#define BENCH_LIMIT_MQUEUE_PER_BYTE                         (0)
+#endif
+
+#if !defined(BENCH_LIMIT_MEMPOOL_ALLOC_FREE)
+#define BENCH_LIMIT_MEMPOOL_ALLOC_FREE                      (0)
+#endif
+
+#if !defined(BENCH_LIMIT_EVFLAGS_RAISE_WAIT)
+#define BENCH_LIMIT_EVFLAGS_RAISE_WAIT                      (0)
+#endif
+
+#if !defined(BENCH_LIMIT_TIMER_START_STOP)
+#define BENCH_LIMIT_TIMER_START_STOP                        (0)
+#endif
+
+#if !defined(BENCH_LIMIT_FIRST_FIT_TOP)
+#define BENCH_LIMIT_FIRST_FIT_TOP                           (0)
+#endif
+
+#if !defined(BENCH_LIMIT_BLOCK_POOL)
+#define BENCH_LIMIT_BLOCK_POOL                              (0)
+#endif
+
+#endif // architecture
+
+// ----------------------------------------------------------------------------
+
+#endif /* BENCH_LIMITS_H_ */
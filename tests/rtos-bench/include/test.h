@@ -0,0 +1,50 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <cstdint>
+
+// Each benchmark returns 0 when the measured values are within
+// the expected limits.
+
+int
+run_evflags_bench (void);
+
+int
+run_mutex_bench (void);
+
+int
+run_condvar_bench (void);
+
+int
+run_rwlock_bench (void);
+
+int
+run_mempool_bench (void);
+
+// Also writes the results as JSON.
+int
+run_micro_bench (void);
+
+// Microseconds of real time.
+uint64_t
+real_micros (void);
+
+// Busy loop for the given number of microseconds of CPU time;
+// unlike waiting for the real time, it does not progress while
+// the thread is preempted.
+void
+spin (unsigned int micros);
+
+#endif /* TEST_H_ */
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// The state shared by the broadcasting thread and the waiters.
+struct generation
+{
+  mutex mx
+    { "mx" };
+  condition_variable cv
+    { "cv" };
+
+  // Incremented by each broadcast; protected by the mutex.
+  unsigned int count = 0;
+  bool quit = false;
+};
+
+// A thread waiting for the next generation.
+class condvar_waiter
+{
+public:
+
+  condvar_waiter (const char* name, generation& gen);
+
+  void*
+  object_main (void);
+
+  rtos::thread&
+  thread (void)
+  {
+    return th_;
+  }
+
+  unsigned int count_ = 0;
+
+protected:
+
+  generation& gen_;
+
+  rtos::thread th_;
+};
+
+#pragma GCC diagnostic pop
+
+static const thread::attributes&
+cv_waiter_attributes (void)
+{
+  static thread::attributes attr;
+
+  // Higher than the broadcasting thread, to run as soon as resumed.
+  attr.th_priority = thread::priority::above_normal;
+  return attr;
+}
+
+condvar_waiter::condvar_waiter (const char* name, generation& gen) :
+    gen_ (gen), //
+    th_
+      { name, [](void* attr)-> void*
+        { return static_cast<condvar_waiter*> (attr)->object_main ();}, this,
+          cv_waiter_attributes () }
+{
+}
+
+void*
+condvar_waiter::object_main (void)
+{
+  gen_.mx.lock ();
+  unsigned int seen = gen_.count;
+  for (;;)
+    {
+      while (gen_.count == seen && !gen_.quit)
+        {
+          gen_.cv.wait (gen_.mx);
+        }
+      if (gen_.quit)
+        {
+          break;
+        }
+      seen = gen_.count;
+      ++count_;
+    }
+  gen_.mx.unlock ();
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @details
+ * Multiple higher priority threads wait on the same condition
+ * variable, and are notified with `broadcast()` while the mutex
+ * is locked.
+ *
+ * With wait morphing, each waiter is resumed only when the mutex
+ * is released, costing about one context switch; resuming all
+ * waiters at once would also cost two context switches for each
+ * waiter that blocks again on the mutex.
+ */
+int
+run_condvar_bench (void)
+{
+  constexpr unsigned int waiters = 12;
+  constexpr unsigned int rounds = 1000;
+
+  static const char* names[waiters] =
+    { "c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9", "c10",
+        "c11" };
+
+  generation gen;
+
+  condvar_waiter* ws[waiters];
+  for (unsigned int i = 0; i < waiters; ++i)
+    {
+      ws[i] = new condvar_waiter
+        { names[i], gen };
+    }
+
+  // Let all threads reach the wait.
+  sysclock.sleep_for (2);
+
+  statistics::counter_t begin = scheduler::statistics::context_switches ();
+
+  for (unsigned int r = 0; r < rounds; ++r)
+    {
+      gen.mx.lock ();
+      ++gen.count;
+      gen.cv.broadcast ();
+      gen.mx.unlock ();
+    }
+
+  statistics::counter_t switches = scheduler::statistics::context_switches ()
+      - begin;
+
+  gen.mx.lock ();
+  gen.quit = true;
+  gen.cv.broadcast ();
+  gen.mx.unlock ();
+
+  int status = 0;
+
+  for (auto w : ws)
+    {
+      w->thread ().join ();
+      if (w->count_ != rounds)
+        {
+          printf ("%s: %u wake-ups, %u expected\n", w->thread ().name (),
+                  w->count_, rounds);
+          status = 1;
+        }
+      delete w;
+    }
+
+  constexpr unsigned int wakeups = waiters * rounds;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+  printf ("condvar broadcast: %u waiters, %u wake-ups, %u context switches"
+          " (%u.%02u per wake-up)\n",
+          waiters, wakeups, static_cast<unsigned int> (switches),
+          static_cast<unsigned int> (switches / wakeups),
+          static_cast<unsigned int> ((switches * 100 / wakeups) % 100));
+#pragma GCC diagnostic pop
+
+  // Allow some slack for the occasional switches to other threads.
+  if (switches > 2 * wakeups)
+    {
+      printf ("condvar broadcast resumes too many threads\n");
+      status = 1;
+    }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
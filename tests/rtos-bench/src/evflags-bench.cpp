@@ -0,0 +1,189 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// A thread waiting for its own flag of a shared event flags object.
+class flags_waiter
+{
+public:
+
+  flags_waiter (const char* name, event_flags& ev, flags::mask_t mask);
+
+  void*
+  object_main (void);
+
+  rtos::thread&
+  thread (void)
+  {
+    return th_;
+  }
+
+  unsigned int count_ = 0;
+
+protected:
+
+  event_flags& ev_;
+  flags::mask_t mask_;
+
+  rtos::thread th_;
+};
+
+#pragma GCC diagnostic pop
+
+static const thread::attributes&
+waiter_attributes (void)
+{
+  static thread::attributes attr;
+
+  // Higher than the raising thread, to run as soon as resumed.
+  attr.th_priority = thread::priority::above_normal;
+  return attr;
+}
+
+flags_waiter::flags_waiter (const char* name, event_flags& ev,
+                            flags::mask_t mask) :
+    ev_ (ev), //
+    mask_ (mask), //
+    th_
+      { name, [](void* attr)-> void*
+        { return static_cast<flags_waiter*> (attr)->object_main ();}, this,
+          waiter_attributes () }
+{
+}
+
+void*
+flags_waiter::object_main (void)
+{
+  for (;;)
+    {
+      result_t res = ev_.wait (mask_, nullptr,
+                               flags::mode::any | flags::mode::clear);
+      if (res != result::ok || thread ().interrupted ())
+        {
+          break;
+        }
+      ++count_;
+    }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @details
+ * Multiple threads wait on different flags of the same object,
+ * and the flags are raised one by one.
+ *
+ * Each raise should resume only the thread waiting for that flag,
+ * thus costing one context switch to the waiting thread and one back;
+ * resuming all waiting threads would cost two context switches for
+ * each waiting thread.
+ */
+int
+run_evflags_bench (void)
+{
+  constexpr unsigned int waiters = 12;
+  constexpr unsigned int rounds = 1000;
+
+  static const char* names[waiters] =
+    { "w0", "w1", "w2", "w3", "w4", "w5", "w6", "w7", "w8", "w9", "w10",
+        "w11" };
+
+  event_flags ev
+    { "ev" };
+
+  flags_waiter* ws[waiters];
+  for (unsigned int i = 0; i < waiters; ++i)
+    {
+      ws[i] = new flags_waiter
+        { names[i], ev, 1u << i };
+    }
+
+  // Let all threads reach the wait.
+  sysclock.sleep_for (2);
+
+  statistics::counter_t begin = scheduler::statistics::context_switches ();
+
+  for (unsigned int r = 0; r < rounds; ++r)
+    {
+      for (unsigned int i = 0; i < waiters; ++i)
+        {
+          ev.raise (1u << i);
+        }
+    }
+
+  statistics::counter_t switches = scheduler::statistics::context_switches ()
+      - begin;
+
+  int status = 0;
+
+  for (auto w : ws)
+    {
+      if (w->count_ != rounds)
+        {
+          printf ("%s: %u wake-ups, %u expected\n", w->thread ().name (),
+                  w->count_, rounds);
+          status = 1;
+        }
+
+      w->thread ().interrupt ();
+      w->thread ().join ();
+      delete w;
+    }
+
+  constexpr unsigned int raises = waiters * rounds;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+  printf ("evflags raise/wait: %u waiters, %u raises, %u context switches"
+          " (%u.%02u per raise)\n",
+          waiters, raises, static_cast<unsigned int> (switches),
+          static_cast<unsigned int> (switches / raises),
+          static_cast<unsigned int> ((switches * 100 / raises) % 100));
+#pragma GCC diagnostic pop
+
+  // Allow some slack for the occasional switches to other threads.
+  if (switches > 3 * raises)
+    {
+      printf ("evflags raise resumes too many threads\n");
+      status = 1;
+    }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+#include <cstdio>
+#include <cstdint>
+#include <sys/time.h>
+
+#include <test.h>
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__ARM_EABI__)
+
+uint64_t
+real_micros (void)
+{
+  return static_cast<uint64_t> (hrclock.now ()) * 1000000u
+      / hrclock.input_clock_frequency_hz ();
+}
+
+#else
+
+uint64_t
+real_micros (void)
+{
+  /* struct */ timeval tp;
+  gettimeofday (&tp, nullptr);
+  return static_cast<uint64_t> (tp.tv_sec) * 1000000u
+      + static_cast<uint64_t> (tp.tv_usec);
+}
+
+#endif
+
+static uint32_t spin_loops_per_milli = 1000;
+
+void
+spin (unsigned int micros)
+{
+  volatile uint32_t count = 0;
+  uint32_t loops = static_cast<uint32_t> (static_cast<uint64_t> (micros)
+      * spin_loops_per_milli / 1000u);
+  while (count < loops)
+    {
+      count = count + 1;
+    }
+}
+
+static void
+calibrate_spin (void)
+{
+  constexpr uint64_t loops = 1000000;
+
+  // With one loop per microsecond, measure the real duration.
+  spin_loops_per_milli = 1000;
+  uint64_t begin = real_micros ();
+  spin (static_cast<unsigned int> (loops));
+  uint64_t elapsed = real_micros () - begin;
+
+  if (elapsed != 0)
+    {
+      spin_loops_per_milli = static_cast<uint32_t> (loops * 1000u / elapsed);
+    }
+}
+
+int
+os_main (int argc __attribute__((unused)),
+         char* argv[] __attribute__((unused)))
+{
+  printf ("\nRTOS benchmarks\n");
+#if defined(__clang__)
+  printf ("Built with clang " __VERSION__ "\n");
+#else
+  printf ("Built with GCC " __VERSION__ "\n");
+#endif
+
+  calibrate_spin ();
+
+  int status = 0;
+
+  status |= run_evflags_bench ();
+  status |= run_mutex_bench ();
+  status |= run_condvar_bench ();
+  status |= run_rwlock_bench ();
+  status |= run_mempool_bench ();
+  status |= run_micro_bench ();
+
+  puts (status == 0 ? "Done." : "Failed.");
+  return status;
+}
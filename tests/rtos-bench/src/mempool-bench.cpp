@@ -0,0 +1,272 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// The block content, used to detect blocks allocated twice.
+struct block
+{
+  uintptr_t owner;
+  unsigned int sequence;
+};
+
+// Fewer blocks than the possible users, so that the threads
+// also take the blocking path.
+constexpr std::size_t pool_blocks = 4;
+
+// The state shared by the threads and the timer callback.
+struct shared_pool
+{
+  memory_pool_inclusive<block, pool_blocks> mp
+    { "mp" };
+
+  unsigned int rounds = 0;
+
+  // Updated only by the timer callback.
+  unsigned int isr_allocs = 0;
+  unsigned int isr_misses = 0;
+
+  // Updated by all.
+  volatile unsigned int errors = 0;
+};
+
+// A thread repeatedly allocating and freeing a block.
+class mempool_user
+{
+public:
+
+  mempool_user (const char* name, shared_pool& pool);
+
+  void*
+  object_main (void);
+
+  rtos::thread&
+  thread (void)
+  {
+    return th_;
+  }
+
+protected:
+
+  shared_pool& pool_;
+
+  rtos::thread th_;
+};
+
+#pragma GCC diagnostic pop
+
+static void
+report_error (shared_pool& pool)
+{
+  interrupts::critical_section ics;
+  pool.errors = pool.errors + 1;
+}
+
+mempool_user::mempool_user (const char* name, shared_pool& pool) :
+    pool_ (pool), //
+    th_
+      { name, [](void* attr)-> void*
+        { return static_cast<mempool_user*> (attr)->object_main ();}, this }
+{
+}
+
+void*
+mempool_user::object_main (void)
+{
+  uintptr_t owner = reinterpret_cast<uintptr_t> (this);
+
+  for (unsigned int r = 0; r < pool_.rounds; ++r)
+    {
+      block* b = pool_.mp.alloc ();
+      if (b == nullptr)
+        {
+          report_error (pool_);
+          continue;
+        }
+
+      b->owner = owner;
+      b->sequence = r;
+
+      // Hold the block for a while, to let the other users run.
+      if ((r % 4) == 0)
+        {
+          this_thread::yield ();
+        }
+
+      if (b->owner != owner || b->sequence != r)
+        {
+          report_error (pool_);
+        }
+
+      pool_.mp.free (b);
+    }
+  return nullptr;
+}
+
+// Called from the system clock interrupt.
+static void
+isr_user (void* args)
+{
+  shared_pool& pool = *static_cast<shared_pool*> (args);
+
+  block* bs[2];
+  for (auto& b : bs)
+    {
+      b = pool.mp.try_alloc ();
+      if (b == nullptr)
+        {
+          ++pool.isr_misses;
+          continue;
+        }
+      ++pool.isr_allocs;
+      b->owner = 0;
+      b->sequence = pool.isr_allocs;
+    }
+
+  if (bs[0] != nullptr && bs[0] == bs[1])
+    {
+      report_error (pool);
+    }
+
+  for (auto b : bs)
+    {
+      if (b != nullptr)
+        {
+          pool.mp.free (b);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @details
+ * Multiple threads allocate and free blocks from a small memory pool,
+ * while a periodic timer, running in the system clock interrupt
+ * context, does the same with `try_alloc()`.
+ *
+ * The pool has fewer blocks than the possible users, so the threads
+ * also block when the pool is empty. The throughput is reported,
+ * and the test fails if a block was allocated twice or if blocks
+ * were lost.
+ */
+int
+run_mempool_bench (void)
+{
+  constexpr unsigned int users = 4;
+  static const char* names[users] =
+    { "m0", "m1", "m2", "m3" };
+
+  shared_pool pool;
+  pool.rounds = 20000;
+
+  timer tm
+    { "tm", isr_user, &pool, timer::periodic_initializer };
+  tm.start (1);
+
+  uint64_t begin = real_micros ();
+
+  mempool_user* us[users];
+  for (unsigned int i = 0; i < users; ++i)
+    {
+      us[i] = new mempool_user
+        { names[i], pool };
+    }
+
+  for (auto u : us)
+    {
+      u->thread ().join ();
+      delete u;
+    }
+
+  uint64_t elapsed = real_micros () - begin;
+
+  tm.stop ();
+
+  int status = 0;
+
+  // All blocks must be back in the pool.
+  block* ps[pool_blocks];
+  std::size_t count = 0;
+  for (auto& p : ps)
+    {
+      p = pool.mp.try_alloc ();
+      if (p != nullptr)
+        {
+          ++count;
+        }
+    }
+  for (auto p : ps)
+    {
+      if (p != nullptr)
+        {
+          pool.mp.free (p);
+        }
+    }
+
+  unsigned int allocs = users * pool.rounds + pool.isr_allocs;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+  printf ("mempool contention (%s): %u threads + timer isr, %u allocs"
+          " (%u from isr, %u isr misses), %u us, %u ns per alloc\n",
+#if defined(OS_INCLUDE_RTOS_MEMORY_POOL_LOCK_FREE)
+          "lock-free",
+#else
+          "critical sections",
+#endif
+          users, allocs, pool.isr_allocs, pool.isr_misses,
+          static_cast<unsigned int> (elapsed),
+          static_cast<unsigned int> (elapsed * 1000 / allocs));
+#pragma GCC diagnostic pop
+
+  if (pool.errors != 0)
+    {
+      printf ("mempool blocks allocated twice: %u\n", pool.errors);
+      status = 1;
+    }
+
+  if (count != pool_blocks || pool.mp.count () != 0)
+    {
+      printf ("mempool blocks lost: %u\n",
+              static_cast<unsigned int> (pool_blocks - count));
+      status = 1;
+    }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
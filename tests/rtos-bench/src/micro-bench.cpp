@@ -0,0 +1,538 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+
+#include <test.h>
+#include <bench-limits.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/memory/block-pool.h>
+#include <cmsis-plus/memory/first-fit-top.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+  // Each benchmark is run this many times, and the median is compared
+  // with the limit, to filter out the occasional interrupts.
+  constexpr unsigned int samples = 11;
+
+  // The number of operations timed together, to make the clock
+  // resolution irrelevant.
+  constexpr unsigned int batch = 200;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+  struct bench_result
+  {
+    const char* name;
+    // Message or block size, in bytes, or 0.
+    unsigned int size;
+    uint32_t min;
+    uint32_t median;
+    uint32_t max;
+    uint32_t limit;
+  };
+
+  template<std::size_t S>
+    struct message
+    {
+      char data[S];
+    };
+
+  // A 64 bytes block for the pools.
+  struct block
+  {
+    uint32_t data[16];
+  };
+
+  // The state shared with the helper threads.
+  struct shared
+  {
+    semaphore ping
+      { "ping" };
+    semaphore pong
+      { "pong" };
+    mutex mx
+      { "mx" };
+    volatile bool done = false;
+  };
+
+#pragma GCC diagnostic pop
+
+  constexpr unsigned int max_results = 16;
+
+  bench_result results[max_results];
+  unsigned int results_count = 0;
+
+  uint32_t
+  cycles_per_op (clock::timestamp_t begin, statistics::counter_t ops)
+  {
+    if (ops == 0)
+      {
+        return 0;
+      }
+    return static_cast<uint32_t> ((hrclock.now () - begin) / ops);
+  }
+
+  // Run the sampling function `samples` times and keep
+  // the minimum, the median and the maximum.
+  template<typename F>
+    void
+    measure (const char* name, unsigned int size, uint32_t limit, F sample)
+    {
+      uint32_t values[samples];
+
+      for (auto& v : values)
+        {
+          v = sample ();
+        }
+
+      // Insertion sort, the array is small.
+      for (unsigned int i = 1; i < samples; ++i)
+        {
+          uint32_t v = values[i];
+          unsigned int j = i;
+          for (; j > 0 && values[j - 1] > v; --j)
+            {
+              values[j] = values[j - 1];
+            }
+          values[j] = v;
+        }
+
+      if (results_count < max_results)
+        {
+          results[results_count++] =
+            { name, size, values[0], values[samples / 2],
+                values[samples - 1], limit };
+        }
+    }
+
+  // --------------------------------------------------------------------------
+
+  // Yield until done; with the same priority as the main thread,
+  // each yield switches to the other thread.
+  void*
+  yielder (void* args)
+  {
+    shared& sh = *static_cast<shared*> (args);
+
+    while (!sh.done)
+      {
+        this_thread::yield ();
+      }
+    return nullptr;
+  }
+
+  // Answer each ping with a pong.
+  void*
+  ponger (void* args)
+  {
+    shared& sh = *static_cast<shared*> (args);
+
+    for (;;)
+      {
+        sh.ping.wait ();
+        if (sh.done)
+          {
+            break;
+          }
+        sh.pong.post ();
+      }
+    return nullptr;
+  }
+
+  // When pinged, block on the mutex owned by the main thread.
+  void*
+  locker (void* args)
+  {
+    shared& sh = *static_cast<shared*> (args);
+
+    for (;;)
+      {
+        sh.ping.wait ();
+        if (sh.done)
+          {
+            break;
+          }
+        sh.mx.lock ();
+        sh.mx.unlock ();
+      }
+    return nullptr;
+  }
+
+  const thread::attributes&
+  helper_attributes (void)
+  {
+    static thread::attributes attr;
+
+    // Higher than the main thread, to run as soon as resumed.
+    attr.th_priority = thread::priority::above_normal;
+    return attr;
+  }
+
+  void
+  bench_context_switch (void)
+  {
+    shared sh;
+
+    thread_inclusive<> th
+      { "yielder", yielder, &sh };
+
+    measure ("context-switch", 0, BENCH_LIMIT_CONTEXT_SWITCH, []
+      {
+        statistics::counter_t switches =
+        scheduler::statistics::context_switches ();
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            this_thread::yield ();
+          }
+
+        return cycles_per_op (begin,
+            scheduler::statistics::context_switches () - switches);
+      });
+
+    sh.done = true;
+    th.join ();
+  }
+
+  void
+  bench_semaphore (void)
+  {
+    shared sh;
+
+    thread_inclusive<> th
+      { "ponger", ponger, &sh, helper_attributes () };
+
+    measure ("semaphore-ping-pong", 0, BENCH_LIMIT_SEMAPHORE_PING_PONG, [&sh]
+      {
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            sh.ping.post ();
+            sh.pong.wait ();
+          }
+
+        return cycles_per_op (begin, batch);
+      });
+
+    sh.done = true;
+    sh.ping.post ();
+    th.join ();
+  }
+
+  void
+  bench_mutex (void)
+  {
+    shared sh;
+
+    measure ("mutex-uncontended", 0, BENCH_LIMIT_MUTEX_UNCONTENDED, [&sh]
+      {
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            sh.mx.lock ();
+            sh.mx.unlock ();
+          }
+
+        return cycles_per_op (begin, batch);
+      });
+
+    thread_inclusive<> th
+      { "locker", locker, &sh, helper_attributes () };
+
+    measure ("mutex-contended", 0, BENCH_LIMIT_MUTEX_CONTENDED, [&sh]
+      {
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            sh.mx.lock ();
+            // The locker runs and blocks on the mutex.
+            sh.ping.post ();
+            // The locker takes the mutex, releases it and waits.
+            sh.mx.unlock ();
+          }
+
+        return cycles_per_op (begin, batch);
+      });
+
+    sh.done = true;
+    sh.ping.post ();
+    th.join ();
+  }
+
+  template<std::size_t S>
+    void
+    bench_mqueue (void)
+    {
+      message_queue_inclusive<message<S>, 2> mq
+        { "mq" };
+
+      measure ("mqueue-send-receive", S,
+               BENCH_LIMIT_MQUEUE_SEND_RECEIVE + BENCH_LIMIT_MQUEUE_PER_BYTE * S,
+               [&mq]
+                 {
+                   message<S> msg
+                     { };
+
+                   clock::timestamp_t begin = hrclock.now ();
+
+                   for (unsigned int i = 0; i < batch; ++i)
+                     {
+                       mq.send (&msg);
+                       mq.receive (&msg);
+                     }
+
+                   return cycles_per_op (begin, batch);
+                 });
+    }
+
+  void
+  bench_mempool (void)
+  {
+    memory_pool_inclusive<block, 8> mp
+      { "mp" };
+
+    measure ("mempool-alloc-free", sizeof(block),
+             BENCH_LIMIT_MEMPOOL_ALLOC_FREE, [&mp]
+               {
+                 clock::timestamp_t begin = hrclock.now ();
+
+                 for (unsigned int i = 0; i < batch; ++i)
+                   {
+                     mp.free (mp.alloc ());
+                   }
+
+                 return cycles_per_op (begin, batch);
+               });
+  }
+
+  void
+  bench_evflags (void)
+  {
+    event_flags ev
+      { "ev" };
+
+    measure ("evflags-raise-wait", 0, BENCH_LIMIT_EVFLAGS_RAISE_WAIT, [&ev]
+      {
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            ev.raise (0x1);
+            ev.try_wait (0x1);
+          }
+
+        return cycles_per_op (begin, batch);
+      });
+  }
+
+  void
+  timer_callback (void* args __attribute__((unused)))
+  {
+  }
+
+  void
+  bench_timer (void)
+  {
+    timer tm
+      { "tm", timer_callback, nullptr };
+
+    measure ("timer-start-stop", 0, BENCH_LIMIT_TIMER_START_STOP, [&tm]
+      {
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            // Long enough to never expire.
+            tm.start (100000);
+            tm.stop ();
+          }
+
+        return cycles_per_op (begin, batch);
+      });
+  }
+
+  void
+  bench_first_fit_top (std::size_t bytes)
+  {
+    os::memory::first_fit_top_inclusive<2048> ff
+      { "ff" };
+
+    // Keep a few blocks allocated, to have a fragmented free list.
+    void* held[4];
+    for (auto& p : held)
+      {
+        p = ff.allocate (24);
+        ff.deallocate (ff.allocate (8), 8);
+      }
+
+    measure ("first-fit-top", static_cast<unsigned int> (bytes),
+             BENCH_LIMIT_FIRST_FIT_TOP, [&ff, bytes]
+               {
+                 clock::timestamp_t begin = hrclock.now ();
+
+                 for (unsigned int i = 0; i < batch; ++i)
+                   {
+                     ff.deallocate (ff.allocate (bytes), bytes);
+                   }
+
+                 return cycles_per_op (begin, batch);
+               });
+
+    for (auto p : held)
+      {
+        ff.deallocate (p, 24);
+      }
+  }
+
+  void
+  bench_block_pool (void)
+  {
+    os::memory::block_pool_typed_inclusive<block, 8> bp
+      { "bp" };
+
+    measure ("block-pool", sizeof(block), BENCH_LIMIT_BLOCK_POOL, [&bp]
+      {
+        clock::timestamp_t begin = hrclock.now ();
+
+        for (unsigned int i = 0; i < batch; ++i)
+          {
+            bp.deallocate (bp.allocate (sizeof(block)), sizeof(block));
+          }
+
+        return cycles_per_op (begin, batch);
+      });
+  }
+
+  // --------------------------------------------------------------------------
+
+  // Write the results as a JSON object, between marker lines,
+  // to be easily extracted from the test output.
+  void
+  print_json (void)
+  {
+    printf ("BENCH-JSON-BEGIN\n");
+    printf ("{\n");
+    printf ("  \"suite\": \"rtos-bench\",\n");
+#if defined(__ARM_EABI__)
+    printf ("  \"platform\": \"cortex-m\",\n");
+#else
+    printf ("  \"platform\": \"native\",\n");
+#endif
+#if defined(DEBUG)
+    printf ("  \"build\": \"debug\",\n");
+#else
+    printf ("  \"build\": \"release\",\n");
+#endif
+    printf ("  \"compiler\": \"" __VERSION__ "\",\n");
+    printf ("  \"unit\": \"cycles\",\n");
+    printf ("  \"clock_hz\": %lu,\n",
+            static_cast<unsigned long> (hrclock.input_clock_frequency_hz ()));
+    printf ("  \"samples\": %u,\n", samples);
+    printf ("  \"batch\": %u,\n", batch);
+    printf ("  \"results\": [\n");
+
+    for (unsigned int i = 0; i < results_count; ++i)
+      {
+        const bench_result& r = results[i];
+        bool pass = (r.limit == 0) || (r.median <= r.limit);
+
+        printf ("    { \"name\": \"%s\", \"size\": %u, \"min\": %lu,"
+                " \"median\": %lu, \"max\": %lu, \"limit\": %lu,"
+                " \"pass\": %s }%s\n",
+                r.name, r.size, static_cast<unsigned long> (r.min),
+                static_cast<unsigned long> (r.median),
+                static_cast<unsigned long> (r.max),
+                static_cast<unsigned long> (r.limit), pass ? "true" : "false",
+                (i + 1 < results_count) ? "," : "");
+      }
+
+    printf ("  ]\n");
+    printf ("}\n");
+    printf ("BENCH-JSON-END\n");
+  }
+
+} /* namespace */
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @details
+ * Measure the cost of the most common RTOS operations, in `hrclock`
+ * cycles, and compare the medians with the limits in `bench-limits.h`.
+ *
+ * The context switch is measured between two threads of the same
+ * priority which yield to each other; the other benchmarks include
+ * the context switches they cause, if any.
+ */
+int
+run_micro_bench (void)
+{
+  results_count = 0;
+
+  bench_context_switch ();
+  bench_semaphore ();
+  bench_mutex ();
+
+  bench_mqueue<8> ();
+  bench_mqueue<16> ();
+  bench_mqueue<64> ();
+  bench_mqueue<128> ();
+
+  bench_mempool ();
+  bench_evflags ();
+  bench_timer ();
+
+  bench_first_fit_top (16);
+  bench_first_fit_top (128);
+  bench_block_pool ();
+
+  print_json ();
+
+  int status = 0;
+
+  for (unsigned int i = 0; i < results_count; ++i)
+    {
+      const bench_result& r = results[i];
+      if (r.limit != 0 && r.median > r.limit)
+        {
+          printf ("%s(%u): %lu cycles, over the %lu limit\n", r.name, r.size,
+                  static_cast<unsigned long> (r.median),
+                  static_cast<unsigned long> (r.limit));
+          status = 1;
+        }
+    }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
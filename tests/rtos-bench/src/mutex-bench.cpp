@@ -0,0 +1,285 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+// The duration of the critical section of the low priority thread.
+constexpr unsigned int low_work_micros = 5000;
+// The duration of the medium priority thread, which preempts
+// the threads that are not properly boosted.
+constexpr unsigned int noise_work_micros = 10000;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// The chain of threads: `high` blocks on `m1`, owned by `middle`,
+// which blocks on `m2`, owned by `low`. `noise` has a priority
+// between `middle` and `high`, and hogs the CPU.
+struct inversion_chain
+{
+  inversion_chain (const mutex::attributes& attr);
+
+  mutex m1;
+  mutex m2;
+
+  semaphore_binary start_low
+    { "start_low", 0 };
+  semaphore_binary start_middle
+    { "start_middle", 0 };
+  semaphore_binary start_noise
+    { "start_noise", 0 };
+  semaphore_binary start_high
+    { "start_high", 0 };
+
+  semaphore_counting ready
+    { "ready", 4, 0 };
+  semaphore_counting done
+    { "done", 4, 0 };
+
+  bool volatile quit = false;
+  uint64_t volatile blocked_micros = 0;
+};
+
+#pragma GCC diagnostic pop
+
+inversion_chain::inversion_chain (const mutex::attributes& attr) :
+    m1
+      { "m1", attr }, //
+    m2
+      { "m2", attr }
+{
+}
+
+static thread::attributes
+chain_thread_attributes (thread::priority_t prio)
+{
+  thread::attributes attr;
+  attr.th_priority = prio;
+  return attr;
+}
+
+static void*
+low_main (void* args)
+{
+  auto* ch = static_cast<inversion_chain*> (args);
+  for (;;)
+    {
+      ch->start_low.wait ();
+      if (ch->quit)
+        {
+          break;
+        }
+
+      ch->m2.lock ();
+      ch->ready.post ();
+      spin (low_work_micros);
+      ch->m2.unlock ();
+
+      ch->done.post ();
+    }
+  return nullptr;
+}
+
+static void*
+middle_main (void* args)
+{
+  auto* ch = static_cast<inversion_chain*> (args);
+  for (;;)
+    {
+      ch->start_middle.wait ();
+      if (ch->quit)
+        {
+          break;
+        }
+
+      ch->m1.lock ();
+      ch->m2.lock ();
+      ch->m2.unlock ();
+      ch->m1.unlock ();
+
+      ch->done.post ();
+    }
+  return nullptr;
+}
+
+static void*
+noise_main (void* args)
+{
+  auto* ch = static_cast<inversion_chain*> (args);
+  for (;;)
+    {
+      ch->start_noise.wait ();
+      if (ch->quit)
+        {
+          break;
+        }
+
+      spin (noise_work_micros);
+
+      ch->done.post ();
+    }
+  return nullptr;
+}
+
+static void*
+high_main (void* args)
+{
+  auto* ch = static_cast<inversion_chain*> (args);
+  for (;;)
+    {
+      ch->start_high.wait ();
+      if (ch->quit)
+        {
+          break;
+        }
+
+      uint64_t begin = real_micros ();
+      ch->m1.lock ();
+      ch->blocked_micros = real_micros () - begin;
+      ch->m1.unlock ();
+
+      ch->done.post ();
+    }
+  return nullptr;
+}
+
+/*
+ * Run the chain a number of times and return the worst case
+ * blocking time of the high priority thread, in microseconds.
+ */
+static uint64_t
+run_chain (const mutex::attributes& mx_attr, unsigned int rounds)
+{
+  inversion_chain ch
+    { mx_attr };
+
+  thread low
+    { "low", low_main, &ch, chain_thread_attributes (thread::priority::low) };
+  thread middle
+    { "middle", middle_main, &ch, chain_thread_attributes (
+        thread::priority::below_normal) };
+  thread noise
+    { "noise", noise_main, &ch, chain_thread_attributes (
+        thread::priority::normal) };
+  thread high
+    { "high", high_main, &ch, chain_thread_attributes (
+        thread::priority::above_normal) };
+
+  uint64_t worst = 0;
+  for (unsigned int i = 0; i < rounds; ++i)
+    {
+      // `low` locks `m2` and starts its critical section.
+      ch.start_low.post ();
+      ch.ready.wait ();
+
+      // `middle` locks `m1` and blocks on `m2`.
+      ch.start_middle.post ();
+      sysclock.sleep_for (1);
+
+      // `high` blocks on `m1`; if `low` is not boosted above `noise`,
+      // `high` must also wait for `noise`.
+      ch.start_noise.post ();
+      ch.start_high.post ();
+
+      for (unsigned int j = 0; j < 4; ++j)
+        {
+          ch.done.wait ();
+        }
+
+      if (ch.blocked_micros > worst)
+        {
+          worst = ch.blocked_micros;
+        }
+    }
+
+  ch.quit = true;
+  ch.start_low.post ();
+  ch.start_middle.post ();
+  ch.start_noise.post ();
+  ch.start_high.post ();
+
+  low.join ();
+  middle.join ();
+  noise.join ();
+  high.join ();
+
+  return worst;
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @details
+ * A priority inversion scenario with a chain of two mutexes,
+ * derived from the mutex stress test.
+ *
+ * With transitive priority inheritance, the high priority thread
+ * waits at most for the rest of the low priority critical section;
+ * otherwise it also waits for the unrelated medium priority thread.
+ */
+int
+run_mutex_bench (void)
+{
+  constexpr unsigned int rounds = 10;
+
+  // The orchestrating thread must preempt all chain threads.
+  thread& crt_thread = this_thread::thread ();
+  thread::priority_t saved_prio = crt_thread.priority ();
+  crt_thread.priority (thread::priority::high);
+
+  mutex::attributes none_attr;
+  none_attr.mx_protocol = mutex::protocol::none;
+  uint64_t worst_none = run_chain (none_attr, rounds);
+
+  mutex::attributes inherit_attr;
+  inherit_attr.mx_protocol = mutex::protocol::inherit;
+  uint64_t worst_inherit = run_chain (inherit_attr, rounds);
+
+  crt_thread.priority (saved_prio);
+
+  printf ("mutex inversion chain: worst blocking %u us with inherit, "
+          "%u us without (%u us critical section, %u us noise)\n",
+          static_cast<unsigned int> (worst_inherit),
+          static_cast<unsigned int> (worst_none), low_work_micros,
+          noise_work_micros);
+
+  int status = 0;
+
+  // With proper inheritance the noise must never be waited for.
+  if (worst_inherit >= low_work_micros + noise_work_micros / 2)
+    {
+      printf ("mutex inversion chain not bounded by inheritance\n");
+      status = 1;
+    }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// The locks shared by the readers.
+struct shared_locks
+{
+  rwlock rw
+    { "rw" };
+  mutex mx
+    { "mx" };
+
+  // When false, the readers serialise on the mutex.
+  bool use_rwlock = true;
+  unsigned int rounds = 0;
+};
+
+// A thread repeatedly entering a read section.
+class rwlock_reader
+{
+public:
+
+  rwlock_reader (const char* name, shared_locks& locks);
+
+  void*
+  object_main (void);
+
+  rtos::thread&
+  thread (void)
+  {
+    return th_;
+  }
+
+protected:
+
+  shared_locks& locks_;
+
+  rtos::thread th_;
+};
+
+#pragma GCC diagnostic pop
+
+rwlock_reader::rwlock_reader (const char* name, shared_locks& locks) :
+    locks_ (locks), //
+    th_
+      { name, [](void* attr)-> void*
+        { return static_cast<rwlock_reader*> (attr)->object_main ();}, this }
+{
+}
+
+void*
+rwlock_reader::object_main (void)
+{
+  for (unsigned int r = 0; r < locks_.rounds; ++r)
+    {
+      // The read section blocks, as a lengthy access would do, so that
+      // the other readers get a chance to run while the lock is held.
+      if (locks_.use_rwlock)
+        {
+          locks_.rw.read_lock ();
+          sysclock.sleep_for (1);
+          locks_.rw.unlock ();
+        }
+      else
+        {
+          locks_.mx.lock ();
+          sysclock.sleep_for (1);
+          locks_.mx.unlock ();
+        }
+    }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+static clock::duration_t
+measure_readers (unsigned int count, bool use_rwlock)
+{
+  constexpr unsigned int max_readers = 8;
+  static const char* names[max_readers] =
+    { "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7" };
+
+  shared_locks locks;
+  locks.use_rwlock = use_rwlock;
+  locks.rounds = 50;
+
+  // Start at a tick boundary.
+  sysclock.sleep_for (1);
+  clock::timestamp_t begin = sysclock.now ();
+
+  rwlock_reader* rs[max_readers];
+  for (unsigned int i = 0; i < count; ++i)
+    {
+      rs[i] = new rwlock_reader
+        { names[i], locks };
+    }
+
+  for (unsigned int i = 0; i < count; ++i)
+    {
+      rs[i]->thread ().join ();
+      delete rs[i];
+    }
+
+  return static_cast<clock::duration_t> (sysclock.now () - begin);
+}
+
+/**
+ * @details
+ * Multiple threads enter read sections guarded either by a read-write
+ * lock or by a mutex. Each section sleeps for one tick, so the total
+ * duration measures how many readers are in the section at once.
+ *
+ * With the read-write lock the duration is expected to stay about the
+ * same regardless of the number of readers, while with the mutex it
+ * grows linearly.
+ */
+int
+run_rwlock_bench (void)
+{
+  static const unsigned int counts[] =
+    { 1, 2, 4, 8 };
+
+  int status = 0;
+
+  for (auto count : counts)
+    {
+      clock::duration_t rw_ticks = measure_readers (count, true);
+      clock::duration_t mx_ticks = measure_readers (count, false);
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+      printf ("rwlock readers: %u threads, %u ticks (mutex %u ticks)\n",
+              count, static_cast<unsigned int> (rw_ticks),
+              static_cast<unsigned int> (mx_ticks));
+#pragma GCC diagnostic pop
+
+      if (count == 8 && rw_ticks * 2 >= mx_ticks)
+        {
+          printf ("rwlock readers do not run concurrently\n");
+          status = 1;
+        }
+    }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,29 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <cstdint>
+
+int
+run_tests (unsigned int seconds);
+
+// Statistics updated by the tickless sleep hook.
+extern volatile uint32_t tickless_sleeps;
+extern volatile uint64_t tickless_slept_ticks;
+
+// Microseconds of real time.
+uint64_t
+real_micros (void);
+
+#endif /* TEST_H_ */
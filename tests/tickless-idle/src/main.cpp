@@ -0,0 +1,138 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <sys/time.h>
+
+#include <test.h>
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace os;
+using namespace os::rtos;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wmissing-variable-declarations"
+#endif
+
+volatile uint32_t tickless_sleeps;
+volatile uint64_t tickless_slept_ticks;
+
+#pragma GCC diagnostic pop
+
+uint64_t
+real_micros (void)
+{
+  /* struct */ timeval tp;
+  gettimeofday (&tp, nullptr);
+  return static_cast<uint64_t> (tp.tv_sec) * 1000000u
+      + static_cast<uint64_t> (tp.tv_usec);
+}
+
+/**
+ * @details
+ * On the native platform the SysTick is simulated by a periodic
+ * `ITIMER_REAL` timer, and the interrupts are simulated by signals,
+ * which are blocked during critical sections.
+ *
+ * Instead of reprogramming the timer, the hook keeps it running,
+ * sleeps the process until the requested tick, and counts the timer
+ * periods that passed; the signals of all these periods are merged
+ * into a single pending one, which will count the last tick when
+ * the critical section is exited.
+ */
+uint32_t
+os_rtos_idle_tickless_sleep_hook (uint32_t ticks)
+{
+  /* struct */ itimerval itv;
+  getitimer (ITIMER_REAL, &itv);
+
+  uint64_t period = static_cast<uint64_t> (itv.it_interval.tv_sec) * 1000000u
+      + static_cast<uint64_t> (itv.it_interval.tv_usec);
+  uint64_t remaining = static_cast<uint64_t> (itv.it_value.tv_sec) * 1000000u
+      + static_cast<uint64_t> (itv.it_value.tv_usec);
+
+  if (period == 0)
+    {
+      // The timer is not running, there is nothing to do.
+      return 0;
+    }
+
+  uint64_t begin = real_micros ();
+
+  // Wake up shortly after the requested tick.
+  uint64_t micros = remaining + (ticks - 1) * period + period / 10;
+  /* struct */ timespec ts;
+  ts.tv_sec = static_cast<time_t> (micros / 1000000u);
+  ts.tv_nsec = static_cast<long> ((micros % 1000000u) * 1000u);
+  nanosleep (&ts, nullptr);
+
+  uint64_t elapsed = real_micros () - begin;
+  if (elapsed < remaining)
+    {
+      return 0;
+    }
+
+  // The number of periods that passed, less the pending one.
+  uint32_t slept = static_cast<uint32_t> ((elapsed - remaining) / period);
+
+  tickless_sleeps = tickless_sleeps + 1;
+  tickless_slept_ticks = tickless_slept_ticks + slept;
+
+  return slept;
+}
+
+int
+os_main (int argc, char* argv[])
+{
+  unsigned int seconds = 10;
+  if (argc > 1)
+    {
+      seconds = static_cast<unsigned int> (atoi (argv[1]));
+    }
+
+  printf ("\nTickless idle test\n");
+#if defined(__clang__)
+  printf ("Built with clang " __VERSION__ "\n");
+#else
+  printf ("Built with GCC " __VERSION__ "\n");
+#endif
+
+  uint32_t seed;
+
+  /* struct */ timeval tp;
+  gettimeofday (&tp, nullptr);
+  // Use some large prime numbers and the current time.
+  seed =
+      static_cast<uint32_t> ((tp.tv_sec + tp.tv_usec + 15485863) * 179424673);
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+  printf ("Seed %u\n", static_cast<unsigned int> (seed));
+#pragma GCC diagnostic pop
+
+  srand (seed);
+
+  return run_tests (seconds);
+}
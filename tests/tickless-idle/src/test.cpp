@@ -0,0 +1,272 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// A thread sleeping random durations and checking the wake-up moments.
+class sleeper
+{
+public:
+
+  sleeper (const char* name, unsigned int min_ticks, unsigned int max_ticks);
+
+  void*
+  object_main (void);
+
+  rtos::thread&
+  thread (void)
+  {
+    return th_;
+  }
+
+  unsigned int count_ = 0;
+  unsigned int late_ = 0;
+  clock::duration_t max_late_ = 0;
+
+protected:
+
+  unsigned int min_ticks_;
+  unsigned int max_ticks_;
+
+  rtos::thread th_;
+};
+
+#pragma GCC diagnostic pop
+
+sleeper::sleeper (const char* name, unsigned int min_ticks,
+                  unsigned int max_ticks) :
+    min_ticks_ (min_ticks), //
+    max_ticks_ (max_ticks), //
+    th_
+      { name, [](void* attr)-> void*
+        { return static_cast<sleeper*> (attr)->object_main ();}, this }
+{
+  trace::printf ("%s @%p %s\n", __func__, this, name);
+}
+
+void*
+sleeper::object_main (void)
+{
+  while (!thread ().interrupted ())
+    {
+      clock::duration_t ticks = (static_cast<unsigned int> (rand ())
+          % (max_ticks_ - min_ticks_)) + min_ticks_;
+
+      clock::timestamp_t due = sysclock.now () + ticks;
+      sysclock.sleep_for (ticks);
+      clock::timestamp_t now = sysclock.now ();
+
+      if (thread ().interrupted ())
+        {
+          break;
+        }
+
+      // Woken by the tick that reached the deadline,
+      // possibly delayed by other threads by one tick.
+      if (now > due + 1)
+        {
+          ++late_;
+        }
+      if (now > due && static_cast<clock::duration_t> (now - due) > max_late_)
+        {
+          max_late_ = static_cast<clock::duration_t> (now - due);
+        }
+      ++count_;
+    }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+// A one-shot timer, restarted after each expiration.
+class oneshot
+{
+public:
+
+  oneshot (const char* name);
+
+  bool
+  run (clock::duration_t ticks);
+
+  unsigned int count_ = 0;
+  unsigned int lost_ = 0;
+  unsigned int late_ = 0;
+
+protected:
+
+  clock::timestamp_t due_ = 0;
+  clock::timestamp_t fired_ = 0;
+  rtos::timer tm_;
+};
+
+#pragma GCC diagnostic pop
+
+oneshot::oneshot (const char* name) :
+    tm_
+      { name, [](void* attr)
+        {
+          static_cast<oneshot*> (attr)->fired_ = sysclock.now ();
+        }, this }
+{
+}
+
+bool
+oneshot::run (clock::duration_t ticks)
+{
+  fired_ = 0;
+  due_ = sysclock.now () + ticks;
+  tm_.start (ticks);
+
+  // Leave enough time for the timer to expire.
+  sysclock.sleep_for (ticks + 5);
+
+  if (fired_ == 0)
+    {
+      ++lost_;
+      tm_.stop ();
+      return false;
+    }
+
+  if (fired_ < due_ || fired_ > due_ + 1)
+    {
+      ++late_;
+      return false;
+    }
+
+  ++count_;
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+int
+run_tests (unsigned int seconds)
+{
+  sleeper s0
+    { "s0", 2, 10 };
+  sleeper s1
+    { "s1", 10, 50 };
+  sleeper s2
+    { "s2", 50, 200 };
+  sleeper s3
+    { "s3", 100, 1500 };
+
+  sleeper* ss[] =
+    { &s0, &s1, &s2, &s3 };
+
+  oneshot os0
+    { "os0" };
+
+  uint64_t begin_micros = real_micros ();
+  clock::timestamp_t begin_ticks = sysclock.now ();
+  clock::timestamp_t end_ticks = begin_ticks
+      + seconds * clock_systick::frequency_hz;
+
+  while (sysclock.now () < end_ticks)
+    {
+      clock::duration_t ticks = (static_cast<unsigned int> (rand ()) % 300)
+          + 2;
+      os0.run (ticks);
+    }
+
+  uint64_t real = real_micros () - begin_micros;
+  clock::timestamp_t counted = sysclock.now () - begin_ticks;
+
+  for (auto s : ss)
+    {
+      s->thread ().interrupt ();
+      s->thread ().join ();
+    }
+
+  int status = 0;
+
+  for (auto s : ss)
+    {
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+      printf ("%s: %u sleeps, %u late, max %u ticks late\n",
+              s->thread ().name (), s->count_, s->late_,
+              static_cast<unsigned int> (s->max_late_));
+#pragma GCC diagnostic pop
+
+      if (s->late_ != 0)
+        {
+          status = 1;
+        }
+    }
+
+  printf ("timer: %u expired, %u lost, %u late\n", os0.count_, os0.lost_,
+          os0.late_);
+  if (os0.lost_ != 0 || os0.late_ != 0)
+    {
+      status = 1;
+    }
+
+  // Compare the counted ticks with the real time; allow 2% for the
+  // host scheduling jitter.
+  uint64_t expected = real * clock_systick::frequency_hz / 1000000u;
+  uint64_t drift = (expected > counted) ? expected - counted : counted
+      - expected;
+
+  printf ("clock: %u ticks counted, %u ticks of real time\n",
+          static_cast<unsigned int> (counted),
+          static_cast<unsigned int> (expected));
+  if (drift > expected / 50 + 10)
+    {
+      printf ("clock drift too large\n");
+      status = 1;
+    }
+
+  printf ("tickless: %u sleeps, %u ticks slept\n",
+          static_cast<unsigned int> (tickless_sleeps),
+          static_cast<unsigned int> (tickless_slept_ticks));
+  if (tickless_sleeps == 0)
+    {
+      printf ("tickless sleep not used\n");
+      status = 1;
+    }
+
+  puts (status == 0 ? "Done." : "Failed.");
+  return status;
+}
@@ -0,0 +1,65 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <sys/time.h>
+
+#include <test.h>
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace os;
+using namespace os::rtos;
+
+int
+os_main (int argc, char* argv[])
+{
+  unsigned int iterations = 20000;
+  if (argc > 1)
+    {
+      iterations = static_cast<unsigned int> (atoi (argv[1]));
+    }
+
+  printf ("\nTiming wheel test\n");
+#if defined(__clang__)
+  printf ("Built with clang " __VERSION__ "\n");
+#else
+  printf ("Built with GCC " __VERSION__ "\n");
+#endif
+
+  uint32_t seed;
+
+  /* struct */ timeval tp;
+  gettimeofday (&tp, nullptr);
+  // Use some large prime numbers and the current time.
+  seed =
+      static_cast<uint32_t> ((tp.tv_sec + tp.tv_usec + 15485863) * 179424673);
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+  printf ("Seed %u\n", static_cast<unsigned int> (seed));
+#pragma GCC diagnostic pop
+
+  srand (seed);
+
+  return run_tests (iterations);
+}
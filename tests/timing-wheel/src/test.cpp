@@ -0,0 +1,359 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2023 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/mit/.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <test.h>
+
+#include <cmsis-plus/rtos/os.h>
+#include <cmsis-plus/diag/trace.h>
+
+using namespace os;
+using namespace os::rtos;
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+#if !defined(OS_USE_RTOS_CLOCK_TIMING_WHEEL)
+#error "This test requires OS_USE_RTOS_CLOCK_TIMING_WHEEL."
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+  using wheel = internal::clock_timestamps_list;
+
+  constexpr clock::timestamp_t range = wheel::range;
+
+  // The time passed to the last check.
+  clock::timestamp_t current;
+
+  unsigned int failures;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wpadded"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wpadded"
+#endif
+
+  // A node which remembers when it expired.
+  class probe : public internal::timestamp_node
+  {
+  public:
+
+    probe (clock::timestamp_t ts) :
+        timestamp_node
+          { ts }
+    {
+    }
+
+    virtual void
+    action (void) override
+    {
+      unlink ();
+      fired_ = true;
+      when_ = current;
+    }
+
+    bool fired_ = false;
+    clock::timestamp_t when_ = 0;
+  };
+
+#pragma GCC diagnostic pop
+
+  void
+  link (wheel& list, probe& node, clock::timestamp_t ts)
+  {
+    // ----- Enter critical section -------------------------------------------
+    interrupts::critical_section ics;
+
+    node.timestamp = ts;
+    node.fired_ = false;
+    list.link (node);
+    // ----- Exit critical section --------------------------------------------
+  }
+
+  void
+  unlink (probe& node)
+  {
+    // ----- Enter critical section -------------------------------------------
+    interrupts::critical_section ics;
+
+    // Does nothing if already unlinked.
+    node.unlink ();
+    // ----- Exit critical section --------------------------------------------
+  }
+
+  void
+  check (wheel& list, clock::timestamp_t now)
+  {
+    current = now;
+    list.check_timestamp (now);
+  }
+
+  // Advance the time one unit at a time.
+  void
+  step (wheel& list, clock::timestamp_t to)
+  {
+    for (clock::timestamp_t t = current + 1; t <= to; ++t)
+      {
+        check (list, t);
+      }
+  }
+
+  void
+  expect_fired (const char* test, const probe& node, clock::timestamp_t when)
+  {
+    if (!node.fired_ || node.when_ != when)
+      {
+        printf ("%s: node due at %llu expired %s %llu, expected %llu\n", test,
+                static_cast<unsigned long long> (node.timestamp),
+                node.fired_ ? "at" : "not yet, now",
+                static_cast<unsigned long long> (
+                    node.fired_ ? node.when_ : current),
+                static_cast<unsigned long long> (when));
+        ++failures;
+      }
+  }
+
+  void
+  expect_pending (const char* test, const probe& node)
+  {
+    if (node.fired_)
+      {
+        printf ("%s: node due at %llu expired early, at %llu\n", test,
+                static_cast<unsigned long long> (node.timestamp),
+                static_cast<unsigned long long> (node.when_));
+        ++failures;
+      }
+  }
+
+  // --------------------------------------------------------------------------
+
+  // Step one unit at a time across the wheel range boundaries,
+  // with the overflow nodes due right after them; the wheel is
+  // empty when the boundaries are crossed.
+  void
+  test_overflow_stepping (void)
+  {
+    const char* name = "overflow-stepping";
+
+    wheel list;
+    current = 0;
+
+    probe p0
+      { 0 };
+    probe p1
+      { 0 };
+    probe p2
+      { 0 };
+    probe p3
+      { 0 };
+
+    link (list, p0, range - 1);
+    link (list, p1, range);
+    link (list, p2, range + 5);
+    link (list, p3, 2 * range + 9);
+
+    check (list, range - 50);
+    expect_pending (name, p0);
+
+    step (list, range + 100);
+    expect_fired (name, p0, range - 1);
+    expect_fired (name, p1, range);
+    expect_fired (name, p2, range + 5);
+    expect_pending (name, p3);
+
+    // Stop one unit before the boundary, like a tickless sleep would.
+    check (list, 2 * range - 1);
+    expect_pending (name, p3);
+
+    step (list, 2 * range + 100);
+    expect_fired (name, p3, 2 * range + 9);
+
+    for (auto p :
+      { &p0, &p1, &p2, &p3 })
+      {
+        unlink (*p);
+      }
+  }
+
+  // Jump over one or more wheel ranges, with and without
+  // overflow nodes in between.
+  void
+  test_jumps (void)
+  {
+    const char* name = "jumps";
+
+    wheel list;
+    current = 0;
+
+    probe a
+      { 0 };
+    probe b
+      { 0 };
+    probe c
+      { 0 };
+    probe d
+      { 0 };
+    probe e
+      { 0 };
+
+    link (list, a, 100);
+    link (list, b, 3 * range + 1);
+    link (list, c, 5 * range + 2);
+    link (list, d, 5 * range + 3);
+    link (list, e, 6 * range + 10);
+
+    check (list, 50);
+    expect_pending (name, a);
+
+    // Several ranges at once.
+    check (list, 4 * range);
+    expect_fired (name, a, 4 * range);
+    expect_fired (name, b, 4 * range);
+    expect_pending (name, c);
+
+    // Exactly to a node in the overflow list.
+    check (list, 5 * range + 2);
+    expect_fired (name, c, 5 * range + 2);
+    expect_pending (name, d);
+
+    check (list, 5 * range + 3);
+    expect_fired (name, d, 5 * range + 3);
+
+    // Less than a range, but across a boundary.
+    check (list, 6 * range + 9);
+    expect_pending (name, e);
+    check (list, 6 * range + 20);
+    expect_fired (name, e, 6 * range + 20);
+
+    for (auto p :
+      { &a, &b, &c, &d, &e })
+      {
+        unlink (*p);
+      }
+  }
+
+  clock::duration_t
+  random_delay (void)
+  {
+    unsigned int r = static_cast<unsigned int> (rand ());
+
+    switch (r % 4)
+      {
+      case 0:
+        return r % 32 + 1;
+      case 1:
+        return r % 1024 + 1;
+      case 2:
+        return static_cast<clock::duration_t> (r % range + 1);
+      default:
+        return static_cast<clock::duration_t> (r % (4 * range) + 1);
+      }
+  }
+
+  clock::duration_t
+  random_step (void)
+  {
+    unsigned int r = static_cast<unsigned int> (rand ());
+
+    switch (r % 8)
+      {
+      case 6:
+        return static_cast<clock::duration_t> (r % (range / 2) + 1);
+      case 7:
+        return static_cast<clock::duration_t> (r % (2 * range) + range);
+      default:
+        return r % 64 + 1;
+      }
+  }
+
+  // Re-arm the nodes when they expire, like periodic timers, while
+  // the time moves forward with random steps; each node must expire
+  // at the first check not earlier than its time stamp.
+  void
+  test_random (unsigned int iterations)
+  {
+    const char* name = "random";
+
+    wheel list;
+    current = 0;
+
+    constexpr std::size_t count = 32;
+    probe* nodes[count];
+
+    for (auto& p : nodes)
+      {
+        p = new probe
+          { 0 };
+        link (list, *p, random_delay ());
+      }
+
+    clock::timestamp_t previous = 0;
+    for (unsigned int i = 0; i < iterations && failures == 0; ++i)
+      {
+        check (list, previous + random_step ());
+
+        for (auto p : nodes)
+          {
+            if (!p->fired_)
+              {
+                if (p->timestamp <= current)
+                  {
+                    expect_fired (name, *p, current);
+                  }
+                continue;
+              }
+
+            if (p->timestamp <= previous || p->timestamp > current)
+              {
+                printf ("%s: node due at %llu expired at %llu, after %llu\n",
+                        name, static_cast<unsigned long long> (p->timestamp),
+                        static_cast<unsigned long long> (current),
+                        static_cast<unsigned long long> (previous));
+                ++failures;
+              }
+            link (list, *p, current + random_delay ());
+          }
+        previous = current;
+      }
+
+    for (auto p : nodes)
+      {
+        unlink (*p);
+        delete p;
+      }
+  }
+
+} /* namespace */
+
+// ----------------------------------------------------------------------------
+
+int
+run_tests (unsigned int iterations)
+{
+  failures = 0;
+
+  test_overflow_stepping ();
+  test_jumps ();
+  test_random (iterations);
+
+  puts (failures == 0 ? "Done." : "Failed.");
+  return (failures == 0) ? 0 : 1;
+}
+
+// ----------------------------------------------------------------------------